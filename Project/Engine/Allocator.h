@@ -0,0 +1,98 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_MSC_VER)
+#define ENG_ALIGNOF(type) __alignof(type)
+#else
+#define ENG_ALIGNOF(type) __alignof__(type)
+#endif
+
+// Where an allocation was made from, for allocators that track them (see
+// eng_AllocatorGetCallsite). Compiled out of final builds.
+#if defined(GAME_FINAL)
+#define ENG_ALLOCATOR_CALLSITE NULL, 0
+#else
+#define ENG_ALLOCATOR_CALLSITE __FILE__, __LINE__
+#endif
+
+// Suits any engine object, for allocations whose type isn't visible (see
+// the eng_*GetSizeof functions).
+#define ENG_ALLOCATOR_DEFAULT_ALIGNMENT 16
+
+/**
+* Allocator
+*
+* Where an engine object gets its internal memory from. Objects take one
+* at init, keep the pointer, and make every allocation through it until
+* they're freed, so it must outlive them. A NULL allocator means the heap.
+*
+* Alignments are powers of two. Realloc and Free are given the size the
+* caller allocated, so allocators that bucket by size don't need headers.
+* Realloc of NULL allocates. Allocators handed to objects that allocate
+* from jobs (eng_TextureLoader, eng_JobPool) must be thread safe.
+*/
+typedef struct eng_Allocator
+{
+	void* (*Alloc)(void* userData, size_t size, size_t alignment);
+	void* (*Realloc)(void* userData, void* ptr, size_t oldSize, size_t newSize, size_t alignment);
+	void (*Free)(void* userData, void* ptr, size_t size);
+	void* UserData;
+} eng_Allocator;
+
+////////////////////////////////////////////////////////////////////////// Allocator API
+
+/** @returns the allocator over the C heap, honouring alignment. Thread safe. */
+const eng_Allocator* eng_AllocatorGetHeap(void);
+
+/**
+* @return uninitialized memory, or NULL on failure. allocator may be NULL
+* for the heap. Called through eng_AllocatorAlloc, which passes the callsite.
+*/
+void* eng_AllocatorAllocAt(const eng_Allocator* allocator, size_t size, size_t alignment, const char* file, int line);
+
+/** Like eng_AllocatorAllocAt, but the memory is zeroed. */
+void* eng_AllocatorCallocAt(const eng_Allocator* allocator, size_t count, size_t size, size_t alignment, const char* file, int line);
+
+/**
+* Grows or shrinks ptr, keeping the first min(oldSize, newSize) bytes.
+* @return the new memory, or NULL on failure, in which case ptr is untouched.
+*/
+void* eng_AllocatorReallocAt(const eng_Allocator* allocator, void* ptr, size_t oldSize, size_t newSize, size_t alignment, const char* file, int line);
+
+#define eng_AllocatorAlloc(allocator, size, alignment) \
+	eng_AllocatorAllocAt(allocator, size, alignment, ENG_ALLOCATOR_CALLSITE)
+#define eng_AllocatorCalloc(allocator, count, size, alignment) \
+	eng_AllocatorCallocAt(allocator, count, size, alignment, ENG_ALLOCATOR_CALLSITE)
+#define eng_AllocatorRealloc(allocator, ptr, oldSize, newSize, alignment) \
+	eng_AllocatorReallocAt(allocator, ptr, oldSize, newSize, alignment, ENG_ALLOCATOR_CALLSITE)
+
+/** Frees ptr, which was allocated with size bytes. NULL is ignored. */
+void eng_AllocatorFree(const eng_Allocator* allocator, void* ptr, size_t size);
+
+/**
+* Allocator Get Callsite
+*
+* For use inside an allocator's Alloc and Realloc: where the allocation
+* being made on this thread was requested. file is NULL in final builds
+* or when the allocator was called directly.
+*/
+void eng_AllocatorGetCallsite(const char** outFile, int* outLine);
+
+#define eng_AllocatorAllocType(allocator, type, count) \
+	((type*)eng_AllocatorAlloc(allocator, (count) * sizeof(type), ENG_ALIGNOF(type)))
+#define eng_AllocatorCallocType(allocator, type, count) \
+	((type*)eng_AllocatorCalloc(allocator, count, sizeof(type), ENG_ALIGNOF(type)))
+#define eng_AllocatorFreeType(allocator, ptr, type, count) \
+	eng_AllocatorFree(allocator, ptr, (count) * sizeof(type))
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,139 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Engine/Allocator.h>
+
+typedef struct eng_Arena eng_Arena;
+typedef struct eng_ArenaBlock eng_ArenaBlock;
+
+// A position in the arena to reset back to.
+typedef struct eng_ArenaMarker
+{
+	eng_ArenaBlock* Block;
+	size_t Offset;
+} eng_ArenaMarker;
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+/**
+* Arena Malloc
+*
+* @note The arena is not ready for use until eng_ArenaInit is called.
+* @return A newly allocated arena.
+*/
+eng_Arena* eng_ArenaMalloc(void);
+
+/**
+* Arena Init
+*
+* @description A linear allocator: allocations bump an offset through a
+* block of blockSize bytes and can't be freed individually, only reset
+* back to a marker all at once. When a block is full another is chained
+* on, so the arena never runs out while the heap doesn't. Blocks are kept
+* across resets and reused. The first block is allocated here. Blocks
+* come from allocator, or the heap if it's NULL.
+* @return true if initialization was successful.
+*/
+bool eng_ArenaInit(eng_Arena* arena, size_t blockSize, const eng_Allocator* allocator);
+
+/**
+* Arena Free
+*
+* Frees every block, and with them every allocation made from the arena.
+* If subAllocationsOnly is true, the arena pointer itself will not be freed.
+*/
+void eng_ArenaFree(eng_Arena* arena, bool subAllocationsOnly);
+
+/**
+* Arena Get Sizeof
+*
+* @return the sizeof the internal eng_Arena object, for use with
+* custom allocators.
+*/
+size_t eng_ArenaGetSizeof(void);
+
+////////////////////////////////////////////////////////////////////////// Arena API
+
+/**
+* Arena Alloc
+*
+* alignment must be a power of two. Allocations larger than the block size
+* get a block of their own.
+* @return uninitialized memory, or NULL if a new block couldn't be allocated.
+*/
+void* eng_ArenaAlloc(eng_Arena* arena, size_t size, size_t alignment);
+
+/** Like eng_ArenaAlloc, but the memory is zeroed. */
+void* eng_ArenaCalloc(eng_Arena* arena, size_t count, size_t size, size_t alignment);
+
+#define eng_ArenaAllocType(arena, type) ((type*)eng_ArenaAlloc(arena, sizeof(type), ENG_ALIGNOF(type)))
+#define eng_ArenaCallocType(arena, type, count) ((type*)eng_ArenaCalloc(arena, count, sizeof(type), ENG_ALIGNOF(type)))
+
+/** @returns the arena's current position. */
+eng_ArenaMarker eng_ArenaGetMarker(eng_Arena* arena);
+
+/**
+* Arena Reset
+*
+* Releases everything allocated since marker was taken. Markers taken
+* after this one are invalidated.
+*/
+void eng_ArenaReset(eng_Arena* arena, eng_ArenaMarker marker);
+
+/** Releases every allocation. */
+void eng_ArenaClear(eng_Arena* arena);
+
+/** @returns the bytes allocated, including alignment padding. */
+size_t eng_ArenaGetUsed(eng_Arena* arena);
+
+/** @returns the bytes of every block the arena holds. */
+size_t eng_ArenaGetCapacity(eng_Arena* arena);
+
+/** @returns how many blocks the arena holds. */
+uint32_t eng_ArenaGetBlockCount(eng_Arena* arena);
+
+/**
+* Arena Get Allocator
+*
+* @return an allocator over the arena, valid for the arena's lifetime, to
+* hand to objects whose sub-allocations should live in it. Frees only
+* give memory back when they're of the most recent allocation, so
+* temporaries freed in reverse order cost nothing; otherwise memory is
+* only reclaimed by resets. Reallocating the most recent allocation grows
+* it in place where the block has room. Not thread safe.
+*/
+const eng_Allocator* eng_ArenaGetAllocator(eng_Arena* arena);
+
+#ifdef __cplusplus
+}
+
+/**
+* Arena Scope
+*
+* Resets the arena to where it was when the scope was entered.
+*/
+class eng_ArenaScope {
+public:
+	explicit eng_ArenaScope(eng_Arena* arena)
+		: Arena(arena), Marker(eng_ArenaGetMarker(arena)) {
+	}
+
+	~eng_ArenaScope() {
+		eng_ArenaReset(Arena, Marker);
+	}
+
+	eng_ArenaScope(const eng_ArenaScope&) = delete;
+	eng_ArenaScope& operator=(const eng_ArenaScope&) = delete;
+
+private:
+	eng_Arena* Arena;
+	eng_ArenaMarker Marker;
+};
+#endif
\ No newline at end of file
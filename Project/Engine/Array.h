@@ -2,28 +2,83 @@
 
 #ifdef __cplusplus
 extern "C" {
+#else
+#include <stdbool.h>
 #endif
 
+#include <stddef.h>
 #include <stdint.h>
 
-#define ENG_ARRAY_CALLOC calloc
-#define ENG_ARRAY_REALLOC realloc
-#define ENG_ARRAY_FREE free
+#include <Engine/Allocator.h>
+
+// How an array's buffer grows once it's full.
+typedef struct eng_ArrayGrowth {
+	// The buffer grows to this percent of its current size; 200 doubles it.
+	uint32_t Percent;
+	// The buffer grows by at least this many bytes.
+	size_t MinimumStep;
+	// Buffer sizes are rounded up to a multiple of this power of two, so big
+	// arrays can grow in whole pages. 0 to not round.
+	size_t RoundTo;
+} eng_ArrayGrowth;
+
+/** Doubling, with no minimum step or rounding. */
+eng_ArrayGrowth eng_ArrayGetDefaultGrowth(void);
+
+typedef enum eng_ArrayStorage
+{
+	// Buffer comes from Allocator.
+	ENG_ARRAY_STORAGE_ALLOCATOR = 0,
+	// Buffer is storage owned by whoever holds the array, until it's outgrown.
+	ENG_ARRAY_STORAGE_INLINE,
+	// Buffer starts a reserved address range of ReservedSize bytes, the
+	// first BufferSize of which are committed.
+	ENG_ARRAY_STORAGE_VIRTUAL,
+} eng_ArrayStorage;
 
 typedef struct eng_Array {
 	void* Buffer;
 	uint32_t Count;
-	uint32_t BufferSize;
 	uint32_t TypeSize;
+	// In bytes.
+	size_t BufferSize;
+	eng_ArrayStorage Storage;
+	// Virtual arrays only.
+	bool HugePages;
+	size_t ReservedSize;
+	// NULL for the heap.
+	const eng_Allocator* Allocator;
+	// NULL for eng_ArrayGetDefaultGrowth.
+	const eng_ArrayGrowth* Growth;
 } eng_Array;
 
 #define eng_ArrayDecl(name, type) eng_Array name
+// Declares name along with room for count elements right after it, for
+// lists that are usually tiny. Initialize with eng_ArrayInitInlineType.
+#define eng_ArrayDeclInline(name, type, count) eng_Array name; type name##Inline[count]
 
 void eng_ArrayInit(eng_Array* array, uint32_t typeSize);
 #define eng_ArrayInitType(array, type) eng_ArrayInit(array, sizeof(type))
+// The buffer comes from allocator, which must outlive the array.
+void eng_ArrayInitAllocator(eng_Array* array, uint32_t typeSize, const eng_Allocator* allocator);
+#define eng_ArrayInitAllocatorType(array, type, allocator) eng_ArrayInitAllocator(array, sizeof(type), allocator)
+// Starts out in buffer, bufferSize bytes that must stay put for the array's
+// lifetime, and only allocates from allocator once it outgrows it.
+void eng_ArrayInitInline(eng_Array* array, uint32_t typeSize, void* buffer, size_t bufferSize, const eng_Allocator* allocator);
+#define eng_ArrayInitInlineType(array, type, inlineBuffer, allocator) eng_ArrayInitInline(array, sizeof(type), inlineBuffer, sizeof(inlineBuffer), allocator)
+// Reserves address space for maxCount elements up front and commits pages
+// as the array grows, so growing never copies and elements never move.
+// Growing past maxCount is fatal. hugePages asks for huge page backing
+// where the OS supports it. Returns false if the range couldn't be reserved.
+bool eng_ArrayInitVirtual(eng_Array* array, uint32_t typeSize, size_t maxCount, bool hugePages);
+#define eng_ArrayInitVirtualType(array, type, maxCount, hugePages) eng_ArrayInitVirtual(array, sizeof(type), maxCount, hugePages)
 void eng_ArrayDestroy(eng_Array* array);
 
-void eng_ArrayReserve(eng_Array* array, uint32_t elementsToReserve);
+// growth must outlive the array; NULL goes back to the defaults.
+void eng_ArraySetGrowth(eng_Array* array, const eng_ArrayGrowth* growth);
+
+void eng_ArrayReserve(eng_Array* array, size_t elementsToReserve);
+// New elements are left uninitialized.
 void eng_ArrayResize(eng_Array* array, uint32_t newElementCount);
 
 void* eng_ArrayIndex(eng_Array* array, uint32_t index);
@@ -31,6 +86,7 @@ void* eng_ArrayIndex(eng_Array* array, uint32_t index);
 #define eng_ArrayPIndexType(array, type, index) ((type*)eng_ArrayIndex(array, index))
 
 uint32_t eng_ArrayPushBack(eng_Array* array, void* object);
+// Pushes nothing if Count would pass UINT32_MAX.
 void eng_ArrayPushBackMany(eng_Array* array, void* objects, uint32_t count);
 
 void* eng_ArrayBegin(eng_Array* array);
@@ -41,6 +97,19 @@ void* eng_ArrayEnd(eng_Array* array);
 void eng_ArrayRemoveLastSwap(eng_Array* array, uint32_t index);
 void eng_ArrayRemoveInPlace(eng_Array* array, uint32_t index);
 
+// The batch removals below keep the order of what's left and run in one
+// pass, moving each run of kept elements at once.
+
+typedef bool(*eng_ArrayPredicate_t)(const void* element, void* userData);
+// Removes every element predicate returns true for. @returns how many were removed.
+uint32_t eng_ArrayRemoveIf(eng_Array* array, eng_ArrayPredicate_t predicate, void* userData);
+// Removes every element bytewise equal to value, vectorized for 4 and 8
+// byte elements. @returns how many were removed.
+uint32_t eng_ArrayRemoveValue(eng_Array* array, const void* value);
+void eng_ArrayRemoveRange(eng_Array* array, uint32_t first, uint32_t count);
+// indices must be ascending with no repeats.
+void eng_ArrayRemoveIndices(eng_Array* array, const uint32_t* indices, uint32_t count);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
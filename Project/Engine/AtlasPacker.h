@@ -0,0 +1,121 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define ENG_ATLAS_INVALID_ENTRY UINT32_MAX
+
+typedef struct eng_AtlasPacker eng_AtlasPacker;
+typedef struct eng_Allocator eng_Allocator;
+
+// Where an entry was placed, in texels from the top left of its page.
+typedef struct eng_AtlasRect
+{
+	uint32_t Page;
+	uint32_t X;
+	uint32_t Y;
+	uint32_t Width;
+	uint32_t Height;
+} eng_AtlasRect;
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+/**
+* Atlas Packer Malloc
+*
+* @note The packer is not ready for use until eng_AtlasPackerInit is called.
+* @return A newly allocated atlas packer.
+*/
+eng_AtlasPacker* eng_AtlasPackerMalloc(void);
+
+/**
+* Atlas Packer Init
+*
+* @description Packs rectangles into pages of pageWidth by pageHeight
+* texels using MaxRects with best short side fit. A new page is opened
+* when nothing fits in the open ones, up to maxPages. padding texels are
+* kept free right of and below every entry so filtering doesn't bleed
+* between neighbours. The packer only does the bookkeeping; copying texels
+* into the pages is up to the caller. The bookkeeping comes from
+* allocator (NULL for the heap).
+* @return true if initialization was successful.
+*/
+bool eng_AtlasPackerInit(eng_AtlasPacker* packer, uint32_t pageWidth, uint32_t pageHeight, uint32_t padding, uint32_t maxPages, const eng_Allocator* allocator);
+
+/**
+* Atlas Packer Free
+*
+* Frees memory associated with the packer. If subAllocationsOnly is true,
+* the packer pointer itself will not be freed.
+*/
+void eng_AtlasPackerFree(eng_AtlasPacker* packer, bool subAllocationsOnly);
+
+/**
+* Atlas Packer Get Sizeof
+*
+* @return the sizeof the internal eng_AtlasPacker object, for use with
+* custom allocators.
+*/
+size_t eng_AtlasPackerGetSizeof(void);
+
+////////////////////////////////////////////////////////////////////////// Atlas Packer API
+
+/**
+* Atlas Packer Add
+*
+* Places a width by height rectangle, preferring earlier pages.
+* @return the entry, or ENG_ATLAS_INVALID_ENTRY if it's larger than a page
+* or every page is full. outRect may be NULL.
+*/
+uint32_t eng_AtlasPackerAdd(eng_AtlasPacker* packer, uint32_t width, uint32_t height, eng_AtlasRect* outRect);
+
+/**
+* Atlas Packer Add Many
+*
+* Places count rectangles given as (width, height) pairs in sizes, largest
+* side first, which packs far tighter than adding them as they come. Meant
+* for cooking atlases offline and for loading screens. outEntries gets the
+* entry of every rectangle in the order given, ENG_ATLAS_INVALID_ENTRY for
+* any that didn't fit.
+* @return the number of rectangles placed.
+*/
+uint32_t eng_AtlasPackerAddMany(eng_AtlasPacker* packer, const uint32_t* sizes, uint32_t count, uint32_t* outEntries);
+
+/**
+* Atlas Packer Add At
+*
+* Places a rectangle at a known position, e.g. one read back from an
+* atlas cooked offline, so a runtime packer can carry on adding to it.
+* Width and Height of rect exclude padding, as eng_AtlasPackerAdd reports them.
+* @return the entry, or ENG_ATLAS_INVALID_ENTRY if that space isn't free.
+*/
+uint32_t eng_AtlasPackerAddAt(eng_AtlasPacker* packer, const eng_AtlasRect* rect);
+
+/**
+* Atlas Packer Remove
+*
+* Frees an entry's space for later adds. Removal is cheap: freed space is
+* reused as is, and once a sixteenth of a page has been freed, the next add
+* that doesn't fit rebuilds the page's free space from its remaining
+* entries so freed neighbours combine. Entry values are reused.
+* @return false if entry isn't in use.
+*/
+bool eng_AtlasPackerRemove(eng_AtlasPacker* packer, uint32_t entry);
+
+/** @return false if entry isn't in use. */
+bool eng_AtlasPackerGetRect(eng_AtlasPacker* packer, uint32_t entry, eng_AtlasRect* outRect);
+
+/** @return the number of pages opened so far. */
+uint32_t eng_AtlasPackerGetPageCount(eng_AtlasPacker* packer);
+
+/** @return the fraction of page's texels covered by entries and their padding. */
+float eng_AtlasPackerGetOccupancy(eng_AtlasPacker* packer, uint32_t page);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
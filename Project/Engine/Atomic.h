@@ -0,0 +1,162 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#define ENG_THREAD_LOCAL __declspec(thread)
+#else
+#define ENG_THREAD_LOCAL __thread
+#endif
+
+// Thin wrappers over the compiler's interlocked intrinsics. All operations
+// are sequentially consistent (full barrier), which is what MSVC's
+// _Interlocked* family gives us anyway.
+
+/** @returns the value stored at dst. */
+static inline int32_t eng_AtomicLoad32(volatile int32_t* dst)
+{
+#if defined(_MSC_VER)
+	return (int32_t)_InterlockedOr((volatile long*)dst, 0);
+#else
+	return __atomic_load_n(dst, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/** Stores value at dst. */
+static inline void eng_AtomicStore32(volatile int32_t* dst, int32_t value)
+{
+#if defined(_MSC_VER)
+	_InterlockedExchange((volatile long*)dst, (long)value);
+#else
+	__atomic_store_n(dst, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/** @returns the value of dst before the exchange. */
+static inline int32_t eng_AtomicExchange32(volatile int32_t* dst, int32_t value)
+{
+#if defined(_MSC_VER)
+	return (int32_t)_InterlockedExchange((volatile long*)dst, (long)value);
+#else
+	return __atomic_exchange_n(dst, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/** @returns the value of dst after the addition. */
+static inline int32_t eng_AtomicAdd32(volatile int32_t* dst, int32_t value)
+{
+#if defined(_MSC_VER)
+	return (int32_t)_InterlockedExchangeAdd((volatile long*)dst, (long)value) + value;
+#else
+	return __atomic_add_fetch(dst, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/** @returns the value of dst after the increment. */
+static inline int32_t eng_AtomicIncrement32(volatile int32_t* dst)
+{
+	return eng_AtomicAdd32(dst, 1);
+}
+
+/** @returns the value of dst after the decrement. */
+static inline int32_t eng_AtomicDecrement32(volatile int32_t* dst)
+{
+	return eng_AtomicAdd32(dst, -1);
+}
+
+/** @returns the value of dst before the exchange. */
+static inline int32_t eng_AtomicCompareExchange32(volatile int32_t* dst, int32_t exchange, int32_t comparand)
+{
+#if defined(_MSC_VER)
+	return (int32_t)_InterlockedCompareExchange((volatile long*)dst, (long)exchange, (long)comparand);
+#else
+	__atomic_compare_exchange_n(dst, &comparand, exchange, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+	return comparand;
+#endif
+}
+
+/** @returns the value stored at dst. */
+static inline int64_t eng_AtomicLoad64(volatile int64_t* dst)
+{
+#if defined(_MSC_VER)
+	// A compare exchange that never changes the value reads all 64 bits at
+	// once on 32 bit targets too.
+	return (int64_t)_InterlockedCompareExchange64((volatile __int64*)dst, 0, 0);
+#else
+	return __atomic_load_n(dst, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/** @returns the value of dst before the exchange. */
+static inline int64_t eng_AtomicCompareExchange64(volatile int64_t* dst, int64_t exchange, int64_t comparand)
+{
+#if defined(_MSC_VER)
+	return (int64_t)_InterlockedCompareExchange64((volatile __int64*)dst, (__int64)exchange, (__int64)comparand);
+#else
+	__atomic_compare_exchange_n(dst, &comparand, exchange, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+	return comparand;
+#endif
+}
+
+/** Spins until lock, 0 while free, is taken. For short critical sections only. */
+static inline void eng_AtomicLock(volatile int32_t* lock)
+{
+	while (eng_AtomicCompareExchange32(lock, 1, 0) != 0)
+	{
+		while (eng_AtomicLoad32(lock) != 0)
+		{
+		}
+	}
+}
+
+/** Releases a lock taken with eng_AtomicLock. */
+static inline void eng_AtomicUnlock(volatile int32_t* lock)
+{
+	eng_AtomicStore32(lock, 0);
+}
+
+/** @returns the pointer stored at dst. */
+static inline void* eng_AtomicLoadPtr(void* volatile* dst)
+{
+#if defined(_MSC_VER)
+	return _InterlockedCompareExchangePointer(dst, NULL, NULL);
+#else
+	return __atomic_load_n(dst, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/** @returns the pointer stored at dst before the exchange. */
+static inline void* eng_AtomicExchangePtr(void* volatile* dst, void* value)
+{
+#if defined(_MSC_VER)
+	return _InterlockedExchangePointer(dst, value);
+#else
+	return __atomic_exchange_n(dst, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/** @returns the pointer stored at dst before the exchange. */
+static inline void* eng_AtomicCompareExchangePtr(void* volatile* dst, void* exchange, void* comparand)
+{
+#if defined(_MSC_VER)
+	return _InterlockedCompareExchangePointer(dst, exchange, comparand);
+#else
+	__atomic_compare_exchange_n(dst, &comparand, exchange, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+	return comparand;
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Thin wrappers over the compiler's bit scan intrinsics. value must not be
+// 0; the result is undefined if it is.
+
+/** @returns the index of the lowest set bit in value. */
+static inline uint32_t eng_BitScanForward32(uint32_t value)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward(&index, value);
+	return (uint32_t)index;
+#else
+	return (uint32_t)__builtin_ctz(value);
+#endif
+}
+
+/** @returns the index of the highest set bit in value. */
+static inline uint32_t eng_BitScanReverse32(uint32_t value)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanReverse(&index, value);
+	return (uint32_t)index;
+#else
+	return 31 - (uint32_t)__builtin_clz(value);
+#endif
+}
+
+/** @returns the index of the lowest set bit in value. */
+static inline uint32_t eng_BitScanForward64(uint64_t value)
+{
+#if defined(_MSC_VER) && defined(_WIN64)
+	unsigned long index;
+	_BitScanForward64(&index, value);
+	return (uint32_t)index;
+#elif defined(_MSC_VER)
+	return (uint32_t)value != 0 ? eng_BitScanForward32((uint32_t)value) : 32 + eng_BitScanForward32((uint32_t)(value >> 32));
+#else
+	return (uint32_t)__builtin_ctzll(value);
+#endif
+}
+
+/** @returns the index of the highest set bit in value. */
+static inline uint32_t eng_BitScanReverse64(uint64_t value)
+{
+#if defined(_MSC_VER) && defined(_WIN64)
+	unsigned long index;
+	_BitScanReverse64(&index, value);
+	return (uint32_t)index;
+#elif defined(_MSC_VER)
+	return (value >> 32) != 0 ? 32 + eng_BitScanReverse32((uint32_t)(value >> 32)) : eng_BitScanReverse32((uint32_t)value);
+#else
+	return 63 - (uint32_t)__builtin_clzll(value);
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Engine/Allocator.h>
+#include <Engine/Array.h>
+
+// An array kept in fixed size chunks. Growing adds a chunk rather than
+// moving what's there, so pointers to elements stay valid until they're
+// popped or the array is destroyed. Elements are contiguous within a
+// chunk; iterate chunk by chunk with eng_ChunkedArrayGetChunk.
+typedef struct eng_ChunkedArray {
+	// void* per chunk, in order.
+	eng_Array Chunks;
+	uint32_t Count;
+	uint32_t TypeSize;
+	// Each chunk holds 1 << ChunkShift elements.
+	uint32_t ChunkShift;
+	// NULL for the heap.
+	const eng_Allocator* Allocator;
+} eng_ChunkedArray;
+
+#define eng_ChunkedArrayDecl(name, type) eng_ChunkedArray name
+
+// elementsPerChunk is rounded up to a power of two. Chunks come from
+// allocator, which must outlive the array.
+void eng_ChunkedArrayInit(eng_ChunkedArray* array, uint32_t typeSize, uint32_t elementsPerChunk, const eng_Allocator* allocator);
+#define eng_ChunkedArrayInitType(array, type, elementsPerChunk, allocator) eng_ChunkedArrayInit(array, sizeof(type), elementsPerChunk, allocator)
+void eng_ChunkedArrayDestroy(eng_ChunkedArray* array);
+
+void* eng_ChunkedArrayIndex(eng_ChunkedArray* array, uint32_t index);
+#define eng_ChunkedArrayIndexType(array, type, index) (*(type*)eng_ChunkedArrayIndex(array, index))
+#define eng_ChunkedArrayPIndexType(array, type, index) ((type*)eng_ChunkedArrayIndex(array, index))
+
+uint32_t eng_ChunkedArrayPushBack(eng_ChunkedArray* array, void* object);
+// Makes room for one more element and returns it, uninitialized.
+void* eng_ChunkedArrayEmplaceBack(eng_ChunkedArray* array);
+#define eng_ChunkedArrayEmplaceBackType(array, type) ((type*)eng_ChunkedArrayEmplaceBack(array))
+void eng_ChunkedArrayPopBack(eng_ChunkedArray* array);
+// Drops every element but keeps the chunks for reuse.
+void eng_ChunkedArrayClear(eng_ChunkedArray* array);
+
+uint32_t eng_ChunkedArrayGetChunkCount(eng_ChunkedArray* array);
+// @returns the first element of chunk, with how many elements it holds in outCount.
+void* eng_ChunkedArrayGetChunk(eng_ChunkedArray* array, uint32_t chunk, uint32_t* outCount);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
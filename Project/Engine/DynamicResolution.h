@@ -0,0 +1,43 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stdint.h>
+
+typedef struct eng_DynamicResolutionSettings
+{
+	bool Enabled;
+	// GPU frame time to hold, in milliseconds.
+	float TargetMilliseconds;
+	// Bounds on the render scale, a fraction of the output size per axis.
+	// MaxScale can't exceed 1.
+	float MinScale;
+	float MaxScale;
+} eng_DynamicResolutionSettings;
+
+////////////////////////////////////////////////////////////////////////// Dynamic Resolution API
+
+/** Disabled, targeting 60 fps with scales between 0.5 and 1. */
+eng_DynamicResolutionSettings eng_DynamicResolutionGetDefaults(void);
+
+/**
+* Dynamic Resolution Next Scale
+*
+* Picks the render scale for the next frame from the scale and GPU time of
+* a recent one. Assumes the frame's cost follows its pixel count, drops
+* quickly when over budget and recovers slowly so a single spike doesn't
+* make the resolution oscillate.
+* @return 1 when settings are disabled, otherwise a scale in [MinScale, MaxScale].
+*/
+float eng_DynamicResolutionNextScale(const eng_DynamicResolutionSettings* settings, float scale, double measuredMilliseconds);
+
+/** Scales an output extent, rounding down to a multiple of 8 pixels where possible. */
+void eng_DynamicResolutionGetExtent(float scale, uint32_t width, uint32_t height, uint32_t* outWidth, uint32_t* outHeight);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
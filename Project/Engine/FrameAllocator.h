@@ -0,0 +1,110 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Engine/Arena.h>
+
+#define ENG_FRAME_ALLOCATOR_MAX_FRAMES 4
+
+typedef struct eng_FrameAllocator eng_FrameAllocator;
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+/**
+* Frame Allocator Malloc
+*
+* @note The frame allocator is not ready for use until
+* eng_FrameAllocatorInit is called.
+* @return A newly allocated frame allocator.
+*/
+eng_FrameAllocator* eng_FrameAllocatorMalloc(void);
+
+/**
+* Frame Allocator Init
+*
+* @description Scratch memory for data that only lives until the GPU is
+* done with the frame it was made for: one arena of bytesPerFrame per
+* frame in flight (at most ENG_FRAME_ALLOCATOR_MAX_FRAMES). A frame's
+* arena is reset all at once when its slot comes round again, so nothing
+* allocated from it is freed individually. A frame that outgrows its
+* arena chains on another block rather than failing; the high-water mark
+* says how big bytesPerFrame should be. The arenas come from allocator,
+* or the heap if it's NULL.
+* @return true if initialization was successful.
+*/
+bool eng_FrameAllocatorInit(eng_FrameAllocator* frameAllocator, size_t bytesPerFrame, uint32_t frameCount, const eng_Allocator* allocator);
+
+/**
+* Frame Allocator Free
+*
+* Frees memory associated with the frame allocator. If subAllocationsOnly
+* is true, the frame allocator pointer itself will not be freed.
+*/
+void eng_FrameAllocatorFree(eng_FrameAllocator* frameAllocator, bool subAllocationsOnly);
+
+/**
+* Frame Allocator Get Sizeof
+*
+* @return the sizeof the internal eng_FrameAllocator object, for use with
+* custom allocators.
+*/
+size_t eng_FrameAllocatorGetSizeof(void);
+
+////////////////////////////////////////////////////////////////////////// Frame Allocator API
+
+/**
+* Frame Allocator Begin Frame
+*
+* Makes frameIndex's arena current and resets it. Only call once the GPU
+* work of the last frame that used frameIndex has completed; a frame
+* allocator given to eng_VulkanSetFrameAllocator is advanced by
+* eng_VulkanUpdate instead.
+*/
+void eng_FrameAllocatorBeginFrame(eng_FrameAllocator* frameAllocator, uint32_t frameIndex);
+
+/**
+* Frame Allocator Alloc
+*
+* Allocates from the current frame. Not thread safe: allocate from the
+* thread that runs the frame.
+* @return uninitialized memory, valid until the frame's slot comes round again.
+*/
+void* eng_FrameAllocatorAlloc(eng_FrameAllocator* frameAllocator, size_t size, size_t alignment);
+
+/** Like eng_FrameAllocatorAlloc, but the memory is zeroed. */
+void* eng_FrameAllocatorCalloc(eng_FrameAllocator* frameAllocator, size_t count, size_t size, size_t alignment);
+
+#define eng_FrameAllocatorAllocType(frameAllocator, type, count) \
+	((type*)eng_FrameAllocatorAlloc(frameAllocator, (count) * sizeof(type), ENG_ALIGNOF(type)))
+#define eng_FrameAllocatorCallocType(frameAllocator, type, count) \
+	((type*)eng_FrameAllocatorCalloc(frameAllocator, count, sizeof(type), ENG_ALIGNOF(type)))
+
+/** Formats a string into the current frame. @return the string, or NULL on failure. */
+char* eng_FrameAllocatorPrintf(eng_FrameAllocator* frameAllocator, const char* fmt, ...);
+char* eng_FrameAllocatorVPrintf(eng_FrameAllocator* frameAllocator, const char* fmt, va_list args);
+
+/** @returns the bytes the current frame has allocated so far. */
+size_t eng_FrameAllocatorGetUsed(eng_FrameAllocator* frameAllocator);
+
+/** @returns the most bytes any frame has allocated. */
+size_t eng_FrameAllocatorGetHighWaterMark(eng_FrameAllocator* frameAllocator);
+
+/** @returns the number of frames given at init. */
+uint32_t eng_FrameAllocatorGetFrameCount(eng_FrameAllocator* frameAllocator);
+
+/** @returns the bytes per frame given at init. */
+size_t eng_FrameAllocatorGetBytesPerFrame(eng_FrameAllocator* frameAllocator);
+
+/** Logs the high-water mark against the bytes per frame. */
+void eng_FrameAllocatorReport(eng_FrameAllocator* frameAllocator);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,115 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct eng_FramePacer eng_FramePacer;
+
+typedef struct eng_FramePacerSettings
+{
+	bool Enabled;
+	// Present interval to pace to, in milliseconds. 0 paces to the display's
+	// refresh interval if known, otherwise to the measured present interval.
+	double TargetMilliseconds;
+	// Slack left between the predicted end of a frame's work and its present.
+	double SafetyMilliseconds;
+	// The end of each wait is spun rather than slept; OS sleeps overshoot.
+	double SpinMilliseconds;
+} eng_FramePacerSettings;
+
+/** Enabled, pacing to the display with 1.5 ms of safety and 0.5 ms spun. */
+eng_FramePacerSettings eng_FramePacerGetDefaults(void);
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+/**
+* Frame Pacer Malloc
+*
+* @note The pacer is not ready for use until eng_FramePacerInit is called.
+* @return A newly allocated frame pacer.
+*/
+eng_FramePacer* eng_FramePacerMalloc(void);
+
+/**
+* Frame Pacer Init
+*
+* @description Delays the start of each frame so its input is sampled as
+* late as possible while its present still makes the next display
+* interval. The pacer predicts when the next present is due from past
+* presents, estimates the frame's work from past frames, and waits until
+* just before the work has to start.
+* @return true if initialization was successful.
+*/
+bool eng_FramePacerInit(eng_FramePacer* pacer, const eng_FramePacerSettings* settings);
+
+/**
+* Frame Pacer Free
+*
+* Frees memory associated with the pacer. If subAllocationsOnly is true,
+* the pacer pointer itself will not be freed.
+*/
+void eng_FramePacerFree(eng_FramePacer* pacer, bool subAllocationsOnly);
+
+/**
+* Frame Pacer Get Sizeof
+*
+* @return the sizeof the internal eng_FramePacer object, for use with
+* custom allocators.
+*/
+size_t eng_FramePacerGetSizeof(void);
+
+////////////////////////////////////////////////////////////////////////// Frame Pacer API
+
+/** May be changed at any time; takes effect on the next wait. */
+void eng_FramePacerSetSettings(eng_FramePacer* pacer, const eng_FramePacerSettings* settings);
+
+/**
+* Sets the display's refresh interval, e.g. from eng_VulkanGetRefreshMilliseconds.
+* 0 means unknown.
+*/
+void eng_FramePacerSetRefreshMilliseconds(eng_FramePacer* pacer, double refreshMilliseconds);
+
+/**
+* Frame Pacer Wait
+*
+* Call at the top of the frame, right before input is sampled. Returns
+* immediately while disabled, or until two frames have been presented.
+*/
+void eng_FramePacerWait(eng_FramePacer* pacer);
+
+/**
+* Frame Pacer Presented
+*
+* Call right after the frame is presented. blockedMilliseconds is how long
+* the frame spent waiting on the display rather than working (see
+* eng_VulkanGetAcquireMilliseconds) and is left out of the work estimate.
+*/
+void eng_FramePacerPresented(eng_FramePacer* pacer, double blockedMilliseconds);
+
+/**
+* @returns the time from the last frame's input sample to its present, in
+* milliseconds. Measured on the CPU; time the image spends queued in the
+* presentation engine isn't included.
+*/
+double eng_FramePacerGetLatencyMilliseconds(eng_FramePacer* pacer);
+
+/** @returns the input to present latency, smoothed over recent frames. */
+double eng_FramePacerGetAverageLatencyMilliseconds(eng_FramePacer* pacer);
+
+/** @returns the smoothed time between presents, in milliseconds. */
+double eng_FramePacerGetIntervalMilliseconds(eng_FramePacer* pacer);
+
+/** @returns the current estimate of a frame's work, in milliseconds. */
+double eng_FramePacerGetWorkMilliseconds(eng_FramePacer* pacer);
+
+/** @returns how long the last eng_FramePacerWait waited, in milliseconds. */
+double eng_FramePacerGetWaitMilliseconds(eng_FramePacer* pacer);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
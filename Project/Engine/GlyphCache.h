@@ -0,0 +1,90 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Every cached glyph occupies one square cell of the atlas.
+#define ENG_GLYPH_CELL_SIZE 32
+// Largest integer scale of the built-in font that still fits in a cell.
+#define ENG_GLYPH_MAX_SCALE 4
+
+typedef struct eng_GlyphCache eng_GlyphCache;
+typedef struct eng_Allocator eng_Allocator;
+
+typedef struct eng_Glyph
+{
+	// Top left of the glyph in the atlas, in texels.
+	uint16_t X;
+	uint16_t Y;
+	uint16_t Width;
+	uint16_t Height;
+	// Horizontal distance to the next glyph's origin, in pixels.
+	uint16_t Advance;
+} eng_Glyph;
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+/**
+* Glyph Cache Malloc
+*
+* @note The cache is not ready for use until eng_GlyphCacheInit is called.
+* @return A newly allocated glyph cache.
+*/
+eng_GlyphCache* eng_GlyphCacheMalloc(void);
+
+/**
+* Glyph Cache Init
+*
+* @description atlas is an 8 bit coverage image of atlasSize by atlasSize
+* texels owned by the caller (typically mapped GPU memory). A cell is not
+* evicted until framesInFlight frames have passed since it was last used,
+* so the GPU never samples a cell that is being rewritten. Cell
+* bookkeeping comes from allocator (NULL for the heap).
+* @return true if initialization was successful.
+*/
+bool eng_GlyphCacheInit(eng_GlyphCache* cache, uint8_t* atlas, uint32_t atlasSize, uint32_t framesInFlight, const eng_Allocator* allocator);
+
+/**
+* Glyph Cache Free
+*
+* Frees memory associated with the cache. If subAllocationsOnly is true,
+* the cache pointer itself will not be freed. The atlas is not freed.
+*/
+void eng_GlyphCacheFree(eng_GlyphCache* cache, bool subAllocationsOnly);
+
+/**
+* Glyph Cache Get Sizeof
+*
+* @return the sizeof the internal eng_GlyphCache object, for use with
+* custom allocators.
+*/
+size_t eng_GlyphCacheGetSizeof(void);
+
+////////////////////////////////////////////////////////////////////////// Glyph Cache API
+
+/**
+* Glyph Cache Get
+*
+* Finds character at scale in the atlas, rasterizing it into the least
+* recently used cell on a miss.
+* @return false if every cell is still in use by frames in flight.
+*/
+bool eng_GlyphCacheGet(eng_GlyphCache* cache, char character, uint32_t scale, eng_Glyph* outGlyph);
+
+/** Marks the end of a frame for eviction purposes. */
+void eng_GlyphCacheNextFrame(eng_GlyphCache* cache);
+
+/** @returns the line height of the built-in font at scale, in pixels. */
+uint32_t eng_GlyphCacheGetLineHeight(uint32_t scale);
+
+/** @returns the number of glyphs rasterized since init (cache misses). */
+uint32_t eng_GlyphCacheGetRasterizeCount(eng_GlyphCache* cache);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
@@ -6,10 +6,17 @@ extern "C" {
 #include <stdbool.h>
 #endif
 
+#include <Engine/DynamicResolution.h>
 #include <Engine/Graphics_VulkanForwardDecl.h> //in place of: <ThirdParty/Vulkan/vulkan.h>
 //#include <stdint.h> // included by Graphics_VulkanForwardDecl
 
 typedef struct eng_Vulkan eng_Vulkan;
+typedef struct eng_Allocator eng_Allocator;
+typedef struct eng_FrameAllocator eng_FrameAllocator;
+
+// Number of frames the CPU may record ahead of the GPU. Per-frame resources
+// should be indexed with eng_VulkanGetFrameIndex.
+#define ENG_VULKAN_FRAMES_IN_FLIGHT 2
 
 ////////////////////////////////////////////////////////////////////////// Lifecycle
 
@@ -20,8 +27,11 @@ eng_Vulkan* eng_VulkanMalloc(void);
  * to be provided is through a window. Calling eng_WindowBindVulkan will 
  * cause the window to provide configuration to vulkan for you.
  * @see eng_WindowBindVulkan
+ * Every internal allocation, including the renderer modules made against
+ * vulkan (text, particles, uploads...), comes from allocator, or the heap
+ * if it's NULL.
  */
-bool eng_VulkanInit(eng_Vulkan* vulkan);
+bool eng_VulkanInit(eng_Vulkan* vulkan, const eng_Allocator* allocator);
 void eng_VulkanFree(eng_Vulkan* vulkan, bool subAllocationsOnly);
 size_t eng_VulkanGetSizeof(void);
 
@@ -38,6 +48,16 @@ void eng_VulkanSetRequiresGraphics(eng_Vulkan* vulkan, bool requiresGraphics);
 // eng_VulkanProvideSurface is called.
 void eng_VulkanSetRequiresPresent(eng_Vulkan* vulkan, bool requiresPresent);
 
+// Dynamic resolution is off by default: the scene renders at the swapchain
+// extent. May be changed at any time; takes effect on the next frame.
+void eng_VulkanSetDynamicResolution(eng_Vulkan* vulkan, const eng_DynamicResolutionSettings* settings);
+
+// eng_VulkanUpdate moves frameAllocator on to the next frame in flight once
+// the GPU is done with it, so scratch allocated for a frame lives until its
+// commands have run. frameAllocator must have ENG_VULKAN_FRAMES_IN_FLIGHT
+// frames. NULL detaches it.
+void eng_VulkanSetFrameAllocator(eng_Vulkan* vulkan, eng_FrameAllocator* frameAllocator);
+
 ////////////////////////////////////////////////////////////////////////// API
 
 bool eng_VulkanCreateInstance(eng_Vulkan* vulkan);
@@ -47,6 +67,134 @@ VkInstance eng_VulkanGetInstance(eng_Vulkan* vulkan);
 
 void eng_VulkanUpdate(eng_Vulkan* vulkan);
 
+/** @returns which of the ENG_VULKAN_FRAMES_IN_FLIGHT frames the next eng_VulkanUpdate will record. */
+uint32_t eng_VulkanGetFrameIndex(eng_Vulkan* vulkan);
+
+/** @returns the size of the swapchain images, in pixels. */
+void eng_VulkanGetExtent(eng_Vulkan* vulkan, uint32_t* outWidth, uint32_t* outHeight);
+
+/**
+ * @returns the size the scene is drawn at this frame, in pixels. OnRender
+ * callbacks set their viewport and scissor to it; the result is upscaled to
+ * the swapchain extent before OnOverlay.
+ */
+void eng_VulkanGetRenderExtent(eng_Vulkan* vulkan, uint32_t* outWidth, uint32_t* outHeight);
+
+/** @returns the render extent as a fraction of the swapchain extent. */
+float eng_VulkanGetRenderScale(eng_Vulkan* vulkan);
+
+/** @returns the GPU time of a recent frame, in milliseconds, or its CPU submission time where the GPU can't be timed. */
+double eng_VulkanGetFrameMilliseconds(eng_Vulkan* vulkan);
+
+/** @returns how long the last eng_VulkanUpdate blocked acquiring a swapchain image, in milliseconds. */
+double eng_VulkanGetAcquireMilliseconds(eng_Vulkan* vulkan);
+
+/** @returns the display's refresh interval in milliseconds, or 0 if the device can't report it. */
+double eng_VulkanGetRefreshMilliseconds(eng_Vulkan* vulkan);
+
+////////////////////////////////////////////////////////////////////////// Query API
+
+// Queries must be recorded into command buffers handed to eng_Vulkan
+// callbacks; their pools are reset at the start of every eng_VulkanUpdate.
+#define ENG_VULKAN_MAX_QUERY_REGIONS 64
+#define ENG_VULKAN_QUERY_NAME_LENGTH 32
+#define ENG_VULKAN_INVALID_QUERY_REGION UINT32_MAX
+
+// Counts samples passing depth and stencil tests. Only meaningful inside a render pass.
+#define ENG_VULKAN_QUERY_OCCLUSION (1 << 0)
+// Counts vertex, primitive, fragment and compute invocations. Ignored if
+// the device doesn't support pipeline statistics queries.
+#define ENG_VULKAN_QUERY_PIPELINE_STATISTICS (1 << 1)
+
+typedef struct eng_VulkanQueryResult
+{
+	bool HasOcclusion;
+	bool HasStatistics;
+	// How many frames ago these results were recorded.
+	uint32_t Age;
+	uint64_t SamplesPassed;
+	uint64_t VertexInvocations;
+	// Primitives that survived clipping.
+	uint64_t ClippingPrimitives;
+	uint64_t FragmentInvocations;
+	uint64_t ComputeInvocations;
+} eng_VulkanQueryResult;
+
+/**
+ * Vulkan Query Region Register
+ *
+ * Creates a named region that collects the queries in flags
+ * (ENG_VULKAN_QUERY_*) every frame it's recorded. Registering a name
+ * again returns the existing region.
+ * @returns the region, or ENG_VULKAN_INVALID_QUERY_REGION if
+ * ENG_VULKAN_MAX_QUERY_REGIONS are already registered.
+ */
+uint32_t eng_VulkanQueryRegionRegister(eng_Vulkan* vulkan, const char* name, uint32_t flags);
+
+/** @returns the region registered as name, or ENG_VULKAN_INVALID_QUERY_REGION. */
+uint32_t eng_VulkanQueryRegionFind(eng_Vulkan* vulkan, const char* name);
+uint32_t eng_VulkanQueryRegionGetCount(eng_Vulkan* vulkan);
+const char* eng_VulkanQueryRegionGetName(eng_Vulkan* vulkan, uint32_t region);
+
+/**
+ * Begins and ends a region in cmd. A region may be recorded once per frame,
+ * and regions with the same query type can't nest. The exception is the
+ * built-in "Scene" and "Overlay" regions covering the OnRender and OnOverlay
+ * passes: a region collecting statistics inside them pauses theirs, and
+ * their results still include it. If the region begins inside a render pass
+ * it must end in the same subpass.
+ */
+void eng_VulkanQueryRegionBegin(eng_Vulkan* vulkan, VkCommandBuffer cmd, uint32_t region);
+void eng_VulkanQueryRegionEnd(eng_Vulkan* vulkan, VkCommandBuffer cmd, uint32_t region);
+
+/**
+ * Vulkan Query Region Get Result
+ *
+ * Results are collected without waiting when a frame slot comes around
+ * again, so they trail the current frame by ENG_VULKAN_FRAMES_IN_FLIGHT or
+ * more.
+ * @returns false if the region has no results yet.
+ */
+bool eng_VulkanQueryRegionGetResult(eng_Vulkan* vulkan, uint32_t region, eng_VulkanQueryResult* outResult);
+
+/**
+ * @returns false only if the region's most recent occlusion result passed
+ * no samples. Draw a cheap proxy inside the region while skipping the real
+ * draw, or the region will never be found visible again.
+ */
+bool eng_VulkanQueryRegionIsVisible(eng_Vulkan* vulkan, uint32_t region);
+
+////////////////////////////////////////////////////////////////////////// Callbacks
+
+typedef void(*eng_VulkanRecordCallback_t)(void* userData, VkCommandBuffer cmd);
+
+/**
+ * Binds a function to the OnPreRender callback, recorded before the main
+ * render pass every eng_VulkanUpdate. Compute and transfer passes whose
+ * results are used while rendering belong here.
+ */
+void eng_OnPreRenderBind(eng_Vulkan* vulkan, eng_VulkanRecordCallback_t onPreRender, void* userData);
+/** Unbinds a function from the OnPreRender callback, recorded before the main render pass every eng_VulkanUpdate. */
+void eng_OnPreRenderUnbind(eng_Vulkan* vulkan, eng_VulkanRecordCallback_t onPreRender);
+
+/**
+ * Binds a function to the OnRender callback, recorded inside the main
+ * render pass every eng_VulkanUpdate. The pass covers the render extent
+ * (see eng_VulkanGetRenderExtent), not the whole swapchain.
+ */
+void eng_OnRenderBind(eng_Vulkan* vulkan, eng_VulkanRecordCallback_t onRender, void* userData);
+/** Unbinds a function from the OnRender callback, recorded inside the main render pass every eng_VulkanUpdate. */
+void eng_OnRenderUnbind(eng_Vulkan* vulkan, eng_VulkanRecordCallback_t onRender);
+
+/**
+ * Binds a function to the OnOverlay callback, recorded every
+ * eng_VulkanUpdate in a swapchain sized render pass after the scene is
+ * upscaled. UI belongs here so it stays sharp at any render scale.
+ */
+void eng_OnOverlayBind(eng_Vulkan* vulkan, eng_VulkanRecordCallback_t onOverlay, void* userData);
+/** Unbinds a function from the OnOverlay callback, recorded after the scene is upscaled every eng_VulkanUpdate. */
+void eng_OnOverlayUnbind(eng_Vulkan* vulkan, eng_VulkanRecordCallback_t onOverlay);
+
 // Requires <Engine/Log.h> to be included. Function must return a boolean for success.
 #define eng_VulkanEnsure(result, step) if(!eng_Ensure(result == VK_SUCCESS, "Failed to " step ". Error(%d): \"%s\"", (int)result, eng_InternalVkResultToString(result))) { return false; }
 
@@ -0,0 +1,75 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct eng_Vulkan eng_Vulkan;
+typedef struct eng_VulkanDebugDraw eng_VulkanDebugDraw;
+
+// Packs a color for the debug draw calls. Components are 0-255.
+#define ENG_DEBUG_DRAW_COLOR(r, g, b, a) ((uint32_t)(r) | ((uint32_t)(g) << 8) | ((uint32_t)(b) << 16) | ((uint32_t)(a) << 24))
+
+// Debug drawing compiles out of final builds entirely: none of the
+// arguments are evaluated and nothing is allocated.
+#if defined(GAME_FINAL)
+#define eng_VulkanDebugDrawMalloc() NULL
+#define eng_VulkanDebugDrawInit(debugDraw, vulkan, maxPrimitivesPerFrame) (true)
+#define eng_VulkanDebugDrawFree(debugDraw, subAllocationsOnly)
+#define eng_VulkanDebugDrawGetSizeof() ((size_t)0)
+#define eng_VulkanDebugDrawSetViewProjection(debugDraw, viewProjection)
+#define eng_VulkanDebugDrawLine(debugDraw, from, to, color)
+#define eng_VulkanDebugDrawBox(debugDraw, min, max, color)
+#define eng_VulkanDebugDrawSphere(debugDraw, center, radius, color)
+#define eng_VulkanDebugDrawGetDroppedCount(debugDraw) (0u)
+#else
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+
+eng_VulkanDebugDraw* eng_VulkanDebugDrawMalloc(void);
+/**
+ * @description Creates the per-frame primitive streams and the debug draw
+ * pipeline (Shaders/DebugDraw.vert.spv, Shaders/DebugDraw.frag.spv), then
+ * binds to vulkan's OnRender callback. At most maxPrimitivesPerFrame of each
+ * primitive type are drawn per frame; the rest are dropped.
+ * @note vulkan must already have a device (see eng_WindowBindVulkan).
+ */
+bool eng_VulkanDebugDrawInit(eng_VulkanDebugDraw* debugDraw, eng_Vulkan* vulkan, uint32_t maxPrimitivesPerFrame);
+void eng_VulkanDebugDrawFree(eng_VulkanDebugDraw* debugDraw, bool subAllocationsOnly);
+size_t eng_VulkanDebugDrawGetSizeof(void);
+
+////////////////////////////////////////////////////////////////////////// API
+
+/**
+ * Sets the column major matrix taking debug draw positions to clip space.
+ * Defaults to identity, so positions are in clip space until this is set.
+ */
+void eng_VulkanDebugDrawSetViewProjection(eng_VulkanDebugDraw* debugDraw, const float viewProjection[16]);
+
+/**
+ * Debug Draw Line, Box and Sphere
+ *
+ * Queue a wireframe primitive for the next eng_VulkanUpdate. Safe to call
+ * from any thread without locking: one atomic add picks the stream being
+ * filled and a slot in it. A call racing eng_VulkanUpdate lands in either
+ * the frame being recorded or the one after it, never in a stream the GPU
+ * is reading. Boxes are axis aligned; spheres are drawn as three axis
+ * aligned circles. Primitives only last one frame.
+ */
+void eng_VulkanDebugDrawLine(eng_VulkanDebugDraw* debugDraw, const float from[3], const float to[3], uint32_t color);
+void eng_VulkanDebugDrawBox(eng_VulkanDebugDraw* debugDraw, const float min[3], const float max[3], uint32_t color);
+void eng_VulkanDebugDrawSphere(eng_VulkanDebugDraw* debugDraw, const float center[3], float radius, uint32_t color);
+
+/** @returns how many primitives didn't fit in the last drawn frame. */
+uint32_t eng_VulkanDebugDrawGetDroppedCount(eng_VulkanDebugDraw* debugDraw);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
@@ -20,15 +20,15 @@ VK_DEFINE_HANDLE(VkInstance)
 //VK_DEFINE_HANDLE(VkDevice)
 //VK_DEFINE_HANDLE(VkQueue)
 //VK_DEFINE_NON_DISPATCHABLE_HANDLE(VkSemaphore)
-//VK_DEFINE_HANDLE(VkCommandBuffer)
+VK_DEFINE_HANDLE(VkCommandBuffer)
 //VK_DEFINE_NON_DISPATCHABLE_HANDLE(VkFence)
 //VK_DEFINE_NON_DISPATCHABLE_HANDLE(VkDeviceMemory)
-//VK_DEFINE_NON_DISPATCHABLE_HANDLE(VkBuffer)
+VK_DEFINE_NON_DISPATCHABLE_HANDLE(VkBuffer)
 //VK_DEFINE_NON_DISPATCHABLE_HANDLE(VkImage)
 //VK_DEFINE_NON_DISPATCHABLE_HANDLE(VkEvent)
 //VK_DEFINE_NON_DISPATCHABLE_HANDLE(VkQueryPool)
 //VK_DEFINE_NON_DISPATCHABLE_HANDLE(VkBufferView)
-//VK_DEFINE_NON_DISPATCHABLE_HANDLE(VkImageView)
+VK_DEFINE_NON_DISPATCHABLE_HANDLE(VkImageView)
 //VK_DEFINE_NON_DISPATCHABLE_HANDLE(VkShaderModule)
 //VK_DEFINE_NON_DISPATCHABLE_HANDLE(VkPipelineCache)
 //VK_DEFINE_NON_DISPATCHABLE_HANDLE(VkPipelineLayout)
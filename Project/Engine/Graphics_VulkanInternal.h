@@ -1,13 +1,198 @@
 #pragma once
 
+// Requires <ThirdParty/Vulkan/vulkan.h> to be included first.
+
 #ifdef __cplusplus
 extern "C" {
+#else
+#include <stdbool.h>
 #endif
 
+#include <Engine/Array.h>
+#include <Engine/DynamicResolution.h>
+#include <Engine/Graphics_Vulkan.h>
+
+typedef struct eng_Stopwatch eng_Stopwatch;
+
+typedef struct eng_BufferInfo
+{
+	VkImage image;
+	VkCommandBuffer cmd;
+	VkImageView view;
+	VkFramebuffer fb;
+} eng_BufferInfo;
+
+// Semaphores other submissions can ask the next frame to wait on.
+#define ENG_VULKAN_MAX_FRAME_WAITS 8
+
+// Extra statistics queries per frame slot that enclosing regions resume in
+// after a nested region ends.
+#define ENG_VULKAN_MAX_QUERY_PIECES 64
+
+// Per frame slot GPU timing that drives the render scale.
+typedef struct eng_VulkanFrameTiming
+{
+	// Both timestamps were written and can be read back.
+	bool QueriesWritten;
+	// The render scale the timed frame was drawn at.
+	float RenderScale;
+} eng_VulkanFrameTiming;
+
+typedef struct eng_VulkanQueryRegion
+{
+	char Name[ENG_VULKAN_QUERY_NAME_LENGTH];
+	uint32_t Flags;
+	// The eng_Vulkan FrameNumber + 1 the region was last recorded in, per
+	// frame slot. 0 if the slot holds nothing to collect.
+	uint64_t RecordedFrame[ENG_VULKAN_FRAMES_IN_FLIGHT];
+	// The enclosing region this one was recorded inside per frame slot, or
+	// ENG_VULKAN_INVALID_QUERY_REGION.
+	uint32_t EnclosingRegion[ENG_VULKAN_FRAMES_IN_FLIGHT];
+	// Set on the built-in pass regions, which only collect statistics. Their
+	// query is ended while a nested region collects statistics and resumed
+	// in a piece after it, since two statistics queries can't be active.
+	bool Encloses;
+	bool Suspended;
+	// The statistics query an enclosing region currently has open.
+	uint32_t StatisticsQuery;
+	bool Active;
+	bool HasResult;
+	uint64_t ResultFrame;
+	eng_VulkanQueryResult Result;
+} eng_VulkanQueryRegion;
+
+typedef struct eng_VulkanCallback
+{
+	eng_VulkanRecordCallback_t Func;
+	void* UserData;
+} eng_VulkanCallback;
+
+// Shared between the Graphics_Vulkan*.c translation units. Nothing outside
+// of the vulkan backend should reach into this struct.
+typedef struct eng_Vulkan
+{
+	VkInstance Instance;
+	VkPhysicalDevice PhysicalDevice;
+	VkPhysicalDeviceMemoryProperties MemoryProperties;
+	VkDevice Device;
+	uint32_t QueueFamilyIndex;
+	VkQueue Queue;
+	VkCommandPool CommandPool;
+	// Same as the graphics queue when the device has no compute-only family.
+	uint32_t ComputeQueueFamilyIndex;
+	VkQueue ComputeQueue;
+	VkCommandPool ComputeCommandPool;
+	VkSwapchainKHR Swapchain;
+	VkFormat SwapchainFormat;
+	VkExtent2D SwapchainExtent;
+	VkCommandBuffer DrawCmd;
+	// Scene pass into SceneImage. Compatible with OverlayRenderPass, so
+	// pipelines made against either work in both.
+	VkRenderPass RenderPass;
+	// Swapchain pass after the upscale; loads what the blit wrote.
+	VkRenderPass OverlayRenderPass;
+	eng_BufferInfo* Buffers;
+	uint32_t BufferCount;
+	uint32_t FrameIndex;
+	// Frames recorded so far.
+	uint64_t FrameNumber;
+	VkPhysicalDeviceFeatures EnabledFeatures;
+
+	// ENG_VULKAN_MAX_QUERY_REGIONS queries per frame slot in each pool,
+	// followed in the statistics pool by ENG_VULKAN_MAX_QUERY_PIECES per
+	// frame slot.
+	VkQueryPool OcclusionQueries;
+	VkQueryPool StatisticsQueries;
+	// Pieces used per frame slot, and the region each belongs to.
+	uint32_t QueryPieceCount[ENG_VULKAN_FRAMES_IN_FLIGHT];
+	uint32_t QueryPieceRegions[ENG_VULKAN_FRAMES_IN_FLIGHT][ENG_VULKAN_MAX_QUERY_PIECES];
+	eng_ArrayDecl(QueryRegions, eng_VulkanQueryRegion);
+	uint32_t SceneQueryRegion;
+	uint32_t OverlayQueryRegion;
+
+	// Offscreen scene target, sized to the swapchain. Only RenderExtent of
+	// it is drawn each frame and then upscaled to the swapchain image.
+	VkImage SceneImage;
+	VkDeviceMemory SceneMemory;
+	VkImageView SceneView;
+	VkFramebuffer SceneFramebuffer;
+	VkFilter UpscaleFilter;
+	VkExtent2D RenderExtent;
+	float RenderScale;
+	eng_DynamicResolutionSettings DynamicResolution;
+
+	// Two timestamps per frame slot bracketing the frame's commands.
+	// VK_NULL_HANDLE if the graphics queue can't time, in which case
+	// FrameStopwatch times the submission on the CPU instead.
+	VkQueryPool FrameTimestamps;
+	double NanosecondsPerTick;
+	eng_VulkanFrameTiming FrameTimings[ENG_VULKAN_FRAMES_IN_FLIGHT];
+	eng_Stopwatch* FrameStopwatch;
+	double GpuFrameMilliseconds;
+	// Times vkAcquireNextImageKHR, which is where FIFO presentation blocks.
+	eng_Stopwatch* AcquireStopwatch;
+	// From VK_GOOGLE_display_timing; 0 if the device doesn't have it.
+	bool DisplayTiming;
+	double RefreshMilliseconds;
+
+	// One extra slot for the swapchain acquire semaphore.
+	VkSemaphore FrameWaitSemaphores[ENG_VULKAN_MAX_FRAME_WAITS + 1];
+	VkPipelineStageFlags FrameWaitStages[ENG_VULKAN_MAX_FRAME_WAITS + 1];
+	uint32_t FrameWaitCount;
+
+	eng_ArrayDeclInline(Extensions, const char*, 4);
+	// Where every internal allocation comes from, including the renderer
+	// modules made against vulkan; NULL for the heap.
+	const eng_Allocator* Allocator;
+	eng_FrameAllocator* FrameAllocator;
+
+	// callbacks
+	eng_ArrayDeclInline(OnPreRender, eng_VulkanCallback, 4);
+	eng_ArrayDeclInline(OnRender, eng_VulkanCallback, 4);
+	eng_ArrayDeclInline(OnOverlay, eng_VulkanCallback, 4);
+} eng_Vulkan;
+
 const char* eng_InternalVkResultToString(VkResult result);
 
 const char* eng_InternalVKFormatToString(VkFormat format);
 
+/** @returns a memory type index matching typeBits and properties, or UINT32_MAX. */
+uint32_t eng_InternalVkFindMemoryType(eng_Vulkan* vulkan, uint32_t typeBits, VkMemoryPropertyFlags properties);
+
+/** Creates a buffer with its own dedicated memory allocation. */
+bool eng_InternalVkCreateBuffer(eng_Vulkan* vulkan, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer* outBuffer, VkDeviceMemory* outMemory);
+
+/**
+* Like eng_InternalVkCreateBuffer. When sharedWithCompute is set and compute
+* runs on its own queue family, the buffer is shared concurrently between
+* the graphics and compute families so no ownership transfers are needed.
+*/
+bool eng_InternalVkCreateSharedBuffer(eng_Vulkan* vulkan, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, bool sharedWithCompute, VkBuffer* outBuffer, VkDeviceMemory* outMemory);
+
+/**
+* Makes the next eng_VulkanUpdate submission wait on semaphore before
+* stages. Used to order work submitted to other queues (e.g. async compute)
+* ahead of the frame.
+*/
+void eng_InternalVkWaitOnSemaphore(eng_Vulkan* vulkan, VkSemaphore semaphore, VkPipelineStageFlags stages);
+
+/** Creates the query pools and the built in "Scene" and "Overlay" regions. */
+bool eng_InternalVkQueriesCreate(eng_Vulkan* vulkan);
+void eng_InternalVkQueriesDestroy(eng_Vulkan* vulkan);
+/**
+* Collects what the current frame slot recorded last time round, then
+* records the reset of its queries into cmd. Called by eng_VulkanUpdate
+* before any callback.
+*/
+void eng_InternalVkQueriesBeginFrame(eng_Vulkan* vulkan, VkCommandBuffer cmd);
+
+/**
+* Loads a SPIR-V module compiled from Project/Shaders. path is relative to
+* the working directory, e.g. "Shaders/Text.vert.spv".
+* @returns VK_NULL_HANDLE on failure.
+*/
+VkShaderModule eng_InternalVkLoadShader(eng_Vulkan* vulkan, const char* path);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
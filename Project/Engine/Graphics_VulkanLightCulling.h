@@ -0,0 +1,67 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stddef.h>
+
+#include <Engine/Graphics_VulkanForwardDecl.h> //in place of: <ThirdParty/Vulkan/vulkan.h>
+#include <Engine/LightCulling.h>
+
+typedef struct eng_Vulkan eng_Vulkan;
+typedef struct eng_VulkanLightCulling eng_VulkanLightCulling;
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+
+eng_VulkanLightCulling* eng_VulkanLightCullingMalloc(void);
+/**
+ * @description Computes the cluster bounds for config, creates the light,
+ * bounds and output buffers and the culling pipeline
+ * (Shaders/LightCulling.comp.spv). Binds to vulkan's OnPreRender callback so
+ * every frame's lights are culled before the main render pass.
+ * @note vulkan must already have a device (see eng_WindowBindVulkan).
+ */
+bool eng_VulkanLightCullingInit(eng_VulkanLightCulling* culling, eng_Vulkan* vulkan, const eng_LightClusterConfig* config, uint32_t maxLights);
+void eng_VulkanLightCullingFree(eng_VulkanLightCulling* culling, bool subAllocationsOnly);
+size_t eng_VulkanLightCullingGetSizeof(void);
+
+////////////////////////////////////////////////////////////////////////// API
+
+/**
+ * Light Culling Set Lights
+ *
+ * Copies this frame's view space lights; anything past maxLights is
+ * dropped. Call once per frame before eng_VulkanUpdate.
+ */
+void eng_VulkanLightCullingSetLights(eng_VulkanLightCulling* culling, const eng_Light* lights, uint32_t count);
+
+const eng_LightClusterConfig* eng_VulkanLightCullingGetConfig(eng_VulkanLightCulling* culling);
+
+/**
+ * Buffers for shading passes bound to OnRender, all std430 storage buffers:
+ * the lights (eng_Light[]) of the current frame, the per cluster light
+ * counts (uint[]) and the per cluster light indices
+ * (uint[MaxLightsPerCluster] per cluster). Use eng_LightClusterFind's
+ * formula to pick a fragment's cluster.
+ */
+VkBuffer eng_VulkanLightCullingGetLightBuffer(eng_VulkanLightCulling* culling);
+VkBuffer eng_VulkanLightCullingGetCountBuffer(eng_VulkanLightCulling* culling);
+VkBuffer eng_VulkanLightCullingGetIndexBuffer(eng_VulkanLightCulling* culling);
+
+/**
+ * Light Culling Validate
+ *
+ * Reads back the most recently culled frame and compares it to
+ * eng_LightCullClusters on the same lights. Logs the first mismatches.
+ * Stalls the device; meant for debugging and software Vulkan
+ * implementations, not for every frame.
+ * @returns true if the GPU and CPU results match exactly.
+ */
+bool eng_VulkanLightCullingValidate(eng_VulkanLightCulling* culling);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct eng_Vulkan eng_Vulkan;
+typedef struct eng_VulkanParticles eng_VulkanParticles;
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+
+eng_VulkanParticles* eng_VulkanParticlesMalloc(void);
+/**
+ * @description Creates two particle buffers of capacity particles that the
+ * simulation ping-pongs between, and the compute and draw pipelines
+ * (Shaders/Particles.comp.spv, .vert.spv, .frag.spv). Binds to vulkan's
+ * OnRender callback.
+ * @note vulkan must already have a device (see eng_WindowBindVulkan).
+ */
+bool eng_VulkanParticlesInit(eng_VulkanParticles* particles, eng_Vulkan* vulkan, uint32_t capacity);
+void eng_VulkanParticlesFree(eng_VulkanParticles* particles, bool subAllocationsOnly);
+size_t eng_VulkanParticlesGetSizeof(void);
+
+////////////////////////////////////////////////////////////////////////// API
+
+/** Moves the emitter to (x, y) pixels and sets how many particles it spawns per second. */
+void eng_VulkanParticlesSetEmitter(eng_VulkanParticles* particles, float x, float y, float particlesPerSecond);
+
+/**
+ * Particles Update
+ *
+ * Submits one simulation step of deltaSeconds. Runs on the async compute
+ * queue when the device has one; the next eng_VulkanUpdate waits for it
+ * before drawing. Call at most once per frame, before eng_VulkanUpdate.
+ */
+void eng_VulkanParticlesUpdate(eng_VulkanParticles* particles, float deltaSeconds);
+
+uint32_t eng_VulkanParticlesGetCapacity(eng_VulkanParticles* particles);
+/** @returns true if simulation runs on a queue separate from graphics. */
+bool eng_VulkanParticlesIsAsyncCompute(eng_VulkanParticles* particles);
+
+/**
+ * GPU time of the most recent simulation step and particle draw, measured
+ * with timestamp queries a few frames behind. Both are 0 if the device
+ * can't time the queues involved.
+ */
+double eng_VulkanParticlesGetSimulationMilliseconds(eng_VulkanParticles* particles);
+double eng_VulkanParticlesGetRenderMilliseconds(eng_VulkanParticles* particles);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct eng_Vulkan eng_Vulkan;
+typedef struct eng_VulkanText eng_VulkanText;
+
+// Packs a color for eng_VulkanTextDraw. Components are 0-255.
+#define ENG_TEXT_COLOR(r, g, b, a) ((uint32_t)(r) | ((uint32_t)(g) << 8) | ((uint32_t)(b) << 16) | ((uint32_t)(a) << 24))
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+
+eng_VulkanText* eng_VulkanTextMalloc(void);
+/**
+ * @description Creates the glyph atlas, per-frame vertex buffers and the
+ * text pipeline (Shaders/Text.vert.spv, Shaders/Text.frag.spv), then binds
+ * to vulkan's OnOverlay callback so text stays sharp at any render scale.
+ * At most maxGlyphsPerFrame glyphs are
+ * drawn per frame; the rest are dropped. The glyph cache is allocated
+ * from the allocator vulkan was initialized with.
+ * @note vulkan must already have a device (see eng_WindowBindVulkan).
+ */
+bool eng_VulkanTextInit(eng_VulkanText* text, eng_Vulkan* vulkan, uint32_t maxGlyphsPerFrame);
+void eng_VulkanTextFree(eng_VulkanText* text, bool subAllocationsOnly);
+size_t eng_VulkanTextGetSizeof(void);
+
+////////////////////////////////////////////////////////////////////////// API
+
+/**
+ * Text Draw
+ *
+ * Queues str for the next eng_VulkanUpdate, with its top left corner at
+ * (x, y) pixels. Glyphs are the built-in font at an integer scale (1-4).
+ * '\n' starts a new line. Text only lasts one frame.
+ */
+void eng_VulkanTextDraw(eng_VulkanText* text, int32_t x, int32_t y, uint32_t scale, uint32_t color, const char* str);
+/** printf style eng_VulkanTextDraw. Output is truncated at 255 characters. */
+void eng_VulkanTextDrawf(eng_VulkanText* text, int32_t x, int32_t y, uint32_t scale, uint32_t color, const char* fmt, ...);
+
+/** @returns the distance between lines of text at scale, in pixels. */
+uint32_t eng_VulkanTextGetLineHeight(uint32_t scale);
+/** @returns the number of glyphs rasterized into the atlas so far. */
+uint32_t eng_VulkanTextGetRasterizeCount(eng_VulkanText* text);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <Engine/Graphics_VulkanForwardDecl.h> //in place of: <ThirdParty/Vulkan/vulkan.h>
+#include <Engine/Image.h>
+
+typedef struct eng_Vulkan eng_Vulkan;
+typedef struct eng_VulkanTexture eng_VulkanTexture;
+typedef struct eng_VulkanUploader eng_VulkanUploader;
+
+////////////////////////////////////////////////////////////////////////// Texture Lifecycle
+
+eng_VulkanTexture* eng_VulkanTextureMalloc(void);
+/** Initializes an empty texture. It becomes ready once an uploader fills it. */
+bool eng_VulkanTextureInit(eng_VulkanTexture* texture);
+/**
+ * @note The GPU must be done with the texture, and any upload into it must
+ * have completed or been abandoned by freeing its uploader.
+ */
+void eng_VulkanTextureFree(eng_VulkanTexture* texture, bool subAllocationsOnly);
+size_t eng_VulkanTextureGetSizeof(void);
+
+////////////////////////////////////////////////////////////////////////// Texture API
+
+/** @returns true once the texture's pixels are resident and it can be sampled. */
+bool eng_VulkanTextureIsReady(eng_VulkanTexture* texture);
+VkImageView eng_VulkanTextureGetView(eng_VulkanTexture* texture);
+uint32_t eng_VulkanTextureGetWidth(eng_VulkanTexture* texture);
+uint32_t eng_VulkanTextureGetHeight(eng_VulkanTexture* texture);
+
+////////////////////////////////////////////////////////////////////////// Uploader Lifecycle
+
+eng_VulkanUploader* eng_VulkanUploaderMalloc(void);
+/**
+ * @description Creates a persistently mapped staging ring of stagingSize
+ * bytes. Uploads larger than the ring get a one-off staging buffer.
+ * @note vulkan must already have a device (see eng_WindowBindVulkan).
+ */
+bool eng_VulkanUploaderInit(eng_VulkanUploader* uploader, eng_Vulkan* vulkan, uint32_t stagingSize);
+void eng_VulkanUploaderFree(eng_VulkanUploader* uploader, bool subAllocationsOnly);
+size_t eng_VulkanUploaderGetSizeof(void);
+
+////////////////////////////////////////////////////////////////////////// Uploader API
+
+/**
+ * Uploader Queue Image
+ *
+ * Creates the GPU image for texture and queues image's pixels for upload.
+ * The uploader takes ownership of image's data and destroys it once it has
+ * been copied to staging memory. Main thread only.
+ * @return false if the format is unsupported or the GPU image could not be
+ * created. image is destroyed either way.
+ */
+bool eng_VulkanUploaderQueueImage(eng_VulkanUploader* uploader, eng_VulkanTexture* texture, eng_Image* image);
+
+/**
+ * Uploader Update
+ *
+ * Call once per frame on the main thread. Retires finished upload batches
+ * (marking their textures ready) without waiting on the GPU, then records
+ * and submits copies for as many queued images as the staging ring and the
+ * per-update byte budget allow.
+ */
+void eng_VulkanUploaderUpdate(eng_VulkanUploader* uploader);
+
+/** Limits how many bytes a single eng_VulkanUploaderUpdate copies. 0 removes the limit. */
+void eng_VulkanUploaderSetBudget(eng_VulkanUploader* uploader, uint32_t bytesPerUpdate);
+
+/** @returns true if nothing is queued or in flight. */
+bool eng_VulkanUploaderIsIdle(eng_VulkanUploader* uploader);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Engine/Allocator.h>
+
+// How keys are hashed and compared. keySize is the map's key size.
+typedef struct eng_HashMapKeyOps {
+	uint64_t(*Hash)(const void* key, uint32_t keySize);
+	bool(*Equal)(const void* a, const void* b, uint32_t keySize);
+} eng_HashMapKeyOps;
+
+// Keys are const char* and compared by contents. The strings must outlive
+// their entries; the map only stores the pointers.
+extern const eng_HashMapKeyOps eng_HashMapStringKeys;
+
+// Open addressing in the style of Swiss tables: a control byte per slot
+// holding 7 bits of the key's hash, probed a 16 byte group at a time, so
+// most misses and hits touch one cache line of control bytes and compare a
+// single key. Keys and values are copied in and live in flat arrays.
+typedef struct eng_HashMap {
+	// Capacity + 16 control bytes; the last 16 mirror the first 16 so a
+	// group can be loaded at any slot without wrapping.
+	uint8_t* Control;
+	void* Keys;
+	void* Values;
+	uint32_t Count;
+	// A power of two, at least 16.
+	uint32_t Capacity;
+	// Removed slots that still break up probe sequences.
+	uint32_t Tombstones;
+	uint32_t KeySize;
+	uint32_t ValueSize;
+	// NULL for bytewise keys.
+	const eng_HashMapKeyOps* KeyOps;
+	// NULL for the heap.
+	const eng_Allocator* Allocator;
+} eng_HashMap;
+
+#define eng_HashMapDecl(name, keyType, valueType) eng_HashMap name
+
+// keyOps may be NULL to hash and compare keys bytewise. Storage comes from
+// allocator, which must outlive the map.
+void eng_HashMapInit(eng_HashMap* map, uint32_t keySize, uint32_t valueSize, const eng_HashMapKeyOps* keyOps, const eng_Allocator* allocator);
+#define eng_HashMapInitType(map, keyType, valueType, keyOps, allocator) eng_HashMapInit(map, sizeof(keyType), sizeof(valueType), keyOps, allocator)
+void eng_HashMapDestroy(eng_HashMap* map);
+
+// Makes room for count entries without growing again.
+void eng_HashMapReserve(eng_HashMap* map, uint32_t count);
+void eng_HashMapClear(eng_HashMap* map);
+
+// @returns the value stored for key, or NULL. Only valid until the next insert.
+void* eng_HashMapFind(eng_HashMap* map, const void* key);
+#define eng_HashMapFindType(map, valueType, key) ((valueType*)eng_HashMapFind(map, key))
+// Stores value for key, replacing what was there. value may be NULL to
+// leave a new entry's value uninitialized. @returns the stored value.
+void* eng_HashMapInsert(eng_HashMap* map, const void* key, const void* value);
+#define eng_HashMapInsertType(map, valueType, key, value) ((valueType*)eng_HashMapInsert(map, key, value))
+// @returns true if key was found and removed.
+bool eng_HashMapRemove(eng_HashMap* map, const void* key);
+uint32_t eng_HashMapCount(eng_HashMap* map);
+
+// Iterates slots in use, in no particular order:
+// for (uint32_t i = eng_HashMapBegin(map); i < map->Capacity; i = eng_HashMapNext(map, i))
+uint32_t eng_HashMapBegin(eng_HashMap* map);
+uint32_t eng_HashMapNext(eng_HashMap* map, uint32_t slot);
+void* eng_HashMapKeyAt(eng_HashMap* map, uint32_t slot);
+#define eng_HashMapKeyAtType(map, keyType, slot) (*(keyType*)eng_HashMapKeyAt(map, slot))
+void* eng_HashMapValueAt(eng_HashMap* map, uint32_t slot);
+#define eng_HashMapValueAtType(map, valueType, slot) (*(valueType*)eng_HashMapValueAt(map, slot))
+
+/** @returns a 64 bit hash of size bytes at data, good in both its high and low bits. */
+uint64_t eng_HashBytes(const void* data, size_t size);
+
+/** @returns eng_HashBytes of string, without its terminator. */
+uint64_t eng_HashString(const char* string);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
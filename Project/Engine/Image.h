@@ -0,0 +1,104 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define ENG_IMAGE_MAX_LEVELS 16
+
+typedef struct eng_Allocator eng_Allocator;
+
+typedef enum eng_ImageFormat
+{
+	ENG_IMAGE_FORMAT_UNKNOWN = 0,
+
+	// Uncompressed, 4 bytes per pixel
+	ENG_IMAGE_FORMAT_RGBA8,
+	ENG_IMAGE_FORMAT_RGBA8_SRGB,
+	ENG_IMAGE_FORMAT_BGRA8,
+	ENG_IMAGE_FORMAT_BGRA8_SRGB,
+
+	// Block compressed, 4x4 pixels per block
+	ENG_IMAGE_FORMAT_BC1,
+	ENG_IMAGE_FORMAT_BC1_SRGB,
+	ENG_IMAGE_FORMAT_BC2,
+	ENG_IMAGE_FORMAT_BC2_SRGB,
+	ENG_IMAGE_FORMAT_BC3,
+	ENG_IMAGE_FORMAT_BC3_SRGB,
+	ENG_IMAGE_FORMAT_BC4,
+	ENG_IMAGE_FORMAT_BC5,
+	ENG_IMAGE_FORMAT_BC6H,
+	ENG_IMAGE_FORMAT_BC7,
+	ENG_IMAGE_FORMAT_BC7_SRGB,
+
+	ENG_IMAGE_FORMAT_COUNT
+} eng_ImageFormat;
+
+typedef struct eng_ImageLevel
+{
+	uint32_t Width;
+	uint32_t Height;
+	// Byte offset of this level into eng_Image::Data.
+	uint32_t Offset;
+	uint32_t Size;
+} eng_ImageLevel;
+
+/**
+* Image
+*
+* Decoded pixel data ready to be copied into a GPU texture. Uncompressed
+* sources (TGA, PNG) are expanded to RGBA8; pre-compressed sources (DDS,
+* KTX) keep their block format and mip chain untouched.
+*/
+typedef struct eng_Image
+{
+	void* Data;
+	uint32_t DataSize;
+	uint32_t Width;
+	uint32_t Height;
+	uint32_t LevelCount;
+	eng_ImageFormat Format;
+	eng_ImageLevel Levels[ENG_IMAGE_MAX_LEVELS];
+	// Where Data and decoding scratch come from; NULL for the heap.
+	const eng_Allocator* Allocator;
+} eng_Image;
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+/**
+* Image Init From Memory
+*
+* Decodes a TGA, PNG, DDS or KTX file that has already been read into
+* memory. The container is detected from its header; data is not retained.
+* Pixel data and scratch come from allocator (NULL for the heap).
+* @return true if the image was decoded.
+*/
+bool eng_ImageInitFromMemory(eng_Image* image, const void* data, size_t size, const eng_Allocator* allocator);
+
+/**
+* Image Init From File
+*
+* Reads and decodes the file at path. Safe to call from worker threads
+* as long as allocator is thread safe.
+* @return true if the image was read and decoded.
+*/
+bool eng_ImageInitFromFile(eng_Image* image, const char* path, const eng_Allocator* allocator);
+
+/** Frees the pixel data owned by the image. */
+void eng_ImageDestroy(eng_Image* image);
+
+////////////////////////////////////////////////////////////////////////// Format API
+
+/** @returns true if the format stores 4x4 pixel blocks. */
+bool eng_ImageFormatIsBlockCompressed(eng_ImageFormat format);
+
+/** @returns the number of bytes needed for a width by height level. */
+uint32_t eng_ImageFormatGetLevelSize(eng_ImageFormat format, uint32_t width, uint32_t height);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
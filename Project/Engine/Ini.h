@@ -8,6 +8,7 @@ extern "C" {
 #include <stdint.h>
 
 typedef struct eng_IniR eng_IniR;
+typedef struct eng_Allocator eng_Allocator;
 
 ////////////////////////////////////////////////////////////////////////// Lifecycle
 /**
@@ -21,10 +22,11 @@ eng_IniR* eng_IniRMalloc(void);
 /**
 * Ini (readable) Init
 *
-* @description Initializes the ini, making it ready for use.
+* @description Initializes the ini, making it ready for use. The file's
+* contents are kept in memory from allocator (NULL for the heap).
 * @return true if initialization was successful.
 */
-bool eng_IniRInit(eng_IniR* ini, const char* path);
+bool eng_IniRInit(eng_IniR* ini, const char* path, const eng_Allocator* allocator);
 	
 /**
 * Ini (readable) Free
@@ -44,6 +46,13 @@ size_t eng_IniRGetSizeof(void);
 
 ////////////////////////////////////////////////////////////////////////// Ini API
 
+/**
+* Ini (readable) Read
+*
+* Section and key names are matched case-insensitively. Values come back
+* upper cased, trimmed, and with surrounding quotes removed.
+* @return the value, owned by the ini, or NULL if the key is not present.
+*/
 const char* eng_IniRRead(eng_IniR* ini, const char* section, const char* key);
 
 #ifdef __cplusplus
@@ -0,0 +1,90 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct eng_JobPool eng_JobPool;
+typedef struct eng_Allocator eng_Allocator;
+
+typedef void(*eng_JobFunc_t)(void*);
+
+/**
+* Job Counter
+*
+* Tracks how many jobs pushed against it are still outstanding. Zero
+* initialize before use; a counter may be reused once it reaches zero.
+*/
+typedef struct eng_JobCounter
+{
+	volatile int32_t Pending;
+} eng_JobCounter;
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+/**
+* Job Pool Malloc
+*
+* @note The job pool is not ready for use until eng_JobPoolInit is called.
+* @return A newly allocated job pool.
+*/
+eng_JobPool* eng_JobPoolMalloc(void);
+
+/**
+* Job Pool Init
+*
+* @description Starts workerCount worker threads. If workerCount is 0 one
+* worker per logical core (minus the calling thread) is started. The
+* queue and worker handles come from allocator (NULL for the heap), which
+* must be thread safe: the queue grows on whichever thread pushes.
+* @return true if initialization was successful.
+*/
+bool eng_JobPoolInit(eng_JobPool* pool, uint32_t workerCount, const eng_Allocator* allocator);
+
+/**
+* Job Pool Free
+*
+* Finishes all queued jobs, joins the workers and frees memory associated
+* with the pool. If subAllocationsOnly is true, the pool pointer itself
+* will not be freed.
+*/
+void eng_JobPoolFree(eng_JobPool* pool, bool subAllocationsOnly);
+
+/**
+* Job Pool Get Sizeof
+*
+* @return the sizeof the internal eng_JobPool object, for use with custom
+* allocators.
+*/
+size_t eng_JobPoolGetSizeof(void);
+
+////////////////////////////////////////////////////////////////////////// Job Pool API
+
+/**
+* Job Pool Push
+*
+* Queues func(userData) to run on a worker. Safe to call from any thread,
+* including from inside a job. counter may be NULL. If the queue can't grow
+* the job runs on the calling thread instead.
+*/
+void eng_JobPoolPush(eng_JobPool* pool, eng_JobFunc_t func, void* userData, eng_JobCounter* counter);
+
+/**
+* Job Pool Wait
+*
+* Blocks until every job pushed against counter has finished. The calling
+* thread runs queued jobs while it waits, so waiting from inside a job
+* cannot deadlock the pool.
+*/
+void eng_JobPoolWait(eng_JobPool* pool, eng_JobCounter* counter);
+
+/** @returns the number of worker threads owned by the pool. */
+uint32_t eng_JobPoolGetWorkerCount(eng_JobPool* pool);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Light positions are in view space: +X right, +Y down, +Z forward, which
+// matches Vulkan's clip space orientation.
+typedef struct eng_Light
+{
+	float Position[3];
+	float Radius;
+	float Color[3];
+	float Intensity;
+} eng_Light;
+
+// The view frustum is split into TilesX * TilesY screen tiles and Slices
+// exponentially spaced depth slices between Near and Far.
+typedef struct eng_LightClusterConfig
+{
+	uint32_t TilesX;
+	uint32_t TilesY;
+	uint32_t Slices;
+	uint32_t MaxLightsPerCluster;
+	float FovY; // radians
+	float Aspect;
+	float Near;
+	float Far;
+} eng_LightClusterConfig;
+
+////////////////////////////////////////////////////////////////////////// Light Culling API
+
+/** @returns TilesX * TilesY * Slices. */
+uint32_t eng_LightClusterGetCount(const eng_LightClusterConfig* config);
+
+/**
+* Light Cluster Get Bounds
+*
+* Writes the view space AABB of cluster (x, y, z). Every cluster is
+* flattened as x + TilesX * (y + TilesY * z).
+*/
+void eng_LightClusterGetBounds(const eng_LightClusterConfig* config, uint32_t x, uint32_t y, uint32_t z, float outMin[3], float outMax[3]);
+
+/** @returns the cluster containing a view space position, or UINT32_MAX outside the frustum. */
+uint32_t eng_LightClusterFind(const eng_LightClusterConfig* config, const float viewPosition[3]);
+
+/**
+* Light Cull Clusters
+*
+* Reference culling on the CPU. bounds holds eng_LightClusterGetCount
+* entries of (min xyz, pad, max xyz, pad) as eng_LightClusterGetBounds
+* writes them. For every cluster, outCounts gets the number of lights
+* touching it and outIndices (MaxLightsPerCluster per cluster) their
+* indices in ascending order. Clusters with more lights than fit keep the
+* first MaxLightsPerCluster. Matches LightCulling.comp, short of lights that
+* graze a cluster within float rounding.
+*/
+void eng_LightCullClusters(const eng_LightClusterConfig* config, const float* bounds, const eng_Light* lights, uint32_t lightCount, uint32_t* outCounts, uint32_t* outIndices);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,112 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Engine/Allocator.h>
+
+// Threads past this many share the global free list without a cache.
+#define ENG_POOL_MAX_THREADS 64
+
+typedef struct eng_Pool eng_Pool;
+
+typedef struct eng_PoolSettings
+{
+	// Objects per slab; rounded up so slabs fill a power of two bytes.
+	uint32_t ObjectsPerSlab;
+	// The pool never holds more than this many slabs.
+	uint32_t MaxSlabs;
+	// Objects a thread keeps for itself before giving half back.
+	uint32_t ThreadCacheSize;
+	// When false the global free list is guarded by a spin lock instead.
+	bool LockFree;
+} eng_PoolSettings;
+
+/** 64 objects per slab, at most 1024 slabs, caches of 32 and a lock-free list. */
+eng_PoolSettings eng_PoolGetDefaults(void);
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+/**
+* Pool Malloc
+*
+* @note The pool is not ready for use until eng_PoolInit is called.
+* @return A newly allocated pool.
+*/
+eng_Pool* eng_PoolMalloc(void);
+
+/**
+* Pool Init
+*
+* @description Hands out objects of objectSize bytes, aligned to alignment
+* (a power of two, at most 64), for things that are made and released
+* constantly. Objects come from cache-line-aligned slabs taken from
+* allocator (NULL for the heap) and are never given back until the pool is
+* freed. Free objects are linked through their own memory. Each thread
+* allocates from and releases to a cache of its own, so the shared free
+* list is only touched a batch at a time. Outside of final builds released
+* objects are poisoned, and writes to them are reported when they're
+* handed out again. settings may be NULL for the defaults.
+* @return true if initialization was successful.
+*/
+bool eng_PoolInit(eng_Pool* pool, size_t objectSize, size_t alignment, const eng_PoolSettings* settings, const eng_Allocator* allocator);
+
+/**
+* Pool Free
+*
+* Frees every slab, and with them every object. If subAllocationsOnly is
+* true, the pool pointer itself will not be freed.
+*/
+void eng_PoolFree(eng_Pool* pool, bool subAllocationsOnly);
+
+/**
+* Pool Get Sizeof
+*
+* @return the sizeof the internal eng_Pool object, for use with
+* custom allocators.
+*/
+size_t eng_PoolGetSizeof(void);
+
+////////////////////////////////////////////////////////////////////////// Pool API
+
+/**
+* Pool Alloc
+*
+* Thread safe.
+* @return an uninitialized object, or NULL once MaxSlabs are full.
+*/
+void* eng_PoolAlloc(eng_Pool* pool);
+
+/** Gives obj back to the pool. Thread safe, from any thread. NULL is ignored. */
+void eng_PoolRelease(eng_Pool* pool, void* obj);
+
+/**
+* Pool Flush Thread Cache
+*
+* Gives the calling thread's cached objects back to the shared list. Call
+* before a thread that used the pool exits, or its cache sits idle.
+*/
+void eng_PoolFlushThreadCache(eng_Pool* pool);
+
+/** @returns the size objects are handed out at, including alignment padding. */
+size_t eng_PoolGetObjectSize(eng_Pool* pool);
+
+/** @returns how many objects the pool's slabs hold, in use or not. */
+uint32_t eng_PoolGetCapacity(eng_Pool* pool);
+
+/**
+* Pool Get Allocator
+*
+* @return an allocator over the pool, valid for its lifetime. Requests
+* larger than the object size fail; reallocs never move.
+*/
+const eng_Allocator* eng_PoolGetAllocator(eng_Pool* pool);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
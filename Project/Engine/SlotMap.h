@@ -0,0 +1,60 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Engine/Allocator.h>
+#include <Engine/Array.h>
+
+// Slot index in the low 32 bits, generation in the high 32. A handle stops
+// resolving once its element is removed, even after the slot is reused.
+typedef uint64_t eng_SlotHandle;
+
+// Generations start at 1, so this never resolves.
+#define ENG_SLOT_HANDLE_INVALID ((eng_SlotHandle)0)
+
+// Elements kept densely packed, in no particular order, for iteration, and
+// looked up in O(1) through handles that survive other elements being
+// inserted and removed.
+typedef struct eng_SlotMap {
+	// The elements, densely packed.
+	eng_Array Dense;
+	// uint32_t slot index per element in Dense.
+	eng_Array DenseToSlot;
+	// eng_Slot per slot.
+	eng_Array Slots;
+	// First free slot, or UINT32_MAX.
+	uint32_t FreeSlot;
+} eng_SlotMap;
+
+#define eng_SlotMapDecl(name, type) eng_SlotMap name
+
+// Storage comes from allocator, which must outlive the map.
+void eng_SlotMapInit(eng_SlotMap* map, uint32_t typeSize, const eng_Allocator* allocator);
+#define eng_SlotMapInitType(map, type, allocator) eng_SlotMapInit(map, sizeof(type), allocator)
+void eng_SlotMapDestroy(eng_SlotMap* map);
+
+// Copies object in. @returns its handle.
+eng_SlotHandle eng_SlotMapInsert(eng_SlotMap* map, void* object);
+// @returns true if handle resolved and its element was removed.
+bool eng_SlotMapRemove(eng_SlotMap* map, eng_SlotHandle handle);
+// @returns the element handle refers to, or NULL if it's been removed.
+// Only valid until the next insert or remove.
+void* eng_SlotMapGet(eng_SlotMap* map, eng_SlotHandle handle);
+#define eng_SlotMapGetType(map, type, handle) ((type*)eng_SlotMapGet(map, handle))
+bool eng_SlotMapContains(eng_SlotMap* map, eng_SlotHandle handle);
+
+// Iterate elements with Count and Dense, e.g. eng_ArrayBeginType(&map->Dense, type).
+uint32_t eng_SlotMapCount(eng_SlotMap* map);
+// @returns the handle of the element at index in Dense.
+eng_SlotHandle eng_SlotMapGetHandle(eng_SlotMap* map, uint32_t index);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Engine/Allocator.h>
+
+#define ENG_SOA_MAX_COLUMNS 16
+// Every column starts on a cache line.
+#define ENG_SOA_COLUMN_ALIGNMENT 64
+// Capacity is kept a multiple of this, so a SIMD loop can always run to
+// the end of its last vector without a scalar tail; the slack past Count
+// is uninitialized.
+#define ENG_SOA_CAPACITY_GRANULE 16
+
+// Parallel columns sharing one count. Rows are added, grown and removed
+// across every column at once, so loops that only touch a few fields of
+// each row stream just those columns. All columns live in one allocation.
+typedef struct eng_SoaArray {
+	void* Columns[ENG_SOA_MAX_COLUMNS];
+	uint32_t ColumnSizes[ENG_SOA_MAX_COLUMNS];
+	uint32_t ColumnCount;
+	uint32_t Count;
+	uint32_t Capacity;
+	// NULL for the heap.
+	const eng_Allocator* Allocator;
+} eng_SoaArray;
+
+#define eng_SoaArrayDecl(name) eng_SoaArray name
+
+// columnSizes holds the element size of each of columnCount columns. Storage
+// comes from allocator, which must outlive the array.
+void eng_SoaArrayInit(eng_SoaArray* array, const uint32_t* columnSizes, uint32_t columnCount, const eng_Allocator* allocator);
+void eng_SoaArrayDestroy(eng_SoaArray* array);
+
+void eng_SoaArrayReserve(eng_SoaArray* array, uint32_t rowsToReserve);
+// New rows are left uninitialized.
+void eng_SoaArrayResize(eng_SoaArray* array, uint32_t newRowCount);
+
+// @returns the first element of column. Only valid until the array grows.
+void* eng_SoaArrayColumn(eng_SoaArray* array, uint32_t column);
+#define eng_SoaArrayColumnType(array, type, column) ((type*)eng_SoaArrayColumn(array, column))
+void* eng_SoaArrayIndex(eng_SoaArray* array, uint32_t column, uint32_t row);
+#define eng_SoaArrayIndexType(array, type, column, row) (*(type*)eng_SoaArrayIndex(array, column, row))
+
+// Adds an uninitialized row. @returns its index.
+uint32_t eng_SoaArrayPushBack(eng_SoaArray* array);
+// Moves the last row into row, in every column.
+void eng_SoaArrayRemoveLastSwap(eng_SoaArray* array, uint32_t row);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
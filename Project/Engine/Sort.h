@@ -0,0 +1,72 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Engine/Array.h>
+
+typedef struct eng_JobPool eng_JobPool;
+
+// @returns < 0 if a orders before b, 0 if they're equal and > 0 after.
+typedef int(*eng_CompareFunc_t)(const void* a, const void* b, void* userData);
+
+// Key types the radix sort and keyed searches understand, found at a byte
+// offset inside each element.
+typedef enum eng_SortKey
+{
+	ENG_SORT_KEY_U32 = 0,
+	ENG_SORT_KEY_I32,
+	ENG_SORT_KEY_F32,
+	ENG_SORT_KEY_U64,
+	ENG_SORT_KEY_I64,
+	ENG_SORT_KEY_F64,
+} eng_SortKey;
+
+////////////////////////////////////////////////////////////////////////// Sort API
+
+/**
+* Array Radix Sort
+*
+* Sorts array ascending by the keyType key keyOffset bytes into each
+* element. Least significant byte first, one pass per key byte, skipping
+* bytes every key shares. Stable. Negative floats sort before positive
+* ones, -0 before +0, and NaNs to the ends. Scratch the size of the array
+* comes from the array's allocator.
+*/
+void eng_ArrayRadixSort(eng_Array* array, eng_SortKey keyType, uint32_t keyOffset);
+
+/**
+* Array Sort
+*
+* Stable merge sort by compare. With jobs the array is split into chunks
+* sorted on the job pool, which are then merged in parallel pairs; jobs
+* may be NULL to sort on the calling thread. Scratch the size of the array
+* comes from the array's allocator, which must be thread safe if jobs is
+* given. compare must be safe to call from several threads.
+*/
+void eng_ArraySort(eng_Array* array, eng_CompareFunc_t compare, void* userData, eng_JobPool* jobs);
+
+// The searches below expect the array sorted ascending, and don't branch
+// on comparison results, so they run at a steady speed on large arrays.
+
+/** @returns the index of the first element not ordered before key, or Count. */
+uint32_t eng_ArrayLowerBound(eng_Array* array, const void* key, eng_CompareFunc_t compare, void* userData);
+
+/** @returns the index of the first element ordered after key, or Count. */
+uint32_t eng_ArrayUpperBound(eng_Array* array, const void* key, eng_CompareFunc_t compare, void* userData);
+
+/** eng_ArrayLowerBound by the keyType key keyOffset bytes into each element. key points to a keyType value. */
+uint32_t eng_ArrayLowerBoundKey(eng_Array* array, eng_SortKey keyType, uint32_t keyOffset, const void* key);
+
+/** eng_ArrayUpperBound by the keyType key keyOffset bytes into each element. key points to a keyType value. */
+uint32_t eng_ArrayUpperBoundKey(eng_Array* array, eng_SortKey keyType, uint32_t keyOffset, const void* key);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
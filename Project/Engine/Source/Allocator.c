@@ -0,0 +1,135 @@
+#include <Engine/Allocator.h>
+
+#include <Engine/Atomic.h>
+
+#include <stdlib.h>
+#include <string.h>
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+void* eng_HeapAlloc(void* userData, size_t size, size_t alignment);
+void* eng_HeapRealloc(void* userData, void* ptr, size_t oldSize, size_t newSize, size_t alignment);
+void eng_HeapFree(void* userData, void* ptr, size_t size);
+
+static ENG_THREAD_LOCAL const char* t_CallsiteFile;
+static ENG_THREAD_LOCAL int t_CallsiteLine;
+
+static const eng_Allocator s_HeapAllocator = {
+	.Alloc = eng_HeapAlloc,
+	.Realloc = eng_HeapRealloc,
+	.Free = eng_HeapFree,
+	.UserData = NULL,
+};
+
+////////////////////////////////////////////////////////////////////////// Allocator API
+const eng_Allocator* eng_AllocatorGetHeap(void)
+{
+	return &s_HeapAllocator;
+}
+
+void* eng_AllocatorAllocAt(const eng_Allocator* allocator, size_t size, size_t alignment, const char* file, int line)
+{
+	if (allocator == NULL)
+	{
+		allocator = &s_HeapAllocator;
+	}
+	t_CallsiteFile = file;
+	t_CallsiteLine = line;
+	return allocator->Alloc(allocator->UserData, size, alignment);
+}
+
+void* eng_AllocatorCallocAt(const eng_Allocator* allocator, size_t count, size_t size, size_t alignment, const char* file, int line)
+{
+	if (size != 0 && count > SIZE_MAX / size)
+	{
+		return NULL;
+	}
+	void* ptr = eng_AllocatorAllocAt(allocator, count * size, alignment, file, line);
+	if (ptr != NULL)
+	{
+		memset(ptr, 0, count * size);
+	}
+	return ptr;
+}
+
+void* eng_AllocatorReallocAt(const eng_Allocator* allocator, void* ptr, size_t oldSize, size_t newSize, size_t alignment, const char* file, int line)
+{
+	if (allocator == NULL)
+	{
+		allocator = &s_HeapAllocator;
+	}
+	t_CallsiteFile = file;
+	t_CallsiteLine = line;
+	if (ptr == NULL)
+	{
+		return allocator->Alloc(allocator->UserData, newSize, alignment);
+	}
+	return allocator->Realloc(allocator->UserData, ptr, oldSize, newSize, alignment);
+}
+
+void eng_AllocatorFree(const eng_Allocator* allocator, void* ptr, size_t size)
+{
+	if (ptr == NULL)
+	{
+		return;
+	}
+	if (allocator == NULL)
+	{
+		allocator = &s_HeapAllocator;
+	}
+	allocator->Free(allocator->UserData, ptr, size);
+}
+
+void eng_AllocatorGetCallsite(const char** outFile, int* outLine)
+{
+	*outFile = t_CallsiteFile;
+	*outLine = t_CallsiteLine;
+	// Allocators calling their own backing allocator directly shouldn't
+	// inherit a stale callsite.
+	t_CallsiteFile = NULL;
+	t_CallsiteLine = 0;
+}
+
+////////////////////////////////////////////////////////////////////////// Internal
+void* eng_HeapAlloc(void* userData, size_t size, size_t alignment)
+{
+#if defined(_MSC_VER)
+	return _aligned_malloc(size, alignment);
+#else
+	if (alignment <= ENG_ALLOCATOR_DEFAULT_ALIGNMENT)
+	{
+		return malloc(size);
+	}
+	void* ptr = NULL;
+	return posix_memalign(&ptr, alignment, size) == 0 ? ptr : NULL;
+#endif
+}
+
+void* eng_HeapRealloc(void* userData, void* ptr, size_t oldSize, size_t newSize, size_t alignment)
+{
+#if defined(_MSC_VER)
+	return _aligned_realloc(ptr, newSize, alignment);
+#else
+	if (alignment <= ENG_ALLOCATOR_DEFAULT_ALIGNMENT)
+	{
+		return realloc(ptr, newSize);
+	}
+	void* newPtr = eng_HeapAlloc(userData, newSize, alignment);
+	if (newPtr != NULL)
+	{
+		memcpy(newPtr, ptr, oldSize < newSize ? oldSize : newSize);
+		free(ptr);
+	}
+	return newPtr;
+#endif
+}
+
+void eng_HeapFree(void* userData, void* ptr, size_t size)
+{
+#if defined(_MSC_VER)
+	_aligned_free(ptr);
+#else
+	free(ptr);
+#endif
+}
\ No newline at end of file
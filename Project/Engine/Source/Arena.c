@@ -0,0 +1,267 @@
+#include <Engine/Arena.h>
+
+#include <Engine/Log.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct eng_ArenaBlock
+{
+	// Blocks after the current one are empty, kept for reuse.
+	struct eng_ArenaBlock* Next;
+	size_t Capacity;
+	size_t Used;
+} eng_ArenaBlock;
+
+typedef struct eng_Arena
+{
+	eng_Allocator Interface;
+	const eng_Allocator* Allocator;
+	size_t BlockSize;
+	eng_ArenaBlock* First;
+	eng_ArenaBlock* Current;
+} eng_Arena;
+
+eng_ArenaBlock* eng_ArenaBlockMalloc(eng_Arena* arena, size_t capacity);
+void eng_ArenaBlockFree(eng_Arena* arena, eng_ArenaBlock* block);
+uint8_t* eng_ArenaBlockData(eng_ArenaBlock* block);
+// @returns the offset in block an allocation would start at, or SIZE_MAX if it doesn't fit.
+size_t eng_ArenaBlockFit(eng_ArenaBlock* block, size_t size, size_t alignment);
+// @returns true if ptr is the most recent allocation in the current block.
+bool eng_ArenaIsTop(eng_Arena* arena, void* ptr, size_t size);
+void* eng_ArenaInterfaceAlloc(void* userData, size_t size, size_t alignment);
+void* eng_ArenaInterfaceRealloc(void* userData, void* ptr, size_t oldSize, size_t newSize, size_t alignment);
+void eng_ArenaInterfaceFree(void* userData, void* ptr, size_t size);
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+eng_Arena* eng_ArenaMalloc(void)
+{
+	return malloc(sizeof(eng_Arena));
+}
+
+bool eng_ArenaInit(eng_Arena* arena, size_t blockSize, const eng_Allocator* allocator)
+{
+	memset(arena, 0, sizeof(eng_Arena));
+	arena->Interface.Alloc = eng_ArenaInterfaceAlloc;
+	arena->Interface.Realloc = eng_ArenaInterfaceRealloc;
+	arena->Interface.Free = eng_ArenaInterfaceFree;
+	arena->Interface.UserData = arena;
+	arena->Allocator = allocator;
+	arena->BlockSize = blockSize;
+	arena->First = eng_ArenaBlockMalloc(arena, blockSize);
+	arena->Current = arena->First;
+	return arena->First != NULL;
+}
+
+void eng_ArenaFree(eng_Arena* arena, bool subAllocationsOnly)
+{
+	if (arena == NULL)
+	{
+		return;
+	}
+
+	eng_ArenaBlock* block = arena->First;
+	while (block != NULL)
+	{
+		eng_ArenaBlock* next = block->Next;
+		eng_ArenaBlockFree(arena, block);
+		block = next;
+	}
+
+	if (!subAllocationsOnly)
+	{
+		free(arena);
+	}
+}
+
+size_t eng_ArenaGetSizeof(void)
+{
+	return sizeof(eng_Arena);
+}
+
+////////////////////////////////////////////////////////////////////////// Arena API
+void* eng_ArenaAlloc(eng_Arena* arena, size_t size, size_t alignment)
+{
+	if (!eng_Ensure(alignment != 0 && (alignment & (alignment - 1)) == 0, "Arena alignment %zu isn't a power of two.\n", alignment))
+	{
+		return NULL;
+	}
+
+	eng_ArenaBlock* block = arena->Current;
+	size_t offset = eng_ArenaBlockFit(block, size, alignment);
+	if (offset == SIZE_MAX)
+	{
+		// Move on to the next kept block if it fits, otherwise chain a new
+		// one in ahead of it so the kept block stays around for later.
+		block = arena->Current->Next;
+		offset = block != NULL ? eng_ArenaBlockFit(block, size, alignment) : SIZE_MAX;
+		if (offset == SIZE_MAX)
+		{
+			size_t capacity = size + alignment > arena->BlockSize ? size + alignment : arena->BlockSize;
+			block = eng_ArenaBlockMalloc(arena, capacity);
+			if (block == NULL)
+			{
+				return NULL;
+			}
+			block->Next = arena->Current->Next;
+			arena->Current->Next = block;
+			offset = eng_ArenaBlockFit(block, size, alignment);
+		}
+		arena->Current = block;
+	}
+
+	block->Used = offset + size;
+	return eng_ArenaBlockData(block) + offset;
+}
+
+void* eng_ArenaCalloc(eng_Arena* arena, size_t count, size_t size, size_t alignment)
+{
+	if (size != 0 && count > SIZE_MAX / size)
+	{
+		return NULL;
+	}
+	void* ptr = eng_ArenaAlloc(arena, count * size, alignment);
+	if (ptr != NULL)
+	{
+		memset(ptr, 0, count * size);
+	}
+	return ptr;
+}
+
+eng_ArenaMarker eng_ArenaGetMarker(eng_Arena* arena)
+{
+	const eng_ArenaMarker marker = {
+		.Block = arena->Current,
+		.Offset = arena->Current->Used,
+	};
+	return marker;
+}
+
+void eng_ArenaReset(eng_Arena* arena, eng_ArenaMarker marker)
+{
+	for (eng_ArenaBlock* block = marker.Block->Next; block != NULL; block = block->Next)
+	{
+		block->Used = 0;
+	}
+	marker.Block->Used = marker.Offset;
+	arena->Current = marker.Block;
+}
+
+void eng_ArenaClear(eng_Arena* arena)
+{
+	const eng_ArenaMarker start = {
+		.Block = arena->First,
+		.Offset = 0,
+	};
+	eng_ArenaReset(arena, start);
+}
+
+size_t eng_ArenaGetUsed(eng_Arena* arena)
+{
+	size_t used = 0;
+	for (eng_ArenaBlock* block = arena->First; block != NULL; block = block->Next)
+	{
+		used += block->Used;
+	}
+	return used;
+}
+
+size_t eng_ArenaGetCapacity(eng_Arena* arena)
+{
+	size_t capacity = 0;
+	for (eng_ArenaBlock* block = arena->First; block != NULL; block = block->Next)
+	{
+		capacity += block->Capacity;
+	}
+	return capacity;
+}
+
+uint32_t eng_ArenaGetBlockCount(eng_Arena* arena)
+{
+	uint32_t count = 0;
+	for (eng_ArenaBlock* block = arena->First; block != NULL; block = block->Next)
+	{
+		++count;
+	}
+	return count;
+}
+
+const eng_Allocator* eng_ArenaGetAllocator(eng_Arena* arena)
+{
+	return &arena->Interface;
+}
+
+////////////////////////////////////////////////////////////////////////// Internal
+eng_ArenaBlock* eng_ArenaBlockMalloc(eng_Arena* arena, size_t capacity)
+{
+	eng_ArenaBlock* block = eng_AllocatorAlloc(arena->Allocator, sizeof(eng_ArenaBlock) + capacity, ENG_ALLOCATOR_DEFAULT_ALIGNMENT);
+	if (block != NULL)
+	{
+		block->Next = NULL;
+		block->Capacity = capacity;
+		block->Used = 0;
+	}
+	return block;
+}
+
+uint8_t* eng_ArenaBlockData(eng_ArenaBlock* block)
+{
+	return (uint8_t*)(block + 1);
+}
+
+size_t eng_ArenaBlockFit(eng_ArenaBlock* block, size_t size, size_t alignment)
+{
+	uintptr_t start = (uintptr_t)eng_ArenaBlockData(block) + block->Used;
+	size_t offset = block->Used + (size_t)((alignment - (start & (alignment - 1))) & (alignment - 1));
+	if (offset > block->Capacity || size > block->Capacity - offset)
+	{
+		return SIZE_MAX;
+	}
+	return offset;
+}
+
+void eng_ArenaBlockFree(eng_Arena* arena, eng_ArenaBlock* block)
+{
+	eng_AllocatorFree(arena->Allocator, block, sizeof(eng_ArenaBlock) + block->Capacity);
+}
+
+bool eng_ArenaIsTop(eng_Arena* arena, void* ptr, size_t size)
+{
+	eng_ArenaBlock* block = arena->Current;
+	return (uint8_t*)ptr + size == eng_ArenaBlockData(block) + block->Used && (uint8_t*)ptr >= eng_ArenaBlockData(block);
+}
+
+void* eng_ArenaInterfaceAlloc(void* userData, size_t size, size_t alignment)
+{
+	return eng_ArenaAlloc(userData, size, alignment);
+}
+
+void* eng_ArenaInterfaceRealloc(void* userData, void* ptr, size_t oldSize, size_t newSize, size_t alignment)
+{
+	eng_Arena* arena = userData;
+	if (eng_ArenaIsTop(arena, ptr, oldSize))
+	{
+		size_t offset = (size_t)((uint8_t*)ptr - eng_ArenaBlockData(arena->Current));
+		if (newSize <= arena->Current->Capacity - offset)
+		{
+			arena->Current->Used = offset + newSize;
+			return ptr;
+		}
+	}
+
+	void* newPtr = eng_ArenaAlloc(arena, newSize, alignment);
+	if (newPtr != NULL)
+	{
+		memcpy(newPtr, ptr, oldSize < newSize ? oldSize : newSize);
+	}
+	return newPtr;
+}
+
+void eng_ArenaInterfaceFree(void* userData, void* ptr, size_t size)
+{
+	eng_Arena* arena = userData;
+	if (eng_ArenaIsTop(arena, ptr, size))
+	{
+		arena->Current->Used = (size_t)((uint8_t*)ptr - eng_ArenaBlockData(arena->Current));
+	}
+}
\ No newline at end of file
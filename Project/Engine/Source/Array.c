@@ -1,54 +1,138 @@
 #include <Engine/Array.h>
 
+#include <Engine/Bits.h>
 #include <Engine/Log.h>
+#include <Engine/VirtualMemory.h>
 
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define ENG_ARRAY_SSE2 1
+#endif
+
 // This was not some carefully selected decision
 // If you have a better idea about array growth rates you should propose it.
 #define INITIAL_ARRAY_SIZE 4
-#define GROWTH_PER_EXCESS 2.0
+
+// Slides runs of kept elements down over removed ones.
+typedef struct eng_ArrayCompactor
+{
+	char* Buffer;
+	size_t TypeSize;
+	// Where the next kept run goes.
+	uint32_t Write;
+	// The first kept element not yet moved.
+	uint32_t RunStart;
+} eng_ArrayCompactor;
+
+eng_ArrayCompactor eng_ArrayCompactorBegin(eng_Array* array);
+// Marks index, at or after every index marked before it, as removed.
+void eng_ArrayCompactorRemove(eng_ArrayCompactor* compactor, uint32_t index);
+// Moves the last run and sets the array's new count. @returns how many were removed.
+uint32_t eng_ArrayCompactorEnd(eng_ArrayCompactor* compactor, eng_Array* array);
+
+// Moves the contents into a buffer of bufferSize bytes.
+void eng_ArrayReallocate(eng_Array* array, size_t bufferSize);
+// @returns the buffer size to grow to, per the array's growth policy, to fit at least required bytes.
+size_t eng_ArrayGetGrowSize(eng_Array* array, size_t required);
+
+eng_ArrayGrowth eng_ArrayGetDefaultGrowth(void)
+{
+	eng_ArrayGrowth growth = {
+		.Percent = 200,
+		.MinimumStep = 0,
+		.RoundTo = 0,
+	};
+	return growth;
+}
 
 void eng_ArrayInit(eng_Array* array, uint32_t typeSize)
 {
+	eng_ArrayInitAllocator(array, typeSize, NULL);
+}
+
+void eng_ArrayInitAllocator(eng_Array* array, uint32_t typeSize, const eng_Allocator* allocator)
+{
+	array->Allocator = allocator;
 	array->TypeSize = typeSize;
 	array->Count = 0;
-	array->BufferSize = INITIAL_ARRAY_SIZE * typeSize;
-	array->Buffer = ENG_ARRAY_CALLOC(array->BufferSize, array->TypeSize);
+	array->Storage = ENG_ARRAY_STORAGE_ALLOCATOR;
+	array->HugePages = false;
+	array->ReservedSize = 0;
+	array->Growth = NULL;
+	array->BufferSize = (size_t)INITIAL_ARRAY_SIZE * typeSize;
+	// BufferSize is already in bytes.
+	array->Buffer = eng_AllocatorCalloc(array->Allocator, array->BufferSize, 1, ENG_ALLOCATOR_DEFAULT_ALIGNMENT);
+}
+
+void eng_ArrayInitInline(eng_Array* array, uint32_t typeSize, void* buffer, size_t bufferSize, const eng_Allocator* allocator)
+{
+	array->Allocator = allocator;
+	array->TypeSize = typeSize;
+	array->Count = 0;
+	array->Storage = ENG_ARRAY_STORAGE_INLINE;
+	array->HugePages = false;
+	array->ReservedSize = 0;
+	array->Growth = NULL;
+	array->BufferSize = bufferSize;
+	array->Buffer = buffer;
+}
+
+bool eng_ArrayInitVirtual(eng_Array* array, uint32_t typeSize, size_t maxCount, bool hugePages)
+{
+	size_t pageSize = eng_VirtualGetPageSize(hugePages);
+	array->Allocator = NULL;
+	array->TypeSize = typeSize;
+	array->Count = 0;
+	array->Storage = ENG_ARRAY_STORAGE_VIRTUAL;
+	array->HugePages = hugePages;
+	array->ReservedSize = (maxCount * typeSize + pageSize - 1) & ~(pageSize - 1);
+	array->Growth = NULL;
+	array->BufferSize = 0;
+	array->Buffer = eng_VirtualReserve(array->ReservedSize, hugePages);
+	return array->Buffer != NULL;
 }
 
 void eng_ArrayDestroy(eng_Array* array)
 {
-	free(array->Buffer);
+	switch (array->Storage)
+	{
+	case ENG_ARRAY_STORAGE_ALLOCATOR:
+		eng_AllocatorFree(array->Allocator, array->Buffer, array->BufferSize);
+		break;
+	case ENG_ARRAY_STORAGE_VIRTUAL:
+		if (array->Buffer != NULL)
+		{
+			eng_VirtualRelease(array->Buffer, array->ReservedSize);
+		}
+		break;
+	default:
+		break;
+	}
 }
 
-void eng_ArrayReserve(eng_Array* array, uint32_t reservation)
+void eng_ArraySetGrowth(eng_Array* array, const eng_ArrayGrowth* growth)
 {
+	array->Growth = growth;
+}
+
+void eng_ArrayReserve(eng_Array* array, size_t elementsToReserve)
+{
+	size_t reservation = elementsToReserve * array->TypeSize;
 #if !defined(GAME_FINAL)
 	if (array->BufferSize == reservation)
 	{
 		eng_DevFatal("Reserving an array to the size it's already at is redundant.\n");
 		return;
 	}
-	else 
-#endif
-	if (array->BufferSize < reservation)
+	if (elementsToReserve < array->Count)
 	{
-		array->Buffer = ENG_ARRAY_REALLOC(array->Buffer, reservation);
-		array->BufferSize = reservation;
+		eng_DevFatal("Reserving an array to be smaller than its contents is invalid. Did you mean to resize then reserve?\n");
 	}
-	else
-	{
-#if !defined(GAME_FINAL)
-		if (reservation < array->Count)
-		{
-			eng_DevFatal("Reserving an array to be smaller than its contents is invalid. Did you mean to resize then reserve?\n");
-		}
 #endif
-		array->Buffer = ENG_ARRAY_REALLOC(array->Buffer, reservation);
-		array->BufferSize = reservation;
-	}
+	eng_ArrayReallocate(array, reservation);
 }
 
 void eng_ArrayResize(eng_Array* array, uint32_t newSize)
@@ -59,15 +143,13 @@ void eng_ArrayResize(eng_Array* array, uint32_t newSize)
 		eng_DevFatal("Array resize is redundant.");
 	}
 #endif	
-	if (newSize < array->Count)
-	{
-		array->Count = newSize;
-		// todo: re-reserve if delta is too great.
-	}
-	else
+	size_t requiredBufferSize = (size_t)newSize * array->TypeSize;
+	if (array->BufferSize < requiredBufferSize)
 	{
-		array->Count += newSize;
+		eng_ArrayReallocate(array, eng_ArrayGetGrowSize(array, requiredBufferSize));
 	}
+	// todo: re-reserve if shrinking by a great deal.
+	array->Count = newSize;
 }
 
 void* eng_ArrayIndex(eng_Array* array, uint32_t index)
@@ -78,7 +160,7 @@ void* eng_ArrayIndex(eng_Array* array, uint32_t index)
 		eng_DevFatal("Array index out of bounds");
 	}
 #endif
-	return (char*)array->Buffer + (intptr_t)(index * array->TypeSize);
+	return (char*)array->Buffer + (size_t)index * array->TypeSize;
 }
 
 uint32_t eng_ArrayPushBack(eng_Array* array, void* object)
@@ -89,19 +171,19 @@ uint32_t eng_ArrayPushBack(eng_Array* array, void* object)
 
 void eng_ArrayPushBackMany(eng_Array* array, void* objects, uint32_t count)
 {
+	// A wrapped count would slip past the buffer size check below.
+	if (!eng_Ensure(count <= UINT32_MAX - array->Count, "Can't push %u more elements onto an array of %u.\n", count, array->Count))
+	{
+		return;
+	}
 	uint32_t newCount = array->Count + count;
-	uint32_t requiredBufferSize = newCount * array->TypeSize;
+	size_t requiredBufferSize = (size_t)newCount * array->TypeSize;
 	if (array->BufferSize < requiredBufferSize)
 	{
-		double newBufferSize = (double)array->BufferSize;
-		do 
-		{
-			newBufferSize *= GROWTH_PER_EXCESS;
-		} while ((uint32_t)newBufferSize < requiredBufferSize);
-		eng_ArrayReserve(array, (uint32_t)newBufferSize);
+		eng_ArrayReallocate(array, eng_ArrayGetGrowSize(array, requiredBufferSize));
 	}
 
-	memcpy((char*)array->Buffer + (intptr_t)(array->Count * array->TypeSize), objects, count * array->TypeSize);
+	memcpy((char*)array->Buffer + (size_t)array->Count * array->TypeSize, objects, (size_t)count * array->TypeSize);
 	array->Count = newCount;
 }
 
@@ -113,7 +195,7 @@ void* eng_ArrayBegin(eng_Array* array)
 
 void* eng_ArrayEnd(eng_Array* array)
 {
-	return (char*)array->Buffer + (intptr_t)(array->Count * array->TypeSize);
+	return (char*)array->Buffer + (size_t)array->Count * array->TypeSize;
 }
 
 void eng_ArrayRemoveLastSwap(eng_Array* array, uint32_t index)
@@ -124,8 +206,8 @@ void eng_ArrayRemoveLastSwap(eng_Array* array, uint32_t index)
 		eng_DevFatal("Trying to remove an element that is not included in the array.");
 	}
 #endif
-	void* element = (char*)array->Buffer + (intptr_t)(index * array->TypeSize);
-	memcpy(element, (char*)array->Buffer + (intptr_t)(--array->Count * array->TypeSize), array->TypeSize);
+	void* element = (char*)array->Buffer + (size_t)index * array->TypeSize;
+	memcpy(element, (char*)array->Buffer + (size_t)--array->Count * array->TypeSize, array->TypeSize);
 }
 
 void eng_ArrayRemoveInPlace(eng_Array* array, uint32_t index)
@@ -136,7 +218,205 @@ void eng_ArrayRemoveInPlace(eng_Array* array, uint32_t index)
 		eng_DevFatal("Trying to remove an element that is not included in the array.");
 	}
 #endif
-	void* element = (char*)array->Buffer + (intptr_t)(index * array->TypeSize);
-	memcpy(element, (char*)element + (intptr_t)array->TypeSize, (size_t)((char*)eng_ArrayEnd(array)- (char*)element) - array->TypeSize);
-	--array->Count;
+	eng_ArrayRemoveRange(array, index, 1);
+}
+
+uint32_t eng_ArrayRemoveIf(eng_Array* array, eng_ArrayPredicate_t predicate, void* userData)
+{
+	eng_ArrayCompactor compactor = eng_ArrayCompactorBegin(array);
+	for (uint32_t i = 0; i < array->Count; ++i)
+	{
+		if (predicate(compactor.Buffer + i * compactor.TypeSize, userData))
+		{
+			eng_ArrayCompactorRemove(&compactor, i);
+		}
+	}
+	return eng_ArrayCompactorEnd(&compactor, array);
+}
+
+uint32_t eng_ArrayRemoveValue(eng_Array* array, const void* value)
+{
+	eng_ArrayCompactor compactor = eng_ArrayCompactorBegin(array);
+	uint32_t i = 0;
+#if defined(ENG_ARRAY_SSE2)
+	// Compare 16 bytes at a time, then only visit the matches.
+	if (array->TypeSize == 4 || array->TypeSize == 8)
+	{
+		uint32_t perBlock = 16 / array->TypeSize;
+		__m128i needle;
+		if (array->TypeSize == 4)
+		{
+			int32_t value32;
+			memcpy(&value32, value, sizeof(value32));
+			needle = _mm_set1_epi32(value32);
+		}
+		else
+		{
+			int64_t value64;
+			memcpy(&value64, value, sizeof(value64));
+			needle = _mm_set_epi64x(value64, value64);
+		}
+		for (; i + perBlock <= array->Count; i += perBlock)
+		{
+			__m128i equal = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(compactor.Buffer + i * compactor.TypeSize)), needle);
+			uint32_t mask;
+			if (array->TypeSize == 4)
+			{
+				mask = (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(equal));
+			}
+			else
+			{
+				// An 8 byte element matches when both of its halves do.
+				equal = _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1)));
+				mask = (uint32_t)_mm_movemask_pd(_mm_castsi128_pd(equal));
+			}
+			while (mask != 0)
+			{
+				eng_ArrayCompactorRemove(&compactor, i + eng_BitScanForward32(mask));
+				mask &= mask - 1;
+			}
+		}
+	}
+#endif
+	for (; i < array->Count; ++i)
+	{
+		if (memcmp(compactor.Buffer + i * compactor.TypeSize, value, compactor.TypeSize) == 0)
+		{
+			eng_ArrayCompactorRemove(&compactor, i);
+		}
+	}
+	return eng_ArrayCompactorEnd(&compactor, array);
+}
+
+void eng_ArrayRemoveRange(eng_Array* array, uint32_t first, uint32_t count)
+{
+#if !defined(GAME_FINAL)
+	if (first > array->Count || count > array->Count - first)
+	{
+		eng_DevFatal("Trying to remove elements that are not included in the array.");
+		return;
+	}
+#endif
+	char* element = (char*)array->Buffer + (size_t)first * array->TypeSize;
+	memmove(element, element + (size_t)count * array->TypeSize, (size_t)(array->Count - first - count) * array->TypeSize);
+	array->Count -= count;
+}
+
+void eng_ArrayRemoveIndices(eng_Array* array, const uint32_t* indices, uint32_t count)
+{
+	eng_ArrayCompactor compactor = eng_ArrayCompactorBegin(array);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+#if !defined(GAME_FINAL)
+		if (indices[i] >= array->Count || (i > 0 && indices[i] <= indices[i - 1]))
+		{
+			eng_DevFatal("Indices to remove must be in the array, ascending and unique.");
+			break;
+		}
+#endif
+		eng_ArrayCompactorRemove(&compactor, indices[i]);
+	}
+	eng_ArrayCompactorEnd(&compactor, array);
+}
+
+////////////////////////////////////////////////////////////////////////// Internal
+eng_ArrayCompactor eng_ArrayCompactorBegin(eng_Array* array)
+{
+	eng_ArrayCompactor compactor = {
+		.Buffer = array->Buffer,
+		.TypeSize = array->TypeSize,
+		.Write = 0,
+		.RunStart = 0,
+	};
+	return compactor;
+}
+
+void eng_ArrayCompactorRemove(eng_ArrayCompactor* compactor, uint32_t index)
+{
+	uint32_t runLength = index - compactor->RunStart;
+	if (runLength > 0 && compactor->Write != compactor->RunStart)
+	{
+		memmove(compactor->Buffer + compactor->Write * compactor->TypeSize, compactor->Buffer + compactor->RunStart * compactor->TypeSize,
+			runLength * compactor->TypeSize);
+	}
+	compactor->Write += runLength;
+	compactor->RunStart = index + 1;
+}
+
+uint32_t eng_ArrayCompactorEnd(eng_ArrayCompactor* compactor, eng_Array* array)
+{
+	uint32_t removed = compactor->RunStart - compactor->Write;
+	if (removed > 0)
+	{
+		eng_ArrayCompactorRemove(compactor, array->Count);
+		array->Count = compactor->Write;
+	}
+	return removed;
+}
+
+void eng_ArrayReallocate(eng_Array* array, size_t bufferSize)
+{
+	if (array->Storage == ENG_ARRAY_STORAGE_INLINE)
+	{
+		// The inline buffer is never shrunk, and once outgrown is left behind for good.
+		if (array->BufferSize < bufferSize)
+		{
+			void* buffer = eng_AllocatorAlloc(array->Allocator, bufferSize, ENG_ALLOCATOR_DEFAULT_ALIGNMENT);
+			memcpy(buffer, array->Buffer, (size_t)array->Count * array->TypeSize);
+			array->Buffer = buffer;
+			array->BufferSize = bufferSize;
+			array->Storage = ENG_ARRAY_STORAGE_ALLOCATOR;
+		}
+	}
+	else if (array->Storage == ENG_ARRAY_STORAGE_VIRTUAL)
+	{
+		// Commits or decommits whole pages at the end; nothing ever moves.
+		size_t pageSize = eng_VirtualGetPageSize(array->HugePages);
+		bufferSize = (bufferSize + pageSize - 1) & ~(pageSize - 1);
+		if (bufferSize > array->ReservedSize)
+		{
+			eng_Fatal("A virtual array outgrew the %zu bytes reserved for it.\n", array->ReservedSize);
+		}
+		if (bufferSize > array->BufferSize && !eng_VirtualCommit((char*)array->Buffer + array->BufferSize, bufferSize - array->BufferSize))
+		{
+			eng_Fatal("Out of memory committing %zu bytes for a virtual array.\n", bufferSize - array->BufferSize);
+		}
+		if (bufferSize < array->BufferSize)
+		{
+			eng_VirtualDecommit((char*)array->Buffer + bufferSize, array->BufferSize - bufferSize);
+		}
+		array->BufferSize = bufferSize;
+	}
+	else if (array->BufferSize != bufferSize)
+	{
+		array->Buffer = eng_AllocatorRealloc(array->Allocator, array->Buffer, array->BufferSize, bufferSize, ENG_ALLOCATOR_DEFAULT_ALIGNMENT);
+		array->BufferSize = bufferSize;
+	}
+}
+
+size_t eng_ArrayGetGrowSize(eng_Array* array, size_t required)
+{
+	eng_ArrayGrowth growth = array->Growth != NULL ? *array->Growth : eng_ArrayGetDefaultGrowth();
+	size_t size = array->BufferSize;
+	// Split so multi gigabyte buffers don't overflow the multiply.
+	size_t step = growth.Percent > 100 ? size / 100 * (growth.Percent - 100) + size % 100 * (growth.Percent - 100) / 100 : 0;
+	if (step < growth.MinimumStep)
+	{
+		step = growth.MinimumStep;
+	}
+	size = SIZE_MAX - size < step ? SIZE_MAX : size + step;
+	if (size < required)
+	{
+		size = required;
+	}
+	if (growth.RoundTo > 1)
+	{
+		size = (size + growth.RoundTo - 1) & ~(growth.RoundTo - 1);
+	}
+	// Growing into the last of a reservation is fine, growing past it isn't.
+	if (array->Storage == ENG_ARRAY_STORAGE_VIRTUAL && size > array->ReservedSize && required <= array->ReservedSize)
+	{
+		size = array->ReservedSize;
+	}
+	return size;
 }
\ No newline at end of file
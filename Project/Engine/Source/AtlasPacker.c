@@ -0,0 +1,490 @@
+#include <Engine/AtlasPacker.h>
+
+#include <Engine/Allocator.h>
+#include <Engine/Array.h>
+#include <Engine/Log.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+// A page's free space is rebuilt once this fraction of it has been removed.
+#define REBUILD_FRACTION 16
+
+typedef struct eng_AtlasSpace
+{
+	uint32_t X;
+	uint32_t Y;
+	uint32_t Width;
+	uint32_t Height;
+} eng_AtlasSpace;
+
+typedef struct eng_AtlasPage
+{
+	// Maximal free rectangles. They overlap; every free texel is in at
+	// least one, and none is contained in another.
+	eng_ArrayDecl(FreeSpaces, eng_AtlasSpace);
+	uint64_t UsedArea;
+	uint32_t EntryCount;
+	// Area of entries removed since FreeSpaces was last rebuilt. Until then
+	// it may be missing maximal rectangles spanning freed and free space.
+	uint64_t FreedArea;
+} eng_AtlasPage;
+
+typedef struct eng_AtlasEntry
+{
+	eng_AtlasRect Rect;
+	bool Used;
+} eng_AtlasEntry;
+
+typedef struct eng_AtlasSortItem
+{
+	uint32_t Width;
+	uint32_t Height;
+	uint32_t Index;
+} eng_AtlasSortItem;
+
+typedef struct eng_AtlasPacker
+{
+	uint32_t PageWidth;
+	uint32_t PageHeight;
+	uint32_t Padding;
+	uint32_t MaxPages;
+	const eng_Allocator* Allocator;
+	eng_ArrayDecl(Pages, eng_AtlasPage);
+	eng_ArrayDecl(Entries, eng_AtlasEntry);
+	// Indices of unused Entries.
+	eng_ArrayDecl(FreeEntries, uint32_t);
+	// Scratch for the pieces free space is split into while placing.
+	eng_ArrayDecl(SplitSpaces, eng_AtlasSpace);
+} eng_AtlasPacker;
+
+eng_AtlasPage* eng_AtlasPackerOpenPage(eng_AtlasPacker* packer);
+void eng_AtlasPackerResetPage(eng_AtlasPacker* packer, eng_AtlasPage* page);
+bool eng_AtlasPackerFindSpace(eng_AtlasPage* page, uint32_t width, uint32_t height, eng_AtlasSpace* outSpace);
+void eng_AtlasPackerOccupy(eng_AtlasPacker* packer, eng_AtlasPage* page, const eng_AtlasSpace* used);
+void eng_AtlasPackerRebuildPage(eng_AtlasPacker* packer, uint32_t pageIndex);
+void eng_AtlasPackerPruneFree(eng_AtlasPage* page, eng_Array* split);
+uint32_t eng_AtlasPackerStore(eng_AtlasPacker* packer, uint32_t pageIndex, const eng_AtlasSpace* space);
+bool eng_AtlasSpaceContains(const eng_AtlasSpace* outer, const eng_AtlasSpace* inner);
+int eng_AtlasSortItemCompare(const void* a, const void* b);
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+eng_AtlasPacker* eng_AtlasPackerMalloc(void)
+{
+	return malloc(sizeof(eng_AtlasPacker));
+}
+
+bool eng_AtlasPackerInit(eng_AtlasPacker* packer, uint32_t pageWidth, uint32_t pageHeight, uint32_t padding, uint32_t maxPages, const eng_Allocator* allocator)
+{
+	memset(packer, 0, sizeof(eng_AtlasPacker));
+	packer->Allocator = allocator;
+	packer->PageWidth = pageWidth;
+	packer->PageHeight = pageHeight;
+	packer->Padding = padding;
+	packer->MaxPages = maxPages;
+	eng_ArrayInitAllocatorType(&packer->Pages, eng_AtlasPage, allocator);
+	eng_ArrayInitAllocatorType(&packer->Entries, eng_AtlasEntry, allocator);
+	eng_ArrayInitAllocatorType(&packer->FreeEntries, uint32_t, allocator);
+	eng_ArrayInitAllocatorType(&packer->SplitSpaces, eng_AtlasSpace, allocator);
+
+	return eng_Ensure(pageWidth > padding && pageHeight > padding && maxPages > 0,
+		"Atlas pages of %ux%u with %u padding can't hold anything.\n", pageWidth, pageHeight, padding);
+}
+
+void eng_AtlasPackerFree(eng_AtlasPacker* packer, bool subAllocationsOnly)
+{
+	if (packer == NULL)
+	{
+		return;
+	}
+
+	for (uint32_t i = 0; i < packer->Pages.Count; ++i)
+	{
+		eng_ArrayDestroy(&eng_ArrayPIndexType(&packer->Pages, eng_AtlasPage, i)->FreeSpaces);
+	}
+	eng_ArrayDestroy(&packer->Pages);
+	eng_ArrayDestroy(&packer->Entries);
+	eng_ArrayDestroy(&packer->FreeEntries);
+	eng_ArrayDestroy(&packer->SplitSpaces);
+
+	if (!subAllocationsOnly)
+	{
+		free(packer);
+	}
+}
+
+size_t eng_AtlasPackerGetSizeof(void)
+{
+	return sizeof(eng_AtlasPacker);
+}
+
+////////////////////////////////////////////////////////////////////////// Atlas Packer API
+uint32_t eng_AtlasPackerAdd(eng_AtlasPacker* packer, uint32_t width, uint32_t height, eng_AtlasRect* outRect)
+{
+	uint32_t paddedWidth = width + packer->Padding;
+	uint32_t paddedHeight = height + packer->Padding;
+	if (width == 0 || height == 0 || paddedWidth > packer->PageWidth || paddedHeight > packer->PageHeight)
+	{
+		return ENG_ATLAS_INVALID_ENTRY;
+	}
+
+	// Rebuilding costs about as much as re-adding every entry on the page, so
+	// it waits until enough has been freed to make it worthwhile.
+	uint64_t rebuildArea = (uint64_t)packer->PageWidth * packer->PageHeight / REBUILD_FRACTION;
+	eng_AtlasSpace space;
+	uint32_t pageIndex = 0;
+	for (; pageIndex < packer->Pages.Count; ++pageIndex)
+	{
+		eng_AtlasPage* page = eng_ArrayPIndexType(&packer->Pages, eng_AtlasPage, pageIndex);
+		if (eng_AtlasPackerFindSpace(page, paddedWidth, paddedHeight, &space))
+		{
+			break;
+		}
+		if (page->FreedArea >= rebuildArea)
+		{
+			eng_AtlasPackerRebuildPage(packer, pageIndex);
+			if (eng_AtlasPackerFindSpace(page, paddedWidth, paddedHeight, &space))
+			{
+				break;
+			}
+		}
+	}
+	if (pageIndex == packer->Pages.Count)
+	{
+		// A fresh page always fits anything that passed the size check.
+		eng_AtlasPage* page = eng_AtlasPackerOpenPage(packer);
+		if (page == NULL)
+		{
+			return ENG_ATLAS_INVALID_ENTRY;
+		}
+		eng_AtlasPackerFindSpace(page, paddedWidth, paddedHeight, &space);
+	}
+
+	eng_AtlasPackerOccupy(packer, eng_ArrayPIndexType(&packer->Pages, eng_AtlasPage, pageIndex), &space);
+	uint32_t entry = eng_AtlasPackerStore(packer, pageIndex, &space);
+	if (outRect != NULL)
+	{
+		eng_AtlasPackerGetRect(packer, entry, outRect);
+	}
+	return entry;
+}
+
+uint32_t eng_AtlasPackerAddMany(eng_AtlasPacker* packer, const uint32_t* sizes, uint32_t count, uint32_t* outEntries)
+{
+	eng_AtlasSortItem* items = eng_AllocatorAllocType(packer->Allocator, eng_AtlasSortItem, count);
+	if (!eng_Ensure(items != NULL || count == 0, "Out of memory sorting %u atlas entries.\n", count))
+	{
+		return 0;
+	}
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		items[i] = (eng_AtlasSortItem){ sizes[i * 2], sizes[i * 2 + 1], i };
+	}
+	qsort(items, count, sizeof(eng_AtlasSortItem), eng_AtlasSortItemCompare);
+
+	uint32_t placed = 0;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		uint32_t entry = eng_AtlasPackerAdd(packer, items[i].Width, items[i].Height, NULL);
+		outEntries[items[i].Index] = entry;
+		placed += entry != ENG_ATLAS_INVALID_ENTRY ? 1 : 0;
+	}
+
+	eng_AllocatorFreeType(packer->Allocator, items, eng_AtlasSortItem, count);
+	return placed;
+}
+
+uint32_t eng_AtlasPackerAddAt(eng_AtlasPacker* packer, const eng_AtlasRect* rect)
+{
+	const eng_AtlasSpace space = {
+		.X = rect->X,
+		.Y = rect->Y,
+		.Width = rect->Width + packer->Padding,
+		.Height = rect->Height + packer->Padding,
+	};
+	if (rect->Width == 0 || rect->Height == 0 || rect->Page >= packer->MaxPages)
+	{
+		return ENG_ATLAS_INVALID_ENTRY;
+	}
+	while (packer->Pages.Count <= rect->Page)
+	{
+		eng_AtlasPackerOpenPage(packer);
+	}
+
+	// Any free area lies wholly inside one of the maximal free rectangles,
+	// as long as nothing was freed since they were built.
+	eng_AtlasPage* page = eng_ArrayPIndexType(&packer->Pages, eng_AtlasPage, rect->Page);
+	if (page->FreedArea > 0)
+	{
+		eng_AtlasPackerRebuildPage(packer, rect->Page);
+	}
+	for (uint32_t i = 0; i < page->FreeSpaces.Count; ++i)
+	{
+		if (eng_AtlasSpaceContains(eng_ArrayPIndexType(&page->FreeSpaces, eng_AtlasSpace, i), &space))
+		{
+			eng_AtlasPackerOccupy(packer, page, &space);
+			return eng_AtlasPackerStore(packer, rect->Page, &space);
+		}
+	}
+	return ENG_ATLAS_INVALID_ENTRY;
+}
+
+bool eng_AtlasPackerRemove(eng_AtlasPacker* packer, uint32_t entry)
+{
+	if (entry >= packer->Entries.Count || !eng_ArrayPIndexType(&packer->Entries, eng_AtlasEntry, entry)->Used)
+	{
+		return false;
+	}
+
+	eng_AtlasEntry* atlasEntry = eng_ArrayPIndexType(&packer->Entries, eng_AtlasEntry, entry);
+	atlasEntry->Used = false;
+	eng_ArrayPushBack(&packer->FreeEntries, &entry);
+
+	eng_AtlasPage* page = eng_ArrayPIndexType(&packer->Pages, eng_AtlasPage, atlasEntry->Rect.Page);
+	eng_AtlasSpace space = {
+		.X = atlasEntry->Rect.X,
+		.Y = atlasEntry->Rect.Y,
+		.Width = atlasEntry->Rect.Width + packer->Padding,
+		.Height = atlasEntry->Rect.Height + packer->Padding,
+	};
+	page->UsedArea -= (uint64_t)space.Width * space.Height;
+	if (--page->EntryCount == 0)
+	{
+		eng_AtlasPackerResetPage(packer, page);
+		return true;
+	}
+
+	// Splitting free space is cheap but merging it back into maximal
+	// rectangles isn't. The freed space is kept as is, and the page is
+	// rebuilt from its entries only once an add doesn't fit.
+	packer->SplitSpaces.Count = 0;
+	eng_ArrayPushBack(&packer->SplitSpaces, &space);
+	eng_AtlasPackerPruneFree(page, &packer->SplitSpaces);
+	page->FreedArea += (uint64_t)space.Width * space.Height;
+	return true;
+}
+
+bool eng_AtlasPackerGetRect(eng_AtlasPacker* packer, uint32_t entry, eng_AtlasRect* outRect)
+{
+	if (entry >= packer->Entries.Count || !eng_ArrayPIndexType(&packer->Entries, eng_AtlasEntry, entry)->Used)
+	{
+		return false;
+	}
+	*outRect = eng_ArrayPIndexType(&packer->Entries, eng_AtlasEntry, entry)->Rect;
+	return true;
+}
+
+uint32_t eng_AtlasPackerGetPageCount(eng_AtlasPacker* packer)
+{
+	return packer->Pages.Count;
+}
+
+float eng_AtlasPackerGetOccupancy(eng_AtlasPacker* packer, uint32_t page)
+{
+	if (page >= packer->Pages.Count)
+	{
+		return 0.0f;
+	}
+	return (float)((double)eng_ArrayPIndexType(&packer->Pages, eng_AtlasPage, page)->UsedArea / ((double)packer->PageWidth * packer->PageHeight));
+}
+
+////////////////////////////////////////////////////////////////////////// Internal
+eng_AtlasPage* eng_AtlasPackerOpenPage(eng_AtlasPacker* packer)
+{
+	if (packer->Pages.Count >= packer->MaxPages)
+	{
+		return NULL;
+	}
+
+	eng_AtlasPage page;
+	memset(&page, 0, sizeof(eng_AtlasPage));
+	eng_ArrayInitAllocatorType(&page.FreeSpaces, eng_AtlasSpace, packer->Allocator);
+	uint32_t index = eng_ArrayPushBack(&packer->Pages, &page);
+	eng_AtlasPage* opened = eng_ArrayPIndexType(&packer->Pages, eng_AtlasPage, index);
+	eng_AtlasPackerResetPage(packer, opened);
+	return opened;
+}
+
+void eng_AtlasPackerResetPage(eng_AtlasPacker* packer, eng_AtlasPage* page)
+{
+	eng_AtlasSpace whole = { 0, 0, packer->PageWidth, packer->PageHeight };
+	page->FreeSpaces.Count = 0;
+	eng_ArrayPushBack(&page->FreeSpaces, &whole);
+	page->UsedArea = 0;
+	page->EntryCount = 0;
+	page->FreedArea = 0;
+}
+
+bool eng_AtlasPackerFindSpace(eng_AtlasPage* page, uint32_t width, uint32_t height, eng_AtlasSpace* outSpace)
+{
+	// Best short side fit: the free rectangle leaving the thinnest sliver.
+	uint32_t bestShortSide = UINT32_MAX;
+	uint32_t bestLongSide = UINT32_MAX;
+	for (uint32_t i = 0; i < page->FreeSpaces.Count; ++i)
+	{
+		const eng_AtlasSpace* candidate = eng_ArrayPIndexType(&page->FreeSpaces, eng_AtlasSpace, i);
+		if (candidate->Width < width || candidate->Height < height)
+		{
+			continue;
+		}
+
+		uint32_t leftoverX = candidate->Width - width;
+		uint32_t leftoverY = candidate->Height - height;
+		uint32_t shortSide = leftoverX < leftoverY ? leftoverX : leftoverY;
+		uint32_t longSide = leftoverX < leftoverY ? leftoverY : leftoverX;
+		if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide))
+		{
+			bestShortSide = shortSide;
+			bestLongSide = longSide;
+			*outSpace = (eng_AtlasSpace){ candidate->X, candidate->Y, width, height };
+		}
+	}
+	return bestShortSide != UINT32_MAX;
+}
+
+void eng_AtlasPackerOccupy(eng_AtlasPacker* packer, eng_AtlasPage* page, const eng_AtlasSpace* used)
+{
+	// Every free rectangle overlapping used is replaced by the up to four
+	// maximal rectangles around it; the rest are kept in place.
+	eng_Array* split = &packer->SplitSpaces;
+	split->Count = 0;
+	uint32_t kept = 0;
+	for (uint32_t i = 0; i < page->FreeSpaces.Count; ++i)
+	{
+		eng_AtlasSpace overlapped = eng_ArrayIndexType(&page->FreeSpaces, eng_AtlasSpace, i);
+		if (used->X >= overlapped.X + overlapped.Width || used->X + used->Width <= overlapped.X
+			|| used->Y >= overlapped.Y + overlapped.Height || used->Y + used->Height <= overlapped.Y)
+		{
+			eng_ArrayIndexType(&page->FreeSpaces, eng_AtlasSpace, kept++) = overlapped;
+			continue;
+		}
+
+		if (used->X > overlapped.X)
+		{
+			eng_AtlasSpace left = { overlapped.X, overlapped.Y, used->X - overlapped.X, overlapped.Height };
+			eng_ArrayPushBack(split, &left);
+		}
+		if (used->X + used->Width < overlapped.X + overlapped.Width)
+		{
+			eng_AtlasSpace right = { used->X + used->Width, overlapped.Y, overlapped.X + overlapped.Width - (used->X + used->Width), overlapped.Height };
+			eng_ArrayPushBack(split, &right);
+		}
+		if (used->Y > overlapped.Y)
+		{
+			eng_AtlasSpace top = { overlapped.X, overlapped.Y, overlapped.Width, used->Y - overlapped.Y };
+			eng_ArrayPushBack(split, &top);
+		}
+		if (used->Y + used->Height < overlapped.Y + overlapped.Height)
+		{
+			eng_AtlasSpace bottom = { overlapped.X, used->Y + used->Height, overlapped.Width, overlapped.Y + overlapped.Height - (used->Y + used->Height) };
+			eng_ArrayPushBack(split, &bottom);
+		}
+	}
+	page->FreeSpaces.Count = kept;
+
+	eng_AtlasPackerPruneFree(page, split);
+	page->UsedArea += (uint64_t)used->Width * used->Height;
+	++page->EntryCount;
+}
+
+void eng_AtlasPackerPruneFree(eng_AtlasPage* page, eng_Array* split)
+{
+	// Untouched free rectangles were already maximal among themselves, so
+	// only the split pieces need checking: against each other and against
+	// the rest, both ways.
+	for (uint32_t i = 0; i < split->Count; ++i)
+	{
+		const eng_AtlasSpace* piece = eng_ArrayPIndexType(split, eng_AtlasSpace, i);
+		bool contained = false;
+		for (uint32_t j = 0; j < split->Count && !contained; ++j)
+		{
+			// Of two identical pieces, the later one is kept.
+			const eng_AtlasSpace* other = eng_ArrayPIndexType(split, eng_AtlasSpace, j);
+			contained = j != i && eng_AtlasSpaceContains(other, piece) && (j > i || !eng_AtlasSpaceContains(piece, other));
+		}
+		for (uint32_t j = 0; j < page->FreeSpaces.Count && !contained; ++j)
+		{
+			contained = eng_AtlasSpaceContains(eng_ArrayPIndexType(&page->FreeSpaces, eng_AtlasSpace, j), piece);
+		}
+		if (contained)
+		{
+			continue;
+		}
+
+		uint32_t kept = 0;
+		for (uint32_t j = 0; j < page->FreeSpaces.Count; ++j)
+		{
+			eng_AtlasSpace space = eng_ArrayIndexType(&page->FreeSpaces, eng_AtlasSpace, j);
+			if (!eng_AtlasSpaceContains(piece, &space))
+			{
+				eng_ArrayIndexType(&page->FreeSpaces, eng_AtlasSpace, kept++) = space;
+			}
+		}
+		page->FreeSpaces.Count = kept;
+		eng_ArrayPushBack(&page->FreeSpaces, (void*)piece);
+	}
+}
+
+void eng_AtlasPackerRebuildPage(eng_AtlasPacker* packer, uint32_t pageIndex)
+{
+	eng_AtlasPage* page = eng_ArrayPIndexType(&packer->Pages, eng_AtlasPage, pageIndex);
+	eng_AtlasPackerResetPage(packer, page);
+	for (uint32_t i = 0; i < packer->Entries.Count; ++i)
+	{
+		const eng_AtlasEntry* atlasEntry = eng_ArrayPIndexType(&packer->Entries, eng_AtlasEntry, i);
+		if (atlasEntry->Used && atlasEntry->Rect.Page == pageIndex)
+		{
+			const eng_AtlasSpace space = {
+				.X = atlasEntry->Rect.X,
+				.Y = atlasEntry->Rect.Y,
+				.Width = atlasEntry->Rect.Width + packer->Padding,
+				.Height = atlasEntry->Rect.Height + packer->Padding,
+			};
+			eng_AtlasPackerOccupy(packer, page, &space);
+		}
+	}
+}
+
+uint32_t eng_AtlasPackerStore(eng_AtlasPacker* packer, uint32_t pageIndex, const eng_AtlasSpace* space)
+{
+	const eng_AtlasEntry atlasEntry = {
+		.Rect = { pageIndex, space->X, space->Y, space->Width - packer->Padding, space->Height - packer->Padding },
+		.Used = true,
+	};
+	if (packer->FreeEntries.Count > 0)
+	{
+		uint32_t entry = eng_ArrayIndexType(&packer->FreeEntries, uint32_t, --packer->FreeEntries.Count);
+		eng_ArrayIndexType(&packer->Entries, eng_AtlasEntry, entry) = atlasEntry;
+		return entry;
+	}
+	return eng_ArrayPushBack(&packer->Entries, (void*)&atlasEntry);
+}
+
+bool eng_AtlasSpaceContains(const eng_AtlasSpace* outer, const eng_AtlasSpace* inner)
+{
+	return inner->X >= outer->X && inner->Y >= outer->Y
+		&& inner->X + inner->Width <= outer->X + outer->Width
+		&& inner->Y + inner->Height <= outer->Y + outer->Height;
+}
+
+int eng_AtlasSortItemCompare(const void* a, const void* b)
+{
+	// Longest side first, then largest area, then input order so cooked
+	// atlases come out the same every time.
+	const eng_AtlasSortItem* itemA = (const eng_AtlasSortItem*)a;
+	const eng_AtlasSortItem* itemB = (const eng_AtlasSortItem*)b;
+	uint32_t sideA = itemA->Width > itemA->Height ? itemA->Width : itemA->Height;
+	uint32_t sideB = itemB->Width > itemB->Height ? itemB->Width : itemB->Height;
+	if (sideA != sideB)
+	{
+		return sideA > sideB ? -1 : 1;
+	}
+	uint64_t areaA = (uint64_t)itemA->Width * itemA->Height;
+	uint64_t areaB = (uint64_t)itemB->Width * itemB->Height;
+	if (areaA != areaB)
+	{
+		return areaA > areaB ? -1 : 1;
+	}
+	return itemA->Index < itemB->Index ? -1 : (itemA->Index > itemB->Index ? 1 : 0);
+}
\ No newline at end of file
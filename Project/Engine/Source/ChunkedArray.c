@@ -0,0 +1,94 @@
+#include <Engine/ChunkedArray.h>
+
+#include <Engine/Bits.h>
+#include <Engine/Log.h>
+
+#include <string.h>
+
+// @returns the number of chunks in use, which may be fewer than are allocated.
+uint32_t eng_ChunkedArrayGetUsedChunks(eng_ChunkedArray* array);
+
+void eng_ChunkedArrayInit(eng_ChunkedArray* array, uint32_t typeSize, uint32_t elementsPerChunk, const eng_Allocator* allocator)
+{
+	array->Allocator = allocator;
+	array->TypeSize = typeSize;
+	array->Count = 0;
+	array->ChunkShift = elementsPerChunk > 1 ? eng_BitScanReverse32(elementsPerChunk - 1) + 1 : 0;
+	eng_ArrayInitAllocatorType(&array->Chunks, void*, allocator);
+}
+
+void eng_ChunkedArrayDestroy(eng_ChunkedArray* array)
+{
+	size_t chunkSize = ((size_t)1 << array->ChunkShift) * array->TypeSize;
+	for (uint32_t i = 0; i < array->Chunks.Count; ++i)
+	{
+		eng_AllocatorFree(array->Allocator, eng_ArrayIndexType(&array->Chunks, void*, i), chunkSize);
+	}
+	eng_ArrayDestroy(&array->Chunks);
+}
+
+void* eng_ChunkedArrayIndex(eng_ChunkedArray* array, uint32_t index)
+{
+#if !defined(GAME_FINAL)
+	if (index >= array->Count)
+	{
+		eng_DevFatal("Chunked array index %u out of bounds of %u.\n", index, array->Count);
+	}
+#endif
+	char* chunk = eng_ArrayIndexType(&array->Chunks, char*, index >> array->ChunkShift);
+	return chunk + (size_t)(index & ((1u << array->ChunkShift) - 1)) * array->TypeSize;
+}
+
+uint32_t eng_ChunkedArrayPushBack(eng_ChunkedArray* array, void* object)
+{
+	memcpy(eng_ChunkedArrayEmplaceBack(array), object, array->TypeSize);
+	return array->Count - 1;
+}
+
+void* eng_ChunkedArrayEmplaceBack(eng_ChunkedArray* array)
+{
+	// Chunks emptied by popping or clearing are kept, so only allocate past the last of them.
+	if ((array->Count >> array->ChunkShift) == array->Chunks.Count)
+	{
+		void* chunk = eng_AllocatorAlloc(array->Allocator, ((size_t)1 << array->ChunkShift) * array->TypeSize, ENG_ALLOCATOR_DEFAULT_ALIGNMENT);
+		eng_ArrayPushBack(&array->Chunks, &chunk);
+	}
+	++array->Count;
+	return eng_ChunkedArrayIndex(array, array->Count - 1);
+}
+
+void eng_ChunkedArrayPopBack(eng_ChunkedArray* array)
+{
+#if !defined(GAME_FINAL)
+	if (array->Count == 0)
+	{
+		eng_DevFatal("Popping from an empty chunked array.\n");
+		return;
+	}
+#endif
+	--array->Count;
+}
+
+void eng_ChunkedArrayClear(eng_ChunkedArray* array)
+{
+	array->Count = 0;
+}
+
+uint32_t eng_ChunkedArrayGetChunkCount(eng_ChunkedArray* array)
+{
+	return eng_ChunkedArrayGetUsedChunks(array);
+}
+
+void* eng_ChunkedArrayGetChunk(eng_ChunkedArray* array, uint32_t chunk, uint32_t* outCount)
+{
+	uint32_t first = chunk << array->ChunkShift;
+	uint32_t remaining = array->Count - first;
+	*outCount = remaining < (1u << array->ChunkShift) ? remaining : (1u << array->ChunkShift);
+	return eng_ArrayIndexType(&array->Chunks, void*, chunk);
+}
+
+////////////////////////////////////////////////////////////////////////// Internal
+uint32_t eng_ChunkedArrayGetUsedChunks(eng_ChunkedArray* array)
+{
+	return (array->Count + (1u << array->ChunkShift) - 1) >> array->ChunkShift;
+}
\ No newline at end of file
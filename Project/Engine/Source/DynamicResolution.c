@@ -0,0 +1,67 @@
+#include <Engine/DynamicResolution.h>
+
+#include <math.h>
+
+// Aim slightly under the target so normal variance doesn't cross it.
+#define BUDGET_HEADROOM 0.9f
+// Fraction of the way to the ideal scale taken per frame.
+#define RESPONSE_DOWN 0.5f
+#define RESPONSE_UP 0.05f
+// Closer than this to the ideal scale counts as on target, which keeps the
+// extent from flickering.
+#define SCALE_DEADBAND 0.02f
+#define EXTENT_ALIGNMENT 8
+
+uint32_t eng_DynamicResolutionScaleAxis(float scale, uint32_t size);
+
+////////////////////////////////////////////////////////////////////////// Dynamic Resolution API
+eng_DynamicResolutionSettings eng_DynamicResolutionGetDefaults(void)
+{
+	const eng_DynamicResolutionSettings settings = {
+		.Enabled = false,
+		.TargetMilliseconds = 1000.0f / 60.0f,
+		.MinScale = 0.5f,
+		.MaxScale = 1.0f,
+	};
+	return settings;
+}
+
+float eng_DynamicResolutionNextScale(const eng_DynamicResolutionSettings* settings, float scale, double measuredMilliseconds)
+{
+	if (!settings->Enabled)
+	{
+		return 1.0f;
+	}
+
+	float maxScale = fminf(settings->MaxScale, 1.0f);
+	float minScale = fminf(settings->MinScale, maxScale);
+	float next = scale;
+	if (measuredMilliseconds > 0.0)
+	{
+		// Pixel count, and so cost, goes with the square of the scale.
+		float ideal = scale * sqrtf(settings->TargetMilliseconds * BUDGET_HEADROOM / (float)measuredMilliseconds);
+		if (fabsf(ideal - scale) > SCALE_DEADBAND)
+		{
+			next += (ideal - scale) * (ideal < scale ? RESPONSE_DOWN : RESPONSE_UP);
+		}
+	}
+	return fmaxf(minScale, fminf(maxScale, next));
+}
+
+void eng_DynamicResolutionGetExtent(float scale, uint32_t width, uint32_t height, uint32_t* outWidth, uint32_t* outHeight)
+{
+	*outWidth = eng_DynamicResolutionScaleAxis(scale, width);
+	*outHeight = eng_DynamicResolutionScaleAxis(scale, height);
+}
+
+////////////////////////////////////////////////////////////////////////// Internal
+uint32_t eng_DynamicResolutionScaleAxis(float scale, uint32_t size)
+{
+	uint32_t scaled = (uint32_t)(size * scale);
+	if (scaled >= size)
+	{
+		return size;
+	}
+	scaled -= scaled % EXTENT_ALIGNMENT;
+	return scaled < EXTENT_ALIGNMENT ? (size < EXTENT_ALIGNMENT ? size : EXTENT_ALIGNMENT) : scaled;
+}
\ No newline at end of file
@@ -0,0 +1,161 @@
+#include <Engine/FrameAllocator.h>
+
+#include <Engine/Log.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct eng_FrameAllocator
+{
+	const eng_Allocator* Allocator;
+	eng_Arena* Frames[ENG_FRAME_ALLOCATOR_MAX_FRAMES];
+	uint32_t FrameCount;
+	uint32_t FrameIndex;
+	size_t BytesPerFrame;
+	size_t HighWaterMark;
+} eng_FrameAllocator;
+
+void eng_FrameAllocatorUpdateHighWaterMark(eng_FrameAllocator* frameAllocator);
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+eng_FrameAllocator* eng_FrameAllocatorMalloc(void)
+{
+	return malloc(sizeof(eng_FrameAllocator));
+}
+
+bool eng_FrameAllocatorInit(eng_FrameAllocator* frameAllocator, size_t bytesPerFrame, uint32_t frameCount, const eng_Allocator* allocator)
+{
+	memset(frameAllocator, 0, sizeof(eng_FrameAllocator));
+	frameAllocator->Allocator = allocator;
+	if (!eng_Ensure(frameCount > 0 && frameCount <= ENG_FRAME_ALLOCATOR_MAX_FRAMES, "Frame allocator can't have %u frames.\n", frameCount))
+	{
+		return false;
+	}
+
+	frameAllocator->FrameCount = frameCount;
+	frameAllocator->BytesPerFrame = bytesPerFrame;
+	for (uint32_t i = 0; i < frameCount; ++i)
+	{
+		frameAllocator->Frames[i] = eng_AllocatorAlloc(allocator, eng_ArenaGetSizeof(), ENG_ALLOCATOR_DEFAULT_ALIGNMENT);
+		if (frameAllocator->Frames[i] == NULL || !eng_ArenaInit(frameAllocator->Frames[i], bytesPerFrame, allocator))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void eng_FrameAllocatorFree(eng_FrameAllocator* frameAllocator, bool subAllocationsOnly)
+{
+	if (frameAllocator == NULL)
+	{
+		return;
+	}
+
+	for (uint32_t i = 0; i < frameAllocator->FrameCount; ++i)
+	{
+		eng_ArenaFree(frameAllocator->Frames[i], true);
+		eng_AllocatorFree(frameAllocator->Allocator, frameAllocator->Frames[i], eng_ArenaGetSizeof());
+	}
+
+	if (!subAllocationsOnly)
+	{
+		free(frameAllocator);
+	}
+}
+
+size_t eng_FrameAllocatorGetSizeof(void)
+{
+	return sizeof(eng_FrameAllocator);
+}
+
+////////////////////////////////////////////////////////////////////////// Frame Allocator API
+void eng_FrameAllocatorBeginFrame(eng_FrameAllocator* frameAllocator, uint32_t frameIndex)
+{
+	frameAllocator->FrameIndex = frameIndex % frameAllocator->FrameCount;
+	eng_Arena* frame = frameAllocator->Frames[frameAllocator->FrameIndex];
+	// The slot's last frame is done: account for it before it's gone.
+	eng_FrameAllocatorUpdateHighWaterMark(frameAllocator);
+	eng_ArenaClear(frame);
+}
+
+void* eng_FrameAllocatorAlloc(eng_FrameAllocator* frameAllocator, size_t size, size_t alignment)
+{
+	return eng_ArenaAlloc(frameAllocator->Frames[frameAllocator->FrameIndex], size, alignment);
+}
+
+void* eng_FrameAllocatorCalloc(eng_FrameAllocator* frameAllocator, size_t count, size_t size, size_t alignment)
+{
+	return eng_ArenaCalloc(frameAllocator->Frames[frameAllocator->FrameIndex], count, size, alignment);
+}
+
+char* eng_FrameAllocatorPrintf(eng_FrameAllocator* frameAllocator, const char* fmt, ...)
+{
+	va_list args;
+	va_start(args, fmt);
+	char* str = eng_FrameAllocatorVPrintf(frameAllocator, fmt, args);
+	va_end(args);
+	return str;
+}
+
+char* eng_FrameAllocatorVPrintf(eng_FrameAllocator* frameAllocator, const char* fmt, va_list args)
+{
+	va_list measureArgs;
+	va_copy(measureArgs, args);
+	int length = vsnprintf(NULL, 0, fmt, measureArgs);
+	va_end(measureArgs);
+	if (length < 0)
+	{
+		return NULL;
+	}
+
+	char* str = eng_FrameAllocatorAlloc(frameAllocator, (size_t)length + 1, 1);
+	if (str != NULL)
+	{
+		vsnprintf(str, (size_t)length + 1, fmt, args);
+	}
+	return str;
+}
+
+size_t eng_FrameAllocatorGetUsed(eng_FrameAllocator* frameAllocator)
+{
+	return eng_ArenaGetUsed(frameAllocator->Frames[frameAllocator->FrameIndex]);
+}
+
+size_t eng_FrameAllocatorGetHighWaterMark(eng_FrameAllocator* frameAllocator)
+{
+	eng_FrameAllocatorUpdateHighWaterMark(frameAllocator);
+	return frameAllocator->HighWaterMark;
+}
+
+uint32_t eng_FrameAllocatorGetFrameCount(eng_FrameAllocator* frameAllocator)
+{
+	return frameAllocator->FrameCount;
+}
+
+size_t eng_FrameAllocatorGetBytesPerFrame(eng_FrameAllocator* frameAllocator)
+{
+	return frameAllocator->BytesPerFrame;
+}
+
+void eng_FrameAllocatorReport(eng_FrameAllocator* frameAllocator)
+{
+	size_t highWaterMark = eng_FrameAllocatorGetHighWaterMark(frameAllocator);
+	eng_Log("Frame scratch high-water mark: %u/%u bytes per frame over %u frames in flight.\n",
+		(unsigned)highWaterMark, (unsigned)frameAllocator->BytesPerFrame, frameAllocator->FrameCount);
+	if (highWaterMark > frameAllocator->BytesPerFrame)
+	{
+		eng_Warn("Frame scratch overflowed into extra blocks; raise its bytes per frame.\n");
+	}
+}
+
+////////////////////////////////////////////////////////////////////////// Internal
+void eng_FrameAllocatorUpdateHighWaterMark(eng_FrameAllocator* frameAllocator)
+{
+	size_t used = eng_FrameAllocatorGetUsed(frameAllocator);
+	if (used > frameAllocator->HighWaterMark)
+	{
+		frameAllocator->HighWaterMark = used;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,239 @@
+#ifdef GAME_WINDOWS
+#include <Engine/FramePacer.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <windows.h>
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+// Fraction of the way to a new measurement taken per frame.
+#define INTERVAL_RESPONSE 0.1
+#define LATENCY_RESPONSE 0.1
+// The work estimate jumps up to a slower frame at once so the next one
+// isn't late too, and only creeps back down.
+#define WORK_DECAY 0.05
+
+typedef struct eng_FramePacer
+{
+	eng_FramePacerSettings Settings;
+	LARGE_INTEGER Freq;
+	// Waitable timer for the sleep; NULL falls back to Sleep.
+	HANDLE Timer;
+
+	double RefreshMilliseconds;
+	double IntervalMilliseconds;
+	double WorkMilliseconds;
+	double WaitMilliseconds;
+	double LatencyMilliseconds;
+	double AverageLatencyMilliseconds;
+
+	LONGLONG LastPresent;
+	LONGLONG InputSample;
+	uint32_t PresentCount;
+} eng_FramePacer;
+
+double eng_FramePacerTicksToMilliseconds(eng_FramePacer* pacer, LONGLONG ticks);
+LONGLONG eng_FramePacerNow(void);
+void eng_FramePacerWaitUntil(eng_FramePacer* pacer, LONGLONG deadline);
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+eng_FramePacer* eng_FramePacerMalloc(void)
+{
+	return malloc(sizeof(eng_FramePacer));
+}
+
+bool eng_FramePacerInit(eng_FramePacer* pacer, const eng_FramePacerSettings* settings)
+{
+	memset(pacer, 0, sizeof(eng_FramePacer));
+	pacer->Settings = *settings;
+	if (QueryPerformanceFrequency(&pacer->Freq) != TRUE)
+	{
+		return false;
+	}
+
+	// High resolution timers sleep to within a fraction of a millisecond
+	// without raising the system timer rate. Older versions of Windows
+	// don't have them.
+	pacer->Timer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+	if (pacer->Timer == NULL)
+	{
+		pacer->Timer = CreateWaitableTimerExW(NULL, NULL, 0, TIMER_ALL_ACCESS);
+	}
+	return true;
+}
+
+void eng_FramePacerFree(eng_FramePacer* pacer, bool subAllocationsOnly)
+{
+	if (pacer == NULL)
+	{
+		return;
+	}
+
+	if (pacer->Timer != NULL)
+	{
+		CloseHandle(pacer->Timer);
+	}
+
+	if (!subAllocationsOnly)
+	{
+		free(pacer);
+	}
+}
+
+size_t eng_FramePacerGetSizeof(void)
+{
+	return sizeof(eng_FramePacer);
+}
+
+////////////////////////////////////////////////////////////////////////// Frame Pacer API
+eng_FramePacerSettings eng_FramePacerGetDefaults(void)
+{
+	const eng_FramePacerSettings settings = {
+		.Enabled = true,
+		.TargetMilliseconds = 0.0,
+		.SafetyMilliseconds = 1.5,
+		.SpinMilliseconds = 0.5,
+	};
+	return settings;
+}
+
+void eng_FramePacerSetSettings(eng_FramePacer* pacer, const eng_FramePacerSettings* settings)
+{
+	pacer->Settings = *settings;
+}
+
+void eng_FramePacerSetRefreshMilliseconds(eng_FramePacer* pacer, double refreshMilliseconds)
+{
+	pacer->RefreshMilliseconds = refreshMilliseconds;
+}
+
+void eng_FramePacerWait(eng_FramePacer* pacer)
+{
+	LONGLONG now = eng_FramePacerNow();
+	pacer->WaitMilliseconds = 0.0;
+
+	double interval = pacer->Settings.TargetMilliseconds;
+	if (interval <= 0.0)
+	{
+		interval = pacer->RefreshMilliseconds > 0.0 ? pacer->RefreshMilliseconds : pacer->IntervalMilliseconds;
+	}
+
+	// Until a couple of presents have been seen there's nothing to predict from.
+	if (pacer->Settings.Enabled && pacer->PresentCount >= 2 && interval > 0.0)
+	{
+		double startMilliseconds = interval - pacer->WorkMilliseconds - pacer->Settings.SafetyMilliseconds;
+		LONGLONG deadline = pacer->LastPresent + (LONGLONG)(startMilliseconds * 1e-3 * (double)pacer->Freq.QuadPart);
+		if (deadline > now)
+		{
+			eng_FramePacerWaitUntil(pacer, deadline);
+			LONGLONG woke = eng_FramePacerNow();
+			pacer->WaitMilliseconds = eng_FramePacerTicksToMilliseconds(pacer, woke - now);
+			now = woke;
+		}
+	}
+
+	pacer->InputSample = now;
+}
+
+void eng_FramePacerPresented(eng_FramePacer* pacer, double blockedMilliseconds)
+{
+	LONGLONG now = eng_FramePacerNow();
+
+	if (pacer->PresentCount > 0)
+	{
+		double interval = eng_FramePacerTicksToMilliseconds(pacer, now - pacer->LastPresent);
+		pacer->IntervalMilliseconds = pacer->PresentCount == 1 ? interval
+			: pacer->IntervalMilliseconds + (interval - pacer->IntervalMilliseconds) * INTERVAL_RESPONSE;
+	}
+
+	double frameMilliseconds = eng_FramePacerTicksToMilliseconds(pacer, now - pacer->InputSample);
+	double work = frameMilliseconds - blockedMilliseconds;
+	if (work < 0.0)
+	{
+		work = 0.0;
+	}
+	if (work > pacer->WorkMilliseconds)
+	{
+		pacer->WorkMilliseconds = work;
+	}
+	else
+	{
+		pacer->WorkMilliseconds += (work - pacer->WorkMilliseconds) * WORK_DECAY;
+	}
+
+	pacer->LatencyMilliseconds = frameMilliseconds;
+	pacer->AverageLatencyMilliseconds = pacer->PresentCount == 0 ? frameMilliseconds
+		: pacer->AverageLatencyMilliseconds + (frameMilliseconds - pacer->AverageLatencyMilliseconds) * LATENCY_RESPONSE;
+
+	pacer->LastPresent = now;
+	++pacer->PresentCount;
+}
+
+double eng_FramePacerGetLatencyMilliseconds(eng_FramePacer* pacer)
+{
+	return pacer->LatencyMilliseconds;
+}
+
+double eng_FramePacerGetAverageLatencyMilliseconds(eng_FramePacer* pacer)
+{
+	return pacer->AverageLatencyMilliseconds;
+}
+
+double eng_FramePacerGetIntervalMilliseconds(eng_FramePacer* pacer)
+{
+	return pacer->IntervalMilliseconds;
+}
+
+double eng_FramePacerGetWorkMilliseconds(eng_FramePacer* pacer)
+{
+	return pacer->WorkMilliseconds;
+}
+
+double eng_FramePacerGetWaitMilliseconds(eng_FramePacer* pacer)
+{
+	return pacer->WaitMilliseconds;
+}
+
+////////////////////////////////////////////////////////////////////////// Internal
+double eng_FramePacerTicksToMilliseconds(eng_FramePacer* pacer, LONGLONG ticks)
+{
+	return (double)ticks * 1e+3 / (double)pacer->Freq.QuadPart;
+}
+
+LONGLONG eng_FramePacerNow(void)
+{
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+	return now.QuadPart;
+}
+
+void eng_FramePacerWaitUntil(eng_FramePacer* pacer, LONGLONG deadline)
+{
+	double sleepMilliseconds = eng_FramePacerTicksToMilliseconds(pacer, deadline - eng_FramePacerNow()) - pacer->Settings.SpinMilliseconds;
+	if (sleepMilliseconds > 0.0)
+	{
+		if (pacer->Timer != NULL)
+		{
+			// Negative due times are relative, in 100 ns units.
+			LARGE_INTEGER due;
+			due.QuadPart = -(LONGLONG)(sleepMilliseconds * 1e+4);
+			if (SetWaitableTimer(pacer->Timer, &due, 0, NULL, NULL, FALSE))
+			{
+				WaitForSingleObject(pacer->Timer, INFINITE);
+			}
+		}
+		else
+		{
+			Sleep((DWORD)sleepMilliseconds);
+		}
+	}
+
+	while (eng_FramePacerNow() < deadline)
+	{
+		YieldProcessor();
+	}
+}
+#endif
\ No newline at end of file
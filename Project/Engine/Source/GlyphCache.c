@@ -0,0 +1,377 @@
+#include <Engine/GlyphCache.h>
+
+#include <Engine/Allocator.h>
+#include <Engine/Log.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#define FONT_FIRST_CHAR ' '
+#define FONT_LAST_CHAR '~'
+#define FONT_GLYPH_WIDTH 5
+#define FONT_GLYPH_HEIGHT 7
+// One column and one row of spacing around every glyph.
+#define FONT_ADVANCE 6
+#define FONT_LINE_HEIGHT 8
+
+#define HASH_BUCKET_COUNT 256
+#define INVALID_CELL UINT16_MAX
+
+// 5x7 ASCII font, one byte per row, bit 4 is the leftmost column.
+static const uint8_t s_Font5x7[FONT_LAST_CHAR - FONT_FIRST_CHAR + 1][FONT_GLYPH_HEIGHT] = {
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // ' '
+	{ 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04 }, // '!'
+	{ 0x0A, 0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00 }, // '"'
+	{ 0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A }, // '#'
+	{ 0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04 }, // '$'
+	{ 0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03 }, // '%'
+	{ 0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D }, // '&'
+	{ 0x0C, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00 }, // '''
+	{ 0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02 }, // '('
+	{ 0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08 }, // ')'
+	{ 0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00 }, // '*'
+	{ 0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00 }, // '+'
+	{ 0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08 }, // ','
+	{ 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00 }, // '-'
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C }, // '.'
+	{ 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00 }, // '/'
+	{ 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E }, // '0'
+	{ 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E }, // '1'
+	{ 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F }, // '2'
+	{ 0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E }, // '3'
+	{ 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02 }, // '4'
+	{ 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E }, // '5'
+	{ 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E }, // '6'
+	{ 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 }, // '7'
+	{ 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E }, // '8'
+	{ 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C }, // '9'
+	{ 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00 }, // ':'
+	{ 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x04, 0x08 }, // ';'
+	{ 0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02 }, // '<'
+	{ 0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00 }, // '='
+	{ 0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08 }, // '>'
+	{ 0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04 }, // '?'
+	{ 0x0E, 0x11, 0x01, 0x0D, 0x15, 0x15, 0x0E }, // '@'
+	{ 0x0E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11 }, // 'A'
+	{ 0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E }, // 'B'
+	{ 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E }, // 'C'
+	{ 0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C }, // 'D'
+	{ 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F }, // 'E'
+	{ 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10 }, // 'F'
+	{ 0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F }, // 'G'
+	{ 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 }, // 'H'
+	{ 0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E }, // 'I'
+	{ 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C }, // 'J'
+	{ 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11 }, // 'K'
+	{ 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F }, // 'L'
+	{ 0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11 }, // 'M'
+	{ 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 }, // 'N'
+	{ 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E }, // 'O'
+	{ 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10 }, // 'P'
+	{ 0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D }, // 'Q'
+	{ 0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11 }, // 'R'
+	{ 0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E }, // 'S'
+	{ 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 }, // 'T'
+	{ 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E }, // 'U'
+	{ 0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04 }, // 'V'
+	{ 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A }, // 'W'
+	{ 0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11 }, // 'X'
+	{ 0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04 }, // 'Y'
+	{ 0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F }, // 'Z'
+	{ 0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E }, // '['
+	{ 0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00 }, // '\'
+	{ 0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E }, // ']'
+	{ 0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00 }, // '^'
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F }, // '_'
+	{ 0x08, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00 }, // '`'
+	{ 0x00, 0x00, 0x0E, 0x01, 0x0F, 0x11, 0x0F }, // 'a'
+	{ 0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x1E }, // 'b'
+	{ 0x00, 0x00, 0x0E, 0x10, 0x10, 0x11, 0x0E }, // 'c'
+	{ 0x01, 0x01, 0x0D, 0x13, 0x11, 0x11, 0x0F }, // 'd'
+	{ 0x00, 0x00, 0x0E, 0x11, 0x1F, 0x10, 0x0E }, // 'e'
+	{ 0x06, 0x09, 0x08, 0x1C, 0x08, 0x08, 0x08 }, // 'f'
+	{ 0x00, 0x0F, 0x11, 0x11, 0x0F, 0x01, 0x0E }, // 'g'
+	{ 0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x11 }, // 'h'
+	{ 0x04, 0x00, 0x0C, 0x04, 0x04, 0x04, 0x0E }, // 'i'
+	{ 0x02, 0x00, 0x06, 0x02, 0x02, 0x12, 0x0C }, // 'j'
+	{ 0x10, 0x10, 0x12, 0x14, 0x18, 0x14, 0x12 }, // 'k'
+	{ 0x0C, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E }, // 'l'
+	{ 0x00, 0x00, 0x1A, 0x15, 0x15, 0x11, 0x11 }, // 'm'
+	{ 0x00, 0x00, 0x16, 0x19, 0x11, 0x11, 0x11 }, // 'n'
+	{ 0x00, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E }, // 'o'
+	{ 0x00, 0x00, 0x1E, 0x11, 0x1E, 0x10, 0x10 }, // 'p'
+	{ 0x00, 0x00, 0x0D, 0x13, 0x0F, 0x01, 0x01 }, // 'q'
+	{ 0x00, 0x00, 0x16, 0x19, 0x10, 0x10, 0x10 }, // 'r'
+	{ 0x00, 0x00, 0x0E, 0x10, 0x0E, 0x01, 0x1E }, // 's'
+	{ 0x08, 0x08, 0x1C, 0x08, 0x08, 0x09, 0x06 }, // 't'
+	{ 0x00, 0x00, 0x11, 0x11, 0x11, 0x13, 0x0D }, // 'u'
+	{ 0x00, 0x00, 0x11, 0x11, 0x11, 0x0A, 0x04 }, // 'v'
+	{ 0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0A }, // 'w'
+	{ 0x00, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11 }, // 'x'
+	{ 0x00, 0x00, 0x11, 0x11, 0x0F, 0x01, 0x0E }, // 'y'
+	{ 0x00, 0x00, 0x1F, 0x02, 0x04, 0x08, 0x1F }, // 'z'
+	{ 0x02, 0x04, 0x04, 0x08, 0x04, 0x04, 0x02 }, // '{'
+	{ 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 }, // '|'
+	{ 0x08, 0x04, 0x04, 0x02, 0x04, 0x04, 0x08 }, // '}'
+	{ 0x00, 0x00, 0x00, 0x0D, 0x12, 0x00, 0x00 }, // '~'
+};
+
+typedef struct eng_GlyphCell
+{
+	// (character << 8) | scale, or 0 when the cell is empty.
+	uint32_t Key;
+	uint32_t LastUsedFrame;
+	// Intrusive LRU list: Newer is towards the most recently used cell.
+	uint16_t Newer;
+	uint16_t Older;
+	uint16_t NextInBucket;
+} eng_GlyphCell;
+
+typedef struct eng_GlyphCache
+{
+	uint8_t* Atlas;
+	uint32_t AtlasSize;
+	uint32_t CellsPerRow;
+	uint32_t CellCount;
+	eng_GlyphCell* Cells;
+	const eng_Allocator* Allocator;
+
+	uint16_t Newest;
+	uint16_t Oldest;
+	uint16_t Buckets[HASH_BUCKET_COUNT];
+
+	uint32_t Frame;
+	uint32_t FramesInFlight;
+	uint32_t RasterizeCount;
+} eng_GlyphCache;
+
+void eng_GlyphCacheUnlinkLRU(eng_GlyphCache* cache, uint16_t cellIndex);
+void eng_GlyphCacheLinkNewest(eng_GlyphCache* cache, uint16_t cellIndex);
+void eng_GlyphCacheUnlinkBucket(eng_GlyphCache* cache, uint16_t cellIndex);
+void eng_GlyphCacheRasterize(eng_GlyphCache* cache, uint16_t cellIndex, char character, uint32_t scale);
+void eng_GlyphCacheFillGlyph(eng_GlyphCache* cache, uint16_t cellIndex, uint32_t scale, eng_Glyph* outGlyph);
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+eng_GlyphCache* eng_GlyphCacheMalloc(void)
+{
+	return malloc(sizeof(eng_GlyphCache));
+}
+
+bool eng_GlyphCacheInit(eng_GlyphCache* cache, uint8_t* atlas, uint32_t atlasSize, uint32_t framesInFlight, const eng_Allocator* allocator)
+{
+	memset(cache, 0, sizeof(eng_GlyphCache));
+	cache->Allocator = allocator;
+
+	cache->Atlas = atlas;
+	cache->AtlasSize = atlasSize;
+	cache->CellsPerRow = atlasSize / ENG_GLYPH_CELL_SIZE;
+	cache->CellCount = cache->CellsPerRow * cache->CellsPerRow;
+	cache->FramesInFlight = framesInFlight;
+	// Frame starts past the guard so untouched cells are immediately evictable.
+	cache->Frame = framesInFlight + 1;
+
+	if (!eng_Ensure(cache->CellCount > 0 && cache->CellCount < INVALID_CELL, "Glyph atlas size %u is not usable.\n", atlasSize))
+	{
+		return false;
+	}
+
+	cache->Cells = eng_AllocatorCallocType(cache->Allocator, eng_GlyphCell, cache->CellCount);
+	if (cache->Cells == NULL)
+	{
+		return false;
+	}
+
+	for (uint32_t i = 0; i < HASH_BUCKET_COUNT; ++i)
+	{
+		cache->Buckets[i] = INVALID_CELL;
+	}
+
+	// Every cell starts out empty on the LRU list, oldest first.
+	cache->Newest = INVALID_CELL;
+	cache->Oldest = INVALID_CELL;
+	for (uint32_t i = 0; i < cache->CellCount; ++i)
+	{
+		cache->Cells[i].NextInBucket = INVALID_CELL;
+		eng_GlyphCacheLinkNewest(cache, (uint16_t)i);
+	}
+
+	memset(atlas, 0, (size_t)atlasSize * atlasSize);
+	return true;
+}
+
+void eng_GlyphCacheFree(eng_GlyphCache* cache, bool subAllocationsOnly)
+{
+	if (cache == NULL)
+	{
+		return;
+	}
+
+	eng_AllocatorFreeType(cache->Allocator, cache->Cells, eng_GlyphCell, cache->CellCount);
+
+	if (!subAllocationsOnly)
+	{
+		free(cache);
+	}
+}
+
+size_t eng_GlyphCacheGetSizeof(void)
+{
+	return sizeof(eng_GlyphCache);
+}
+
+////////////////////////////////////////////////////////////////////////// Glyph Cache API
+bool eng_GlyphCacheGet(eng_GlyphCache* cache, char character, uint32_t scale, eng_Glyph* outGlyph)
+{
+	if (character < FONT_FIRST_CHAR || character > FONT_LAST_CHAR)
+	{
+		character = '?';
+	}
+	if (scale == 0)
+	{
+		scale = 1;
+	}
+	if (scale > ENG_GLYPH_MAX_SCALE)
+	{
+		scale = ENG_GLYPH_MAX_SCALE;
+	}
+
+	uint32_t key = ((uint32_t)(uint8_t)character << 8) | scale;
+	uint32_t bucket = (key * 2654435761u) >> 24;
+
+	// Hit: bump to the front of the LRU list.
+	for (uint16_t cellIndex = cache->Buckets[bucket]; cellIndex != INVALID_CELL; cellIndex = cache->Cells[cellIndex].NextInBucket)
+	{
+		eng_GlyphCell* cell = &cache->Cells[cellIndex];
+		if (cell->Key == key)
+		{
+			cell->LastUsedFrame = cache->Frame;
+			eng_GlyphCacheUnlinkLRU(cache, cellIndex);
+			eng_GlyphCacheLinkNewest(cache, cellIndex);
+			eng_GlyphCacheFillGlyph(cache, cellIndex, scale, outGlyph);
+			return true;
+		}
+	}
+
+	// Miss: recycle the least recently used cell, if the GPU is done with it.
+	uint16_t victimIndex = cache->Oldest;
+	eng_GlyphCell* victim = &cache->Cells[victimIndex];
+	if (victim->Key != 0 && victim->LastUsedFrame + cache->FramesInFlight >= cache->Frame)
+	{
+		return false;
+	}
+
+	if (victim->Key != 0)
+	{
+		eng_GlyphCacheUnlinkBucket(cache, victimIndex);
+	}
+	victim->Key = key;
+	victim->LastUsedFrame = cache->Frame;
+	victim->NextInBucket = cache->Buckets[bucket];
+	cache->Buckets[bucket] = victimIndex;
+
+	eng_GlyphCacheUnlinkLRU(cache, victimIndex);
+	eng_GlyphCacheLinkNewest(cache, victimIndex);
+
+	eng_GlyphCacheRasterize(cache, victimIndex, character, scale);
+	eng_GlyphCacheFillGlyph(cache, victimIndex, scale, outGlyph);
+	return true;
+}
+
+void eng_GlyphCacheNextFrame(eng_GlyphCache* cache)
+{
+	++cache->Frame;
+}
+
+uint32_t eng_GlyphCacheGetLineHeight(uint32_t scale)
+{
+	return FONT_LINE_HEIGHT * (scale ? scale : 1);
+}
+
+uint32_t eng_GlyphCacheGetRasterizeCount(eng_GlyphCache* cache)
+{
+	return cache->RasterizeCount;
+}
+
+////////////////////////////////////////////////////////////////////////// Internal
+void eng_GlyphCacheUnlinkLRU(eng_GlyphCache* cache, uint16_t cellIndex)
+{
+	eng_GlyphCell* cell = &cache->Cells[cellIndex];
+	if (cell->Newer != INVALID_CELL)
+	{
+		cache->Cells[cell->Newer].Older = cell->Older;
+	}
+	else
+	{
+		cache->Newest = cell->Older;
+	}
+	if (cell->Older != INVALID_CELL)
+	{
+		cache->Cells[cell->Older].Newer = cell->Newer;
+	}
+	else
+	{
+		cache->Oldest = cell->Newer;
+	}
+}
+
+void eng_GlyphCacheLinkNewest(eng_GlyphCache* cache, uint16_t cellIndex)
+{
+	eng_GlyphCell* cell = &cache->Cells[cellIndex];
+	cell->Newer = INVALID_CELL;
+	cell->Older = cache->Newest;
+	if (cache->Newest != INVALID_CELL)
+	{
+		cache->Cells[cache->Newest].Newer = cellIndex;
+	}
+	cache->Newest = cellIndex;
+	if (cache->Oldest == INVALID_CELL)
+	{
+		cache->Oldest = cellIndex;
+	}
+}
+
+void eng_GlyphCacheUnlinkBucket(eng_GlyphCache* cache, uint16_t cellIndex)
+{
+	uint32_t bucket = (cache->Cells[cellIndex].Key * 2654435761u) >> 24;
+	uint16_t* link = &cache->Buckets[bucket];
+	while (*link != INVALID_CELL)
+	{
+		if (*link == cellIndex)
+		{
+			*link = cache->Cells[cellIndex].NextInBucket;
+			break;
+		}
+		link = &cache->Cells[*link].NextInBucket;
+	}
+	cache->Cells[cellIndex].NextInBucket = INVALID_CELL;
+}
+
+void eng_GlyphCacheRasterize(eng_GlyphCache* cache, uint16_t cellIndex, char character, uint32_t scale)
+{
+	uint32_t cellX = (cellIndex % cache->CellsPerRow) * ENG_GLYPH_CELL_SIZE;
+	uint32_t cellY = (cellIndex / cache->CellsPerRow) * ENG_GLYPH_CELL_SIZE;
+	const uint8_t* rows = s_Font5x7[character - FONT_FIRST_CHAR];
+
+	for (uint32_t y = 0; y < ENG_GLYPH_CELL_SIZE; ++y)
+	{
+		uint8_t* texel = cache->Atlas + (size_t)(cellY + y) * cache->AtlasSize + cellX;
+		uint32_t fontY = y / scale;
+		for (uint32_t x = 0; x < ENG_GLYPH_CELL_SIZE; ++x)
+		{
+			uint32_t fontX = x / scale;
+			bool set = fontY < FONT_GLYPH_HEIGHT && fontX < FONT_GLYPH_WIDTH
+				&& (rows[fontY] & (0x10 >> fontX)) != 0;
+			texel[x] = set ? 255 : 0;
+		}
+	}
+	++cache->RasterizeCount;
+}
+
+void eng_GlyphCacheFillGlyph(eng_GlyphCache* cache, uint16_t cellIndex, uint32_t scale, eng_Glyph* outGlyph)
+{
+	outGlyph->X = (uint16_t)((cellIndex % cache->CellsPerRow) * ENG_GLYPH_CELL_SIZE);
+	outGlyph->Y = (uint16_t)((cellIndex / cache->CellsPerRow) * ENG_GLYPH_CELL_SIZE);
+	outGlyph->Width = (uint16_t)(FONT_ADVANCE * scale);
+	outGlyph->Height = (uint16_t)(FONT_LINE_HEIGHT * scale);
+	outGlyph->Advance = (uint16_t)(FONT_ADVANCE * scale);
+}
\ No newline at end of file
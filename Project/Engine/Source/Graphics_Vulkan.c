@@ -24,10 +24,14 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+#define _CRT_SECURE_NO_WARNINGS
 #include <Engine/Graphics_Vulkan.h>
 
+#include <Engine/Allocator.h>
 #include <Engine/Array.h>
+#include <Engine/FrameAllocator.h>
 #include <Engine/Log.h>
+#include <Engine/Stopwatch.h>
 
 #if defined(GAME_WINDOWS)
 #define VK_USE_PLATFORM_WIN32_KHR
@@ -37,31 +41,17 @@ SOFTWARE.
 #include <Engine/Graphics_VulkanInternal.h>
 
 #include <assert.h>
+#include <stdio.h>
+#include <string.h>
 
-#define FENCE_COUNT 2
 #define SAMPLE_COUNT 1
 
-typedef struct eng_BufferInfo
-{
-	VkImage image;
-	VkCommandBuffer cmd;
-	VkImageView view;
-	VkFramebuffer fb;
-} eng_BufferInfo;
-
-typedef struct eng_Vulkan
-{
-	VkInstance Instance;
-	VkDevice Device;
-	VkSwapchainKHR Swapchain;
-	VkExtent2D SwapchainExtent;
-	VkCommandBuffer DrawCmd;
-	VkRenderPass RenderPass;
-	VkQueue Queue;
-	eng_BufferInfo* Buffers;
-
-	eng_ArrayDecl(Extensions, const char*);
-} eng_Vulkan;
+void eng_VulkanCallbackListBind(eng_Array* callbackList, eng_VulkanRecordCallback_t func, void* userData);
+void eng_VulkanCallbackListUnbind(eng_Array* callbackList, eng_VulkanRecordCallback_t func);
+void eng_VulkanCallbackListExec(eng_Array* callbackList, VkCommandBuffer cmd);
+bool eng_VulkanCreateSceneTarget(eng_Vulkan* vulkan);
+bool eng_VulkanCreateFrameTiming(eng_Vulkan* vulkan);
+void eng_VulkanUpdateRenderScale(eng_Vulkan* vulkan);
 
 
 ////////////////////////////////////////////////////////////////////////// Lifecycle
@@ -71,11 +61,20 @@ eng_Vulkan* eng_VulkanMalloc(void)
 	return malloc(sizeof(eng_Vulkan));
 }
 
-bool eng_VulkanInit(eng_Vulkan* vulkan)
+bool eng_VulkanInit(eng_Vulkan* vulkan, const eng_Allocator* allocator)
 {
 	memset(vulkan, 0, sizeof(eng_Vulkan));
-
-	eng_ArrayInitType(&vulkan->Extensions, const char*);
+	vulkan->Allocator = allocator;
+
+	eng_ArrayInitInlineType(&vulkan->Extensions, const char*, vulkan->ExtensionsInline, allocator);
+	eng_ArrayInitInlineType(&vulkan->OnPreRender, eng_VulkanCallback, vulkan->OnPreRenderInline, allocator);
+	eng_ArrayInitInlineType(&vulkan->OnRender, eng_VulkanCallback, vulkan->OnRenderInline, allocator);
+	eng_ArrayInitInlineType(&vulkan->OnOverlay, eng_VulkanCallback, vulkan->OnOverlayInline, allocator);
+	eng_ArrayInitAllocatorType(&vulkan->QueryRegions, eng_VulkanQueryRegion, allocator);
+	vulkan->SceneQueryRegion = ENG_VULKAN_INVALID_QUERY_REGION;
+	vulkan->OverlayQueryRegion = ENG_VULKAN_INVALID_QUERY_REGION;
+	vulkan->RenderScale = 1.0f;
+	vulkan->DynamicResolution = eng_DynamicResolutionGetDefaults();
 
 	return true;
 }
@@ -87,8 +86,27 @@ void eng_VulkanFree(eng_Vulkan* vulkan, bool subAllocationsOnly)
 		return;
 	}
 
-	free(vulkan->Buffers);
+	if (vulkan->Device != VK_NULL_HANDLE)
+	{
+		vkDeviceWaitIdle(vulkan->Device);
+		vkDestroyQueryPool(vulkan->Device, vulkan->FrameTimestamps, NULL);
+		eng_InternalVkQueriesDestroy(vulkan);
+		vkDestroyFramebuffer(vulkan->Device, vulkan->SceneFramebuffer, NULL);
+		vkDestroyImageView(vulkan->Device, vulkan->SceneView, NULL);
+		vkDestroyImage(vulkan->Device, vulkan->SceneImage, NULL);
+		vkFreeMemory(vulkan->Device, vulkan->SceneMemory, NULL);
+	}
+	eng_StopwatchFree(vulkan->FrameStopwatch, true);
+	eng_AllocatorFree(vulkan->Allocator, vulkan->FrameStopwatch, eng_StopwatchGetSizeof());
+	eng_StopwatchFree(vulkan->AcquireStopwatch, true);
+	eng_AllocatorFree(vulkan->Allocator, vulkan->AcquireStopwatch, eng_StopwatchGetSizeof());
+
+	eng_AllocatorFreeType(vulkan->Allocator, vulkan->Buffers, eng_BufferInfo, vulkan->BufferCount);
 	eng_ArrayDestroy(&vulkan->Extensions);
+	eng_ArrayDestroy(&vulkan->OnPreRender);
+	eng_ArrayDestroy(&vulkan->OnRender);
+	eng_ArrayDestroy(&vulkan->OnOverlay);
+	eng_ArrayDestroy(&vulkan->QueryRegions);
 
 	if (!subAllocationsOnly)
 	{
@@ -105,11 +123,8 @@ size_t eng_VulkanGetSizeof(void)
 
 void eng_VulkanProvideExtensions(eng_Vulkan* vulkan, const char** extensions, uint32_t extensionsCount)
 {
-	eng_ArrayResize(&vulkan->Extensions, extensionsCount);
-	for (uint32_t i = 0; i < extensionsCount; ++i)
-	{
-		eng_ArrayIndexType(&vulkan->Extensions, const char*, i) = extensions[i];
-	}
+	vulkan->Extensions.Count = 0;
+	eng_ArrayPushBackMany(&vulkan->Extensions, (void*)extensions, extensionsCount);
 }
 
 
@@ -125,6 +140,22 @@ void eng_VulkanSetRequiresPresent(eng_Vulkan* vulkan, bool requiresPresent)
 {
 }
 
+void eng_VulkanSetDynamicResolution(eng_Vulkan* vulkan, const eng_DynamicResolutionSettings* settings)
+{
+	vulkan->DynamicResolution = *settings;
+}
+
+void eng_VulkanSetFrameAllocator(eng_Vulkan* vulkan, eng_FrameAllocator* frameAllocator)
+{
+	if (frameAllocator != NULL)
+	{
+		eng_Ensure(eng_FrameAllocatorGetFrameCount(frameAllocator) == ENG_VULKAN_FRAMES_IN_FLIGHT,
+			"Frame allocator needs %u frames to follow vulkan.\n", ENG_VULKAN_FRAMES_IN_FLIGHT);
+		eng_FrameAllocatorBeginFrame(frameAllocator, vulkan->FrameIndex);
+	}
+	vulkan->FrameAllocator = frameAllocator;
+}
+
 ////////////////////////////////////////////////////////////////////////// API
 bool eng_VulkanCreateInstance(eng_Vulkan* vulkan)
 {
@@ -171,26 +202,29 @@ bool eng_VulkanProvideSurface(eng_Vulkan* vulkan, VkSurfaceKHR surface, uint16_t
 
 		if (gpu_count > 0)
 		{
-			VkPhysicalDevice* gpus = calloc(gpu_count, sizeof(VkPhysicalDevice));
+			VkPhysicalDevice* gpus = eng_AllocatorCallocType(vulkan->Allocator, VkPhysicalDevice, gpu_count);
 			err = vkEnumeratePhysicalDevices(vulkan->Instance, &gpu_count, gpus);
 			assert(!err);
 			gpu = gpus[0];
-			free(gpus);
+			eng_AllocatorFreeType(vulkan->Allocator, gpus, VkPhysicalDevice, gpu_count);
 		}
 		else
 		{
 			gpu = VK_NULL_HANDLE;
 		}
+		vulkan->PhysicalDevice = gpu;
+		vkGetPhysicalDeviceMemoryProperties(gpu, &vulkan->MemoryProperties);
 	}
 
 	VkCommandPool cmd_pool;
 	{
 		uint32_t queue_family_index = UINT32_MAX;
+		uint32_t compute_family_index = UINT32_MAX;
 		{
 			uint32_t queue_count;
 			vkGetPhysicalDeviceQueueFamilyProperties(gpu, &queue_count, NULL);
 
-			VkQueueFamilyProperties* queue_props = calloc(queue_count, sizeof(VkQueueFamilyProperties));
+			VkQueueFamilyProperties* queue_props = eng_AllocatorCallocType(vulkan->Allocator, VkQueueFamilyProperties, queue_count);
 			vkGetPhysicalDeviceQueueFamilyProperties(gpu, &queue_count, queue_props);
 			assert(queue_count >= 1);
 
@@ -205,7 +239,18 @@ bool eng_VulkanProvideSurface(eng_Vulkan* vulkan, VkSurfaceKHR surface, uint16_t
 				}
 			}
 			assert(queue_family_index != UINT32_MAX);
-			free(queue_props);
+
+			// A compute-only family runs asynchronously alongside graphics.
+			compute_family_index = queue_family_index;
+			for (uint32_t i = 0; i < queue_count; i++)
+			{
+				if ((queue_props[i].queueFlags & VK_QUEUE_COMPUTE_BIT) != 0 && (queue_props[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) == 0)
+				{
+					compute_family_index = i;
+					break;
+				}
+			}
+			eng_AllocatorFreeType(vulkan->Allocator, queue_props, VkQueueFamilyProperties, queue_count);
 		}
 
 		uint32_t extension_count = 0;
@@ -213,25 +258,57 @@ bool eng_VulkanProvideSurface(eng_Vulkan* vulkan, VkSurfaceKHR surface, uint16_t
 		extension_count = 0;
 		extension_names[extension_count++] = VK_KHR_SWAPCHAIN_EXTENSION_NAME;
 
+		// Display timing reports the refresh rate, which frame pacing paces to.
+		uint32_t device_extension_count = 0;
+		err = vkEnumerateDeviceExtensionProperties(gpu, NULL, &device_extension_count, NULL);
+		assert(!err);
+		VkExtensionProperties* device_extensions = eng_AllocatorCallocType(vulkan->Allocator, VkExtensionProperties, device_extension_count);
+		err = vkEnumerateDeviceExtensionProperties(gpu, NULL, &device_extension_count, device_extensions);
+		assert(!err);
+		for (uint32_t i = 0; i < device_extension_count; i++)
+		{
+			if (strcmp(device_extensions[i].extensionName, VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME) == 0)
+			{
+				extension_names[extension_count++] = VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME;
+				vulkan->DisplayTiming = true;
+			}
+		}
+		eng_AllocatorFreeType(vulkan->Allocator, device_extensions, VkExtensionProperties, device_extension_count);
+
+		// Optional features are enabled wherever the device has them.
+		VkPhysicalDeviceFeatures supported_features;
+		vkGetPhysicalDeviceFeatures(gpu, &supported_features);
+		vulkan->EnabledFeatures.pipelineStatisticsQuery = supported_features.pipelineStatisticsQuery;
+		vulkan->EnabledFeatures.occlusionQueryPrecise = supported_features.occlusionQueryPrecise;
+
 		float queue_priorities[1] = {0.0};
-		const VkDeviceQueueCreateInfo queueInfo = {
-			.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
-			.queueFamilyIndex = queue_family_index,
-			.queueCount = 1,
-			.pQueuePriorities = queue_priorities};
+		const VkDeviceQueueCreateInfo queueInfos[2] = {
+			[0] = {
+				.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+				.queueFamilyIndex = queue_family_index,
+				.queueCount = 1,
+				.pQueuePriorities = queue_priorities},
+			[1] = {
+				.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+				.queueFamilyIndex = compute_family_index,
+				.queueCount = 1,
+				.pQueuePriorities = queue_priorities},
+		};
 
 		VkDeviceCreateInfo deviceInfo = {
 			.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
-			.queueCreateInfoCount = 1,
-			.pQueueCreateInfos = &queueInfo,
+			.queueCreateInfoCount = compute_family_index != queue_family_index ? 2 : 1,
+			.pQueueCreateInfos = queueInfos,
 			.enabledExtensionCount = extension_count,
 			.ppEnabledExtensionNames = (const char *const *)extension_names,
+			.pEnabledFeatures = &vulkan->EnabledFeatures,
 		};
 
 		err = vkCreateDevice(gpu, &deviceInfo, NULL, &vulkan->Device);
 		assert(!err);
 
 		vkGetDeviceQueue(vulkan->Device, queue_family_index, 0, &vulkan->Queue);
+		vulkan->QueueFamilyIndex = queue_family_index;
 
 		const VkCommandPoolCreateInfo cmd_pool_info = {
 			.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
@@ -240,6 +317,23 @@ bool eng_VulkanProvideSurface(eng_Vulkan* vulkan, VkSurfaceKHR surface, uint16_t
 		};
 		err = vkCreateCommandPool(vulkan->Device, &cmd_pool_info, NULL, &cmd_pool);
 		assert(!err);
+		vulkan->CommandPool = cmd_pool;
+
+		vulkan->ComputeQueueFamilyIndex = compute_family_index;
+		vulkan->ComputeQueue = vulkan->Queue;
+		vulkan->ComputeCommandPool = cmd_pool;
+		if (compute_family_index != queue_family_index)
+		{
+			vkGetDeviceQueue(vulkan->Device, compute_family_index, 0, &vulkan->ComputeQueue);
+
+			const VkCommandPoolCreateInfo compute_pool_info = {
+				.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+				.queueFamilyIndex = compute_family_index,
+				.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+			};
+			err = vkCreateCommandPool(vulkan->Device, &compute_pool_info, NULL, &vulkan->ComputeCommandPool);
+			assert(!err);
+		}
 	}
 
 	VkFormat           format;
@@ -249,7 +343,7 @@ bool eng_VulkanProvideSurface(eng_Vulkan* vulkan, VkSurfaceKHR surface, uint16_t
 		err = vkGetPhysicalDeviceSurfaceFormatsKHR(gpu, surface, &format_count, NULL);
 		assert(!err);
 
-		VkSurfaceFormatKHR* formats = calloc(format_count, sizeof(VkSurfaceFormatKHR));
+		VkSurfaceFormatKHR* formats = eng_AllocatorCallocType(vulkan->Allocator, VkSurfaceFormatKHR, format_count);
 		err = vkGetPhysicalDeviceSurfaceFormatsKHR(gpu, surface, &format_count, formats);
 		assert(!err);
 
@@ -263,8 +357,9 @@ bool eng_VulkanProvideSurface(eng_Vulkan* vulkan, VkSurfaceKHR surface, uint16_t
 			format = formats[0].format;
 		}
 		color_space = formats[0].colorSpace;
+		vulkan->SwapchainFormat = format;
 
-		free(formats);
+		eng_AllocatorFreeType(vulkan->Allocator, formats, VkSurfaceFormatKHR, format_count);
 	}
 
 	{
@@ -294,6 +389,8 @@ bool eng_VulkanProvideSurface(eng_Vulkan* vulkan, VkSurfaceKHR surface, uint16_t
 			vulkan->SwapchainExtent = surf_cap.currentExtent;
 		}
 
+		assert((surf_cap.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_DST_BIT) != 0);
+
 		swapchain_image_count = surf_cap.minImageCount + 1;
 		if ((surf_cap.maxImageCount > 0) && (swapchain_image_count > surf_cap.maxImageCount))
 		{
@@ -307,7 +404,8 @@ bool eng_VulkanProvideSurface(eng_Vulkan* vulkan, VkSurfaceKHR surface, uint16_t
 			.imageFormat = format,
 			.imageColorSpace = color_space,
 			.imageExtent = vulkan->SwapchainExtent,
-			.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
+			// The scene is upscaled into the swapchain image with a blit.
+			.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
 			.preTransform = surf_cap.currentTransform,
 			.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR,
 			.imageArrayLayers = 1,
@@ -320,19 +418,21 @@ bool eng_VulkanProvideSurface(eng_Vulkan* vulkan, VkSurfaceKHR surface, uint16_t
 		assert(!err);
 	}
 
-	vulkan->Buffers = calloc(swapchain_image_count, sizeof(eng_BufferInfo));
-
 	{
+		// The driver may make more images than asked for, so the buffers are
+		// sized by what it reports.
 		err = vkGetSwapchainImagesKHR(vulkan->Device, vulkan->Swapchain, &swapchain_image_count, 0);
 		assert(!err);
-		VkImage* swapchain_images = calloc(swapchain_image_count, sizeof(VkImage));
+		vulkan->Buffers = eng_AllocatorCallocType(vulkan->Allocator, eng_BufferInfo, swapchain_image_count);
+		vulkan->BufferCount = swapchain_image_count;
+		VkImage* swapchain_images = eng_AllocatorCallocType(vulkan->Allocator, VkImage, swapchain_image_count);
 		err = vkGetSwapchainImagesKHR(vulkan->Device, vulkan->Swapchain, &swapchain_image_count, swapchain_images);
 		assert(!err);
 		for (uint32_t i = 0; i < swapchain_image_count; i++)
 		{
 			vulkan->Buffers[i].image = swapchain_images[i];
 		}
-		free(swapchain_images);
+		eng_AllocatorFreeType(vulkan->Allocator, swapchain_images, VkImage, swapchain_image_count);
 	}
 
 	for (uint32_t i = 0; i < swapchain_image_count; i++)
@@ -361,7 +461,10 @@ bool eng_VulkanProvideSurface(eng_Vulkan* vulkan, VkSurfaceKHR surface, uint16_t
 		assert(!err);
 	}
 
-	const VkAttachmentDescription attachments[1] = {
+	// Both passes share a format and sample count, which is all render pass
+	// compatibility asks for. The scene pass clears and hands its image to
+	// the upscale blit; the overlay pass draws over the blit's result.
+	const VkAttachmentDescription attachments[2] = {
 		[0] = {
 			.format = format,
 			.samples = VK_SAMPLE_COUNT_1_BIT,
@@ -369,6 +472,16 @@ bool eng_VulkanProvideSurface(eng_Vulkan* vulkan, VkSurfaceKHR surface, uint16_t
 			.storeOp = VK_ATTACHMENT_STORE_OP_STORE,
 			.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
 			.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+			.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+			.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+		},
+		[1] = {
+			.format = format,
+			.samples = VK_SAMPLE_COUNT_1_BIT,
+			.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD,
+			.storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+			.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+			.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
 			.initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
 			.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
 		},
@@ -381,17 +494,48 @@ bool eng_VulkanProvideSurface(eng_Vulkan* vulkan, VkSurfaceKHR surface, uint16_t
 		.colorAttachmentCount = 1,
 		.pColorAttachments = &color_reference,
 	};
+	const VkSubpassDependency scene_dependencies[2] = {
+		// The previous frame's blit must finish reading before the clear.
+		[0] = {
+			.srcSubpass = VK_SUBPASS_EXTERNAL,
+			.dstSubpass = 0,
+			.srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT,
+			.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+			.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+		},
+		[1] = {
+			.srcSubpass = 0,
+			.dstSubpass = VK_SUBPASS_EXTERNAL,
+			.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+			.dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT,
+			.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+			.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT,
+		},
+	};
 	const VkRenderPassCreateInfo rp_info = {
 		.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
 		.attachmentCount = 1,
-		.pAttachments = attachments,
+		.pAttachments = &attachments[0],
 		.subpassCount = 1,
 		.pSubpasses = &subpass,
+		.dependencyCount = 2,
+		.pDependencies = scene_dependencies,
 	};
 
 	err = vkCreateRenderPass(vulkan->Device, &rp_info, NULL, &vulkan->RenderPass);
 	assert(!err);
 
+	const VkRenderPassCreateInfo overlay_rp_info = {
+		.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
+		.attachmentCount = 1,
+		.pAttachments = &attachments[1],
+		.subpassCount = 1,
+		.pSubpasses = &subpass,
+	};
+
+	err = vkCreateRenderPass(vulkan->Device, &overlay_rp_info, NULL, &vulkan->OverlayRenderPass);
+	assert(!err);
+
 	for (uint32_t i = 0; i < swapchain_image_count; i++)
 	{
 		VkImageView attachments[1] = {
@@ -400,7 +544,7 @@ bool eng_VulkanProvideSurface(eng_Vulkan* vulkan, VkSurfaceKHR surface, uint16_t
 
 		const VkFramebufferCreateInfo fb_info = {
 			.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
-			.renderPass = vulkan->RenderPass,
+			.renderPass = vulkan->OverlayRenderPass,
 			.attachmentCount = 1,
 			.pAttachments = attachments,
 			.width = vulkan->SwapchainExtent.width,
@@ -411,7 +555,9 @@ bool eng_VulkanProvideSurface(eng_Vulkan* vulkan, VkSurfaceKHR surface, uint16_t
 		err = vkCreateFramebuffer(vulkan->Device, &fb_info, NULL, &vulkan->Buffers[i].fb);
 		assert(!err);
 	}
-	return true;
+
+	vulkan->RenderExtent = vulkan->SwapchainExtent;
+	return eng_VulkanCreateSceneTarget(vulkan) && eng_VulkanCreateFrameTiming(vulkan) && eng_InternalVkQueriesCreate(vulkan);
 }
 
 VkInstance eng_VulkanGetInstance(eng_Vulkan* vulkan)
@@ -432,9 +578,14 @@ void eng_VulkanUpdate(eng_Vulkan* vulkan)
 	}
 
 	uint32_t current_buffer;
+	eng_StopwatchStart(vulkan->AcquireStopwatch);
 	err = vkAcquireNextImageKHR(vulkan->Device, vulkan->Swapchain, UINT64_MAX, present_complete_semaphore, (VkFence)0, &current_buffer);
+	eng_StopwatchStop(vulkan->AcquireStopwatch);
 	assert(!err);
 
+	eng_VulkanUpdateRenderScale(vulkan);
+	uint32_t frameIndex = vulkan->FrameIndex;
+
 	const VkCommandBufferBeginInfo cmd_buf_info = {
 		.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
 	};
@@ -445,8 +596,8 @@ void eng_VulkanUpdate(eng_Vulkan* vulkan)
 	const VkRenderPassBeginInfo rp_begin = {
 		.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
 		.renderPass = vulkan->RenderPass,
-		.framebuffer = vulkan->Buffers[current_buffer].fb,
-		.renderArea.extent = vulkan->SwapchainExtent,
+		.framebuffer = vulkan->SceneFramebuffer,
+		.renderArea.extent = vulkan->RenderExtent,
 		.clearValueCount = 1,
 		.pClearValues = clear_values,
 	};
@@ -454,12 +605,27 @@ void eng_VulkanUpdate(eng_Vulkan* vulkan)
 	err = vkBeginCommandBuffer(vulkan->DrawCmd, &cmd_buf_info);
 	assert(!err);
 
+	if (vulkan->FrameTimestamps != VK_NULL_HANDLE)
+	{
+		vkCmdResetQueryPool(vulkan->DrawCmd, vulkan->FrameTimestamps, frameIndex * 2, 2);
+		vkCmdWriteTimestamp(vulkan->DrawCmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, vulkan->FrameTimestamps, frameIndex * 2 + 0);
+	}
+
+	eng_InternalVkQueriesBeginFrame(vulkan, vulkan->DrawCmd);
+	eng_VulkanCallbackListExec(&vulkan->OnPreRender, vulkan->DrawCmd);
+
+	vkCmdBeginRenderPass(vulkan->DrawCmd, &rp_begin, VK_SUBPASS_CONTENTS_INLINE);
+	eng_VulkanQueryRegionBegin(vulkan, vulkan->DrawCmd, vulkan->SceneQueryRegion);
+	eng_VulkanCallbackListExec(&vulkan->OnRender, vulkan->DrawCmd);
+	eng_VulkanQueryRegionEnd(vulkan, vulkan->DrawCmd, vulkan->SceneQueryRegion);
+	vkCmdEndRenderPass(vulkan->DrawCmd);
+
 	VkImageMemoryBarrier image_memory_barrier = {
 		.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
 		.srcAccessMask = 0,
-		.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+		.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
 		.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-		.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+		.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
 		.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
 		.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
 		.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 },
@@ -467,10 +633,45 @@ void eng_VulkanUpdate(eng_Vulkan* vulkan)
 	};
 
 	vkCmdPipelineBarrier(
-		vulkan->DrawCmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+		vulkan->DrawCmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
 		0, 0, NULL, 0, NULL, 1, &image_memory_barrier);
 
-	vkCmdBeginRenderPass(vulkan->DrawCmd, &rp_begin, VK_SUBPASS_CONTENTS_INLINE);
+	const VkImageBlit upscale = {
+		.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 },
+		.srcOffsets = { { 0, 0, 0 }, { (int32_t)vulkan->RenderExtent.width, (int32_t)vulkan->RenderExtent.height, 1 } },
+		.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 },
+		.dstOffsets = { { 0, 0, 0 }, { (int32_t)vulkan->SwapchainExtent.width, (int32_t)vulkan->SwapchainExtent.height, 1 } },
+	};
+	vkCmdBlitImage(vulkan->DrawCmd, vulkan->SceneImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+		vulkan->Buffers[current_buffer].image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &upscale, vulkan->UpscaleFilter);
+
+	VkImageMemoryBarrier overlay_barrier = {
+		.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+		.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+		.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+		.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+		.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+		.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+		.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 },
+		.image = vulkan->Buffers[current_buffer].image,
+	};
+
+	vkCmdPipelineBarrier(
+		vulkan->DrawCmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+		0, 0, NULL, 0, NULL, 1, &overlay_barrier);
+
+	const VkRenderPassBeginInfo overlay_begin = {
+		.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+		.renderPass = vulkan->OverlayRenderPass,
+		.framebuffer = vulkan->Buffers[current_buffer].fb,
+		.renderArea.extent = vulkan->SwapchainExtent,
+	};
+
+	vkCmdBeginRenderPass(vulkan->DrawCmd, &overlay_begin, VK_SUBPASS_CONTENTS_INLINE);
+	eng_VulkanQueryRegionBegin(vulkan, vulkan->DrawCmd, vulkan->OverlayQueryRegion);
+	eng_VulkanCallbackListExec(&vulkan->OnOverlay, vulkan->DrawCmd);
+	eng_VulkanQueryRegionEnd(vulkan, vulkan->DrawCmd, vulkan->OverlayQueryRegion);
 	vkCmdEndRenderPass(vulkan->DrawCmd);
 
 	VkImageMemoryBarrier present_barrier = {
@@ -489,22 +690,36 @@ void eng_VulkanUpdate(eng_Vulkan* vulkan)
 		vulkan->DrawCmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
 		0, 0, NULL, 0, NULL, 1, &present_barrier);
 
+	if (vulkan->FrameTimestamps != VK_NULL_HANDLE)
+	{
+		vkCmdWriteTimestamp(vulkan->DrawCmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, vulkan->FrameTimestamps, frameIndex * 2 + 1);
+	}
+	vulkan->FrameTimings[frameIndex].QueriesWritten = vulkan->FrameTimestamps != VK_NULL_HANDLE;
+	vulkan->FrameTimings[frameIndex].RenderScale = vulkan->RenderScale;
+
 	err = vkEndCommandBuffer(vulkan->DrawCmd);
 	assert(!err);
 
-	VkPipelineStageFlags pipe_stage_flags = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+	// The acquire semaphore goes last, after any waits other systems queued.
+	vulkan->FrameWaitSemaphores[vulkan->FrameWaitCount] = present_complete_semaphore;
+	vulkan->FrameWaitStages[vulkan->FrameWaitCount] = VK_PIPELINE_STAGE_TRANSFER_BIT;
 
 	VkSubmitInfo submit_info = {
 		.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
 		.commandBufferCount = 1,
 		.pCommandBuffers = &vulkan->DrawCmd,
-		.waitSemaphoreCount = 1,
-		.pWaitSemaphores = &present_complete_semaphore,
-		.pWaitDstStageMask = &pipe_stage_flags,
+		.waitSemaphoreCount = vulkan->FrameWaitCount + 1,
+		.pWaitSemaphores = vulkan->FrameWaitSemaphores,
+		.pWaitDstStageMask = vulkan->FrameWaitStages,
 	};
 
+	if (vulkan->FrameStopwatch != NULL)
+	{
+		eng_StopwatchStart(vulkan->FrameStopwatch);
+	}
 	err = vkQueueSubmit(vulkan->Queue, 1, &submit_info, VK_NULL_HANDLE);
 	assert(!err);
+	vulkan->FrameWaitCount = 0;
 
 	VkPresentInfoKHR present = {
 		.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
@@ -522,9 +737,373 @@ void eng_VulkanUpdate(eng_Vulkan* vulkan)
 
 	err = vkQueueWaitIdle(vulkan->Queue);
 	assert(err == VK_SUCCESS);
+	if (vulkan->FrameStopwatch != NULL)
+	{
+		// Includes the present, which may wait for vblank on some drivers.
+		eng_StopwatchStop(vulkan->FrameStopwatch);
+		vulkan->GpuFrameMilliseconds = eng_StopwatchGetMilliseconds(vulkan->FrameStopwatch);
+	}
 
 	vkDestroySemaphore(vulkan->Device, present_complete_semaphore, NULL);
+
+	vulkan->FrameIndex = (vulkan->FrameIndex + 1) % ENG_VULKAN_FRAMES_IN_FLIGHT;
+	++vulkan->FrameNumber;
+	if (vulkan->FrameAllocator != NULL)
+	{
+		eng_FrameAllocatorBeginFrame(vulkan->FrameAllocator, vulkan->FrameIndex);
+	}
+}
+
+uint32_t eng_VulkanGetFrameIndex(eng_Vulkan* vulkan)
+{
+	return vulkan->FrameIndex;
+}
+
+void eng_VulkanGetExtent(eng_Vulkan* vulkan, uint32_t* outWidth, uint32_t* outHeight)
+{
+	*outWidth = vulkan->SwapchainExtent.width;
+	*outHeight = vulkan->SwapchainExtent.height;
+}
+
+void eng_VulkanGetRenderExtent(eng_Vulkan* vulkan, uint32_t* outWidth, uint32_t* outHeight)
+{
+	*outWidth = vulkan->RenderExtent.width;
+	*outHeight = vulkan->RenderExtent.height;
+}
+
+float eng_VulkanGetRenderScale(eng_Vulkan* vulkan)
+{
+	return vulkan->RenderScale;
+}
+
+double eng_VulkanGetFrameMilliseconds(eng_Vulkan* vulkan)
+{
+	return vulkan->GpuFrameMilliseconds;
+}
+
+double eng_VulkanGetAcquireMilliseconds(eng_Vulkan* vulkan)
+{
+	return vulkan->AcquireStopwatch != NULL ? eng_StopwatchGetMilliseconds(vulkan->AcquireStopwatch) : 0.0;
+}
+
+double eng_VulkanGetRefreshMilliseconds(eng_Vulkan* vulkan)
+{
+	return vulkan->RefreshMilliseconds;
+}
+
+////////////////////////////////////////////////////////////////////////// Callbacks
+void eng_OnPreRenderBind(eng_Vulkan* vulkan, eng_VulkanRecordCallback_t onPreRender, void* userData)
+{
+	eng_VulkanCallbackListBind(&vulkan->OnPreRender, onPreRender, userData);
+}
+
+void eng_OnPreRenderUnbind(eng_Vulkan* vulkan, eng_VulkanRecordCallback_t onPreRender)
+{
+	eng_VulkanCallbackListUnbind(&vulkan->OnPreRender, onPreRender);
+}
+
+void eng_OnRenderBind(eng_Vulkan* vulkan, eng_VulkanRecordCallback_t onRender, void* userData)
+{
+	eng_VulkanCallbackListBind(&vulkan->OnRender, onRender, userData);
+}
+
+void eng_OnRenderUnbind(eng_Vulkan* vulkan, eng_VulkanRecordCallback_t onRender)
+{
+	eng_VulkanCallbackListUnbind(&vulkan->OnRender, onRender);
+}
+
+void eng_OnOverlayBind(eng_Vulkan* vulkan, eng_VulkanRecordCallback_t onOverlay, void* userData)
+{
+	eng_VulkanCallbackListBind(&vulkan->OnOverlay, onOverlay, userData);
+}
+
+void eng_OnOverlayUnbind(eng_Vulkan* vulkan, eng_VulkanRecordCallback_t onOverlay)
+{
+	eng_VulkanCallbackListUnbind(&vulkan->OnOverlay, onOverlay);
 }
 
 
 ////////////////////////////////////////////////////////////////////////// Internal
+uint32_t eng_InternalVkFindMemoryType(eng_Vulkan* vulkan, uint32_t typeBits, VkMemoryPropertyFlags properties)
+{
+	for (uint32_t i = 0; i < vulkan->MemoryProperties.memoryTypeCount; ++i)
+	{
+		if ((typeBits & (1u << i)) && (vulkan->MemoryProperties.memoryTypes[i].propertyFlags & properties) == properties)
+		{
+			return i;
+		}
+	}
+	return UINT32_MAX;
+}
+
+bool eng_InternalVkCreateBuffer(eng_Vulkan* vulkan, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer* outBuffer, VkDeviceMemory* outMemory)
+{
+	return eng_InternalVkCreateSharedBuffer(vulkan, size, usage, properties, false, outBuffer, outMemory);
+}
+
+bool eng_InternalVkCreateSharedBuffer(eng_Vulkan* vulkan, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, bool sharedWithCompute, VkBuffer* outBuffer, VkDeviceMemory* outMemory)
+{
+	const uint32_t families[2] = { vulkan->QueueFamilyIndex, vulkan->ComputeQueueFamilyIndex };
+	bool concurrent = sharedWithCompute && families[0] != families[1];
+	const VkBufferCreateInfo bufferInfo = {
+		.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+		.size = size,
+		.usage = usage,
+		.sharingMode = concurrent ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+		.queueFamilyIndexCount = concurrent ? 2 : 0,
+		.pQueueFamilyIndices = concurrent ? families : NULL,
+	};
+	VkResult result = vkCreateBuffer(vulkan->Device, &bufferInfo, NULL, outBuffer);
+	eng_VulkanEnsure(result, "create buffer");
+
+	VkMemoryRequirements requirements;
+	vkGetBufferMemoryRequirements(vulkan->Device, *outBuffer, &requirements);
+
+	const VkMemoryAllocateInfo allocInfo = {
+		.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+		.allocationSize = requirements.size,
+		.memoryTypeIndex = eng_InternalVkFindMemoryType(vulkan, requirements.memoryTypeBits, properties),
+	};
+	if (!eng_Ensure(allocInfo.memoryTypeIndex != UINT32_MAX, "No memory type fits buffer usage 0x%X.\n", (unsigned)usage))
+	{
+		vkDestroyBuffer(vulkan->Device, *outBuffer, NULL);
+		return false;
+	}
+	result = vkAllocateMemory(vulkan->Device, &allocInfo, NULL, outMemory);
+	eng_VulkanEnsure(result, "allocate buffer memory");
+
+	result = vkBindBufferMemory(vulkan->Device, *outBuffer, *outMemory, 0);
+	eng_VulkanEnsure(result, "bind buffer memory");
+	return true;
+}
+
+void eng_VulkanCallbackListBind(eng_Array* callbackList, eng_VulkanRecordCallback_t func, void* userData)
+{
+	eng_VulkanCallback callback = { .Func = func, .UserData = userData };
+	eng_ArrayPushBack(callbackList, &callback);
+}
+
+void eng_VulkanCallbackListUnbind(eng_Array* callbackList, eng_VulkanRecordCallback_t func)
+{
+	for (uint32_t i = 0; i < callbackList->Count; ++i)
+	{
+		if (eng_ArrayPIndexType(callbackList, eng_VulkanCallback, i)->Func == func)
+		{
+			// Keep bind order: callbacks record passes and draws in sequence.
+			eng_ArrayRemoveInPlace(callbackList, i);
+			return;
+		}
+	}
+}
+
+void eng_VulkanCallbackListExec(eng_Array* callbackList, VkCommandBuffer cmd)
+{
+	for (uint32_t i = 0; i < callbackList->Count; ++i)
+	{
+		eng_VulkanCallback* callback = eng_ArrayPIndexType(callbackList, eng_VulkanCallback, i);
+		callback->Func(callback->UserData, cmd);
+	}
+}
+
+void eng_InternalVkWaitOnSemaphore(eng_Vulkan* vulkan, VkSemaphore semaphore, VkPipelineStageFlags stages)
+{
+	if (!eng_Ensure(vulkan->FrameWaitCount < ENG_VULKAN_MAX_FRAME_WAITS, "Too many semaphores for one frame to wait on.\n"))
+	{
+		return;
+	}
+	vulkan->FrameWaitSemaphores[vulkan->FrameWaitCount] = semaphore;
+	vulkan->FrameWaitStages[vulkan->FrameWaitCount] = stages;
+	++vulkan->FrameWaitCount;
+}
+
+VkShaderModule eng_InternalVkLoadShader(eng_Vulkan* vulkan, const char* path)
+{
+	FILE* file = fopen(path, "rb");
+	if (!eng_Ensure(file != NULL, "Failed to open shader \"%s\".\n", path))
+	{
+		return VK_NULL_HANDLE;
+	}
+
+	fseek(file, 0, SEEK_END);
+	long size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	// SPIR-V is a stream of 32 bit words.
+	uint32_t* code = NULL;
+	if (size > 0 && (size % sizeof(uint32_t)) == 0)
+	{
+		code = eng_AllocatorAlloc(vulkan->Allocator, (size_t)size, ENG_ALIGNOF(uint32_t));
+		if (code != NULL && fread(code, 1, (size_t)size, file) != (size_t)size)
+		{
+			eng_AllocatorFree(vulkan->Allocator, code, (size_t)size);
+			code = NULL;
+		}
+	}
+	fclose(file);
+	if (!eng_Ensure(code != NULL, "Shader \"%s\" is not valid SPIR-V.\n", path))
+	{
+		return VK_NULL_HANDLE;
+	}
+
+	const VkShaderModuleCreateInfo moduleInfo = {
+		.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+		.codeSize = (size_t)size,
+		.pCode = code,
+	};
+	VkShaderModule module = VK_NULL_HANDLE;
+	VkResult result = vkCreateShaderModule(vulkan->Device, &moduleInfo, NULL, &module);
+	eng_AllocatorFree(vulkan->Allocator, code, (size_t)size);
+	if (!eng_Ensure(result == VK_SUCCESS, "Failed to create shader module \"%s\". Error(%d): \"%s\"", path, (int)result, eng_InternalVkResultToString(result)))
+	{
+		return VK_NULL_HANDLE;
+	}
+	return module;
+}
+
+bool eng_VulkanCreateSceneTarget(eng_Vulkan* vulkan)
+{
+	VkFormatProperties formatProperties;
+	vkGetPhysicalDeviceFormatProperties(vulkan->PhysicalDevice, vulkan->SwapchainFormat, &formatProperties);
+	const VkFormatFeatureFlags blit = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT;
+	if (!eng_Ensure((formatProperties.optimalTilingFeatures & blit) == blit, "Swapchain format %s can't be blitted to upscale the scene.\n", eng_InternalVKFormatToString(vulkan->SwapchainFormat)))
+	{
+		return false;
+	}
+	vulkan->UpscaleFilter = (formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT) != 0
+		? VK_FILTER_LINEAR
+		: VK_FILTER_NEAREST;
+
+	const VkImageCreateInfo imageInfo = {
+		.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+		.imageType = VK_IMAGE_TYPE_2D,
+		.format = vulkan->SwapchainFormat,
+		.extent = { vulkan->SwapchainExtent.width, vulkan->SwapchainExtent.height, 1 },
+		.mipLevels = 1,
+		.arrayLayers = 1,
+		.samples = VK_SAMPLE_COUNT_1_BIT,
+		.tiling = VK_IMAGE_TILING_OPTIMAL,
+		.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+		.sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+		.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+	};
+	VkResult result = vkCreateImage(vulkan->Device, &imageInfo, NULL, &vulkan->SceneImage);
+	eng_VulkanEnsure(result, "create scene image");
+
+	VkMemoryRequirements requirements;
+	vkGetImageMemoryRequirements(vulkan->Device, vulkan->SceneImage, &requirements);
+	const VkMemoryAllocateInfo allocInfo = {
+		.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+		.allocationSize = requirements.size,
+		.memoryTypeIndex = eng_InternalVkFindMemoryType(vulkan, requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
+	};
+	result = vkAllocateMemory(vulkan->Device, &allocInfo, NULL, &vulkan->SceneMemory);
+	eng_VulkanEnsure(result, "allocate scene image memory");
+	result = vkBindImageMemory(vulkan->Device, vulkan->SceneImage, vulkan->SceneMemory, 0);
+	eng_VulkanEnsure(result, "bind scene image memory");
+
+	const VkImageViewCreateInfo viewInfo = {
+		.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+		.image = vulkan->SceneImage,
+		.viewType = VK_IMAGE_VIEW_TYPE_2D,
+		.format = vulkan->SwapchainFormat,
+		.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 },
+	};
+	result = vkCreateImageView(vulkan->Device, &viewInfo, NULL, &vulkan->SceneView);
+	eng_VulkanEnsure(result, "create scene image view");
+
+	const VkFramebufferCreateInfo framebufferInfo = {
+		.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
+		.renderPass = vulkan->RenderPass,
+		.attachmentCount = 1,
+		.pAttachments = &vulkan->SceneView,
+		.width = vulkan->SwapchainExtent.width,
+		.height = vulkan->SwapchainExtent.height,
+		.layers = 1,
+	};
+	result = vkCreateFramebuffer(vulkan->Device, &framebufferInfo, NULL, &vulkan->SceneFramebuffer);
+	eng_VulkanEnsure(result, "create scene framebuffer");
+	return true;
+}
+
+bool eng_VulkanCreateFrameTiming(eng_Vulkan* vulkan)
+{
+	uint32_t familyCount = 0;
+	vkGetPhysicalDeviceQueueFamilyProperties(vulkan->PhysicalDevice, &familyCount, NULL);
+	VkQueueFamilyProperties* families = eng_AllocatorCallocType(vulkan->Allocator, VkQueueFamilyProperties, familyCount);
+	if (families == NULL)
+	{
+		return false;
+	}
+	vkGetPhysicalDeviceQueueFamilyProperties(vulkan->PhysicalDevice, &familyCount, families);
+	bool canTime = families[vulkan->QueueFamilyIndex].timestampValidBits > 0;
+	eng_AllocatorFreeType(vulkan->Allocator, families, VkQueueFamilyProperties, familyCount);
+
+	// Time blocked on the swapchain is reported separately so frame pacing
+	// can tell waiting for the display apart from the frame's own work.
+	vulkan->AcquireStopwatch = eng_AllocatorAlloc(vulkan->Allocator, eng_StopwatchGetSizeof(), ENG_ALLOCATOR_DEFAULT_ALIGNMENT);
+	if (!eng_Ensure(vulkan->AcquireStopwatch != NULL && eng_StopwatchInit(vulkan->AcquireStopwatch), "Failed to create the acquire stopwatch.\n"))
+	{
+		return false;
+	}
+
+	if (vulkan->DisplayTiming)
+	{
+		PFN_vkGetRefreshCycleDurationGOOGLE getRefreshCycleDuration =
+			(PFN_vkGetRefreshCycleDurationGOOGLE)vkGetDeviceProcAddr(vulkan->Device, "vkGetRefreshCycleDurationGOOGLE");
+		VkRefreshCycleDurationGOOGLE refresh;
+		if (getRefreshCycleDuration != NULL && getRefreshCycleDuration(vulkan->Device, vulkan->Swapchain, &refresh) == VK_SUCCESS)
+		{
+			vulkan->RefreshMilliseconds = (double)refresh.refreshDuration * 1e-6;
+		}
+	}
+
+	if (!canTime)
+	{
+		vulkan->FrameStopwatch = eng_AllocatorAlloc(vulkan->Allocator, eng_StopwatchGetSizeof(), ENG_ALLOCATOR_DEFAULT_ALIGNMENT);
+		return eng_Ensure(vulkan->FrameStopwatch != NULL && eng_StopwatchInit(vulkan->FrameStopwatch), "Failed to create the frame stopwatch.\n");
+	}
+
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(vulkan->PhysicalDevice, &properties);
+	vulkan->NanosecondsPerTick = properties.limits.timestampPeriod;
+
+	const VkQueryPoolCreateInfo poolInfo = {
+		.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+		.queryType = VK_QUERY_TYPE_TIMESTAMP,
+		.queryCount = ENG_VULKAN_FRAMES_IN_FLIGHT * 2,
+	};
+	VkResult result = vkCreateQueryPool(vulkan->Device, &poolInfo, NULL, &vulkan->FrameTimestamps);
+	eng_VulkanEnsure(result, "create frame timestamp pool");
+	return true;
+}
+
+void eng_VulkanUpdateRenderScale(eng_Vulkan* vulkan)
+{
+	eng_VulkanFrameTiming* timing = &vulkan->FrameTimings[vulkan->FrameIndex];
+	float measuredScale = vulkan->RenderScale;
+	bool measured = vulkan->FrameStopwatch != NULL;
+
+	// This frame slot's last frame has finished, so its timestamps are in.
+	if (timing->QueriesWritten)
+	{
+		uint64_t ticks[2];
+		VkResult result = vkGetQueryPoolResults(vulkan->Device, vulkan->FrameTimestamps, vulkan->FrameIndex * 2, 2,
+			sizeof(ticks), ticks, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+		timing->QueriesWritten = false;
+		if (result == VK_SUCCESS)
+		{
+			vulkan->GpuFrameMilliseconds = (double)(ticks[1] - ticks[0]) * vulkan->NanosecondsPerTick * 1e-6;
+			measuredScale = timing->RenderScale;
+			measured = true;
+		}
+	}
+
+	if (measured || !vulkan->DynamicResolution.Enabled)
+	{
+		// Step from the scale the measured frame was drawn at; its time only
+		// says something about that frame's pixel count.
+		vulkan->RenderScale = eng_DynamicResolutionNextScale(&vulkan->DynamicResolution, measuredScale, vulkan->GpuFrameMilliseconds);
+	}
+	eng_DynamicResolutionGetExtent(vulkan->RenderScale, vulkan->SwapchainExtent.width, vulkan->SwapchainExtent.height,
+		&vulkan->RenderExtent.width, &vulkan->RenderExtent.height);
+}
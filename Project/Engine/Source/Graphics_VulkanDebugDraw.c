@@ -0,0 +1,403 @@
+#include <Engine/Graphics_VulkanDebugDraw.h>
+
+#if !defined(GAME_FINAL)
+
+#include <Engine/Atomic.h>
+#include <Engine/Graphics_Vulkan.h>
+#include <Engine/Log.h>
+
+#if defined(GAME_WINDOWS)
+#define VK_USE_PLATFORM_WIN32_KHR
+#endif
+#include <ThirdParty/Vulkan/vulkan.h>
+
+#include <Engine/Graphics_VulkanInternal.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+// Must match DebugDraw.vert.
+#define PRIMITIVE_LINE 0
+#define PRIMITIVE_BOX 1
+#define PRIMITIVE_SPHERE 2
+#define PRIMITIVE_COUNT 3
+#define SPHERE_SEGMENTS 32
+// A stream handed to the GPU stays busy for up to ENG_VULKAN_FRAMES_IN_FLIGHT
+// frames, and one more is always being filled.
+#define STREAM_COUNT (ENG_VULKAN_FRAMES_IN_FLIGHT + 1)
+// Reservations hold the stream being filled above the slot bits.
+#define SLOT_BITS 24
+#define SLOT_MASK ((1u << SLOT_BITS) - 1)
+
+// Every primitive is one instance; the vertex shader expands it into a
+// line list of this many vertices.
+static const uint32_t VerticesPerPrimitive[PRIMITIVE_COUNT] = {
+	[PRIMITIVE_LINE] = 2,
+	[PRIMITIVE_BOX] = 24,
+	[PRIMITIVE_SPHERE] = 3 * SPHERE_SEGMENTS * 2,
+};
+
+// Line: A to B. Box: A min, B max. Sphere: A center, B[0] radius.
+typedef struct eng_DebugDrawPrimitive
+{
+	float A[3];
+	uint32_t Color;
+	float B[3];
+	float Padding;
+} eng_DebugDrawPrimitive;
+
+typedef struct eng_DebugDrawPushConstants
+{
+	float ViewProjection[16];
+	uint32_t Primitive;
+} eng_DebugDrawPushConstants;
+
+typedef struct eng_VulkanDebugDrawStream
+{
+	VkBuffer PrimitiveBuffer;
+	VkDeviceMemory PrimitiveMemory;
+	// MaxPrimitives of each type, one type after another.
+	eng_DebugDrawPrimitive* Primitives;
+	// Pushes per type that are done with their slot, written or dropped.
+	volatile int32_t Written[PRIMITIVE_COUNT];
+} eng_VulkanDebugDrawStream;
+
+typedef struct eng_VulkanDebugDraw
+{
+	eng_Vulkan* Vulkan;
+	uint32_t MaxPrimitives;
+	float ViewProjection[16];
+	uint32_t DroppedCount;
+
+	VkPipelineLayout PipelineLayout;
+	VkPipeline Pipeline;
+
+	// Per type, the stream being filled in the top bits and the slots
+	// reserved in it below SLOT_BITS. Can run past MaxPrimitives; those are
+	// dropped, up to SLOT_MASK pushes a frame. One atomic add picks both, so
+	// a push can't land in a stream after it's been handed to the GPU.
+	volatile int32_t Reserved[PRIMITIVE_COUNT];
+	// Only changed by the recording thread.
+	uint32_t FillingStream;
+	eng_VulkanDebugDrawStream Streams[STREAM_COUNT];
+} eng_VulkanDebugDraw;
+
+bool eng_VulkanDebugDrawCreateBuffers(eng_VulkanDebugDraw* debugDraw);
+bool eng_VulkanDebugDrawCreatePipeline(eng_VulkanDebugDraw* debugDraw);
+void eng_VulkanDebugDrawPush(eng_VulkanDebugDraw* debugDraw, uint32_t primitive, const eng_DebugDrawPrimitive* value);
+void eng_VulkanDebugDrawRecord(void* userData, VkCommandBuffer cmd);
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+eng_VulkanDebugDraw* eng_VulkanDebugDrawMalloc(void)
+{
+	return malloc(sizeof(eng_VulkanDebugDraw));
+}
+
+bool eng_VulkanDebugDrawInit(eng_VulkanDebugDraw* debugDraw, eng_Vulkan* vulkan, uint32_t maxPrimitivesPerFrame)
+{
+	memset(debugDraw, 0, sizeof(eng_VulkanDebugDraw));
+	debugDraw->Vulkan = vulkan;
+	debugDraw->MaxPrimitives = maxPrimitivesPerFrame;
+	debugDraw->ViewProjection[0] = debugDraw->ViewProjection[5] = debugDraw->ViewProjection[10] = debugDraw->ViewProjection[15] = 1.0f;
+
+	if (!eng_Ensure(maxPrimitivesPerFrame > 0 && maxPrimitivesPerFrame < SLOT_MASK, "Debug draw needs room for between 1 and %u primitives per frame.\n", SLOT_MASK - 1))
+	{
+		return false;
+	}
+
+	if (!eng_VulkanDebugDrawCreateBuffers(debugDraw) || !eng_VulkanDebugDrawCreatePipeline(debugDraw))
+	{
+		return false;
+	}
+
+	eng_OnRenderBind(vulkan, eng_VulkanDebugDrawRecord, debugDraw);
+	return true;
+}
+
+void eng_VulkanDebugDrawFree(eng_VulkanDebugDraw* debugDraw, bool subAllocationsOnly)
+{
+	if (debugDraw == NULL)
+	{
+		return;
+	}
+
+	VkDevice device = debugDraw->Vulkan->Device;
+	eng_OnRenderUnbind(debugDraw->Vulkan, eng_VulkanDebugDrawRecord);
+	vkDeviceWaitIdle(device);
+
+	vkDestroyPipeline(device, debugDraw->Pipeline, NULL);
+	vkDestroyPipelineLayout(device, debugDraw->PipelineLayout, NULL);
+	for (uint32_t i = 0; i < STREAM_COUNT; ++i)
+	{
+		vkDestroyBuffer(device, debugDraw->Streams[i].PrimitiveBuffer, NULL);
+		vkFreeMemory(device, debugDraw->Streams[i].PrimitiveMemory, NULL);
+	}
+
+	if (!subAllocationsOnly)
+	{
+		free(debugDraw);
+	}
+}
+
+size_t eng_VulkanDebugDrawGetSizeof(void)
+{
+	return sizeof(eng_VulkanDebugDraw);
+}
+
+////////////////////////////////////////////////////////////////////////// API
+void eng_VulkanDebugDrawSetViewProjection(eng_VulkanDebugDraw* debugDraw, const float viewProjection[16])
+{
+	memcpy(debugDraw->ViewProjection, viewProjection, sizeof(debugDraw->ViewProjection));
+}
+
+void eng_VulkanDebugDrawLine(eng_VulkanDebugDraw* debugDraw, const float from[3], const float to[3], uint32_t color)
+{
+	const eng_DebugDrawPrimitive line = {
+		.A = { from[0], from[1], from[2] },
+		.Color = color,
+		.B = { to[0], to[1], to[2] },
+	};
+	eng_VulkanDebugDrawPush(debugDraw, PRIMITIVE_LINE, &line);
+}
+
+void eng_VulkanDebugDrawBox(eng_VulkanDebugDraw* debugDraw, const float min[3], const float max[3], uint32_t color)
+{
+	const eng_DebugDrawPrimitive box = {
+		.A = { min[0], min[1], min[2] },
+		.Color = color,
+		.B = { max[0], max[1], max[2] },
+	};
+	eng_VulkanDebugDrawPush(debugDraw, PRIMITIVE_BOX, &box);
+}
+
+void eng_VulkanDebugDrawSphere(eng_VulkanDebugDraw* debugDraw, const float center[3], float radius, uint32_t color)
+{
+	const eng_DebugDrawPrimitive sphere = {
+		.A = { center[0], center[1], center[2] },
+		.Color = color,
+		.B = { radius },
+	};
+	eng_VulkanDebugDrawPush(debugDraw, PRIMITIVE_SPHERE, &sphere);
+}
+
+uint32_t eng_VulkanDebugDrawGetDroppedCount(eng_VulkanDebugDraw* debugDraw)
+{
+	return debugDraw->DroppedCount;
+}
+
+////////////////////////////////////////////////////////////////////////// Internal
+void eng_VulkanDebugDrawPush(eng_VulkanDebugDraw* debugDraw, uint32_t primitive, const eng_DebugDrawPrimitive* value)
+{
+	uint32_t reservation = (uint32_t)eng_AtomicIncrement32(&debugDraw->Reserved[primitive]) - 1;
+	eng_VulkanDebugDrawStream* stream = &debugDraw->Streams[reservation >> SLOT_BITS];
+	uint32_t slot = reservation & SLOT_MASK;
+	if (slot < debugDraw->MaxPrimitives)
+	{
+		stream->Primitives[primitive * debugDraw->MaxPrimitives + slot] = *value;
+	}
+	eng_AtomicIncrement32(&stream->Written[primitive]);
+}
+
+bool eng_VulkanDebugDrawCreateBuffers(eng_VulkanDebugDraw* debugDraw)
+{
+	eng_Vulkan* vulkan = debugDraw->Vulkan;
+	const VkMemoryPropertyFlags hostVisible = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+	// Primitives are written straight into mapped memory as they're drawn.
+	VkDeviceSize primitiveBytes = (VkDeviceSize)debugDraw->MaxPrimitives * PRIMITIVE_COUNT * sizeof(eng_DebugDrawPrimitive);
+	for (uint32_t i = 0; i < STREAM_COUNT; ++i)
+	{
+		eng_VulkanDebugDrawStream* stream = &debugDraw->Streams[i];
+		if (!eng_InternalVkCreateBuffer(vulkan, primitiveBytes, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, hostVisible,
+			&stream->PrimitiveBuffer, &stream->PrimitiveMemory))
+		{
+			return false;
+		}
+		VkResult result = vkMapMemory(vulkan->Device, stream->PrimitiveMemory, 0, primitiveBytes, 0, (void**)&stream->Primitives);
+		eng_VulkanEnsure(result, "map debug draw primitives");
+	}
+
+	return true;
+}
+
+bool eng_VulkanDebugDrawCreatePipeline(eng_VulkanDebugDraw* debugDraw)
+{
+	eng_Vulkan* vulkan = debugDraw->Vulkan;
+
+	const VkPushConstantRange pushRange = {
+		.stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
+		.offset = 0,
+		.size = sizeof(eng_DebugDrawPushConstants),
+	};
+	const VkPipelineLayoutCreateInfo layoutInfo = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+		.pushConstantRangeCount = 1,
+		.pPushConstantRanges = &pushRange,
+	};
+	VkResult result = vkCreatePipelineLayout(vulkan->Device, &layoutInfo, NULL, &debugDraw->PipelineLayout);
+	eng_VulkanEnsure(result, "create debug draw pipeline layout");
+
+	VkShaderModule vertexShader = eng_InternalVkLoadShader(vulkan, "Shaders/DebugDraw.vert.spv");
+	VkShaderModule fragmentShader = eng_InternalVkLoadShader(vulkan, "Shaders/DebugDraw.frag.spv");
+	if (vertexShader == VK_NULL_HANDLE || fragmentShader == VK_NULL_HANDLE)
+	{
+		vkDestroyShaderModule(vulkan->Device, vertexShader, NULL);
+		vkDestroyShaderModule(vulkan->Device, fragmentShader, NULL);
+		return false;
+	}
+
+	const VkPipelineShaderStageCreateInfo stages[2] = {
+		[0] = {
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+			.stage = VK_SHADER_STAGE_VERTEX_BIT,
+			.module = vertexShader,
+			.pName = "main",
+		},
+		[1] = {
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+			.stage = VK_SHADER_STAGE_FRAGMENT_BIT,
+			.module = fragmentShader,
+			.pName = "main",
+		},
+	};
+
+	// One instance per primitive; all three types share the layout so one
+	// pipeline draws them all.
+	const VkVertexInputBindingDescription primitiveBinding = {
+		.binding = 0,
+		.stride = sizeof(eng_DebugDrawPrimitive),
+		.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE,
+	};
+	const VkVertexInputAttributeDescription primitiveAttributes[3] = {
+		[0] = { .location = 0, .binding = 0, .format = VK_FORMAT_R32G32B32_SFLOAT, .offset = offsetof(eng_DebugDrawPrimitive, A) },
+		[1] = { .location = 1, .binding = 0, .format = VK_FORMAT_R8G8B8A8_UNORM, .offset = offsetof(eng_DebugDrawPrimitive, Color) },
+		[2] = { .location = 2, .binding = 0, .format = VK_FORMAT_R32G32B32_SFLOAT, .offset = offsetof(eng_DebugDrawPrimitive, B) },
+	};
+	const VkPipelineVertexInputStateCreateInfo vertexInput = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+		.vertexBindingDescriptionCount = 1,
+		.pVertexBindingDescriptions = &primitiveBinding,
+		.vertexAttributeDescriptionCount = 3,
+		.pVertexAttributeDescriptions = primitiveAttributes,
+	};
+	const VkPipelineInputAssemblyStateCreateInfo inputAssembly = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
+		.topology = VK_PRIMITIVE_TOPOLOGY_LINE_LIST,
+	};
+	const VkPipelineViewportStateCreateInfo viewportState = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+		.viewportCount = 1,
+		.scissorCount = 1,
+	};
+	const VkPipelineRasterizationStateCreateInfo rasterization = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
+		.polygonMode = VK_POLYGON_MODE_FILL,
+		.cullMode = VK_CULL_MODE_NONE,
+		.frontFace = VK_FRONT_FACE_CLOCKWISE,
+		.lineWidth = 1.0f,
+	};
+	const VkPipelineMultisampleStateCreateInfo multisample = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+		.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+	};
+	const VkPipelineColorBlendAttachmentState blendAttachment = {
+		.blendEnable = VK_TRUE,
+		.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA,
+		.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA,
+		.colorBlendOp = VK_BLEND_OP_ADD,
+		.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE,
+		.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA,
+		.alphaBlendOp = VK_BLEND_OP_ADD,
+		.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT,
+	};
+	const VkPipelineColorBlendStateCreateInfo colorBlend = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+		.attachmentCount = 1,
+		.pAttachments = &blendAttachment,
+	};
+	const VkDynamicState dynamicStates[2] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+	const VkPipelineDynamicStateCreateInfo dynamicState = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+		.dynamicStateCount = 2,
+		.pDynamicStates = dynamicStates,
+	};
+
+	const VkGraphicsPipelineCreateInfo pipelineInfo = {
+		.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+		.stageCount = 2,
+		.pStages = stages,
+		.pVertexInputState = &vertexInput,
+		.pInputAssemblyState = &inputAssembly,
+		.pViewportState = &viewportState,
+		.pRasterizationState = &rasterization,
+		.pMultisampleState = &multisample,
+		.pColorBlendState = &colorBlend,
+		.pDynamicState = &dynamicState,
+		.layout = debugDraw->PipelineLayout,
+		.renderPass = vulkan->RenderPass,
+		.subpass = 0,
+	};
+	result = vkCreateGraphicsPipelines(vulkan->Device, VK_NULL_HANDLE, 1, &pipelineInfo, NULL, &debugDraw->Pipeline);
+
+	vkDestroyShaderModule(vulkan->Device, vertexShader, NULL);
+	vkDestroyShaderModule(vulkan->Device, fragmentShader, NULL);
+	eng_VulkanEnsure(result, "create debug draw pipeline");
+	return true;
+}
+
+void eng_VulkanDebugDrawRecord(void* userData, VkCommandBuffer cmd)
+{
+	eng_VulkanDebugDraw* debugDraw = (eng_VulkanDebugDraw*)userData;
+	eng_VulkanDebugDrawStream* stream = &debugDraw->Streams[debugDraw->FillingStream];
+	debugDraw->FillingStream = (debugDraw->FillingStream + 1) % STREAM_COUNT;
+
+	VkExtent2D renderExtent = debugDraw->Vulkan->RenderExtent;
+	const VkViewport viewport = {
+		.width = (float)renderExtent.width,
+		.height = (float)renderExtent.height,
+		.maxDepth = 1.0f,
+	};
+	const VkRect2D scissor = { .extent = renderExtent };
+	eng_DebugDrawPushConstants constants;
+	memcpy(constants.ViewProjection, debugDraw->ViewProjection, sizeof(constants.ViewProjection));
+	const VkDeviceSize primitiveOffset = 0;
+	bool bound = false;
+
+	debugDraw->DroppedCount = 0;
+	for (uint32_t primitive = 0; primitive < PRIMITIVE_COUNT; ++primitive)
+	{
+		// Pushes from here on fill the next stream. Ones that reserved a slot
+		// in this stream before the swap may still be writing it.
+		uint32_t reservation = (uint32_t)eng_AtomicExchange32(&debugDraw->Reserved[primitive], (int32_t)(debugDraw->FillingStream << SLOT_BITS));
+		uint32_t count = reservation & SLOT_MASK;
+		while ((uint32_t)eng_AtomicLoad32(&stream->Written[primitive]) != count)
+		{
+		}
+		eng_AtomicStore32(&stream->Written[primitive], 0);
+		if (count > debugDraw->MaxPrimitives)
+		{
+			debugDraw->DroppedCount += count - debugDraw->MaxPrimitives;
+			count = debugDraw->MaxPrimitives;
+		}
+		if (count == 0)
+		{
+			continue;
+		}
+
+		if (!bound)
+		{
+			vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, debugDraw->Pipeline);
+			vkCmdSetViewport(cmd, 0, 1, &viewport);
+			vkCmdSetScissor(cmd, 0, 1, &scissor);
+			vkCmdBindVertexBuffers(cmd, 0, 1, &stream->PrimitiveBuffer, &primitiveOffset);
+			bound = true;
+		}
+
+		// Each type is one draw, its instances starting at its section of the stream.
+		constants.Primitive = primitive;
+		vkCmdPushConstants(cmd, debugDraw->PipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(constants), &constants);
+		vkCmdDraw(cmd, VerticesPerPrimitive[primitive], count, 0, primitive * debugDraw->MaxPrimitives);
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,510 @@
+#include <Engine/Graphics_VulkanLightCulling.h>
+
+#include <Engine/Allocator.h>
+#include <Engine/Graphics_Vulkan.h>
+#include <Engine/Log.h>
+
+#if defined(GAME_WINDOWS)
+#define VK_USE_PLATFORM_WIN32_KHR
+#endif
+#include <ThirdParty/Vulkan/vulkan.h>
+
+#include <Engine/Graphics_VulkanInternal.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+// Must match local_size_x in LightCulling.comp.
+#define CULLING_GROUP_SIZE 64
+// min xyz, pad, max xyz, pad: two std430 vec4s.
+#define BOUNDS_FLOATS_PER_CLUSTER 8
+// Mismatches logged by eng_VulkanLightCullingValidate before it gives up listing them.
+#define MAX_REPORTED_MISMATCHES 8
+
+typedef struct eng_CullingConstants
+{
+	uint32_t LightCount;
+	uint32_t ClusterCount;
+	uint32_t MaxLightsPerCluster;
+} eng_CullingConstants;
+
+typedef struct eng_VulkanLightFrame
+{
+	VkBuffer LightBuffer;
+	VkDeviceMemory LightMemory;
+	eng_Light* Lights;
+	uint32_t LightCount;
+	VkDescriptorSet Set;
+} eng_VulkanLightFrame;
+
+typedef struct eng_VulkanLightCulling
+{
+	eng_Vulkan* Vulkan;
+	eng_LightClusterConfig Config;
+	uint32_t ClusterCount;
+	uint32_t MaxLights;
+
+	VkBuffer BoundsBuffer;
+	VkDeviceMemory BoundsMemory;
+	float* Bounds;
+	VkBuffer CountBuffer;
+	VkDeviceMemory CountMemory;
+	VkBuffer IndexBuffer;
+	VkDeviceMemory IndexMemory;
+
+	VkDescriptorSetLayout SetLayout;
+	VkDescriptorPool DescriptorPool;
+	VkPipelineLayout Layout;
+	VkPipeline Pipeline;
+
+	// The frame slot the latest recorded dispatch read its lights from.
+	uint32_t CulledFrame;
+	bool HasCulled;
+	uint32_t QueryRegion;
+
+	eng_VulkanLightFrame Frames[ENG_VULKAN_FRAMES_IN_FLIGHT];
+} eng_VulkanLightCulling;
+
+bool eng_VulkanLightCullingCreateBuffers(eng_VulkanLightCulling* culling);
+bool eng_VulkanLightCullingCreateDescriptors(eng_VulkanLightCulling* culling);
+bool eng_VulkanLightCullingCreatePipeline(eng_VulkanLightCulling* culling);
+bool eng_VulkanLightCullingReadback(eng_VulkanLightCulling* culling, VkBuffer readback);
+void eng_VulkanLightCullingRecord(void* userData, VkCommandBuffer cmd);
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+eng_VulkanLightCulling* eng_VulkanLightCullingMalloc(void)
+{
+	return malloc(sizeof(eng_VulkanLightCulling));
+}
+
+bool eng_VulkanLightCullingInit(eng_VulkanLightCulling* culling, eng_Vulkan* vulkan, const eng_LightClusterConfig* config, uint32_t maxLights)
+{
+	memset(culling, 0, sizeof(eng_VulkanLightCulling));
+	culling->Vulkan = vulkan;
+	culling->Config = *config;
+	culling->ClusterCount = eng_LightClusterGetCount(config);
+	culling->MaxLights = maxLights;
+
+	if (!eng_Ensure(culling->ClusterCount > 0 && config->MaxLightsPerCluster > 0 && maxLights > 0,
+		"Light culling needs at least one cluster, one light and one light per cluster.\n"))
+	{
+		return false;
+	}
+	if (!eng_Ensure(config->Near > 0.0f && config->Far > config->Near, "Light cluster depth range must satisfy 0 < Near < Far.\n"))
+	{
+		return false;
+	}
+
+	if (!eng_VulkanLightCullingCreateBuffers(culling)
+		|| !eng_VulkanLightCullingCreateDescriptors(culling)
+		|| !eng_VulkanLightCullingCreatePipeline(culling))
+	{
+		return false;
+	}
+
+	culling->QueryRegion = eng_VulkanQueryRegionRegister(vulkan, "Light culling", ENG_VULKAN_QUERY_PIPELINE_STATISTICS);
+	eng_OnPreRenderBind(vulkan, eng_VulkanLightCullingRecord, culling);
+	return true;
+}
+
+void eng_VulkanLightCullingFree(eng_VulkanLightCulling* culling, bool subAllocationsOnly)
+{
+	if (culling == NULL)
+	{
+		return;
+	}
+
+	eng_Vulkan* vulkan = culling->Vulkan;
+	VkDevice device = vulkan->Device;
+	eng_OnPreRenderUnbind(vulkan, eng_VulkanLightCullingRecord);
+	vkDeviceWaitIdle(device);
+
+	vkDestroyPipeline(device, culling->Pipeline, NULL);
+	vkDestroyPipelineLayout(device, culling->Layout, NULL);
+	vkDestroyDescriptorPool(device, culling->DescriptorPool, NULL);
+	vkDestroyDescriptorSetLayout(device, culling->SetLayout, NULL);
+
+	for (uint32_t i = 0; i < ENG_VULKAN_FRAMES_IN_FLIGHT; ++i)
+	{
+		vkDestroyBuffer(device, culling->Frames[i].LightBuffer, NULL);
+		vkFreeMemory(device, culling->Frames[i].LightMemory, NULL);
+	}
+	vkDestroyBuffer(device, culling->BoundsBuffer, NULL);
+	vkFreeMemory(device, culling->BoundsMemory, NULL);
+	vkDestroyBuffer(device, culling->CountBuffer, NULL);
+	vkFreeMemory(device, culling->CountMemory, NULL);
+	vkDestroyBuffer(device, culling->IndexBuffer, NULL);
+	vkFreeMemory(device, culling->IndexMemory, NULL);
+
+	if (!subAllocationsOnly)
+	{
+		free(culling);
+	}
+}
+
+size_t eng_VulkanLightCullingGetSizeof(void)
+{
+	return sizeof(eng_VulkanLightCulling);
+}
+
+////////////////////////////////////////////////////////////////////////// API
+void eng_VulkanLightCullingSetLights(eng_VulkanLightCulling* culling, const eng_Light* lights, uint32_t count)
+{
+	eng_VulkanLightFrame* frame = &culling->Frames[eng_VulkanGetFrameIndex(culling->Vulkan)];
+	if (count > culling->MaxLights)
+	{
+		count = culling->MaxLights;
+	}
+	memcpy(frame->Lights, lights, count * sizeof(eng_Light));
+	frame->LightCount = count;
+}
+
+const eng_LightClusterConfig* eng_VulkanLightCullingGetConfig(eng_VulkanLightCulling* culling)
+{
+	return &culling->Config;
+}
+
+VkBuffer eng_VulkanLightCullingGetLightBuffer(eng_VulkanLightCulling* culling)
+{
+	return culling->Frames[eng_VulkanGetFrameIndex(culling->Vulkan)].LightBuffer;
+}
+
+VkBuffer eng_VulkanLightCullingGetCountBuffer(eng_VulkanLightCulling* culling)
+{
+	return culling->CountBuffer;
+}
+
+VkBuffer eng_VulkanLightCullingGetIndexBuffer(eng_VulkanLightCulling* culling)
+{
+	return culling->IndexBuffer;
+}
+
+bool eng_VulkanLightCullingValidate(eng_VulkanLightCulling* culling)
+{
+	if (!eng_Ensure(culling->HasCulled, "Light culling has not run yet; nothing to validate.\n"))
+	{
+		return false;
+	}
+
+	eng_Vulkan* vulkan = culling->Vulkan;
+	VkDevice device = vulkan->Device;
+	const eng_VulkanLightFrame* frame = &culling->Frames[culling->CulledFrame];
+	size_t countBytes = culling->ClusterCount * sizeof(uint32_t);
+	size_t indexBytes = countBytes * culling->Config.MaxLightsPerCluster;
+
+	VkBuffer readback = VK_NULL_HANDLE;
+	VkDeviceMemory readbackMemory = VK_NULL_HANDLE;
+	if (!eng_InternalVkCreateBuffer(vulkan, countBytes + indexBytes, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &readback, &readbackMemory))
+	{
+		return false;
+	}
+
+	uint32_t* expected = eng_AllocatorAlloc(vulkan->Allocator, countBytes + indexBytes, ENG_ALIGNOF(uint32_t));
+	bool matches = false;
+	if (eng_Ensure(expected != NULL, "Failed to allocate light culling reference results.\n")
+		&& eng_VulkanLightCullingReadback(culling, readback))
+	{
+		uint32_t* expectedCounts = expected;
+		uint32_t* expectedIndices = expected + culling->ClusterCount;
+		eng_LightCullClusters(&culling->Config, culling->Bounds, frame->Lights, frame->LightCount, expectedCounts, expectedIndices);
+
+		void* mapped = NULL;
+		vkMapMemory(device, readbackMemory, 0, VK_WHOLE_SIZE, 0, &mapped);
+		const uint32_t* actualCounts = (const uint32_t*)mapped;
+		const uint32_t* actualIndices = actualCounts + culling->ClusterCount;
+
+		uint32_t mismatches = 0;
+		for (uint32_t cluster = 0; cluster < culling->ClusterCount; ++cluster)
+		{
+			uint32_t count = expectedCounts[cluster];
+			const uint32_t* expectedList = expectedIndices + cluster * culling->Config.MaxLightsPerCluster;
+			const uint32_t* actualList = actualIndices + cluster * culling->Config.MaxLightsPerCluster;
+			if (actualCounts[cluster] == count && memcmp(expectedList, actualList, count * sizeof(uint32_t)) == 0)
+			{
+				continue;
+			}
+			if (mismatches < MAX_REPORTED_MISMATCHES)
+			{
+				eng_Err("Light cluster %u: GPU found %u lights, CPU found %u.\n", cluster, actualCounts[cluster], count);
+			}
+			++mismatches;
+		}
+		vkUnmapMemory(device, readbackMemory);
+
+		matches = mismatches == 0;
+		if (matches)
+		{
+			eng_Log("Light culling matches the CPU reference (%u lights, %u clusters).\n", frame->LightCount, culling->ClusterCount);
+		}
+		else
+		{
+			eng_Err("Light culling differs from the CPU reference in %u of %u clusters.\n", mismatches, culling->ClusterCount);
+		}
+	}
+
+	eng_AllocatorFree(vulkan->Allocator, expected, countBytes + indexBytes);
+	vkDestroyBuffer(device, readback, NULL);
+	vkFreeMemory(device, readbackMemory, NULL);
+	return matches;
+}
+
+////////////////////////////////////////////////////////////////////////// Internal
+bool eng_VulkanLightCullingCreateBuffers(eng_VulkanLightCulling* culling)
+{
+	eng_Vulkan* vulkan = culling->Vulkan;
+	VkDevice device = vulkan->Device;
+	const eng_LightClusterConfig* config = &culling->Config;
+	const VkMemoryPropertyFlags hostVisible = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+	// Bounds never change, and the CPU reference reads the same copy the GPU
+	// does, so both sides cull against bit identical clusters.
+	VkDeviceSize boundsBytes = (VkDeviceSize)culling->ClusterCount * BOUNDS_FLOATS_PER_CLUSTER * sizeof(float);
+	if (!eng_InternalVkCreateBuffer(vulkan, boundsBytes, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, hostVisible,
+		&culling->BoundsBuffer, &culling->BoundsMemory))
+	{
+		return false;
+	}
+	VkResult result = vkMapMemory(device, culling->BoundsMemory, 0, VK_WHOLE_SIZE, 0, (void**)&culling->Bounds);
+	eng_VulkanEnsure(result, "map light cluster bounds");
+
+	for (uint32_t z = 0; z < config->Slices; ++z)
+	{
+		for (uint32_t y = 0; y < config->TilesY; ++y)
+		{
+			for (uint32_t x = 0; x < config->TilesX; ++x)
+			{
+				float* bounds = culling->Bounds + (x + config->TilesX * (y + config->TilesY * z)) * BOUNDS_FLOATS_PER_CLUSTER;
+				eng_LightClusterGetBounds(config, x, y, z, bounds, bounds + 4);
+				bounds[3] = 0.0f;
+				bounds[7] = 0.0f;
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < ENG_VULKAN_FRAMES_IN_FLIGHT; ++i)
+	{
+		eng_VulkanLightFrame* frame = &culling->Frames[i];
+		if (!eng_InternalVkCreateBuffer(vulkan, (VkDeviceSize)culling->MaxLights * sizeof(eng_Light), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			hostVisible, &frame->LightBuffer, &frame->LightMemory))
+		{
+			return false;
+		}
+		result = vkMapMemory(device, frame->LightMemory, 0, VK_WHOLE_SIZE, 0, (void**)&frame->Lights);
+		eng_VulkanEnsure(result, "map light buffer");
+	}
+
+	VkDeviceSize countBytes = (VkDeviceSize)culling->ClusterCount * sizeof(uint32_t);
+	const VkBufferUsageFlags outputUsage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+	if (!eng_InternalVkCreateBuffer(vulkan, countBytes, outputUsage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+		&culling->CountBuffer, &culling->CountMemory))
+	{
+		return false;
+	}
+	return eng_InternalVkCreateBuffer(vulkan, countBytes * config->MaxLightsPerCluster, outputUsage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+		&culling->IndexBuffer, &culling->IndexMemory);
+}
+
+bool eng_VulkanLightCullingCreateDescriptors(eng_VulkanLightCulling* culling)
+{
+	VkDevice device = culling->Vulkan->Device;
+
+	// bounds, lights, counts, indices
+	VkDescriptorSetLayoutBinding bindings[4];
+	for (uint32_t binding = 0; binding < 4; ++binding)
+	{
+		bindings[binding] = (VkDescriptorSetLayoutBinding){
+			.binding = binding,
+			.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			.descriptorCount = 1,
+			.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+		};
+	}
+	const VkDescriptorSetLayoutCreateInfo layoutInfo = {
+		.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+		.bindingCount = 4,
+		.pBindings = bindings,
+	};
+	VkResult result = vkCreateDescriptorSetLayout(device, &layoutInfo, NULL, &culling->SetLayout);
+	eng_VulkanEnsure(result, "create light culling descriptor set layout");
+
+	const VkDescriptorPoolSize poolSize = {
+		.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+		.descriptorCount = ENG_VULKAN_FRAMES_IN_FLIGHT * 4,
+	};
+	const VkDescriptorPoolCreateInfo poolInfo = {
+		.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+		.maxSets = ENG_VULKAN_FRAMES_IN_FLIGHT,
+		.poolSizeCount = 1,
+		.pPoolSizes = &poolSize,
+	};
+	result = vkCreateDescriptorPool(device, &poolInfo, NULL, &culling->DescriptorPool);
+	eng_VulkanEnsure(result, "create light culling descriptor pool");
+
+	for (uint32_t i = 0; i < ENG_VULKAN_FRAMES_IN_FLIGHT; ++i)
+	{
+		eng_VulkanLightFrame* frame = &culling->Frames[i];
+		const VkDescriptorSetAllocateInfo setInfo = {
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+			.descriptorPool = culling->DescriptorPool,
+			.descriptorSetCount = 1,
+			.pSetLayouts = &culling->SetLayout,
+		};
+		result = vkAllocateDescriptorSets(device, &setInfo, &frame->Set);
+		eng_VulkanEnsure(result, "allocate light culling descriptor set");
+
+		const VkDescriptorBufferInfo bufferInfos[4] = {
+			[0] = { culling->BoundsBuffer, 0, VK_WHOLE_SIZE },
+			[1] = { frame->LightBuffer, 0, VK_WHOLE_SIZE },
+			[2] = { culling->CountBuffer, 0, VK_WHOLE_SIZE },
+			[3] = { culling->IndexBuffer, 0, VK_WHOLE_SIZE },
+		};
+		VkWriteDescriptorSet writes[4];
+		for (uint32_t binding = 0; binding < 4; ++binding)
+		{
+			writes[binding] = (VkWriteDescriptorSet){
+				.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+				.dstSet = frame->Set,
+				.dstBinding = binding,
+				.descriptorCount = 1,
+				.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+				.pBufferInfo = &bufferInfos[binding],
+			};
+		}
+		vkUpdateDescriptorSets(device, 4, writes, 0, NULL);
+	}
+	return true;
+}
+
+bool eng_VulkanLightCullingCreatePipeline(eng_VulkanLightCulling* culling)
+{
+	eng_Vulkan* vulkan = culling->Vulkan;
+	VkDevice device = vulkan->Device;
+
+	const VkPushConstantRange range = {
+		.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+		.size = sizeof(eng_CullingConstants),
+	};
+	const VkPipelineLayoutCreateInfo layoutInfo = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+		.setLayoutCount = 1,
+		.pSetLayouts = &culling->SetLayout,
+		.pushConstantRangeCount = 1,
+		.pPushConstantRanges = &range,
+	};
+	VkResult result = vkCreatePipelineLayout(device, &layoutInfo, NULL, &culling->Layout);
+	eng_VulkanEnsure(result, "create light culling pipeline layout");
+
+	VkShaderModule shader = eng_InternalVkLoadShader(vulkan, "Shaders/LightCulling.comp.spv");
+	if (shader == VK_NULL_HANDLE)
+	{
+		return false;
+	}
+	const VkComputePipelineCreateInfo pipelineInfo = {
+		.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+		.stage = {
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+			.stage = VK_SHADER_STAGE_COMPUTE_BIT,
+			.module = shader,
+			.pName = "main",
+		},
+		.layout = culling->Layout,
+	};
+	result = vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, NULL, &culling->Pipeline);
+	vkDestroyShaderModule(device, shader, NULL);
+	eng_VulkanEnsure(result, "create light culling pipeline");
+	return true;
+}
+
+bool eng_VulkanLightCullingReadback(eng_VulkanLightCulling* culling, VkBuffer readback)
+{
+	eng_Vulkan* vulkan = culling->Vulkan;
+	VkDevice device = vulkan->Device;
+	VkDeviceSize countBytes = (VkDeviceSize)culling->ClusterCount * sizeof(uint32_t);
+	VkDeviceSize indexBytes = countBytes * culling->Config.MaxLightsPerCluster;
+
+	VkCommandBuffer cmd = VK_NULL_HANDLE;
+	const VkCommandBufferAllocateInfo cmdInfo = {
+		.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+		.commandPool = vulkan->CommandPool,
+		.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+		.commandBufferCount = 1,
+	};
+	VkResult result = vkAllocateCommandBuffers(device, &cmdInfo, &cmd);
+	eng_VulkanEnsure(result, "allocate light culling readback command buffer");
+
+	const VkCommandBufferBeginInfo beginInfo = {
+		.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+		.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+	};
+	vkBeginCommandBuffer(cmd, &beginInfo);
+	const VkMemoryBarrier culled = {
+		.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+		.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+		.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT,
+	};
+	vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &culled, 0, NULL, 0, NULL);
+	const VkBufferCopy countCopy = { .size = countBytes };
+	const VkBufferCopy indexCopy = { .dstOffset = countBytes, .size = indexBytes };
+	vkCmdCopyBuffer(cmd, culling->CountBuffer, readback, 1, &countCopy);
+	vkCmdCopyBuffer(cmd, culling->IndexBuffer, readback, 1, &indexCopy);
+	const VkMemoryBarrier copied = {
+		.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+		.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+		.dstAccessMask = VK_ACCESS_HOST_READ_BIT,
+	};
+	vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &copied, 0, NULL, 0, NULL);
+	vkEndCommandBuffer(cmd);
+
+	const VkSubmitInfo submitInfo = {
+		.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+		.commandBufferCount = 1,
+		.pCommandBuffers = &cmd,
+	};
+	result = vkQueueSubmit(vulkan->Queue, 1, &submitInfo, VK_NULL_HANDLE);
+	if (result == VK_SUCCESS)
+	{
+		vkQueueWaitIdle(vulkan->Queue);
+	}
+	vkFreeCommandBuffers(device, vulkan->CommandPool, 1, &cmd);
+	return eng_Ensure(result == VK_SUCCESS, "Failed to submit light culling readback. Error(%d): \"%s\"\n", (int)result, eng_InternalVkResultToString(result));
+}
+
+void eng_VulkanLightCullingRecord(void* userData, VkCommandBuffer cmd)
+{
+	eng_VulkanLightCulling* culling = (eng_VulkanLightCulling*)userData;
+	uint32_t frameIndex = eng_VulkanGetFrameIndex(culling->Vulkan);
+	eng_VulkanLightFrame* frame = &culling->Frames[frameIndex];
+
+	// The previous frame's shading may still be reading the light lists.
+	const VkMemoryBarrier previousReads = {
+		.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+		.srcAccessMask = VK_ACCESS_SHADER_READ_BIT,
+		.dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+	};
+	vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+		VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &previousReads, 0, NULL, 0, NULL);
+
+	const eng_CullingConstants constants = {
+		.LightCount = frame->LightCount,
+		.ClusterCount = culling->ClusterCount,
+		.MaxLightsPerCluster = culling->Config.MaxLightsPerCluster,
+	};
+	vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, culling->Pipeline);
+	vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, culling->Layout, 0, 1, &frame->Set, 0, NULL);
+	vkCmdPushConstants(cmd, culling->Layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants), &constants);
+	eng_VulkanQueryRegionBegin(culling->Vulkan, cmd, culling->QueryRegion);
+	vkCmdDispatch(cmd, (culling->ClusterCount + CULLING_GROUP_SIZE - 1) / CULLING_GROUP_SIZE, 1, 1);
+	eng_VulkanQueryRegionEnd(culling->Vulkan, cmd, culling->QueryRegion);
+
+	const VkMemoryBarrier culled = {
+		.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+		.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+		.dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
+	};
+	vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+		VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 1, &culled, 0, NULL, 0, NULL);
+
+	culling->CulledFrame = frameIndex;
+	culling->HasCulled = true;
+}
\ No newline at end of file
@@ -0,0 +1,696 @@
+#include <Engine/Graphics_VulkanParticles.h>
+
+#include <Engine/Allocator.h>
+#include <Engine/Graphics_Vulkan.h>
+#include <Engine/Log.h>
+
+#if defined(GAME_WINDOWS)
+#define VK_USE_PLATFORM_WIN32_KHR
+#endif
+#include <ThirdParty/Vulkan/vulkan.h>
+
+#include <Engine/Graphics_VulkanInternal.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+// Must match local_size_x in Particles.comp.
+#define SIMULATION_GROUP_SIZE 256
+#define DEFAULT_GRAVITY 200.0f
+// Per frame: simulation begin, simulation end, draw begin, draw end.
+#define TIMESTAMPS_PER_FRAME 4
+
+// Mirrors the Particle struct in the shaders (std430).
+typedef struct eng_GpuParticle
+{
+	float Position[2];
+	float Velocity[2];
+	float Life;
+	float MaxLife;
+	uint32_t Color;
+	float Size;
+} eng_GpuParticle;
+
+typedef struct eng_SimulationConstants
+{
+	float Emitter[2];
+	float Gravity[2];
+	float DeltaTime;
+	float Time;
+	uint32_t Capacity;
+	uint32_t EmitCount;
+	uint32_t InSide;
+} eng_SimulationConstants;
+
+typedef struct eng_DrawConstants
+{
+	float InvHalfExtent[2];
+} eng_DrawConstants;
+
+typedef struct eng_VulkanParticleFrame
+{
+	VkCommandBuffer Cmd;
+	VkSemaphore SimulationDone;
+	// Timestamp queries were reset by this frame's simulation step.
+	bool QueriesReset;
+	// All four timestamps were written and can be read back.
+	bool QueriesWritten;
+} eng_VulkanParticleFrame;
+
+typedef struct eng_VulkanParticles
+{
+	eng_Vulkan* Vulkan;
+	uint32_t Capacity;
+
+	VkBuffer ParticleBuffers[2];
+	VkDeviceMemory ParticleMemory[2];
+	// Two VkDrawIndirectCommands, one per particle buffer.
+	VkBuffer ArgsBuffer;
+	VkDeviceMemory ArgsMemory;
+	bool ArgsInitialized;
+	// The particle buffer the latest simulation step wrote.
+	uint32_t CurrentSide;
+
+	VkDescriptorSetLayout ComputeSetLayout;
+	VkDescriptorSetLayout DrawSetLayout;
+	VkDescriptorPool DescriptorPool;
+	VkDescriptorSet ComputeSets[2];
+	VkDescriptorSet DrawSets[2];
+	VkPipelineLayout ComputeLayout;
+	VkPipelineLayout DrawLayout;
+	VkPipeline ComputePipeline;
+	VkPipeline DrawPipeline;
+
+	float Emitter[2];
+	float EmitRate;
+	float EmitAccumulator;
+	float Time;
+
+	VkQueryPool Timestamps;
+	double NanosecondsPerTick;
+	double SimulationMilliseconds;
+	double RenderMilliseconds;
+	uint32_t QueryRegion;
+
+	eng_VulkanParticleFrame Frames[ENG_VULKAN_FRAMES_IN_FLIGHT];
+} eng_VulkanParticles;
+
+bool eng_VulkanParticlesCreateBuffers(eng_VulkanParticles* particles);
+bool eng_VulkanParticlesCreateDescriptors(eng_VulkanParticles* particles);
+bool eng_VulkanParticlesCreatePipelines(eng_VulkanParticles* particles);
+bool eng_VulkanParticlesCreateFrames(eng_VulkanParticles* particles);
+void eng_VulkanParticlesReadTimestamps(eng_VulkanParticles* particles, uint32_t frameIndex);
+void eng_VulkanParticlesRecord(void* userData, VkCommandBuffer cmd);
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+eng_VulkanParticles* eng_VulkanParticlesMalloc(void)
+{
+	return malloc(sizeof(eng_VulkanParticles));
+}
+
+bool eng_VulkanParticlesInit(eng_VulkanParticles* particles, eng_Vulkan* vulkan, uint32_t capacity)
+{
+	memset(particles, 0, sizeof(eng_VulkanParticles));
+	particles->Vulkan = vulkan;
+	particles->Capacity = capacity;
+	particles->Emitter[0] = vulkan->SwapchainExtent.width * 0.5f;
+	particles->Emitter[1] = vulkan->SwapchainExtent.height * 0.5f;
+
+	if (!eng_Ensure(capacity > 0, "Particle capacity must be at least 1.\n"))
+	{
+		return false;
+	}
+
+	if (!eng_VulkanParticlesCreateBuffers(particles)
+		|| !eng_VulkanParticlesCreateDescriptors(particles)
+		|| !eng_VulkanParticlesCreatePipelines(particles)
+		|| !eng_VulkanParticlesCreateFrames(particles))
+	{
+		return false;
+	}
+
+	particles->QueryRegion = eng_VulkanQueryRegionRegister(vulkan, "Particles", ENG_VULKAN_QUERY_OCCLUSION | ENG_VULKAN_QUERY_PIPELINE_STATISTICS);
+	eng_OnRenderBind(vulkan, eng_VulkanParticlesRecord, particles);
+	return true;
+}
+
+void eng_VulkanParticlesFree(eng_VulkanParticles* particles, bool subAllocationsOnly)
+{
+	if (particles == NULL)
+	{
+		return;
+	}
+
+	eng_Vulkan* vulkan = particles->Vulkan;
+	VkDevice device = vulkan->Device;
+	eng_OnRenderUnbind(vulkan, eng_VulkanParticlesRecord);
+	vkDeviceWaitIdle(device);
+
+	for (uint32_t i = 0; i < ENG_VULKAN_FRAMES_IN_FLIGHT; ++i)
+	{
+		eng_VulkanParticleFrame* frame = &particles->Frames[i];
+		if (frame->Cmd != VK_NULL_HANDLE)
+		{
+			vkFreeCommandBuffers(device, vulkan->ComputeCommandPool, 1, &frame->Cmd);
+		}
+		vkDestroySemaphore(device, frame->SimulationDone, NULL);
+	}
+	vkDestroyQueryPool(device, particles->Timestamps, NULL);
+
+	vkDestroyPipeline(device, particles->ComputePipeline, NULL);
+	vkDestroyPipeline(device, particles->DrawPipeline, NULL);
+	vkDestroyPipelineLayout(device, particles->ComputeLayout, NULL);
+	vkDestroyPipelineLayout(device, particles->DrawLayout, NULL);
+	vkDestroyDescriptorPool(device, particles->DescriptorPool, NULL);
+	vkDestroyDescriptorSetLayout(device, particles->ComputeSetLayout, NULL);
+	vkDestroyDescriptorSetLayout(device, particles->DrawSetLayout, NULL);
+
+	for (uint32_t i = 0; i < 2; ++i)
+	{
+		vkDestroyBuffer(device, particles->ParticleBuffers[i], NULL);
+		vkFreeMemory(device, particles->ParticleMemory[i], NULL);
+	}
+	vkDestroyBuffer(device, particles->ArgsBuffer, NULL);
+	vkFreeMemory(device, particles->ArgsMemory, NULL);
+
+	if (!subAllocationsOnly)
+	{
+		free(particles);
+	}
+}
+
+size_t eng_VulkanParticlesGetSizeof(void)
+{
+	return sizeof(eng_VulkanParticles);
+}
+
+////////////////////////////////////////////////////////////////////////// API
+void eng_VulkanParticlesSetEmitter(eng_VulkanParticles* particles, float x, float y, float particlesPerSecond)
+{
+	particles->Emitter[0] = x;
+	particles->Emitter[1] = y;
+	particles->EmitRate = particlesPerSecond;
+}
+
+void eng_VulkanParticlesUpdate(eng_VulkanParticles* particles, float deltaSeconds)
+{
+	eng_Vulkan* vulkan = particles->Vulkan;
+	uint32_t frameIndex = eng_VulkanGetFrameIndex(vulkan);
+	eng_VulkanParticleFrame* frame = &particles->Frames[frameIndex];
+	VkCommandBuffer cmd = frame->Cmd;
+
+	// This frame slot's previous step has finished, so its timings are in.
+	eng_VulkanParticlesReadTimestamps(particles, frameIndex);
+
+	particles->EmitAccumulator += particles->EmitRate * deltaSeconds;
+	uint32_t emitCount = (uint32_t)particles->EmitAccumulator;
+	particles->EmitAccumulator -= (float)emitCount;
+	particles->Time += deltaSeconds;
+
+	uint32_t inSide = particles->CurrentSide;
+	uint32_t outSide = 1 - inSide;
+
+	const VkCommandBufferBeginInfo beginInfo = {
+		.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+		.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+	};
+	vkBeginCommandBuffer(cmd, &beginInfo);
+
+	if (particles->Timestamps != VK_NULL_HANDLE)
+	{
+		vkCmdResetQueryPool(cmd, particles->Timestamps, frameIndex * TIMESTAMPS_PER_FRAME, TIMESTAMPS_PER_FRAME);
+		vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, particles->Timestamps, frameIndex * TIMESTAMPS_PER_FRAME + 0);
+		frame->QueriesReset = true;
+	}
+
+	if (!particles->ArgsInitialized)
+	{
+		const VkDrawIndirectCommand initialArgs[2] = {
+			[0] = { .vertexCount = 4 },
+			[1] = { .vertexCount = 4 },
+		};
+		vkCmdUpdateBuffer(cmd, particles->ArgsBuffer, 0, sizeof(initialArgs), (const uint32_t*)initialArgs);
+		particles->ArgsInitialized = true;
+	}
+
+	// The previous step's writes (particles and counts) feed this one.
+	const VkMemoryBarrier previousStep = {
+		.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+		.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT,
+		.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT,
+	};
+	vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+		VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &previousStep, 0, NULL, 0, NULL);
+
+	// Out's instance count is the compaction cursor.
+	vkCmdFillBuffer(cmd, particles->ArgsBuffer, outSide * sizeof(VkDrawIndirectCommand) + offsetof(VkDrawIndirectCommand, instanceCount), sizeof(uint32_t), 0);
+
+	const VkMemoryBarrier clearCount = {
+		.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+		.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+		.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+	};
+	vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+		0, 1, &clearCount, 0, NULL, 0, NULL);
+
+	const eng_SimulationConstants constants = {
+		.Emitter = { particles->Emitter[0], particles->Emitter[1] },
+		.Gravity = { 0.0f, DEFAULT_GRAVITY },
+		.DeltaTime = deltaSeconds,
+		.Time = particles->Time,
+		.Capacity = particles->Capacity,
+		.EmitCount = emitCount,
+		.InSide = inSide,
+	};
+	vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, particles->ComputePipeline);
+	vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, particles->ComputeLayout, 0, 1, &particles->ComputeSets[inSide], 0, NULL);
+	vkCmdPushConstants(cmd, particles->ComputeLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants), &constants);
+	vkCmdDispatch(cmd, (particles->Capacity + SIMULATION_GROUP_SIZE - 1) / SIMULATION_GROUP_SIZE, 1, 1);
+
+	if (particles->Timestamps != VK_NULL_HANDLE)
+	{
+		vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, particles->Timestamps, frameIndex * TIMESTAMPS_PER_FRAME + 1);
+	}
+	vkEndCommandBuffer(cmd);
+
+	const VkSubmitInfo submitInfo = {
+		.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+		.commandBufferCount = 1,
+		.pCommandBuffers = &cmd,
+		.signalSemaphoreCount = 1,
+		.pSignalSemaphores = &frame->SimulationDone,
+	};
+	VkResult result = vkQueueSubmit(vulkan->ComputeQueue, 1, &submitInfo, VK_NULL_HANDLE);
+	if (!eng_Ensure(result == VK_SUCCESS, "Failed to submit particle simulation. Error(%d): \"%s\"", (int)result, eng_InternalVkResultToString(result)))
+	{
+		return;
+	}
+
+	// The semaphore also makes the compute writes visible to the draw.
+	eng_InternalVkWaitOnSemaphore(vulkan, frame->SimulationDone, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT);
+	particles->CurrentSide = outSide;
+}
+
+uint32_t eng_VulkanParticlesGetCapacity(eng_VulkanParticles* particles)
+{
+	return particles->Capacity;
+}
+
+bool eng_VulkanParticlesIsAsyncCompute(eng_VulkanParticles* particles)
+{
+	return particles->Vulkan->ComputeQueue != particles->Vulkan->Queue;
+}
+
+double eng_VulkanParticlesGetSimulationMilliseconds(eng_VulkanParticles* particles)
+{
+	return particles->SimulationMilliseconds;
+}
+
+double eng_VulkanParticlesGetRenderMilliseconds(eng_VulkanParticles* particles)
+{
+	return particles->RenderMilliseconds;
+}
+
+////////////////////////////////////////////////////////////////////////// Internal
+bool eng_VulkanParticlesCreateBuffers(eng_VulkanParticles* particles)
+{
+	eng_Vulkan* vulkan = particles->Vulkan;
+	VkDeviceSize particleBytes = (VkDeviceSize)particles->Capacity * sizeof(eng_GpuParticle);
+
+	for (uint32_t i = 0; i < 2; ++i)
+	{
+		if (!eng_InternalVkCreateSharedBuffer(vulkan, particleBytes, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, true, &particles->ParticleBuffers[i], &particles->ParticleMemory[i]))
+		{
+			return false;
+		}
+	}
+
+	return eng_InternalVkCreateSharedBuffer(vulkan, 2 * sizeof(VkDrawIndirectCommand),
+		VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, true, &particles->ArgsBuffer, &particles->ArgsMemory);
+}
+
+bool eng_VulkanParticlesCreateDescriptors(eng_VulkanParticles* particles)
+{
+	VkDevice device = particles->Vulkan->Device;
+
+	const VkDescriptorSetLayoutBinding computeBindings[3] = {
+		[0] = { .binding = 0, .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, .descriptorCount = 1, .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT },
+		[1] = { .binding = 1, .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, .descriptorCount = 1, .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT },
+		[2] = { .binding = 2, .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, .descriptorCount = 1, .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT },
+	};
+	const VkDescriptorSetLayoutCreateInfo computeLayoutInfo = {
+		.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+		.bindingCount = 3,
+		.pBindings = computeBindings,
+	};
+	VkResult result = vkCreateDescriptorSetLayout(device, &computeLayoutInfo, NULL, &particles->ComputeSetLayout);
+	eng_VulkanEnsure(result, "create particle simulation descriptor set layout");
+
+	const VkDescriptorSetLayoutBinding drawBinding = {
+		.binding = 0,
+		.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+		.descriptorCount = 1,
+		.stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
+	};
+	const VkDescriptorSetLayoutCreateInfo drawLayoutInfo = {
+		.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+		.bindingCount = 1,
+		.pBindings = &drawBinding,
+	};
+	result = vkCreateDescriptorSetLayout(device, &drawLayoutInfo, NULL, &particles->DrawSetLayout);
+	eng_VulkanEnsure(result, "create particle draw descriptor set layout");
+
+	// Two simulation sets (A->B, B->A) and two draw sets (A, B).
+	const VkDescriptorPoolSize poolSize = {
+		.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+		.descriptorCount = 2 * 3 + 2,
+	};
+	const VkDescriptorPoolCreateInfo poolInfo = {
+		.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+		.maxSets = 4,
+		.poolSizeCount = 1,
+		.pPoolSizes = &poolSize,
+	};
+	result = vkCreateDescriptorPool(device, &poolInfo, NULL, &particles->DescriptorPool);
+	eng_VulkanEnsure(result, "create particle descriptor pool");
+
+	const VkDescriptorSetLayout layouts[4] = {
+		particles->ComputeSetLayout, particles->ComputeSetLayout,
+		particles->DrawSetLayout, particles->DrawSetLayout,
+	};
+	VkDescriptorSet sets[4];
+	const VkDescriptorSetAllocateInfo setInfo = {
+		.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+		.descriptorPool = particles->DescriptorPool,
+		.descriptorSetCount = 4,
+		.pSetLayouts = layouts,
+	};
+	result = vkAllocateDescriptorSets(device, &setInfo, sets);
+	eng_VulkanEnsure(result, "allocate particle descriptor sets");
+
+	VkDescriptorBufferInfo bufferInfos[8];
+	VkWriteDescriptorSet writes[8];
+	uint32_t writeCount = 0;
+	for (uint32_t side = 0; side < 2; ++side)
+	{
+		particles->ComputeSets[side] = sets[side];
+		particles->DrawSets[side] = sets[2 + side];
+
+		const VkBuffer computeBuffers[3] = { particles->ParticleBuffers[side], particles->ParticleBuffers[1 - side], particles->ArgsBuffer };
+		for (uint32_t binding = 0; binding < 3; ++binding)
+		{
+			bufferInfos[writeCount] = (VkDescriptorBufferInfo){ computeBuffers[binding], 0, VK_WHOLE_SIZE };
+			writes[writeCount] = (VkWriteDescriptorSet){
+				.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+				.dstSet = particles->ComputeSets[side],
+				.dstBinding = binding,
+				.descriptorCount = 1,
+				.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+				.pBufferInfo = &bufferInfos[writeCount],
+			};
+			++writeCount;
+		}
+
+		bufferInfos[writeCount] = (VkDescriptorBufferInfo){ particles->ParticleBuffers[side], 0, VK_WHOLE_SIZE };
+		writes[writeCount] = (VkWriteDescriptorSet){
+			.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+			.dstSet = particles->DrawSets[side],
+			.dstBinding = 0,
+			.descriptorCount = 1,
+			.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			.pBufferInfo = &bufferInfos[writeCount],
+		};
+		++writeCount;
+	}
+	vkUpdateDescriptorSets(device, writeCount, writes, 0, NULL);
+	return true;
+}
+
+bool eng_VulkanParticlesCreatePipelines(eng_VulkanParticles* particles)
+{
+	eng_Vulkan* vulkan = particles->Vulkan;
+	VkDevice device = vulkan->Device;
+
+	const VkPushConstantRange computeRange = {
+		.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+		.size = sizeof(eng_SimulationConstants),
+	};
+	const VkPipelineLayoutCreateInfo computeLayoutInfo = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+		.setLayoutCount = 1,
+		.pSetLayouts = &particles->ComputeSetLayout,
+		.pushConstantRangeCount = 1,
+		.pPushConstantRanges = &computeRange,
+	};
+	VkResult result = vkCreatePipelineLayout(device, &computeLayoutInfo, NULL, &particles->ComputeLayout);
+	eng_VulkanEnsure(result, "create particle simulation pipeline layout");
+
+	const VkPushConstantRange drawRange = {
+		.stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
+		.size = sizeof(eng_DrawConstants),
+	};
+	const VkPipelineLayoutCreateInfo drawLayoutInfo = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+		.setLayoutCount = 1,
+		.pSetLayouts = &particles->DrawSetLayout,
+		.pushConstantRangeCount = 1,
+		.pPushConstantRanges = &drawRange,
+	};
+	result = vkCreatePipelineLayout(device, &drawLayoutInfo, NULL, &particles->DrawLayout);
+	eng_VulkanEnsure(result, "create particle draw pipeline layout");
+
+	VkShaderModule computeShader = eng_InternalVkLoadShader(vulkan, "Shaders/Particles.comp.spv");
+	if (computeShader == VK_NULL_HANDLE)
+	{
+		return false;
+	}
+	const VkComputePipelineCreateInfo computeInfo = {
+		.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+		.stage = {
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+			.stage = VK_SHADER_STAGE_COMPUTE_BIT,
+			.module = computeShader,
+			.pName = "main",
+		},
+		.layout = particles->ComputeLayout,
+	};
+	result = vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &computeInfo, NULL, &particles->ComputePipeline);
+	vkDestroyShaderModule(device, computeShader, NULL);
+	eng_VulkanEnsure(result, "create particle simulation pipeline");
+
+	VkShaderModule vertexShader = eng_InternalVkLoadShader(vulkan, "Shaders/Particles.vert.spv");
+	VkShaderModule fragmentShader = eng_InternalVkLoadShader(vulkan, "Shaders/Particles.frag.spv");
+	if (vertexShader == VK_NULL_HANDLE || fragmentShader == VK_NULL_HANDLE)
+	{
+		vkDestroyShaderModule(device, vertexShader, NULL);
+		vkDestroyShaderModule(device, fragmentShader, NULL);
+		return false;
+	}
+
+	const VkPipelineShaderStageCreateInfo stages[2] = {
+		[0] = {
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+			.stage = VK_SHADER_STAGE_VERTEX_BIT,
+			.module = vertexShader,
+			.pName = "main",
+		},
+		[1] = {
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+			.stage = VK_SHADER_STAGE_FRAGMENT_BIT,
+			.module = fragmentShader,
+			.pName = "main",
+		},
+	};
+	// Particles are pulled from the storage buffer, so there is no vertex input.
+	const VkPipelineVertexInputStateCreateInfo vertexInput = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+	};
+	const VkPipelineInputAssemblyStateCreateInfo inputAssembly = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
+		.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP,
+	};
+	const VkPipelineViewportStateCreateInfo viewportState = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+		.viewportCount = 1,
+		.scissorCount = 1,
+	};
+	const VkPipelineRasterizationStateCreateInfo rasterization = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
+		.polygonMode = VK_POLYGON_MODE_FILL,
+		.cullMode = VK_CULL_MODE_NONE,
+		.frontFace = VK_FRONT_FACE_CLOCKWISE,
+		.lineWidth = 1.0f,
+	};
+	const VkPipelineMultisampleStateCreateInfo multisample = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+		.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+	};
+	const VkPipelineColorBlendAttachmentState blendAttachment = {
+		.blendEnable = VK_TRUE,
+		.srcColorBlendFactor = VK_BLEND_FACTOR_ONE,
+		.dstColorBlendFactor = VK_BLEND_FACTOR_ONE,
+		.colorBlendOp = VK_BLEND_OP_ADD,
+		.srcAlphaBlendFactor = VK_BLEND_FACTOR_ZERO,
+		.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE,
+		.alphaBlendOp = VK_BLEND_OP_ADD,
+		.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT,
+	};
+	const VkPipelineColorBlendStateCreateInfo colorBlend = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+		.attachmentCount = 1,
+		.pAttachments = &blendAttachment,
+	};
+	const VkDynamicState dynamicStates[2] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+	const VkPipelineDynamicStateCreateInfo dynamicState = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+		.dynamicStateCount = 2,
+		.pDynamicStates = dynamicStates,
+	};
+
+	const VkGraphicsPipelineCreateInfo pipelineInfo = {
+		.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+		.stageCount = 2,
+		.pStages = stages,
+		.pVertexInputState = &vertexInput,
+		.pInputAssemblyState = &inputAssembly,
+		.pViewportState = &viewportState,
+		.pRasterizationState = &rasterization,
+		.pMultisampleState = &multisample,
+		.pColorBlendState = &colorBlend,
+		.pDynamicState = &dynamicState,
+		.layout = particles->DrawLayout,
+		.renderPass = vulkan->RenderPass,
+		.subpass = 0,
+	};
+	result = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, NULL, &particles->DrawPipeline);
+
+	vkDestroyShaderModule(device, vertexShader, NULL);
+	vkDestroyShaderModule(device, fragmentShader, NULL);
+	eng_VulkanEnsure(result, "create particle draw pipeline");
+	return true;
+}
+
+bool eng_VulkanParticlesCreateFrames(eng_VulkanParticles* particles)
+{
+	eng_Vulkan* vulkan = particles->Vulkan;
+	VkDevice device = vulkan->Device;
+
+	const VkCommandBufferAllocateInfo cmdInfo = {
+		.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+		.commandPool = vulkan->ComputeCommandPool,
+		.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+		.commandBufferCount = 1,
+	};
+	const VkSemaphoreCreateInfo semaphoreInfo = {
+		.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+	};
+	for (uint32_t i = 0; i < ENG_VULKAN_FRAMES_IN_FLIGHT; ++i)
+	{
+		VkResult result = vkAllocateCommandBuffers(device, &cmdInfo, &particles->Frames[i].Cmd);
+		eng_VulkanEnsure(result, "allocate particle command buffer");
+		result = vkCreateSemaphore(device, &semaphoreInfo, NULL, &particles->Frames[i].SimulationDone);
+		eng_VulkanEnsure(result, "create particle semaphore");
+	}
+
+	// Timing needs timestamp support on both queues; without it the
+	// particles still run, they just report 0 ms.
+	uint32_t familyCount = 0;
+	vkGetPhysicalDeviceQueueFamilyProperties(vulkan->PhysicalDevice, &familyCount, NULL);
+	VkQueueFamilyProperties* families = eng_AllocatorCallocType(vulkan->Allocator, VkQueueFamilyProperties, familyCount);
+	if (families == NULL)
+	{
+		return false;
+	}
+	vkGetPhysicalDeviceQueueFamilyProperties(vulkan->PhysicalDevice, &familyCount, families);
+	bool canTime = families[vulkan->QueueFamilyIndex].timestampValidBits > 0
+		&& families[vulkan->ComputeQueueFamilyIndex].timestampValidBits > 0;
+	eng_AllocatorFreeType(vulkan->Allocator, families, VkQueueFamilyProperties, familyCount);
+
+	if (canTime)
+	{
+		VkPhysicalDeviceProperties properties;
+		vkGetPhysicalDeviceProperties(vulkan->PhysicalDevice, &properties);
+		particles->NanosecondsPerTick = properties.limits.timestampPeriod;
+
+		const VkQueryPoolCreateInfo poolInfo = {
+			.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+			.queryType = VK_QUERY_TYPE_TIMESTAMP,
+			.queryCount = ENG_VULKAN_FRAMES_IN_FLIGHT * TIMESTAMPS_PER_FRAME,
+		};
+		VkResult result = vkCreateQueryPool(device, &poolInfo, NULL, &particles->Timestamps);
+		eng_VulkanEnsure(result, "create particle timestamp pool");
+	}
+	return true;
+}
+
+void eng_VulkanParticlesReadTimestamps(eng_VulkanParticles* particles, uint32_t frameIndex)
+{
+	eng_VulkanParticleFrame* frame = &particles->Frames[frameIndex];
+	if (!frame->QueriesWritten)
+	{
+		return;
+	}
+	frame->QueriesWritten = false;
+
+	uint64_t ticks[TIMESTAMPS_PER_FRAME];
+	VkResult result = vkGetQueryPoolResults(particles->Vulkan->Device, particles->Timestamps,
+		frameIndex * TIMESTAMPS_PER_FRAME, TIMESTAMPS_PER_FRAME, sizeof(ticks), ticks, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+	if (result != VK_SUCCESS)
+	{
+		// Not ready; keep the last timings rather than stall.
+		return;
+	}
+
+	particles->SimulationMilliseconds = (double)(ticks[1] - ticks[0]) * particles->NanosecondsPerTick * 1e-6;
+	particles->RenderMilliseconds = (double)(ticks[3] - ticks[2]) * particles->NanosecondsPerTick * 1e-6;
+}
+
+void eng_VulkanParticlesRecord(void* userData, VkCommandBuffer cmd)
+{
+	eng_VulkanParticles* particles = (eng_VulkanParticles*)userData;
+	if (!particles->ArgsInitialized)
+	{
+		return;
+	}
+
+	uint32_t frameIndex = eng_VulkanGetFrameIndex(particles->Vulkan);
+	eng_VulkanParticleFrame* frame = &particles->Frames[frameIndex];
+	bool timed = frame->QueriesReset;
+	if (timed)
+	{
+		vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, particles->Timestamps, frameIndex * TIMESTAMPS_PER_FRAME + 2);
+	}
+
+	// Particles are placed in swapchain pixels; the viewport maps them onto
+	// however much of the scene target is rendered this frame.
+	VkExtent2D extent = particles->Vulkan->SwapchainExtent;
+	VkExtent2D renderExtent = particles->Vulkan->RenderExtent;
+	const VkViewport viewport = {
+		.width = (float)renderExtent.width,
+		.height = (float)renderExtent.height,
+		.maxDepth = 1.0f,
+	};
+	const VkRect2D scissor = { .extent = renderExtent };
+	const eng_DrawConstants constants = {
+		.InvHalfExtent = { 2.0f / extent.width, 2.0f / extent.height },
+	};
+
+	vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, particles->DrawPipeline);
+	vkCmdSetViewport(cmd, 0, 1, &viewport);
+	vkCmdSetScissor(cmd, 0, 1, &scissor);
+	vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, particles->DrawLayout, 0, 1, &particles->DrawSets[particles->CurrentSide], 0, NULL);
+	vkCmdPushConstants(cmd, particles->DrawLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(constants), &constants);
+	// The instance count is however many particles the simulation kept.
+	eng_VulkanQueryRegionBegin(particles->Vulkan, cmd, particles->QueryRegion);
+	vkCmdDrawIndirect(cmd, particles->ArgsBuffer, particles->CurrentSide * sizeof(VkDrawIndirectCommand), 1, sizeof(VkDrawIndirectCommand));
+	eng_VulkanQueryRegionEnd(particles->Vulkan, cmd, particles->QueryRegion);
+
+	if (timed)
+	{
+		vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, particles->Timestamps, frameIndex * TIMESTAMPS_PER_FRAME + 3);
+		frame->QueriesReset = false;
+		frame->QueriesWritten = true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,384 @@
+#include <Engine/Graphics_Vulkan.h>
+
+#include <Engine/Log.h>
+
+#if defined(GAME_WINDOWS)
+#define VK_USE_PLATFORM_WIN32_KHR
+#endif
+#include <ThirdParty/Vulkan/vulkan.h>
+
+#include <Engine/Graphics_VulkanInternal.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+// Order matches the bit order of PIPELINE_STATISTICS below, which is the
+// order Vulkan writes the counters in.
+#define STATISTIC_VERTEX_INVOCATIONS 0
+#define STATISTIC_CLIPPING_PRIMITIVES 1
+#define STATISTIC_FRAGMENT_INVOCATIONS 2
+#define STATISTIC_COMPUTE_INVOCATIONS 3
+#define STATISTIC_COUNT 4
+#define PIPELINE_STATISTICS (VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT \
+	| VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT \
+	| VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT \
+	| VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT)
+
+eng_VulkanQueryRegion* eng_VulkanQueryRegionGet(eng_Vulkan* vulkan, uint32_t region);
+uint32_t eng_VulkanQueryRegionGetQuery(eng_Vulkan* vulkan, uint32_t region);
+// Leaves out the statistics of enclosing regions, which nested regions suspend.
+uint32_t eng_VulkanQueryRegionGetActiveFlags(eng_Vulkan* vulkan);
+// @returns the active enclosing region collecting statistics, or ENG_VULKAN_INVALID_QUERY_REGION.
+uint32_t eng_VulkanQueryRegionGetEnclosing(eng_Vulkan* vulkan);
+// Collects region's queries from the current frame slot into outResult, pieces included.
+void eng_VulkanQueryRegionCollect(eng_Vulkan* vulkan, uint32_t region, eng_VulkanQueryResult* outResult);
+// Adds the statistics query's counters to inOutResult. @returns false if it isn't available.
+bool eng_VulkanQueryAddStatistics(eng_Vulkan* vulkan, uint32_t query, eng_VulkanQueryResult* inOutResult);
+
+////////////////////////////////////////////////////////////////////////// Query API
+uint32_t eng_VulkanQueryRegionRegister(eng_Vulkan* vulkan, const char* name, uint32_t flags)
+{
+	uint32_t existing = eng_VulkanQueryRegionFind(vulkan, name);
+	if (existing != ENG_VULKAN_INVALID_QUERY_REGION)
+	{
+		eng_VulkanQueryRegionGet(vulkan, existing)->Flags |= flags;
+		return existing;
+	}
+	if (!eng_Ensure(vulkan->QueryRegions.Count < ENG_VULKAN_MAX_QUERY_REGIONS, "Can't register query region \"%s\", all %d are in use.\n", name, ENG_VULKAN_MAX_QUERY_REGIONS))
+	{
+		return ENG_VULKAN_INVALID_QUERY_REGION;
+	}
+
+	eng_VulkanQueryRegion queryRegion;
+	memset(&queryRegion, 0, sizeof(eng_VulkanQueryRegion));
+	strncpy(queryRegion.Name, name, ENG_VULKAN_QUERY_NAME_LENGTH - 1);
+	queryRegion.Flags = flags;
+	for (uint32_t i = 0; i < ENG_VULKAN_FRAMES_IN_FLIGHT; ++i)
+	{
+		queryRegion.EnclosingRegion[i] = ENG_VULKAN_INVALID_QUERY_REGION;
+	}
+	return eng_ArrayPushBack(&vulkan->QueryRegions, &queryRegion);
+}
+
+uint32_t eng_VulkanQueryRegionFind(eng_Vulkan* vulkan, const char* name)
+{
+	for (uint32_t i = 0; i < vulkan->QueryRegions.Count; ++i)
+	{
+		if (strncmp(eng_VulkanQueryRegionGet(vulkan, i)->Name, name, ENG_VULKAN_QUERY_NAME_LENGTH - 1) == 0)
+		{
+			return i;
+		}
+	}
+	return ENG_VULKAN_INVALID_QUERY_REGION;
+}
+
+uint32_t eng_VulkanQueryRegionGetCount(eng_Vulkan* vulkan)
+{
+	return vulkan->QueryRegions.Count;
+}
+
+const char* eng_VulkanQueryRegionGetName(eng_Vulkan* vulkan, uint32_t region)
+{
+	return eng_VulkanQueryRegionGet(vulkan, region)->Name;
+}
+
+void eng_VulkanQueryRegionBegin(eng_Vulkan* vulkan, VkCommandBuffer cmd, uint32_t region)
+{
+	if (region == ENG_VULKAN_INVALID_QUERY_REGION || vulkan->OcclusionQueries == VK_NULL_HANDLE)
+	{
+		return;
+	}
+
+	eng_VulkanQueryRegion* queryRegion = eng_VulkanQueryRegionGet(vulkan, region);
+	uint64_t recordedFrame = vulkan->FrameNumber + 1;
+	if (!eng_Ensure(queryRegion->RecordedFrame[vulkan->FrameIndex] != recordedFrame, "Query region \"%s\" was already recorded this frame.\n", queryRegion->Name))
+	{
+		return;
+	}
+	if (!eng_Ensure((eng_VulkanQueryRegionGetActiveFlags(vulkan) & queryRegion->Flags) == 0, "Query region \"%s\" can't nest in another region with the same query type.\n", queryRegion->Name))
+	{
+		return;
+	}
+	uint32_t enclosing = eng_VulkanQueryRegionGetEnclosing(vulkan);
+	queryRegion->RecordedFrame[vulkan->FrameIndex] = recordedFrame;
+	queryRegion->Active = true;
+
+	uint32_t query = eng_VulkanQueryRegionGetQuery(vulkan, region);
+	if (queryRegion->Flags & ENG_VULKAN_QUERY_OCCLUSION)
+	{
+		vkCmdBeginQuery(cmd, vulkan->OcclusionQueries, query, vulkan->EnabledFeatures.occlusionQueryPrecise ? VK_QUERY_CONTROL_PRECISE_BIT : 0);
+	}
+	if ((queryRegion->Flags & ENG_VULKAN_QUERY_PIPELINE_STATISTICS) && vulkan->StatisticsQueries != VK_NULL_HANDLE)
+	{
+		if (enclosing != ENG_VULKAN_INVALID_QUERY_REGION)
+		{
+			eng_VulkanQueryRegion* enclosingRegion = eng_VulkanQueryRegionGet(vulkan, enclosing);
+			vkCmdEndQuery(cmd, vulkan->StatisticsQueries, enclosingRegion->StatisticsQuery);
+			enclosingRegion->Suspended = true;
+			queryRegion->EnclosingRegion[vulkan->FrameIndex] = enclosing;
+		}
+		queryRegion->StatisticsQuery = query;
+		vkCmdBeginQuery(cmd, vulkan->StatisticsQueries, query, 0);
+	}
+}
+
+void eng_VulkanQueryRegionEnd(eng_Vulkan* vulkan, VkCommandBuffer cmd, uint32_t region)
+{
+	if (region == ENG_VULKAN_INVALID_QUERY_REGION || vulkan->OcclusionQueries == VK_NULL_HANDLE)
+	{
+		return;
+	}
+
+	eng_VulkanQueryRegion* queryRegion = eng_VulkanQueryRegionGet(vulkan, region);
+	if (!queryRegion->Active)
+	{
+		return;
+	}
+	queryRegion->Active = false;
+
+	uint32_t query = eng_VulkanQueryRegionGetQuery(vulkan, region);
+	if (queryRegion->Flags & ENG_VULKAN_QUERY_OCCLUSION)
+	{
+		vkCmdEndQuery(cmd, vulkan->OcclusionQueries, query);
+	}
+	if ((queryRegion->Flags & ENG_VULKAN_QUERY_PIPELINE_STATISTICS) && vulkan->StatisticsQueries != VK_NULL_HANDLE && !queryRegion->Suspended)
+	{
+		vkCmdEndQuery(cmd, vulkan->StatisticsQueries, queryRegion->StatisticsQuery);
+	}
+	queryRegion->Suspended = false;
+
+	// Resume the region this one suspended in a new piece of its statistics.
+	uint32_t enclosing = queryRegion->EnclosingRegion[vulkan->FrameIndex];
+	if (enclosing == ENG_VULKAN_INVALID_QUERY_REGION)
+	{
+		return;
+	}
+	eng_VulkanQueryRegion* enclosingRegion = eng_VulkanQueryRegionGet(vulkan, enclosing);
+	uint32_t* pieceCount = &vulkan->QueryPieceCount[vulkan->FrameIndex];
+	if (!enclosingRegion->Active || !eng_Ensure(*pieceCount < ENG_VULKAN_MAX_QUERY_PIECES, "Query region \"%s\" ran out of pieces, its statistics will miss the rest of this frame.\n", enclosingRegion->Name))
+	{
+		return;
+	}
+	vulkan->QueryPieceRegions[vulkan->FrameIndex][*pieceCount] = enclosing;
+	enclosingRegion->StatisticsQuery = ENG_VULKAN_MAX_QUERY_REGIONS * ENG_VULKAN_FRAMES_IN_FLIGHT + vulkan->FrameIndex * ENG_VULKAN_MAX_QUERY_PIECES + *pieceCount;
+	enclosingRegion->Suspended = false;
+	++*pieceCount;
+	vkCmdBeginQuery(cmd, vulkan->StatisticsQueries, enclosingRegion->StatisticsQuery, 0);
+}
+
+bool eng_VulkanQueryRegionGetResult(eng_Vulkan* vulkan, uint32_t region, eng_VulkanQueryResult* outResult)
+{
+	if (region == ENG_VULKAN_INVALID_QUERY_REGION)
+	{
+		return false;
+	}
+
+	eng_VulkanQueryRegion* queryRegion = eng_VulkanQueryRegionGet(vulkan, region);
+	if (!queryRegion->HasResult)
+	{
+		return false;
+	}
+	*outResult = queryRegion->Result;
+	outResult->Age = (uint32_t)(vulkan->FrameNumber - queryRegion->ResultFrame);
+	return true;
+}
+
+bool eng_VulkanQueryRegionIsVisible(eng_Vulkan* vulkan, uint32_t region)
+{
+	eng_VulkanQueryResult result;
+	return !eng_VulkanQueryRegionGetResult(vulkan, region, &result) || !result.HasOcclusion || result.SamplesPassed > 0;
+}
+
+////////////////////////////////////////////////////////////////////////// Internal
+bool eng_InternalVkQueriesCreate(eng_Vulkan* vulkan)
+{
+	const VkQueryPoolCreateInfo occlusionInfo = {
+		.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+		.queryType = VK_QUERY_TYPE_OCCLUSION,
+		.queryCount = ENG_VULKAN_MAX_QUERY_REGIONS * ENG_VULKAN_FRAMES_IN_FLIGHT,
+	};
+	VkResult result = vkCreateQueryPool(vulkan->Device, &occlusionInfo, NULL, &vulkan->OcclusionQueries);
+	eng_VulkanEnsure(result, "create occlusion query pool");
+
+	if (vulkan->EnabledFeatures.pipelineStatisticsQuery)
+	{
+		const VkQueryPoolCreateInfo statisticsInfo = {
+			.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+			.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS,
+			.queryCount = (ENG_VULKAN_MAX_QUERY_REGIONS + ENG_VULKAN_MAX_QUERY_PIECES) * ENG_VULKAN_FRAMES_IN_FLIGHT,
+			.pipelineStatistics = PIPELINE_STATISTICS,
+		};
+		result = vkCreateQueryPool(vulkan->Device, &statisticsInfo, NULL, &vulkan->StatisticsQueries);
+		eng_VulkanEnsure(result, "create pipeline statistics query pool");
+	}
+
+	vulkan->SceneQueryRegion = eng_VulkanQueryRegionRegister(vulkan, "Scene", ENG_VULKAN_QUERY_PIPELINE_STATISTICS);
+	vulkan->OverlayQueryRegion = eng_VulkanQueryRegionRegister(vulkan, "Overlay", ENG_VULKAN_QUERY_PIPELINE_STATISTICS);
+	uint32_t passRegions[2] = { vulkan->SceneQueryRegion, vulkan->OverlayQueryRegion };
+	for (uint32_t i = 0; i < 2; ++i)
+	{
+		if (passRegions[i] != ENG_VULKAN_INVALID_QUERY_REGION)
+		{
+			eng_VulkanQueryRegionGet(vulkan, passRegions[i])->Encloses = true;
+		}
+	}
+	return true;
+}
+
+void eng_InternalVkQueriesDestroy(eng_Vulkan* vulkan)
+{
+	vkDestroyQueryPool(vulkan->Device, vulkan->OcclusionQueries, NULL);
+	vkDestroyQueryPool(vulkan->Device, vulkan->StatisticsQueries, NULL);
+	vulkan->OcclusionQueries = VK_NULL_HANDLE;
+	vulkan->StatisticsQueries = VK_NULL_HANDLE;
+}
+
+void eng_InternalVkQueriesBeginFrame(eng_Vulkan* vulkan, VkCommandBuffer cmd)
+{
+	if (vulkan->OcclusionQueries == VK_NULL_HANDLE)
+	{
+		return;
+	}
+
+	eng_VulkanQueryResult collected[ENG_VULKAN_MAX_QUERY_REGIONS];
+	memset(collected, 0, sizeof(collected));
+	for (uint32_t i = 0; i < vulkan->QueryRegions.Count; ++i)
+	{
+		if (eng_VulkanQueryRegionGet(vulkan, i)->RecordedFrame[vulkan->FrameIndex] != 0)
+		{
+			eng_VulkanQueryRegionCollect(vulkan, i, &collected[i]);
+		}
+	}
+
+	// Nested regions suspended their enclosing region's statistics, so add
+	// theirs back in to cover the whole pass.
+	for (uint32_t i = 0; i < vulkan->QueryRegions.Count; ++i)
+	{
+		uint32_t enclosing = eng_VulkanQueryRegionGet(vulkan, i)->EnclosingRegion[vulkan->FrameIndex];
+		if (enclosing == ENG_VULKAN_INVALID_QUERY_REGION)
+		{
+			continue;
+		}
+		eng_VulkanQueryResult* total = &collected[enclosing];
+		total->HasStatistics = total->HasStatistics && collected[i].HasStatistics;
+		total->VertexInvocations += collected[i].VertexInvocations;
+		total->ClippingPrimitives += collected[i].ClippingPrimitives;
+		total->FragmentInvocations += collected[i].FragmentInvocations;
+		total->ComputeInvocations += collected[i].ComputeInvocations;
+	}
+
+	for (uint32_t i = 0; i < vulkan->QueryRegions.Count; ++i)
+	{
+		eng_VulkanQueryRegion* queryRegion = eng_VulkanQueryRegionGet(vulkan, i);
+		if (queryRegion->RecordedFrame[vulkan->FrameIndex] == 0)
+		{
+			continue;
+		}
+		if (collected[i].HasOcclusion || collected[i].HasStatistics)
+		{
+			queryRegion->Result = collected[i];
+			queryRegion->ResultFrame = queryRegion->RecordedFrame[vulkan->FrameIndex] - 1;
+			queryRegion->HasResult = true;
+		}
+		queryRegion->RecordedFrame[vulkan->FrameIndex] = 0;
+		queryRegion->EnclosingRegion[vulkan->FrameIndex] = ENG_VULKAN_INVALID_QUERY_REGION;
+	}
+
+	uint32_t firstQuery = vulkan->FrameIndex * ENG_VULKAN_MAX_QUERY_REGIONS;
+	vkCmdResetQueryPool(cmd, vulkan->OcclusionQueries, firstQuery, ENG_VULKAN_MAX_QUERY_REGIONS);
+	if (vulkan->StatisticsQueries != VK_NULL_HANDLE)
+	{
+		vkCmdResetQueryPool(cmd, vulkan->StatisticsQueries, firstQuery, ENG_VULKAN_MAX_QUERY_REGIONS);
+		uint32_t firstPiece = ENG_VULKAN_MAX_QUERY_REGIONS * ENG_VULKAN_FRAMES_IN_FLIGHT + vulkan->FrameIndex * ENG_VULKAN_MAX_QUERY_PIECES;
+		vkCmdResetQueryPool(cmd, vulkan->StatisticsQueries, firstPiece, ENG_VULKAN_MAX_QUERY_PIECES);
+	}
+	vulkan->QueryPieceCount[vulkan->FrameIndex] = 0;
+}
+
+eng_VulkanQueryRegion* eng_VulkanQueryRegionGet(eng_Vulkan* vulkan, uint32_t region)
+{
+	return eng_ArrayPIndexType(&vulkan->QueryRegions, eng_VulkanQueryRegion, region);
+}
+
+uint32_t eng_VulkanQueryRegionGetQuery(eng_Vulkan* vulkan, uint32_t region)
+{
+	return vulkan->FrameIndex * ENG_VULKAN_MAX_QUERY_REGIONS + region;
+}
+
+uint32_t eng_VulkanQueryRegionGetActiveFlags(eng_Vulkan* vulkan)
+{
+	uint32_t flags = 0;
+	for (uint32_t i = 0; i < vulkan->QueryRegions.Count; ++i)
+	{
+		eng_VulkanQueryRegion* queryRegion = eng_VulkanQueryRegionGet(vulkan, i);
+		if (queryRegion->Active)
+		{
+			flags |= queryRegion->Encloses ? queryRegion->Flags & ~ENG_VULKAN_QUERY_PIPELINE_STATISTICS : queryRegion->Flags;
+		}
+	}
+	return flags;
+}
+
+uint32_t eng_VulkanQueryRegionGetEnclosing(eng_Vulkan* vulkan)
+{
+	for (uint32_t i = 0; i < vulkan->QueryRegions.Count; ++i)
+	{
+		eng_VulkanQueryRegion* queryRegion = eng_VulkanQueryRegionGet(vulkan, i);
+		if (queryRegion->Active && queryRegion->Encloses && !queryRegion->Suspended && (queryRegion->Flags & ENG_VULKAN_QUERY_PIPELINE_STATISTICS))
+		{
+			return i;
+		}
+	}
+	return ENG_VULKAN_INVALID_QUERY_REGION;
+}
+
+void eng_VulkanQueryRegionCollect(eng_Vulkan* vulkan, uint32_t region, eng_VulkanQueryResult* outResult)
+{
+	// The availability word follows the values, so a query that hasn't
+	// finished is skipped rather than waited on.
+	eng_VulkanQueryRegion* queryRegion = eng_VulkanQueryRegionGet(vulkan, region);
+	uint32_t query = eng_VulkanQueryRegionGetQuery(vulkan, region);
+	memset(outResult, 0, sizeof(eng_VulkanQueryResult));
+
+	if (queryRegion->Flags & ENG_VULKAN_QUERY_OCCLUSION)
+	{
+		uint64_t values[2];
+		VkResult result = vkGetQueryPoolResults(vulkan->Device, vulkan->OcclusionQueries, query, 1, sizeof(values), values, sizeof(values),
+			VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+		if ((result == VK_SUCCESS || result == VK_NOT_READY) && values[1] != 0)
+		{
+			outResult->HasOcclusion = true;
+			outResult->SamplesPassed = values[0];
+		}
+	}
+
+	if ((queryRegion->Flags & ENG_VULKAN_QUERY_PIPELINE_STATISTICS) && vulkan->StatisticsQueries != VK_NULL_HANDLE)
+	{
+		bool available = eng_VulkanQueryAddStatistics(vulkan, query, outResult);
+		uint32_t firstPiece = ENG_VULKAN_MAX_QUERY_REGIONS * ENG_VULKAN_FRAMES_IN_FLIGHT + vulkan->FrameIndex * ENG_VULKAN_MAX_QUERY_PIECES;
+		for (uint32_t i = 0; i < vulkan->QueryPieceCount[vulkan->FrameIndex]; ++i)
+		{
+			if (vulkan->QueryPieceRegions[vulkan->FrameIndex][i] == region)
+			{
+				available = eng_VulkanQueryAddStatistics(vulkan, firstPiece + i, outResult) && available;
+			}
+		}
+		outResult->HasStatistics = available;
+	}
+}
+
+bool eng_VulkanQueryAddStatistics(eng_Vulkan* vulkan, uint32_t query, eng_VulkanQueryResult* inOutResult)
+{
+	uint64_t values[STATISTIC_COUNT + 1];
+	VkResult result = vkGetQueryPoolResults(vulkan->Device, vulkan->StatisticsQueries, query, 1, sizeof(values), values, sizeof(values),
+		VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+	if ((result != VK_SUCCESS && result != VK_NOT_READY) || values[STATISTIC_COUNT] == 0)
+	{
+		return false;
+	}
+	inOutResult->VertexInvocations += values[STATISTIC_VERTEX_INVOCATIONS];
+	inOutResult->ClippingPrimitives += values[STATISTIC_CLIPPING_PRIMITIVES];
+	inOutResult->FragmentInvocations += values[STATISTIC_FRAGMENT_INVOCATIONS];
+	inOutResult->ComputeInvocations += values[STATISTIC_COMPUTE_INVOCATIONS];
+	return true;
+}
\ No newline at end of file
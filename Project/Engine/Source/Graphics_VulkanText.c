@@ -0,0 +1,499 @@
+#include <Engine/Graphics_VulkanText.h>
+
+#include <Engine/Allocator.h>
+#include <Engine/Graphics_Vulkan.h>
+#include <Engine/GlyphCache.h>
+#include <Engine/Log.h>
+
+#if defined(GAME_WINDOWS)
+#define VK_USE_PLATFORM_WIN32_KHR
+#endif
+#include <ThirdParty/Vulkan/vulkan.h>
+
+#include <Engine/Graphics_VulkanInternal.h>
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 16 bit indices: four vertices per glyph.
+#define MAX_GLYPHS_PER_FRAME (65536 / 4)
+#define LARGE_ATLAS_SIZE 512
+#define SMALL_ATLAS_SIZE 256
+#define DRAWF_BUFFER_SIZE 256
+
+typedef struct eng_TextVertex
+{
+	float X, Y;
+	float U, V;
+	uint32_t Color;
+} eng_TextVertex;
+
+typedef struct eng_TextPushConstants
+{
+	float InvHalfExtent[2];
+	uint32_t AtlasSize;
+} eng_TextPushConstants;
+
+typedef struct eng_VulkanTextFrame
+{
+	VkBuffer VertexBuffer;
+	VkDeviceMemory VertexMemory;
+	eng_TextVertex* Vertices;
+	uint32_t GlyphCount;
+} eng_VulkanTextFrame;
+
+typedef struct eng_VulkanText
+{
+	eng_Vulkan* Vulkan;
+	eng_GlyphCache* Glyphs;
+	uint32_t MaxGlyphs;
+
+	// The atlas is a host visible texel buffer: the glyph cache rasterizes
+	// straight into it, so there is no staging copy or layout transition.
+	uint32_t AtlasSize;
+	VkBuffer AtlasBuffer;
+	VkDeviceMemory AtlasMemory;
+	VkBufferView AtlasView;
+
+	VkBuffer IndexBuffer;
+	VkDeviceMemory IndexMemory;
+
+	VkDescriptorSetLayout SetLayout;
+	VkDescriptorPool DescriptorPool;
+	VkDescriptorSet DescriptorSet;
+	VkPipelineLayout PipelineLayout;
+	VkPipeline Pipeline;
+
+	eng_VulkanTextFrame Frames[ENG_VULKAN_FRAMES_IN_FLIGHT];
+} eng_VulkanText;
+
+bool eng_VulkanTextCreateBuffers(eng_VulkanText* text);
+bool eng_VulkanTextCreatePipeline(eng_VulkanText* text);
+void eng_VulkanTextRecord(void* userData, VkCommandBuffer cmd);
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+eng_VulkanText* eng_VulkanTextMalloc(void)
+{
+	return malloc(sizeof(eng_VulkanText));
+}
+
+bool eng_VulkanTextInit(eng_VulkanText* text, eng_Vulkan* vulkan, uint32_t maxGlyphsPerFrame)
+{
+	memset(text, 0, sizeof(eng_VulkanText));
+	text->Vulkan = vulkan;
+	text->MaxGlyphs = maxGlyphsPerFrame < MAX_GLYPHS_PER_FRAME ? maxGlyphsPerFrame : MAX_GLYPHS_PER_FRAME;
+
+	// 256x256 is all the spec guarantees for a texel buffer; most hardware
+	// allows far more.
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(vulkan->PhysicalDevice, &properties);
+	text->AtlasSize = properties.limits.maxTexelBufferElements >= LARGE_ATLAS_SIZE * LARGE_ATLAS_SIZE
+		? LARGE_ATLAS_SIZE : SMALL_ATLAS_SIZE;
+
+	if (!eng_VulkanTextCreateBuffers(text) || !eng_VulkanTextCreatePipeline(text))
+	{
+		return false;
+	}
+
+	eng_OnOverlayBind(vulkan, eng_VulkanTextRecord, text);
+	return true;
+}
+
+void eng_VulkanTextFree(eng_VulkanText* text, bool subAllocationsOnly)
+{
+	if (text == NULL)
+	{
+		return;
+	}
+
+	VkDevice device = text->Vulkan->Device;
+	eng_OnOverlayUnbind(text->Vulkan, eng_VulkanTextRecord);
+	vkDeviceWaitIdle(device);
+
+	vkDestroyPipeline(device, text->Pipeline, NULL);
+	vkDestroyPipelineLayout(device, text->PipelineLayout, NULL);
+	vkDestroyDescriptorPool(device, text->DescriptorPool, NULL);
+	vkDestroyDescriptorSetLayout(device, text->SetLayout, NULL);
+
+	for (uint32_t i = 0; i < ENG_VULKAN_FRAMES_IN_FLIGHT; ++i)
+	{
+		vkDestroyBuffer(device, text->Frames[i].VertexBuffer, NULL);
+		vkFreeMemory(device, text->Frames[i].VertexMemory, NULL);
+	}
+	vkDestroyBuffer(device, text->IndexBuffer, NULL);
+	vkFreeMemory(device, text->IndexMemory, NULL);
+
+	if (text->Glyphs != NULL)
+	{
+		eng_GlyphCacheFree(text->Glyphs, true);
+		eng_AllocatorFree(text->Vulkan->Allocator, text->Glyphs, eng_GlyphCacheGetSizeof());
+	}
+	vkDestroyBufferView(device, text->AtlasView, NULL);
+	vkDestroyBuffer(device, text->AtlasBuffer, NULL);
+	vkFreeMemory(device, text->AtlasMemory, NULL);
+
+	if (!subAllocationsOnly)
+	{
+		free(text);
+	}
+}
+
+size_t eng_VulkanTextGetSizeof(void)
+{
+	return sizeof(eng_VulkanText);
+}
+
+////////////////////////////////////////////////////////////////////////// API
+void eng_VulkanTextDraw(eng_VulkanText* text, int32_t x, int32_t y, uint32_t scale, uint32_t color, const char* str)
+{
+	eng_VulkanTextFrame* frame = &text->Frames[eng_VulkanGetFrameIndex(text->Vulkan)];
+	int32_t penX = x;
+	int32_t lineHeight = (int32_t)eng_GlyphCacheGetLineHeight(scale);
+
+	for (; *str != '\0'; ++str)
+	{
+		if (*str == '\n')
+		{
+			penX = x;
+			y += lineHeight;
+			continue;
+		}
+
+		eng_Glyph glyph;
+		if (!eng_GlyphCacheGet(text->Glyphs, *str, scale, &glyph))
+		{
+			// Every cell is still referenced by a frame in flight.
+			continue;
+		}
+
+		if (*str != ' ')
+		{
+			if (frame->GlyphCount == text->MaxGlyphs)
+			{
+				return;
+			}
+
+			float left = (float)penX;
+			float top = (float)y;
+			float right = left + glyph.Width;
+			float bottom = top + glyph.Height;
+			float u0 = (float)glyph.X;
+			float v0 = (float)glyph.Y;
+			float u1 = u0 + glyph.Width;
+			float v1 = v0 + glyph.Height;
+
+			eng_TextVertex* quad = frame->Vertices + frame->GlyphCount * 4;
+			quad[0] = (eng_TextVertex){ left, top, u0, v0, color };
+			quad[1] = (eng_TextVertex){ right, top, u1, v0, color };
+			quad[2] = (eng_TextVertex){ right, bottom, u1, v1, color };
+			quad[3] = (eng_TextVertex){ left, bottom, u0, v1, color };
+			++frame->GlyphCount;
+		}
+		penX += glyph.Advance;
+	}
+}
+
+void eng_VulkanTextDrawf(eng_VulkanText* text, int32_t x, int32_t y, uint32_t scale, uint32_t color, const char* fmt, ...)
+{
+	char buffer[DRAWF_BUFFER_SIZE];
+	va_list args;
+	va_start(args, fmt);
+	vsnprintf(buffer, sizeof(buffer), fmt, args);
+	va_end(args);
+	buffer[DRAWF_BUFFER_SIZE - 1] = '\0';
+
+	eng_VulkanTextDraw(text, x, y, scale, color, buffer);
+}
+
+uint32_t eng_VulkanTextGetLineHeight(uint32_t scale)
+{
+	return eng_GlyphCacheGetLineHeight(scale);
+}
+
+uint32_t eng_VulkanTextGetRasterizeCount(eng_VulkanText* text)
+{
+	return eng_GlyphCacheGetRasterizeCount(text->Glyphs);
+}
+
+////////////////////////////////////////////////////////////////////////// Internal
+bool eng_VulkanTextCreateBuffers(eng_VulkanText* text)
+{
+	eng_Vulkan* vulkan = text->Vulkan;
+	const VkMemoryPropertyFlags hostVisible = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+	VkDeviceSize atlasBytes = (VkDeviceSize)text->AtlasSize * text->AtlasSize;
+
+	if (!eng_InternalVkCreateBuffer(vulkan, atlasBytes, VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT, hostVisible,
+		&text->AtlasBuffer, &text->AtlasMemory))
+	{
+		return false;
+	}
+
+	uint8_t* atlas;
+	VkResult result = vkMapMemory(vulkan->Device, text->AtlasMemory, 0, atlasBytes, 0, (void**)&atlas);
+	eng_VulkanEnsure(result, "map glyph atlas");
+
+	const VkBufferViewCreateInfo viewInfo = {
+		.sType = VK_STRUCTURE_TYPE_BUFFER_VIEW_CREATE_INFO,
+		.buffer = text->AtlasBuffer,
+		.format = VK_FORMAT_R8_UNORM,
+		.range = VK_WHOLE_SIZE,
+	};
+	result = vkCreateBufferView(vulkan->Device, &viewInfo, NULL, &text->AtlasView);
+	eng_VulkanEnsure(result, "create glyph atlas view");
+
+	text->Glyphs = eng_AllocatorAlloc(vulkan->Allocator, eng_GlyphCacheGetSizeof(), ENG_ALLOCATOR_DEFAULT_ALIGNMENT);
+	if (text->Glyphs == NULL || !eng_GlyphCacheInit(text->Glyphs, atlas, text->AtlasSize, ENG_VULKAN_FRAMES_IN_FLIGHT, vulkan->Allocator))
+	{
+		return false;
+	}
+
+	// Every quad uses the same index pattern, so the index buffer is filled once.
+	VkDeviceSize indexBytes = (VkDeviceSize)text->MaxGlyphs * 6 * sizeof(uint16_t);
+	if (!eng_InternalVkCreateBuffer(vulkan, indexBytes, VK_BUFFER_USAGE_INDEX_BUFFER_BIT, hostVisible,
+		&text->IndexBuffer, &text->IndexMemory))
+	{
+		return false;
+	}
+
+	uint16_t* indices;
+	result = vkMapMemory(vulkan->Device, text->IndexMemory, 0, indexBytes, 0, (void**)&indices);
+	eng_VulkanEnsure(result, "map text indices");
+	for (uint32_t i = 0; i < text->MaxGlyphs; ++i)
+	{
+		uint16_t first = (uint16_t)(i * 4);
+		indices[i * 6 + 0] = first;
+		indices[i * 6 + 1] = first + 1;
+		indices[i * 6 + 2] = first + 2;
+		indices[i * 6 + 3] = first;
+		indices[i * 6 + 4] = first + 2;
+		indices[i * 6 + 5] = first + 3;
+	}
+	vkUnmapMemory(vulkan->Device, text->IndexMemory);
+
+	// Quads are written straight into mapped memory as text is drawn.
+	VkDeviceSize vertexBytes = (VkDeviceSize)text->MaxGlyphs * 4 * sizeof(eng_TextVertex);
+	for (uint32_t i = 0; i < ENG_VULKAN_FRAMES_IN_FLIGHT; ++i)
+	{
+		eng_VulkanTextFrame* frame = &text->Frames[i];
+		if (!eng_InternalVkCreateBuffer(vulkan, vertexBytes, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, hostVisible,
+			&frame->VertexBuffer, &frame->VertexMemory))
+		{
+			return false;
+		}
+		result = vkMapMemory(vulkan->Device, frame->VertexMemory, 0, vertexBytes, 0, (void**)&frame->Vertices);
+		eng_VulkanEnsure(result, "map text vertices");
+	}
+
+	return true;
+}
+
+bool eng_VulkanTextCreatePipeline(eng_VulkanText* text)
+{
+	eng_Vulkan* vulkan = text->Vulkan;
+
+	const VkDescriptorSetLayoutBinding atlasBinding = {
+		.binding = 0,
+		.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER,
+		.descriptorCount = 1,
+		.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
+	};
+	const VkDescriptorSetLayoutCreateInfo setLayoutInfo = {
+		.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+		.bindingCount = 1,
+		.pBindings = &atlasBinding,
+	};
+	VkResult result = vkCreateDescriptorSetLayout(vulkan->Device, &setLayoutInfo, NULL, &text->SetLayout);
+	eng_VulkanEnsure(result, "create text descriptor set layout");
+
+	const VkDescriptorPoolSize poolSize = {
+		.type = VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER,
+		.descriptorCount = 1,
+	};
+	const VkDescriptorPoolCreateInfo poolInfo = {
+		.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+		.maxSets = 1,
+		.poolSizeCount = 1,
+		.pPoolSizes = &poolSize,
+	};
+	result = vkCreateDescriptorPool(vulkan->Device, &poolInfo, NULL, &text->DescriptorPool);
+	eng_VulkanEnsure(result, "create text descriptor pool");
+
+	const VkDescriptorSetAllocateInfo setInfo = {
+		.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+		.descriptorPool = text->DescriptorPool,
+		.descriptorSetCount = 1,
+		.pSetLayouts = &text->SetLayout,
+	};
+	result = vkAllocateDescriptorSets(vulkan->Device, &setInfo, &text->DescriptorSet);
+	eng_VulkanEnsure(result, "allocate text descriptor set");
+
+	const VkWriteDescriptorSet write = {
+		.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+		.dstSet = text->DescriptorSet,
+		.dstBinding = 0,
+		.descriptorCount = 1,
+		.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER,
+		.pTexelBufferView = &text->AtlasView,
+	};
+	vkUpdateDescriptorSets(vulkan->Device, 1, &write, 0, NULL);
+
+	const VkPushConstantRange pushRange = {
+		.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+		.offset = 0,
+		.size = sizeof(eng_TextPushConstants),
+	};
+	const VkPipelineLayoutCreateInfo layoutInfo = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+		.setLayoutCount = 1,
+		.pSetLayouts = &text->SetLayout,
+		.pushConstantRangeCount = 1,
+		.pPushConstantRanges = &pushRange,
+	};
+	result = vkCreatePipelineLayout(vulkan->Device, &layoutInfo, NULL, &text->PipelineLayout);
+	eng_VulkanEnsure(result, "create text pipeline layout");
+
+	VkShaderModule vertexShader = eng_InternalVkLoadShader(vulkan, "Shaders/Text.vert.spv");
+	VkShaderModule fragmentShader = eng_InternalVkLoadShader(vulkan, "Shaders/Text.frag.spv");
+	if (vertexShader == VK_NULL_HANDLE || fragmentShader == VK_NULL_HANDLE)
+	{
+		vkDestroyShaderModule(vulkan->Device, vertexShader, NULL);
+		vkDestroyShaderModule(vulkan->Device, fragmentShader, NULL);
+		return false;
+	}
+
+	const VkPipelineShaderStageCreateInfo stages[2] = {
+		[0] = {
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+			.stage = VK_SHADER_STAGE_VERTEX_BIT,
+			.module = vertexShader,
+			.pName = "main",
+		},
+		[1] = {
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+			.stage = VK_SHADER_STAGE_FRAGMENT_BIT,
+			.module = fragmentShader,
+			.pName = "main",
+		},
+	};
+
+	const VkVertexInputBindingDescription vertexBinding = {
+		.binding = 0,
+		.stride = sizeof(eng_TextVertex),
+		.inputRate = VK_VERTEX_INPUT_RATE_VERTEX,
+	};
+	const VkVertexInputAttributeDescription vertexAttributes[3] = {
+		[0] = { .location = 0, .binding = 0, .format = VK_FORMAT_R32G32_SFLOAT, .offset = offsetof(eng_TextVertex, X) },
+		[1] = { .location = 1, .binding = 0, .format = VK_FORMAT_R32G32_SFLOAT, .offset = offsetof(eng_TextVertex, U) },
+		[2] = { .location = 2, .binding = 0, .format = VK_FORMAT_R8G8B8A8_UNORM, .offset = offsetof(eng_TextVertex, Color) },
+	};
+	const VkPipelineVertexInputStateCreateInfo vertexInput = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+		.vertexBindingDescriptionCount = 1,
+		.pVertexBindingDescriptions = &vertexBinding,
+		.vertexAttributeDescriptionCount = 3,
+		.pVertexAttributeDescriptions = vertexAttributes,
+	};
+	const VkPipelineInputAssemblyStateCreateInfo inputAssembly = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
+		.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+	};
+	const VkPipelineViewportStateCreateInfo viewportState = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+		.viewportCount = 1,
+		.scissorCount = 1,
+	};
+	const VkPipelineRasterizationStateCreateInfo rasterization = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
+		.polygonMode = VK_POLYGON_MODE_FILL,
+		.cullMode = VK_CULL_MODE_NONE,
+		.frontFace = VK_FRONT_FACE_CLOCKWISE,
+		.lineWidth = 1.0f,
+	};
+	const VkPipelineMultisampleStateCreateInfo multisample = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+		.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+	};
+	const VkPipelineColorBlendAttachmentState blendAttachment = {
+		.blendEnable = VK_TRUE,
+		.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA,
+		.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA,
+		.colorBlendOp = VK_BLEND_OP_ADD,
+		.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE,
+		.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA,
+		.alphaBlendOp = VK_BLEND_OP_ADD,
+		.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT,
+	};
+	const VkPipelineColorBlendStateCreateInfo colorBlend = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+		.attachmentCount = 1,
+		.pAttachments = &blendAttachment,
+	};
+	const VkDynamicState dynamicStates[2] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+	const VkPipelineDynamicStateCreateInfo dynamicState = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+		.dynamicStateCount = 2,
+		.pDynamicStates = dynamicStates,
+	};
+
+	const VkGraphicsPipelineCreateInfo pipelineInfo = {
+		.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+		.stageCount = 2,
+		.pStages = stages,
+		.pVertexInputState = &vertexInput,
+		.pInputAssemblyState = &inputAssembly,
+		.pViewportState = &viewportState,
+		.pRasterizationState = &rasterization,
+		.pMultisampleState = &multisample,
+		.pColorBlendState = &colorBlend,
+		.pDynamicState = &dynamicState,
+		.layout = text->PipelineLayout,
+		.renderPass = vulkan->RenderPass,
+		.subpass = 0,
+	};
+	result = vkCreateGraphicsPipelines(vulkan->Device, VK_NULL_HANDLE, 1, &pipelineInfo, NULL, &text->Pipeline);
+
+	vkDestroyShaderModule(vulkan->Device, vertexShader, NULL);
+	vkDestroyShaderModule(vulkan->Device, fragmentShader, NULL);
+	eng_VulkanEnsure(result, "create text pipeline");
+	return true;
+}
+
+void eng_VulkanTextRecord(void* userData, VkCommandBuffer cmd)
+{
+	eng_VulkanText* text = (eng_VulkanText*)userData;
+	eng_VulkanTextFrame* frame = &text->Frames[eng_VulkanGetFrameIndex(text->Vulkan)];
+
+	if (frame->GlyphCount > 0)
+	{
+		VkExtent2D extent = text->Vulkan->SwapchainExtent;
+		const VkViewport viewport = {
+			.width = (float)extent.width,
+			.height = (float)extent.height,
+			.maxDepth = 1.0f,
+		};
+		const VkRect2D scissor = { .extent = extent };
+		const eng_TextPushConstants constants = {
+			.InvHalfExtent = { 2.0f / extent.width, 2.0f / extent.height },
+			.AtlasSize = text->AtlasSize,
+		};
+		const VkDeviceSize vertexOffset = 0;
+
+		vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, text->Pipeline);
+		vkCmdSetViewport(cmd, 0, 1, &viewport);
+		vkCmdSetScissor(cmd, 0, 1, &scissor);
+		vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, text->PipelineLayout, 0, 1, &text->DescriptorSet, 0, NULL);
+		vkCmdPushConstants(cmd, text->PipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+			0, sizeof(constants), &constants);
+		vkCmdBindVertexBuffers(cmd, 0, 1, &frame->VertexBuffer, &vertexOffset);
+		vkCmdBindIndexBuffer(cmd, text->IndexBuffer, 0, VK_INDEX_TYPE_UINT16);
+
+		// All text for the frame is one draw.
+		vkCmdDrawIndexed(cmd, frame->GlyphCount * 6, 1, 0, 0, 0);
+	}
+
+	// This slot is next written ENG_VULKAN_FRAMES_IN_FLIGHT frames from now.
+	frame->GlyphCount = 0;
+	eng_GlyphCacheNextFrame(text->Glyphs);
+}
\ No newline at end of file
@@ -0,0 +1,603 @@
+#include <Engine/Graphics_VulkanTexture.h>
+
+#include <Engine/Array.h>
+#include <Engine/Graphics_Vulkan.h>
+#include <Engine/Log.h>
+
+#if defined(GAME_WINDOWS)
+#define VK_USE_PLATFORM_WIN32_KHR
+#endif
+#include <ThirdParty/Vulkan/vulkan.h>
+
+#include <Engine/Graphics_VulkanInternal.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+// Enough batches that a frame's upload can be recorded while the previous
+// two are still being copied by the GPU.
+#define UPLOAD_BATCH_COUNT 3
+#define STAGING_ALIGNMENT 16
+#define DEFAULT_BYTES_PER_UPDATE (32u * 1024u * 1024u)
+
+typedef struct eng_VulkanTexture
+{
+	VkDevice Device;
+	VkImage Image;
+	VkDeviceMemory Memory;
+	VkImageView View;
+	VkFormat Format;
+	uint32_t Width;
+	uint32_t Height;
+	uint32_t LevelCount;
+	bool Ready;
+} eng_VulkanTexture;
+
+typedef struct eng_VulkanPendingUpload
+{
+	eng_VulkanTexture* Texture;
+	eng_Image Image;
+} eng_VulkanPendingUpload;
+
+typedef struct eng_VulkanStagingBuffer
+{
+	VkBuffer Buffer;
+	VkDeviceMemory Memory;
+} eng_VulkanStagingBuffer;
+
+typedef struct eng_VulkanUploadBatch
+{
+	VkCommandBuffer Cmd;
+	VkFence Fence;
+	// Ring bytes (including wrap padding) released when the batch retires.
+	uint32_t RingBytes;
+	uint32_t RingEnd;
+	eng_ArrayDecl(Textures, eng_VulkanTexture*);
+	eng_ArrayDecl(DedicatedStaging, eng_VulkanStagingBuffer);
+} eng_VulkanUploadBatch;
+
+typedef struct eng_VulkanUploader
+{
+	eng_Vulkan* Vulkan;
+
+	VkBuffer StagingBuffer;
+	VkDeviceMemory StagingMemory;
+	uint8_t* StagingMapped;
+	uint32_t StagingSize;
+	uint32_t StagingHead;
+	uint32_t StagingTail;
+	uint32_t StagingUsed;
+
+	uint32_t BytesPerUpdate;
+
+	eng_VulkanUploadBatch Batches[UPLOAD_BATCH_COUNT];
+	uint32_t OldestBatch;
+	uint32_t BatchesInFlight;
+
+	eng_ArrayDecl(Pending, eng_VulkanPendingUpload);
+} eng_VulkanUploader;
+
+VkFormat eng_VulkanTextureFormatFromImage(eng_ImageFormat format);
+bool eng_VulkanUploaderStagingAlloc(eng_VulkanUploader* uploader, uint32_t size, uint32_t* outOffset);
+void eng_VulkanUploaderRetire(eng_VulkanUploader* uploader, eng_VulkanUploadBatch* batch);
+void eng_VulkanUploaderRecordCopy(VkCommandBuffer cmd, VkBuffer staging, VkDeviceSize stagingOffset, eng_VulkanTexture* texture, const eng_Image* image);
+
+////////////////////////////////////////////////////////////////////////// Texture Lifecycle
+
+eng_VulkanTexture* eng_VulkanTextureMalloc(void)
+{
+	return malloc(sizeof(eng_VulkanTexture));
+}
+
+bool eng_VulkanTextureInit(eng_VulkanTexture* texture)
+{
+	memset(texture, 0, sizeof(eng_VulkanTexture));
+	return true;
+}
+
+void eng_VulkanTextureFree(eng_VulkanTexture* texture, bool subAllocationsOnly)
+{
+	if (texture == NULL)
+	{
+		return;
+	}
+
+	if (texture->Device != VK_NULL_HANDLE)
+	{
+		vkDestroyImageView(texture->Device, texture->View, NULL);
+		vkDestroyImage(texture->Device, texture->Image, NULL);
+		vkFreeMemory(texture->Device, texture->Memory, NULL);
+	}
+
+	if (!subAllocationsOnly)
+	{
+		free(texture);
+	}
+}
+
+size_t eng_VulkanTextureGetSizeof(void)
+{
+	return sizeof(eng_VulkanTexture);
+}
+
+////////////////////////////////////////////////////////////////////////// Texture API
+
+bool eng_VulkanTextureIsReady(eng_VulkanTexture* texture)
+{
+	return texture->Ready;
+}
+
+VkImageView eng_VulkanTextureGetView(eng_VulkanTexture* texture)
+{
+	return texture->View;
+}
+
+uint32_t eng_VulkanTextureGetWidth(eng_VulkanTexture* texture)
+{
+	return texture->Width;
+}
+
+uint32_t eng_VulkanTextureGetHeight(eng_VulkanTexture* texture)
+{
+	return texture->Height;
+}
+
+////////////////////////////////////////////////////////////////////////// Uploader Lifecycle
+
+eng_VulkanUploader* eng_VulkanUploaderMalloc(void)
+{
+	return malloc(sizeof(eng_VulkanUploader));
+}
+
+bool eng_VulkanUploaderInit(eng_VulkanUploader* uploader, eng_Vulkan* vulkan, uint32_t stagingSize)
+{
+	memset(uploader, 0, sizeof(eng_VulkanUploader));
+	uploader->Vulkan = vulkan;
+	uploader->StagingSize = stagingSize;
+	uploader->BytesPerUpdate = DEFAULT_BYTES_PER_UPDATE;
+	eng_ArrayInitAllocatorType(&uploader->Pending, eng_VulkanPendingUpload, vulkan->Allocator);
+
+	if (!eng_InternalVkCreateBuffer(vulkan, stagingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+		&uploader->StagingBuffer, &uploader->StagingMemory))
+	{
+		return false;
+	}
+
+	VkResult result = vkMapMemory(vulkan->Device, uploader->StagingMemory, 0, stagingSize, 0, (void**)&uploader->StagingMapped);
+	eng_VulkanEnsure(result, "map staging memory");
+
+	const VkCommandBufferAllocateInfo cmdInfo = {
+		.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+		.commandPool = vulkan->CommandPool,
+		.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+		.commandBufferCount = 1,
+	};
+	const VkFenceCreateInfo fenceInfo = {
+		.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+	};
+	for (uint32_t i = 0; i < UPLOAD_BATCH_COUNT; ++i)
+	{
+		eng_VulkanUploadBatch* batch = &uploader->Batches[i];
+		eng_ArrayInitAllocatorType(&batch->Textures, eng_VulkanTexture*, vulkan->Allocator);
+		eng_ArrayInitAllocatorType(&batch->DedicatedStaging, eng_VulkanStagingBuffer, vulkan->Allocator);
+
+		result = vkAllocateCommandBuffers(vulkan->Device, &cmdInfo, &batch->Cmd);
+		eng_VulkanEnsure(result, "allocate upload command buffer");
+		result = vkCreateFence(vulkan->Device, &fenceInfo, NULL, &batch->Fence);
+		eng_VulkanEnsure(result, "create upload fence");
+	}
+
+	return true;
+}
+
+void eng_VulkanUploaderFree(eng_VulkanUploader* uploader, bool subAllocationsOnly)
+{
+	if (uploader == NULL)
+	{
+		return;
+	}
+
+	VkDevice device = uploader->Vulkan->Device;
+	for (uint32_t i = 0; i < uploader->BatchesInFlight; ++i)
+	{
+		eng_VulkanUploadBatch* batch = &uploader->Batches[(uploader->OldestBatch + i) % UPLOAD_BATCH_COUNT];
+		vkWaitForFences(device, 1, &batch->Fence, VK_TRUE, UINT64_MAX);
+		eng_VulkanUploaderRetire(uploader, batch);
+	}
+
+	for (uint32_t i = 0; i < UPLOAD_BATCH_COUNT; ++i)
+	{
+		eng_VulkanUploadBatch* batch = &uploader->Batches[i];
+		if (batch->Cmd != VK_NULL_HANDLE)
+		{
+			vkFreeCommandBuffers(device, uploader->Vulkan->CommandPool, 1, &batch->Cmd);
+		}
+		vkDestroyFence(device, batch->Fence, NULL);
+		eng_ArrayDestroy(&batch->Textures);
+		eng_ArrayDestroy(&batch->DedicatedStaging);
+	}
+
+	// Abandoned uploads: their textures simply never become ready.
+	eng_VulkanPendingUpload* pending = eng_ArrayBeginType(&uploader->Pending, eng_VulkanPendingUpload);
+	eng_VulkanPendingUpload* pendingEnd = eng_ArrayEndType(&uploader->Pending, eng_VulkanPendingUpload);
+	for (; pending < pendingEnd; ++pending)
+	{
+		eng_ImageDestroy(&pending->Image);
+	}
+	eng_ArrayDestroy(&uploader->Pending);
+
+	if (uploader->StagingMapped != NULL)
+	{
+		vkUnmapMemory(device, uploader->StagingMemory);
+	}
+	vkDestroyBuffer(device, uploader->StagingBuffer, NULL);
+	vkFreeMemory(device, uploader->StagingMemory, NULL);
+
+	if (!subAllocationsOnly)
+	{
+		free(uploader);
+	}
+}
+
+size_t eng_VulkanUploaderGetSizeof(void)
+{
+	return sizeof(eng_VulkanUploader);
+}
+
+////////////////////////////////////////////////////////////////////////// Uploader API
+
+bool eng_VulkanUploaderQueueImage(eng_VulkanUploader* uploader, eng_VulkanTexture* texture, eng_Image* image)
+{
+	VkDevice device = uploader->Vulkan->Device;
+	VkFormat format = eng_VulkanTextureFormatFromImage(image->Format);
+	if (!eng_Ensure(format != VK_FORMAT_UNDEFINED, "Image format %d has no vulkan equivalent.\n", (int)image->Format))
+	{
+		eng_ImageDestroy(image);
+		return false;
+	}
+
+	const VkImageCreateInfo imageInfo = {
+		.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+		.imageType = VK_IMAGE_TYPE_2D,
+		.format = format,
+		.extent = { image->Width, image->Height, 1 },
+		.mipLevels = image->LevelCount,
+		.arrayLayers = 1,
+		.samples = VK_SAMPLE_COUNT_1_BIT,
+		.tiling = VK_IMAGE_TILING_OPTIMAL,
+		.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+		.sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+		.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+	};
+	VkResult result = vkCreateImage(device, &imageInfo, NULL, &texture->Image);
+	if (!eng_Ensure(result == VK_SUCCESS, "Failed to create texture image. Error(%d): \"%s\"\n", (int)result, eng_InternalVkResultToString(result)))
+	{
+		eng_ImageDestroy(image);
+		return false;
+	}
+	texture->Device = device;
+
+	VkMemoryRequirements requirements;
+	vkGetImageMemoryRequirements(device, texture->Image, &requirements);
+	const VkMemoryAllocateInfo allocInfo = {
+		.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+		.allocationSize = requirements.size,
+		.memoryTypeIndex = eng_InternalVkFindMemoryType(uploader->Vulkan, requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
+	};
+	result = vkAllocateMemory(device, &allocInfo, NULL, &texture->Memory);
+	if (result == VK_SUCCESS)
+	{
+		result = vkBindImageMemory(device, texture->Image, texture->Memory, 0);
+	}
+	if (result == VK_SUCCESS)
+	{
+		const VkImageViewCreateInfo viewInfo = {
+			.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+			.image = texture->Image,
+			.viewType = VK_IMAGE_VIEW_TYPE_2D,
+			.format = format,
+			.components = {
+				.r = VK_COMPONENT_SWIZZLE_IDENTITY,
+				.g = VK_COMPONENT_SWIZZLE_IDENTITY,
+				.b = VK_COMPONENT_SWIZZLE_IDENTITY,
+				.a = VK_COMPONENT_SWIZZLE_IDENTITY,
+			},
+			.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, image->LevelCount, 0, 1 },
+		};
+		result = vkCreateImageView(device, &viewInfo, NULL, &texture->View);
+	}
+	if (!eng_Ensure(result == VK_SUCCESS, "Failed to back texture image. Error(%d): \"%s\"\n", (int)result, eng_InternalVkResultToString(result)))
+	{
+		eng_ImageDestroy(image);
+		return false;
+	}
+
+	texture->Format = format;
+	texture->Width = image->Width;
+	texture->Height = image->Height;
+	texture->LevelCount = image->LevelCount;
+	texture->Ready = false;
+
+	eng_VulkanPendingUpload pending;
+	pending.Texture = texture;
+	pending.Image = *image;
+	eng_ArrayPushBack(&uploader->Pending, &pending);
+
+	// The uploader owns the pixels now.
+	image->Data = NULL;
+	image->DataSize = 0;
+	return true;
+}
+
+void eng_VulkanUploaderUpdate(eng_VulkanUploader* uploader)
+{
+	VkDevice device = uploader->Vulkan->Device;
+
+	// Retire in submission order so the staging ring tail only moves forward.
+	while (uploader->BatchesInFlight > 0)
+	{
+		eng_VulkanUploadBatch* oldest = &uploader->Batches[uploader->OldestBatch];
+		if (vkGetFenceStatus(device, oldest->Fence) != VK_SUCCESS)
+		{
+			break;
+		}
+		eng_VulkanUploaderRetire(uploader, oldest);
+		uploader->OldestBatch = (uploader->OldestBatch + 1) % UPLOAD_BATCH_COUNT;
+		--uploader->BatchesInFlight;
+	}
+
+	if (uploader->Pending.Count == 0 || uploader->BatchesInFlight == UPLOAD_BATCH_COUNT)
+	{
+		return;
+	}
+
+	eng_VulkanUploadBatch* batch = &uploader->Batches[(uploader->OldestBatch + uploader->BatchesInFlight) % UPLOAD_BATCH_COUNT];
+	batch->RingBytes = 0;
+
+	const VkCommandBufferBeginInfo beginInfo = {
+		.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+		.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+	};
+	VkResult result = vkBeginCommandBuffer(batch->Cmd, &beginInfo);
+	if (!eng_Ensure(result == VK_SUCCESS, "Failed to begin upload command buffer.\n"))
+	{
+		return;
+	}
+
+	uint32_t consumed = 0;
+	uint32_t bytesThisUpdate = 0;
+	for (; consumed < uploader->Pending.Count; ++consumed)
+	{
+		eng_VulkanPendingUpload* pending = eng_ArrayPIndexType(&uploader->Pending, eng_VulkanPendingUpload, consumed);
+		uint32_t size = pending->Image.DataSize;
+		if (consumed > 0 && uploader->BytesPerUpdate != 0 && bytesThisUpdate + size > uploader->BytesPerUpdate)
+		{
+			break;
+		}
+
+		VkBuffer staging;
+		VkDeviceSize stagingOffset;
+		if (size > uploader->StagingSize)
+		{
+			// Too big to ever fit in the ring; give it a buffer of its own.
+			eng_VulkanStagingBuffer dedicated;
+			void* mapped;
+			if (!eng_InternalVkCreateBuffer(uploader->Vulkan, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+				&dedicated.Buffer, &dedicated.Memory))
+			{
+				break;
+			}
+			vkMapMemory(device, dedicated.Memory, 0, size, 0, &mapped);
+			memcpy(mapped, pending->Image.Data, size);
+			vkUnmapMemory(device, dedicated.Memory);
+			eng_ArrayPushBack(&batch->DedicatedStaging, &dedicated);
+			staging = dedicated.Buffer;
+			stagingOffset = 0;
+		}
+		else
+		{
+			uint32_t offset;
+			if (!eng_VulkanUploaderStagingAlloc(uploader, size, &offset))
+			{
+				// Ring is full of in-flight data; try again next update.
+				break;
+			}
+			memcpy(uploader->StagingMapped + offset, pending->Image.Data, size);
+			staging = uploader->StagingBuffer;
+			stagingOffset = offset;
+		}
+
+		eng_VulkanUploaderRecordCopy(batch->Cmd, staging, stagingOffset, pending->Texture, &pending->Image);
+		eng_ArrayPushBack(&batch->Textures, &pending->Texture);
+		eng_ImageDestroy(&pending->Image);
+		bytesThisUpdate += size;
+	}
+
+	vkEndCommandBuffer(batch->Cmd);
+
+	if (consumed == 0)
+	{
+		return;
+	}
+
+	// Drop the uploads we just recorded from the front of the queue.
+	uint32_t remaining = uploader->Pending.Count - consumed;
+	memmove(uploader->Pending.Buffer, eng_ArrayIndex(&uploader->Pending, consumed), remaining * sizeof(eng_VulkanPendingUpload));
+	uploader->Pending.Count = remaining;
+
+	batch->RingEnd = uploader->StagingHead;
+
+	const VkSubmitInfo submitInfo = {
+		.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+		.commandBufferCount = 1,
+		.pCommandBuffers = &batch->Cmd,
+	};
+	result = vkQueueSubmit(uploader->Vulkan->Queue, 1, &submitInfo, batch->Fence);
+	if (eng_Ensure(result == VK_SUCCESS, "Failed to submit texture uploads. Error(%d): \"%s\"\n", (int)result, eng_InternalVkResultToString(result)))
+	{
+		++uploader->BatchesInFlight;
+	}
+}
+
+void eng_VulkanUploaderSetBudget(eng_VulkanUploader* uploader, uint32_t bytesPerUpdate)
+{
+	uploader->BytesPerUpdate = bytesPerUpdate;
+}
+
+bool eng_VulkanUploaderIsIdle(eng_VulkanUploader* uploader)
+{
+	return uploader->Pending.Count == 0 && uploader->BatchesInFlight == 0;
+}
+
+////////////////////////////////////////////////////////////////////////// Internal
+
+VkFormat eng_VulkanTextureFormatFromImage(eng_ImageFormat format)
+{
+	switch (format)
+	{
+	case ENG_IMAGE_FORMAT_RGBA8: return VK_FORMAT_R8G8B8A8_UNORM;
+	case ENG_IMAGE_FORMAT_RGBA8_SRGB: return VK_FORMAT_R8G8B8A8_SRGB;
+	case ENG_IMAGE_FORMAT_BGRA8: return VK_FORMAT_B8G8R8A8_UNORM;
+	case ENG_IMAGE_FORMAT_BGRA8_SRGB: return VK_FORMAT_B8G8R8A8_SRGB;
+	case ENG_IMAGE_FORMAT_BC1: return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+	case ENG_IMAGE_FORMAT_BC1_SRGB: return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+	case ENG_IMAGE_FORMAT_BC2: return VK_FORMAT_BC2_UNORM_BLOCK;
+	case ENG_IMAGE_FORMAT_BC2_SRGB: return VK_FORMAT_BC2_SRGB_BLOCK;
+	case ENG_IMAGE_FORMAT_BC3: return VK_FORMAT_BC3_UNORM_BLOCK;
+	case ENG_IMAGE_FORMAT_BC3_SRGB: return VK_FORMAT_BC3_SRGB_BLOCK;
+	case ENG_IMAGE_FORMAT_BC4: return VK_FORMAT_BC4_UNORM_BLOCK;
+	case ENG_IMAGE_FORMAT_BC5: return VK_FORMAT_BC5_UNORM_BLOCK;
+	case ENG_IMAGE_FORMAT_BC6H: return VK_FORMAT_BC6H_UFLOAT_BLOCK;
+	case ENG_IMAGE_FORMAT_BC7: return VK_FORMAT_BC7_UNORM_BLOCK;
+	case ENG_IMAGE_FORMAT_BC7_SRGB: return VK_FORMAT_BC7_SRGB_BLOCK;
+	default: return VK_FORMAT_UNDEFINED;
+	}
+}
+
+bool eng_VulkanUploaderStagingAlloc(eng_VulkanUploader* uploader, uint32_t size, uint32_t* outOffset)
+{
+	if (uploader->StagingUsed == 0)
+	{
+		uploader->StagingHead = 0;
+		uploader->StagingTail = 0;
+	}
+
+	uint32_t start = (uploader->StagingHead + STAGING_ALIGNMENT - 1) & ~(uint32_t)(STAGING_ALIGNMENT - 1);
+	bool full = uploader->StagingUsed > 0 && uploader->StagingHead == uploader->StagingTail;
+	if (full)
+	{
+		return false;
+	}
+
+	if (uploader->StagingHead >= uploader->StagingTail)
+	{
+		// Free space is [Head, Size) followed by [0, Tail).
+		if (start + size <= uploader->StagingSize)
+		{
+			*outOffset = start;
+		}
+		else if (size <= uploader->StagingTail)
+		{
+			// Wrap, wasting the end of the ring.
+			start = 0;
+			*outOffset = 0;
+			uploader->StagingUsed += uploader->StagingSize - uploader->StagingHead;
+			uploader->Batches[(uploader->OldestBatch + uploader->BatchesInFlight) % UPLOAD_BATCH_COUNT].RingBytes += uploader->StagingSize - uploader->StagingHead;
+			uploader->StagingHead = 0;
+		}
+		else
+		{
+			return false;
+		}
+	}
+	else if (start + size <= uploader->StagingTail)
+	{
+		// Free space is [Head, Tail).
+		*outOffset = start;
+	}
+	else
+	{
+		return false;
+	}
+
+	uint32_t consumed = start + size - uploader->StagingHead;
+	uploader->StagingUsed += consumed;
+	uploader->Batches[(uploader->OldestBatch + uploader->BatchesInFlight) % UPLOAD_BATCH_COUNT].RingBytes += consumed;
+	uploader->StagingHead = start + size;
+	return true;
+}
+
+void eng_VulkanUploaderRetire(eng_VulkanUploader* uploader, eng_VulkanUploadBatch* batch)
+{
+	VkDevice device = uploader->Vulkan->Device;
+
+	eng_VulkanTexture** texture = eng_ArrayBeginType(&batch->Textures, eng_VulkanTexture*);
+	eng_VulkanTexture** textureEnd = eng_ArrayEndType(&batch->Textures, eng_VulkanTexture*);
+	for (; texture < textureEnd; ++texture)
+	{
+		(*texture)->Ready = true;
+	}
+	batch->Textures.Count = 0;
+
+	eng_VulkanStagingBuffer* staging = eng_ArrayBeginType(&batch->DedicatedStaging, eng_VulkanStagingBuffer);
+	eng_VulkanStagingBuffer* stagingEnd = eng_ArrayEndType(&batch->DedicatedStaging, eng_VulkanStagingBuffer);
+	for (; staging < stagingEnd; ++staging)
+	{
+		vkDestroyBuffer(device, staging->Buffer, NULL);
+		vkFreeMemory(device, staging->Memory, NULL);
+	}
+	batch->DedicatedStaging.Count = 0;
+
+	uploader->StagingUsed -= batch->RingBytes;
+	uploader->StagingTail = batch->RingEnd;
+	batch->RingBytes = 0;
+
+	vkResetFences(device, 1, &batch->Fence);
+}
+
+void eng_VulkanUploaderRecordCopy(VkCommandBuffer cmd, VkBuffer staging, VkDeviceSize stagingOffset, eng_VulkanTexture* texture, const eng_Image* image)
+{
+	const VkImageSubresourceRange range = { VK_IMAGE_ASPECT_COLOR_BIT, 0, image->LevelCount, 0, 1 };
+
+	VkImageMemoryBarrier toTransfer = {
+		.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+		.srcAccessMask = 0,
+		.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+		.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+		.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+		.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+		.image = texture->Image,
+		.subresourceRange = range,
+	};
+	vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+		0, 0, NULL, 0, NULL, 1, &toTransfer);
+
+	VkBufferImageCopy regions[ENG_IMAGE_MAX_LEVELS];
+	for (uint32_t i = 0; i < image->LevelCount; ++i)
+	{
+		const eng_ImageLevel* level = &image->Levels[i];
+		regions[i] = (VkBufferImageCopy) {
+			.bufferOffset = stagingOffset + level->Offset,
+			.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, i, 0, 1 },
+			.imageExtent = { level->Width, level->Height, 1 },
+		};
+	}
+	vkCmdCopyBufferToImage(cmd, staging, texture->Image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, image->LevelCount, regions);
+
+	VkImageMemoryBarrier toShader = {
+		.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+		.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+		.dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
+		.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+		.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+		.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+		.image = texture->Image,
+		.subresourceRange = range,
+	};
+	vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+		0, 0, NULL, 0, NULL, 1, &toShader);
+}
\ No newline at end of file
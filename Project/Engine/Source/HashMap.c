@@ -0,0 +1,349 @@
+#include <Engine/HashMap.h>
+
+#include <Engine/Bits.h>
+#include <Engine/Log.h>
+
+#include <string.h>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define ENG_HASHMAP_SSE2 1
+#endif
+
+#define GROUP_WIDTH 16
+#define MIN_CAPACITY 16
+// High bit set, so a group's free slots are found with one movemask.
+#define CONTROL_EMPTY 0x80
+#define CONTROL_TOMBSTONE 0xFE
+
+uint64_t eng_HashMapStringHash(const void* key, uint32_t keySize);
+bool eng_HashMapStringEqual(const void* a, const void* b, uint32_t keySize);
+
+const eng_HashMapKeyOps eng_HashMapStringKeys = {
+	.Hash = eng_HashMapStringHash,
+	.Equal = eng_HashMapStringEqual,
+};
+
+uint64_t eng_HashMapHashKey(eng_HashMap* map, const void* key);
+bool eng_HashMapKeysEqual(eng_HashMap* map, const void* a, const void* b);
+// @returns a bit per slot in the group starting at slot whose control byte is h2.
+uint32_t eng_HashMapMatch(const uint8_t* group, uint8_t h2);
+// @returns a bit per slot in the group starting at slot that's empty.
+uint32_t eng_HashMapMatchEmpty(const uint8_t* group);
+// @returns a bit per slot in the group starting at slot that's empty or a tombstone.
+uint32_t eng_HashMapMatchFree(const uint8_t* group);
+void eng_HashMapSetControl(eng_HashMap* map, uint32_t slot, uint8_t control);
+// @returns the slot holding key, or UINT32_MAX.
+uint32_t eng_HashMapFindSlot(eng_HashMap* map, const void* key, uint64_t hash);
+// Allocates an empty table of capacity slots and moves every entry into it.
+void eng_HashMapRehash(eng_HashMap* map, uint32_t capacity);
+size_t eng_HashMapGetAllocationSize(eng_HashMap* map, uint32_t capacity);
+
+void eng_HashMapInit(eng_HashMap* map, uint32_t keySize, uint32_t valueSize, const eng_HashMapKeyOps* keyOps, const eng_Allocator* allocator)
+{
+	memset(map, 0, sizeof(eng_HashMap));
+	map->KeySize = keySize;
+	map->ValueSize = valueSize;
+	map->KeyOps = keyOps;
+	map->Allocator = allocator;
+	eng_HashMapRehash(map, MIN_CAPACITY);
+}
+
+void eng_HashMapDestroy(eng_HashMap* map)
+{
+	eng_AllocatorFree(map->Allocator, map->Control, eng_HashMapGetAllocationSize(map, map->Capacity));
+}
+
+void eng_HashMapReserve(eng_HashMap* map, uint32_t count)
+{
+	// Tables are kept at most 7/8 full.
+	uint32_t capacity = MIN_CAPACITY;
+	while (capacity - capacity / 8 < count)
+	{
+		capacity *= 2;
+	}
+	if (capacity > map->Capacity)
+	{
+		eng_HashMapRehash(map, capacity);
+	}
+}
+
+void eng_HashMapClear(eng_HashMap* map)
+{
+	memset(map->Control, CONTROL_EMPTY, map->Capacity + GROUP_WIDTH);
+	map->Count = 0;
+	map->Tombstones = 0;
+}
+
+void* eng_HashMapFind(eng_HashMap* map, const void* key)
+{
+	uint32_t slot = eng_HashMapFindSlot(map, key, eng_HashMapHashKey(map, key));
+	return slot != UINT32_MAX ? eng_HashMapValueAt(map, slot) : NULL;
+}
+
+void* eng_HashMapInsert(eng_HashMap* map, const void* key, const void* value)
+{
+	uint64_t hash = eng_HashMapHashKey(map, key);
+	uint32_t slot = eng_HashMapFindSlot(map, key, hash);
+	if (slot == UINT32_MAX)
+	{
+		if (map->Count + map->Tombstones + 1 > map->Capacity - map->Capacity / 8)
+		{
+			// Mostly tombstones means cleaning up in place will do.
+			eng_HashMapRehash(map, map->Count + 1 > map->Capacity / 2 ? map->Capacity * 2 : map->Capacity);
+		}
+
+		uint32_t mask = map->Capacity - 1;
+		uint32_t position = (uint32_t)(hash >> 7) & mask;
+		for (uint32_t stride = GROUP_WIDTH;; stride += GROUP_WIDTH)
+		{
+			uint32_t free = eng_HashMapMatchFree(map->Control + position);
+			if (free != 0)
+			{
+				slot = (position + eng_BitScanForward32(free)) & mask;
+				break;
+			}
+			position = (position + stride) & mask;
+		}
+
+		map->Tombstones -= map->Control[slot] == CONTROL_TOMBSTONE ? 1 : 0;
+		eng_HashMapSetControl(map, slot, (uint8_t)(hash & 0x7F));
+		memcpy(eng_HashMapKeyAt(map, slot), key, map->KeySize);
+		++map->Count;
+	}
+
+	void* stored = eng_HashMapValueAt(map, slot);
+	if (value != NULL)
+	{
+		memcpy(stored, value, map->ValueSize);
+	}
+	return stored;
+}
+
+bool eng_HashMapRemove(eng_HashMap* map, const void* key)
+{
+	uint32_t slot = eng_HashMapFindSlot(map, key, eng_HashMapHashKey(map, key));
+	if (slot == UINT32_MAX)
+	{
+		return false;
+	}
+
+	// If no group overlapping this slot was ever full, no probe went past it
+	// and it can go straight back to empty.
+	uint32_t mask = map->Capacity - 1;
+	uint32_t emptyAfter = eng_HashMapMatchEmpty(map->Control + slot);
+	uint32_t emptyBefore = eng_HashMapMatchEmpty(map->Control + ((slot - GROUP_WIDTH) & mask));
+	bool wasNeverFull = emptyAfter != 0 && emptyBefore != 0 &&
+		eng_BitScanForward32(emptyAfter) + (GROUP_WIDTH - 1 - eng_BitScanReverse32(emptyBefore)) < GROUP_WIDTH;
+	eng_HashMapSetControl(map, slot, wasNeverFull ? CONTROL_EMPTY : CONTROL_TOMBSTONE);
+	map->Tombstones += wasNeverFull ? 0 : 1;
+	--map->Count;
+	return true;
+}
+
+uint32_t eng_HashMapCount(eng_HashMap* map)
+{
+	return map->Count;
+}
+
+uint32_t eng_HashMapBegin(eng_HashMap* map)
+{
+	return eng_HashMapNext(map, UINT32_MAX);
+}
+
+uint32_t eng_HashMapNext(eng_HashMap* map, uint32_t slot)
+{
+	// UINT32_MAX + 1 wraps to the first slot.
+	for (++slot; slot < map->Capacity; ++slot)
+	{
+		if ((map->Control[slot] & CONTROL_EMPTY) == 0)
+		{
+			break;
+		}
+	}
+	return slot;
+}
+
+void* eng_HashMapKeyAt(eng_HashMap* map, uint32_t slot)
+{
+	return (char*)map->Keys + (size_t)slot * map->KeySize;
+}
+
+void* eng_HashMapValueAt(eng_HashMap* map, uint32_t slot)
+{
+	return (char*)map->Values + (size_t)slot * map->ValueSize;
+}
+
+uint64_t eng_HashBytes(const void* data, size_t size)
+{
+	// 8 bytes at a time through a multiply-xorshift, then murmur's finalizer.
+	const uint8_t* bytes = data;
+	uint64_t hash = 0x9E3779B97F4A7C15ull ^ (size * 0xC2B2AE3D27D4EB4Full);
+	for (; size >= 8; size -= 8, bytes += 8)
+	{
+		uint64_t word;
+		memcpy(&word, bytes, sizeof(word));
+		hash = (hash ^ word) * 0x9FB21C651E98DF25ull;
+		hash ^= hash >> 29;
+	}
+	if (size > 0)
+	{
+		uint64_t word = 0;
+		memcpy(&word, bytes, size);
+		hash = (hash ^ word) * 0x9FB21C651E98DF25ull;
+	}
+	hash ^= hash >> 33;
+	hash *= 0xFF51AFD7ED558CCDull;
+	hash ^= hash >> 33;
+	hash *= 0xC4CEB9FE1A85EC53ull;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+uint64_t eng_HashString(const char* string)
+{
+	return eng_HashBytes(string, strlen(string));
+}
+
+////////////////////////////////////////////////////////////////////////// Internal
+uint64_t eng_HashMapStringHash(const void* key, uint32_t keySize)
+{
+	(void)keySize;
+	return eng_HashString(*(const char* const*)key);
+}
+
+bool eng_HashMapStringEqual(const void* a, const void* b, uint32_t keySize)
+{
+	(void)keySize;
+	return strcmp(*(const char* const*)a, *(const char* const*)b) == 0;
+}
+
+uint64_t eng_HashMapHashKey(eng_HashMap* map, const void* key)
+{
+	return map->KeyOps != NULL ? map->KeyOps->Hash(key, map->KeySize) : eng_HashBytes(key, map->KeySize);
+}
+
+bool eng_HashMapKeysEqual(eng_HashMap* map, const void* a, const void* b)
+{
+	return map->KeyOps != NULL ? map->KeyOps->Equal(a, b, map->KeySize) : memcmp(a, b, map->KeySize) == 0;
+}
+
+#if defined(ENG_HASHMAP_SSE2)
+
+uint32_t eng_HashMapMatch(const uint8_t* group, uint8_t h2)
+{
+	__m128i control = _mm_loadu_si128((const __m128i*)group);
+	return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8((char)h2)));
+}
+
+uint32_t eng_HashMapMatchEmpty(const uint8_t* group)
+{
+	return eng_HashMapMatch(group, CONTROL_EMPTY);
+}
+
+uint32_t eng_HashMapMatchFree(const uint8_t* group)
+{
+	return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+}
+
+#else
+
+uint32_t eng_HashMapMatch(const uint8_t* group, uint8_t h2)
+{
+	uint32_t mask = 0;
+	for (uint32_t i = 0; i < GROUP_WIDTH; ++i)
+	{
+		mask |= (uint32_t)(group[i] == h2) << i;
+	}
+	return mask;
+}
+
+uint32_t eng_HashMapMatchEmpty(const uint8_t* group)
+{
+	return eng_HashMapMatch(group, CONTROL_EMPTY);
+}
+
+uint32_t eng_HashMapMatchFree(const uint8_t* group)
+{
+	uint32_t mask = 0;
+	for (uint32_t i = 0; i < GROUP_WIDTH; ++i)
+	{
+		mask |= (uint32_t)(group[i] >> 7) << i;
+	}
+	return mask;
+}
+
+#endif
+
+void eng_HashMapSetControl(eng_HashMap* map, uint32_t slot, uint8_t control)
+{
+	map->Control[slot] = control;
+	if (slot < GROUP_WIDTH)
+	{
+		map->Control[map->Capacity + slot] = control;
+	}
+}
+
+uint32_t eng_HashMapFindSlot(eng_HashMap* map, const void* key, uint64_t hash)
+{
+	uint32_t mask = map->Capacity - 1;
+	uint32_t position = (uint32_t)(hash >> 7) & mask;
+	uint8_t h2 = (uint8_t)(hash & 0x7F);
+	// Probing by growing strides visits every group once the table is a power of two.
+	for (uint32_t stride = GROUP_WIDTH; stride <= map->Capacity; stride += GROUP_WIDTH)
+	{
+		const uint8_t* group = map->Control + position;
+		for (uint32_t match = eng_HashMapMatch(group, h2); match != 0; match &= match - 1)
+		{
+			uint32_t slot = (position + eng_BitScanForward32(match)) & mask;
+			if (eng_HashMapKeysEqual(map, eng_HashMapKeyAt(map, slot), key))
+			{
+				return slot;
+			}
+		}
+		if (eng_HashMapMatchEmpty(group) != 0)
+		{
+			break;
+		}
+		position = (position + stride) & mask;
+	}
+	return UINT32_MAX;
+}
+
+void eng_HashMapRehash(eng_HashMap* map, uint32_t capacity)
+{
+	uint8_t* oldControl = map->Control;
+	void* oldKeys = map->Keys;
+	void* oldValues = map->Values;
+	uint32_t oldCapacity = map->Capacity;
+	size_t oldSize = eng_HashMapGetAllocationSize(map, oldCapacity);
+
+	// Control bytes, keys and values in one allocation.
+	size_t keysOffset = (capacity + GROUP_WIDTH + ENG_ALLOCATOR_DEFAULT_ALIGNMENT - 1) & ~(size_t)(ENG_ALLOCATOR_DEFAULT_ALIGNMENT - 1);
+	size_t valuesOffset = (keysOffset + (size_t)capacity * map->KeySize + ENG_ALLOCATOR_DEFAULT_ALIGNMENT - 1) & ~(size_t)(ENG_ALLOCATOR_DEFAULT_ALIGNMENT - 1);
+	map->Capacity = capacity;
+	map->Control = eng_AllocatorAlloc(map->Allocator, eng_HashMapGetAllocationSize(map, capacity), ENG_ALLOCATOR_DEFAULT_ALIGNMENT);
+	map->Keys = map->Control + keysOffset;
+	map->Values = map->Control + valuesOffset;
+	eng_HashMapClear(map);
+
+	if (oldControl == NULL)
+	{
+		return;
+	}
+	for (uint32_t i = 0; i < oldCapacity; ++i)
+	{
+		if ((oldControl[i] & CONTROL_EMPTY) == 0)
+		{
+			eng_HashMapInsert(map, (char*)oldKeys + (size_t)i * map->KeySize, (char*)oldValues + (size_t)i * map->ValueSize);
+		}
+	}
+	eng_AllocatorFree(map->Allocator, oldControl, oldSize);
+}
+
+size_t eng_HashMapGetAllocationSize(eng_HashMap* map, uint32_t capacity)
+{
+	size_t keysOffset = (capacity + GROUP_WIDTH + ENG_ALLOCATOR_DEFAULT_ALIGNMENT - 1) & ~(size_t)(ENG_ALLOCATOR_DEFAULT_ALIGNMENT - 1);
+	size_t valuesOffset = (keysOffset + (size_t)capacity * map->KeySize + ENG_ALLOCATOR_DEFAULT_ALIGNMENT - 1) & ~(size_t)(ENG_ALLOCATOR_DEFAULT_ALIGNMENT - 1);
+	return valuesOffset + (size_t)capacity * map->ValueSize;
+}
\ No newline at end of file
@@ -0,0 +1,1050 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <Engine/Image.h>
+
+#include <Engine/Allocator.h>
+#include <Engine/Log.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define READ_U16_LE(p) ((uint32_t)(p)[0] | ((uint32_t)(p)[1] << 8))
+#define READ_U32_LE(p) ((uint32_t)(p)[0] | ((uint32_t)(p)[1] << 8) | ((uint32_t)(p)[2] << 16) | ((uint32_t)(p)[3] << 24))
+#define READ_U32_BE(p) (((uint32_t)(p)[0] << 24) | ((uint32_t)(p)[1] << 16) | ((uint32_t)(p)[2] << 8) | (uint32_t)(p)[3])
+#define FOURCC(a, b, c, d) ((uint32_t)(a) | ((uint32_t)(b) << 8) | ((uint32_t)(c) << 16) | ((uint32_t)(d) << 24))
+
+bool eng_ImageDecodeTGA(eng_Image* image, const uint8_t* data, size_t size);
+bool eng_ImageDecodePNG(eng_Image* image, const uint8_t* data, size_t size);
+bool eng_ImageDecodeDDS(eng_Image* image, const uint8_t* data, size_t size);
+bool eng_ImageDecodeKTX(eng_Image* image, const uint8_t* data, size_t size);
+bool eng_ImageAllocateRGBA8(eng_Image* image, uint32_t width, uint32_t height);
+bool eng_ImageCopyLevels(eng_Image* image, eng_ImageFormat format, uint32_t width, uint32_t height, uint32_t levelCount, const uint8_t* data, size_t size);
+
+static const uint8_t s_PNGSignature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+static const uint8_t s_KTXIdentifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+bool eng_ImageInitFromMemory(eng_Image* image, const void* data, size_t size, const eng_Allocator* allocator)
+{
+	memset(image, 0, sizeof(eng_Image));
+	image->Allocator = allocator;
+
+	const uint8_t* bytes = (const uint8_t*)data;
+	bool decoded;
+	if (size >= sizeof(s_PNGSignature) && memcmp(bytes, s_PNGSignature, sizeof(s_PNGSignature)) == 0)
+	{
+		decoded = eng_ImageDecodePNG(image, bytes, size);
+	}
+	else if (size >= 4 && READ_U32_LE(bytes) == FOURCC('D', 'D', 'S', ' '))
+	{
+		decoded = eng_ImageDecodeDDS(image, bytes, size);
+	}
+	else if (size >= sizeof(s_KTXIdentifier) && memcmp(bytes, s_KTXIdentifier, sizeof(s_KTXIdentifier)) == 0)
+	{
+		decoded = eng_ImageDecodeKTX(image, bytes, size);
+	}
+	else
+	{
+		// TGA has no magic number, so it's the fallback.
+		decoded = eng_ImageDecodeTGA(image, bytes, size);
+	}
+
+	if (!decoded)
+	{
+		eng_ImageDestroy(image);
+	}
+	return decoded;
+}
+
+bool eng_ImageInitFromFile(eng_Image* image, const char* path, const eng_Allocator* allocator)
+{
+	memset(image, 0, sizeof(eng_Image));
+	image->Allocator = allocator;
+
+	FILE* file = fopen(path, "rb");
+	if (file == NULL)
+	{
+		eng_Err("Failed to open image \"%s\".\n", path);
+		return false;
+	}
+	fseek(file, 0, SEEK_END);
+	long fileSize = ftell(file);
+	rewind(file);
+
+	bool decoded = false;
+	uint8_t* contents = fileSize > 0 ? eng_AllocatorAllocType(allocator, uint8_t, (size_t)fileSize) : NULL;
+	if (contents != NULL && fread(contents, 1, (size_t)fileSize, file) == (size_t)fileSize)
+	{
+		decoded = eng_ImageInitFromMemory(image, contents, (size_t)fileSize, allocator);
+		if (!decoded)
+		{
+			eng_Err("Failed to decode image \"%s\".\n", path);
+		}
+	}
+	eng_AllocatorFreeType(allocator, contents, uint8_t, (size_t)fileSize);
+	fclose(file);
+	return decoded;
+}
+
+void eng_ImageDestroy(eng_Image* image)
+{
+	eng_AllocatorFree(image->Allocator, image->Data, image->DataSize);
+	image->Data = NULL;
+	image->DataSize = 0;
+}
+
+////////////////////////////////////////////////////////////////////////// Format API
+bool eng_ImageFormatIsBlockCompressed(eng_ImageFormat format)
+{
+	return format >= ENG_IMAGE_FORMAT_BC1 && format < ENG_IMAGE_FORMAT_COUNT;
+}
+
+uint32_t eng_ImageFormatGetLevelSize(eng_ImageFormat format, uint32_t width, uint32_t height)
+{
+	switch (format)
+	{
+	case ENG_IMAGE_FORMAT_RGBA8:
+	case ENG_IMAGE_FORMAT_RGBA8_SRGB:
+	case ENG_IMAGE_FORMAT_BGRA8:
+	case ENG_IMAGE_FORMAT_BGRA8_SRGB:
+		return width * height * 4;
+	case ENG_IMAGE_FORMAT_BC1:
+	case ENG_IMAGE_FORMAT_BC1_SRGB:
+	case ENG_IMAGE_FORMAT_BC4:
+		return ((width + 3) / 4) * ((height + 3) / 4) * 8;
+	case ENG_IMAGE_FORMAT_BC2:
+	case ENG_IMAGE_FORMAT_BC2_SRGB:
+	case ENG_IMAGE_FORMAT_BC3:
+	case ENG_IMAGE_FORMAT_BC3_SRGB:
+	case ENG_IMAGE_FORMAT_BC5:
+	case ENG_IMAGE_FORMAT_BC6H:
+	case ENG_IMAGE_FORMAT_BC7:
+	case ENG_IMAGE_FORMAT_BC7_SRGB:
+		return ((width + 3) / 4) * ((height + 3) / 4) * 16;
+	default:
+		return 0;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////// Internal
+bool eng_ImageAllocateRGBA8(eng_Image* image, uint32_t width, uint32_t height)
+{
+	if (width == 0 || height == 0 || width > 16384 || height > 16384)
+	{
+		eng_Err("Image dimensions %ux%u are not supported.\n", width, height);
+		return false;
+	}
+	image->Width = width;
+	image->Height = height;
+	image->Format = ENG_IMAGE_FORMAT_RGBA8;
+	image->LevelCount = 1;
+	image->DataSize = width * height * 4;
+	image->Data = eng_AllocatorAlloc(image->Allocator, image->DataSize, ENG_ALLOCATOR_DEFAULT_ALIGNMENT);
+	image->Levels[0].Width = width;
+	image->Levels[0].Height = height;
+	image->Levels[0].Offset = 0;
+	image->Levels[0].Size = image->DataSize;
+	return image->Data != NULL;
+}
+
+bool eng_ImageCopyLevels(eng_Image* image, eng_ImageFormat format, uint32_t width, uint32_t height, uint32_t levelCount, const uint8_t* data, size_t size)
+{
+	if (width == 0 || height == 0 || width > 16384 || height > 16384)
+	{
+		eng_Err("Image dimensions %ux%u are not supported.\n", width, height);
+		return false;
+	}
+	if (levelCount == 0)
+	{
+		levelCount = 1;
+	}
+	if (levelCount > ENG_IMAGE_MAX_LEVELS)
+	{
+		levelCount = ENG_IMAGE_MAX_LEVELS;
+	}
+
+	image->Width = width;
+	image->Height = height;
+	image->Format = format;
+	image->LevelCount = levelCount;
+
+	uint32_t offset = 0;
+	for (uint32_t i = 0; i < levelCount; ++i)
+	{
+		eng_ImageLevel* level = &image->Levels[i];
+		level->Width = width >> i ? width >> i : 1;
+		level->Height = height >> i ? height >> i : 1;
+		level->Offset = offset;
+		level->Size = eng_ImageFormatGetLevelSize(format, level->Width, level->Height);
+		offset += level->Size;
+	}
+
+	if (offset > size)
+	{
+		eng_Err("Image data is truncated (%u bytes expected, %u available).\n", offset, (uint32_t)size);
+		return false;
+	}
+
+	image->DataSize = offset;
+	image->Data = eng_AllocatorAlloc(image->Allocator, offset, ENG_ALLOCATOR_DEFAULT_ALIGNMENT);
+	if (image->Data == NULL)
+	{
+		return false;
+	}
+	memcpy(image->Data, data, offset);
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////// TGA
+bool eng_ImageDecodeTGA(eng_Image* image, const uint8_t* data, size_t size)
+{
+	if (size < 18)
+	{
+		return false;
+	}
+
+	uint32_t idLength = data[0];
+	uint32_t colorMapType = data[1];
+	uint32_t imageType = data[2];
+	uint32_t colorMapLength = READ_U16_LE(data + 5);
+	uint32_t colorMapEntrySize = data[7];
+	uint32_t width = READ_U16_LE(data + 12);
+	uint32_t height = READ_U16_LE(data + 14);
+	uint32_t pixelDepth = data[16];
+	uint32_t descriptor = data[17];
+
+	bool rle = imageType == 10 || imageType == 11;
+	bool gray = imageType == 3 || imageType == 11;
+	if ((imageType != 2 && imageType != 3 && imageType != 10 && imageType != 11) || colorMapType > 1)
+	{
+		eng_Err("Unsupported TGA image type %u.\n", imageType);
+		return false;
+	}
+	if ((gray && pixelDepth != 8) || (!gray && pixelDepth != 16 && pixelDepth != 24 && pixelDepth != 32))
+	{
+		eng_Err("Unsupported TGA pixel depth %u.\n", pixelDepth);
+		return false;
+	}
+
+	size_t offset = 18 + idLength + (colorMapType ? colorMapLength * ((colorMapEntrySize + 7) / 8) : 0);
+	if (offset > size || !eng_ImageAllocateRGBA8(image, width, height))
+	{
+		return false;
+	}
+
+	uint32_t bytesPerPixel = pixelDepth / 8;
+	uint32_t pixelCount = width * height;
+	uint8_t* out = (uint8_t*)image->Data;
+	bool topDown = (descriptor & 0x20) != 0;
+
+	uint32_t packetRemaining = 0;
+	bool packetRepeats = false;
+	const uint8_t* src = NULL;
+	for (uint32_t i = 0; i < pixelCount; ++i)
+	{
+		if (rle && packetRemaining == 0)
+		{
+			if (offset >= size)
+			{
+				return false;
+			}
+			uint8_t header = data[offset++];
+			packetRemaining = (header & 0x7F) + 1;
+			packetRepeats = (header & 0x80) != 0;
+			src = NULL;
+		}
+
+		if (!rle || !packetRepeats || src == NULL)
+		{
+			if (offset + bytesPerPixel > size)
+			{
+				return false;
+			}
+			src = data + offset;
+			offset += bytesPerPixel;
+		}
+		if (rle)
+		{
+			--packetRemaining;
+		}
+
+		uint32_t x = i % width;
+		uint32_t y = i / width;
+		uint8_t* dst = out + ((topDown ? y : height - 1 - y) * width + x) * 4;
+		switch (pixelDepth)
+		{
+		case 8:
+			dst[0] = dst[1] = dst[2] = src[0];
+			dst[3] = 255;
+			break;
+		case 16:
+		{
+			uint32_t packed = READ_U16_LE(src);
+			dst[0] = (uint8_t)(((packed >> 10) & 0x1F) * 255 / 31);
+			dst[1] = (uint8_t)(((packed >> 5) & 0x1F) * 255 / 31);
+			dst[2] = (uint8_t)((packed & 0x1F) * 255 / 31);
+			dst[3] = (packed & 0x8000) ? 255 : 0;
+			break;
+		}
+		case 24:
+			dst[0] = src[2];
+			dst[1] = src[1];
+			dst[2] = src[0];
+			dst[3] = 255;
+			break;
+		case 32:
+			dst[0] = src[2];
+			dst[1] = src[1];
+			dst[2] = src[0];
+			dst[3] = src[3];
+			break;
+		}
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////// Inflate (RFC 1951)
+// A small canonical-huffman inflater, enough to read PNG IDAT streams.
+
+typedef struct eng_InflateHuffman
+{
+	uint16_t Counts[16];
+	uint16_t Symbols[288];
+} eng_InflateHuffman;
+
+typedef struct eng_Inflate
+{
+	const uint8_t* Src;
+	const uint8_t* SrcEnd;
+	uint32_t BitBuffer;
+	uint32_t BitCount;
+	uint8_t* Dst;
+	size_t DstSize;
+	size_t DstPos;
+	bool Error;
+} eng_Inflate;
+
+static const uint16_t s_LengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const uint16_t s_LengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const uint16_t s_DistanceBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+static const uint16_t s_DistanceExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+static const uint8_t s_CodeLengthOrder[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+uint32_t eng_InflateBits(eng_Inflate* s, uint32_t count)
+{
+	while (s->BitCount < count)
+	{
+		if (s->Src >= s->SrcEnd)
+		{
+			s->Error = true;
+			return 0;
+		}
+		s->BitBuffer |= (uint32_t)(*s->Src++) << s->BitCount;
+		s->BitCount += 8;
+	}
+	uint32_t value = s->BitBuffer & ((1u << count) - 1);
+	s->BitBuffer >>= count;
+	s->BitCount -= count;
+	return value;
+}
+
+bool eng_InflateBuildHuffman(eng_InflateHuffman* h, const uint8_t* lengths, uint32_t count)
+{
+	uint16_t offsets[16];
+	memset(h->Counts, 0, sizeof(h->Counts));
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		++h->Counts[lengths[i]];
+	}
+	h->Counts[0] = 0;
+
+	offsets[1] = 0;
+	for (uint32_t len = 1; len < 15; ++len)
+	{
+		offsets[len + 1] = offsets[len] + h->Counts[len];
+	}
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		if (lengths[i] != 0)
+		{
+			h->Symbols[offsets[lengths[i]]++] = (uint16_t)i;
+		}
+	}
+	return true;
+}
+
+int32_t eng_InflateDecodeSymbol(eng_Inflate* s, const eng_InflateHuffman* h)
+{
+	int32_t code = 0;
+	int32_t first = 0;
+	int32_t index = 0;
+	for (uint32_t len = 1; len < 16; ++len)
+	{
+		code |= (int32_t)eng_InflateBits(s, 1);
+		int32_t count = h->Counts[len];
+		if (code - count < first)
+		{
+			return h->Symbols[index + (code - first)];
+		}
+		index += count;
+		first += count;
+		first <<= 1;
+		code <<= 1;
+	}
+	s->Error = true;
+	return -1;
+}
+
+bool eng_InflateCodes(eng_Inflate* s, const eng_InflateHuffman* lengths, const eng_InflateHuffman* distances)
+{
+	for (;;)
+	{
+		int32_t symbol = eng_InflateDecodeSymbol(s, lengths);
+		if (s->Error)
+		{
+			return false;
+		}
+		if (symbol < 256)
+		{
+			if (s->DstPos >= s->DstSize)
+			{
+				return false;
+			}
+			s->Dst[s->DstPos++] = (uint8_t)symbol;
+		}
+		else if (symbol == 256)
+		{
+			return true;
+		}
+		else
+		{
+			symbol -= 257;
+			if (symbol >= 29)
+			{
+				return false;
+			}
+			size_t length = s_LengthBase[symbol] + eng_InflateBits(s, s_LengthExtra[symbol]);
+
+			int32_t distanceSymbol = eng_InflateDecodeSymbol(s, distances);
+			if (s->Error || distanceSymbol < 0 || distanceSymbol >= 30)
+			{
+				return false;
+			}
+			size_t distance = s_DistanceBase[distanceSymbol] + eng_InflateBits(s, s_DistanceExtra[distanceSymbol]);
+			if (s->Error || distance > s->DstPos || s->DstPos + length > s->DstSize)
+			{
+				return false;
+			}
+
+			// Byte by byte on purpose: the source may overlap the destination.
+			uint8_t* dst = s->Dst + s->DstPos;
+			const uint8_t* src = dst - distance;
+			for (size_t i = 0; i < length; ++i)
+			{
+				dst[i] = src[i];
+			}
+			s->DstPos += length;
+		}
+	}
+}
+
+bool eng_InflateStored(eng_Inflate* s)
+{
+	// Stored blocks start on a byte boundary.
+	s->BitBuffer = 0;
+	s->BitCount = 0;
+	if (s->Src + 4 > s->SrcEnd)
+	{
+		return false;
+	}
+	uint32_t length = READ_U16_LE(s->Src);
+	uint32_t lengthComplement = READ_U16_LE(s->Src + 2);
+	s->Src += 4;
+	if (length != (~lengthComplement & 0xFFFF) || s->Src + length > s->SrcEnd || s->DstPos + length > s->DstSize)
+	{
+		return false;
+	}
+	memcpy(s->Dst + s->DstPos, s->Src, length);
+	s->Src += length;
+	s->DstPos += length;
+	return true;
+}
+
+bool eng_InflateFixed(eng_Inflate* s)
+{
+	// Built per block like the dynamic tables, so decode jobs share nothing.
+	uint8_t codeLengths[288];
+	eng_InflateHuffman lengths, distances;
+	uint32_t i = 0;
+	for (; i < 144; ++i) codeLengths[i] = 8;
+	for (; i < 256; ++i) codeLengths[i] = 9;
+	for (; i < 280; ++i) codeLengths[i] = 7;
+	for (; i < 288; ++i) codeLengths[i] = 8;
+	eng_InflateBuildHuffman(&lengths, codeLengths, 288);
+	for (i = 0; i < 30; ++i) codeLengths[i] = 5;
+	eng_InflateBuildHuffman(&distances, codeLengths, 30);
+	return eng_InflateCodes(s, &lengths, &distances);
+}
+
+bool eng_InflateDynamic(eng_Inflate* s)
+{
+	uint8_t codeLengths[288 + 32];
+	eng_InflateHuffman lengths, distances;
+
+	uint32_t literalCount = eng_InflateBits(s, 5) + 257;
+	uint32_t distanceCount = eng_InflateBits(s, 5) + 1;
+	uint32_t codeLengthCount = eng_InflateBits(s, 4) + 4;
+	if (s->Error || literalCount > 286 || distanceCount > 30)
+	{
+		return false;
+	}
+
+	memset(codeLengths, 0, sizeof(codeLengths));
+	for (uint32_t i = 0; i < codeLengthCount; ++i)
+	{
+		codeLengths[s_CodeLengthOrder[i]] = (uint8_t)eng_InflateBits(s, 3);
+	}
+	eng_InflateBuildHuffman(&lengths, codeLengths, 19);
+
+	uint32_t index = 0;
+	while (index < literalCount + distanceCount)
+	{
+		int32_t symbol = eng_InflateDecodeSymbol(s, &lengths);
+		if (s->Error || symbol < 0)
+		{
+			return false;
+		}
+		if (symbol < 16)
+		{
+			codeLengths[index++] = (uint8_t)symbol;
+			continue;
+		}
+
+		uint8_t repeated = 0;
+		uint32_t repeat;
+		if (symbol == 16)
+		{
+			if (index == 0)
+			{
+				return false;
+			}
+			repeated = codeLengths[index - 1];
+			repeat = 3 + eng_InflateBits(s, 2);
+		}
+		else if (symbol == 17)
+		{
+			repeat = 3 + eng_InflateBits(s, 3);
+		}
+		else
+		{
+			repeat = 11 + eng_InflateBits(s, 7);
+		}
+		if (index + repeat > literalCount + distanceCount)
+		{
+			return false;
+		}
+		while (repeat--)
+		{
+			codeLengths[index++] = repeated;
+		}
+	}
+
+	eng_InflateBuildHuffman(&lengths, codeLengths, literalCount);
+	eng_InflateBuildHuffman(&distances, codeLengths + literalCount, distanceCount);
+	return eng_InflateCodes(s, &lengths, &distances);
+}
+
+// Inflates a zlib wrapped stream into dst. The adler checksum is ignored.
+bool eng_InflateZlib(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize)
+{
+	if (srcSize < 2 || (src[0] & 0x0F) != 8 || ((src[0] << 8) | src[1]) % 31 != 0 || (src[1] & 0x20))
+	{
+		return false;
+	}
+
+	eng_Inflate s;
+	memset(&s, 0, sizeof(s));
+	s.Src = src + 2;
+	s.SrcEnd = src + srcSize;
+	s.Dst = dst;
+	s.DstSize = dstSize;
+
+	uint32_t final;
+	do
+	{
+		final = eng_InflateBits(&s, 1);
+		uint32_t type = eng_InflateBits(&s, 2);
+		bool ok;
+		switch (type)
+		{
+		case 0: ok = eng_InflateStored(&s); break;
+		case 1: ok = eng_InflateFixed(&s); break;
+		case 2: ok = eng_InflateDynamic(&s); break;
+		default: ok = false; break;
+		}
+		if (!ok || s.Error)
+		{
+			return false;
+		}
+	} while (!final);
+
+	return s.DstPos == dstSize;
+}
+
+////////////////////////////////////////////////////////////////////////// PNG
+static uint8_t eng_PNGPaeth(uint8_t a, uint8_t b, uint8_t c)
+{
+	int32_t p = (int32_t)a + b - c;
+	int32_t pa = abs(p - a);
+	int32_t pb = abs(p - b);
+	int32_t pc = abs(p - c);
+	if (pa <= pb && pa <= pc)
+	{
+		return a;
+	}
+	return pb <= pc ? b : c;
+}
+
+// Reads sample index from a scanline, returned at the image's bit depth.
+static uint32_t eng_PNGSample(const uint8_t* row, uint32_t index, uint32_t bitDepth)
+{
+	switch (bitDepth)
+	{
+	case 16:
+		return ((uint32_t)row[index * 2] << 8) | row[index * 2 + 1];
+	case 8:
+		return row[index];
+	default:
+	{
+		uint32_t bit = index * bitDepth;
+		uint32_t shift = 8 - bitDepth - (bit & 7);
+		return (row[bit >> 3] >> shift) & ((1u << bitDepth) - 1);
+	}
+	}
+}
+
+static uint8_t eng_PNGTo8(uint32_t sample, uint32_t bitDepth)
+{
+	if (bitDepth == 16)
+	{
+		return (uint8_t)(sample >> 8);
+	}
+	return (uint8_t)(sample * 255 / ((1u << bitDepth) - 1));
+}
+
+bool eng_ImageDecodePNG(eng_Image* image, const uint8_t* data, size_t size)
+{
+	uint32_t width = 0, height = 0, bitDepth = 0, colorType = 0, interlace = 0;
+	uint8_t palette[256 * 4];
+	uint32_t paletteSize = 0;
+	uint32_t transparentKey[3] = { 0 };
+	bool hasTransparentKey = false;
+
+	memset(palette, 255, sizeof(palette));
+
+	// First pass: header, palette and total compressed size.
+	size_t compressedSize = 0;
+	size_t offset = 8;
+	while (offset + 12 <= size)
+	{
+		uint32_t length = READ_U32_BE(data + offset);
+		uint32_t type = READ_U32_BE(data + offset + 4);
+		const uint8_t* chunk = data + offset + 8;
+		if (length > size - offset - 12)
+		{
+			return false;
+		}
+
+		if (type == 0x49484452 && length >= 13) // IHDR
+		{
+			width = READ_U32_BE(chunk);
+			height = READ_U32_BE(chunk + 4);
+			bitDepth = chunk[8];
+			colorType = chunk[9];
+			interlace = chunk[12];
+		}
+		else if (type == 0x504C5445) // PLTE
+		{
+			paletteSize = length / 3 > 256 ? 256 : length / 3;
+			for (uint32_t i = 0; i < paletteSize; ++i)
+			{
+				palette[i * 4 + 0] = chunk[i * 3 + 0];
+				palette[i * 4 + 1] = chunk[i * 3 + 1];
+				palette[i * 4 + 2] = chunk[i * 3 + 2];
+			}
+		}
+		else if (type == 0x74524E53) // tRNS
+		{
+			if (colorType == 3)
+			{
+				for (uint32_t i = 0; i < length && i < 256; ++i)
+				{
+					palette[i * 4 + 3] = chunk[i];
+				}
+			}
+			else if (colorType == 0 && length >= 2)
+			{
+				transparentKey[0] = ((uint32_t)chunk[0] << 8) | chunk[1];
+				hasTransparentKey = true;
+			}
+			else if (colorType == 2 && length >= 6)
+			{
+				for (uint32_t i = 0; i < 3; ++i)
+				{
+					transparentKey[i] = ((uint32_t)chunk[i * 2] << 8) | chunk[i * 2 + 1];
+				}
+				hasTransparentKey = true;
+			}
+		}
+		else if (type == 0x49444154) // IDAT
+		{
+			compressedSize += length;
+		}
+		else if (type == 0x49454E44) // IEND
+		{
+			break;
+		}
+		offset += 12 + length;
+	}
+
+	uint32_t channels;
+	switch (colorType)
+	{
+	case 0: channels = 1; break;
+	case 2: channels = 3; break;
+	case 3: channels = 1; break;
+	case 4: channels = 2; break;
+	case 6: channels = 4; break;
+	default:
+		eng_Err("Unsupported PNG color type %u.\n", colorType);
+		return false;
+	}
+	if (interlace != 0)
+	{
+		eng_Err("Interlaced PNGs are not supported.\n");
+		return false;
+	}
+	// Palette indices go up to 8 bits and true color samples start at 8.
+	bool depthAllowed;
+	switch (colorType)
+	{
+	case 0: depthAllowed = bitDepth == 1 || bitDepth == 2 || bitDepth == 4 || bitDepth == 8 || bitDepth == 16; break;
+	case 3: depthAllowed = bitDepth == 1 || bitDepth == 2 || bitDepth == 4 || bitDepth == 8; break;
+	default: depthAllowed = bitDepth == 8 || bitDepth == 16; break;
+	}
+	if (!depthAllowed)
+	{
+		eng_Err("Invalid PNG bit depth %u for color type %u.\n", bitDepth, colorType);
+		return false;
+	}
+	if (compressedSize == 0 || !eng_ImageAllocateRGBA8(image, width, height))
+	{
+		return false;
+	}
+
+	// Gather IDAT chunks into one contiguous zlib stream.
+	const size_t compressedCapacity = compressedSize;
+	uint8_t* compressed = eng_AllocatorAllocType(image->Allocator, uint8_t, compressedCapacity);
+	if (compressed == NULL)
+	{
+		eng_Err("Failed to allocate %zu bytes of PNG image data.\n", compressedCapacity);
+		eng_ImageDestroy(image);
+		return false;
+	}
+	compressedSize = 0;
+	for (offset = 8; offset + 12 <= size;)
+	{
+		uint32_t length = READ_U32_BE(data + offset);
+		uint32_t type = READ_U32_BE(data + offset + 4);
+		if (type == 0x49444154)
+		{
+			memcpy(compressed + compressedSize, data + offset + 8, length);
+			compressedSize += length;
+		}
+		else if (type == 0x49454E44)
+		{
+			break;
+		}
+		offset += 12 + length;
+	}
+
+	uint32_t bitsPerPixel = channels * bitDepth;
+	uint32_t bytesPerPixel = bitsPerPixel >= 8 ? bitsPerPixel / 8 : 1;
+	uint32_t stride = (width * bitsPerPixel + 7) / 8;
+	size_t rawSize = (size_t)height * (stride + 1);
+	uint8_t* raw = eng_AllocatorAllocType(image->Allocator, uint8_t, rawSize);
+
+	bool ok = raw != NULL && eng_InflateZlib(compressed, compressedSize, raw, rawSize);
+	eng_AllocatorFreeType(image->Allocator, compressed, uint8_t, compressedCapacity);
+	if (!ok)
+	{
+		eng_Err("PNG image data is corrupt.\n");
+		eng_AllocatorFreeType(image->Allocator, raw, uint8_t, rawSize);
+		return false;
+	}
+
+	// Undo the per-scanline filters in place.
+	uint8_t* previous = NULL;
+	for (uint32_t y = 0; y < height && ok; ++y)
+	{
+		uint8_t* row = raw + (size_t)y * (stride + 1);
+		uint8_t filter = row[0];
+		uint8_t* line = row + 1;
+		for (uint32_t x = 0; x < stride; ++x)
+		{
+			uint8_t a = x >= bytesPerPixel ? line[x - bytesPerPixel] : 0;
+			uint8_t b = previous ? previous[x] : 0;
+			uint8_t c = (previous && x >= bytesPerPixel) ? previous[x - bytesPerPixel] : 0;
+			switch (filter)
+			{
+			case 0: break;
+			case 1: line[x] += a; break;
+			case 2: line[x] += b; break;
+			case 3: line[x] += (uint8_t)(((uint32_t)a + b) / 2); break;
+			case 4: line[x] += eng_PNGPaeth(a, b, c); break;
+			default: ok = false; break;
+			}
+		}
+		previous = line;
+	}
+
+	// Expand to RGBA8.
+	uint8_t* out = (uint8_t*)image->Data;
+	for (uint32_t y = 0; y < height && ok; ++y)
+	{
+		const uint8_t* line = raw + (size_t)y * (stride + 1) + 1;
+		for (uint32_t x = 0; x < width; ++x, out += 4)
+		{
+			switch (colorType)
+			{
+			case 0:
+			{
+				uint32_t v = eng_PNGSample(line, x, bitDepth);
+				out[0] = out[1] = out[2] = eng_PNGTo8(v, bitDepth);
+				out[3] = (hasTransparentKey && v == transparentKey[0]) ? 0 : 255;
+				break;
+			}
+			case 2:
+			{
+				uint32_t r = eng_PNGSample(line, x * 3 + 0, bitDepth);
+				uint32_t g = eng_PNGSample(line, x * 3 + 1, bitDepth);
+				uint32_t b = eng_PNGSample(line, x * 3 + 2, bitDepth);
+				out[0] = eng_PNGTo8(r, bitDepth);
+				out[1] = eng_PNGTo8(g, bitDepth);
+				out[2] = eng_PNGTo8(b, bitDepth);
+				out[3] = (hasTransparentKey && r == transparentKey[0] && g == transparentKey[1] && b == transparentKey[2]) ? 0 : 255;
+				break;
+			}
+			case 3:
+				memcpy(out, &palette[eng_PNGSample(line, x, bitDepth) * 4], 4);
+				break;
+			case 4:
+				out[0] = out[1] = out[2] = eng_PNGTo8(eng_PNGSample(line, x * 2 + 0, bitDepth), bitDepth);
+				out[3] = eng_PNGTo8(eng_PNGSample(line, x * 2 + 1, bitDepth), bitDepth);
+				break;
+			case 6:
+				for (uint32_t c = 0; c < 4; ++c)
+				{
+					out[c] = eng_PNGTo8(eng_PNGSample(line, x * 4 + c, bitDepth), bitDepth);
+				}
+				break;
+			}
+		}
+	}
+
+	eng_AllocatorFreeType(image->Allocator, raw, uint8_t, rawSize);
+	return ok;
+}
+
+////////////////////////////////////////////////////////////////////////// DDS
+bool eng_ImageDecodeDDS(eng_Image* image, const uint8_t* data, size_t size)
+{
+	if (size < 128 || READ_U32_LE(data + 4) != 124)
+	{
+		return false;
+	}
+	const uint8_t* header = data + 4;
+	uint32_t flags = READ_U32_LE(header + 4);
+	uint32_t height = READ_U32_LE(header + 8);
+	uint32_t width = READ_U32_LE(header + 12);
+	uint32_t levelCount = (flags & 0x20000) ? READ_U32_LE(header + 24) : 1;
+	uint32_t pixelFlags = READ_U32_LE(header + 76);
+	uint32_t fourCC = READ_U32_LE(header + 80);
+	uint32_t rgbBitCount = READ_U32_LE(header + 84);
+	uint32_t redMask = READ_U32_LE(header + 88);
+
+	size_t offset = 128;
+	eng_ImageFormat format = ENG_IMAGE_FORMAT_UNKNOWN;
+	if (pixelFlags & 0x4) // DDPF_FOURCC
+	{
+		switch (fourCC)
+		{
+		case FOURCC('D', 'X', 'T', '1'): format = ENG_IMAGE_FORMAT_BC1; break;
+		case FOURCC('D', 'X', 'T', '2'):
+		case FOURCC('D', 'X', 'T', '3'): format = ENG_IMAGE_FORMAT_BC2; break;
+		case FOURCC('D', 'X', 'T', '4'):
+		case FOURCC('D', 'X', 'T', '5'): format = ENG_IMAGE_FORMAT_BC3; break;
+		case FOURCC('A', 'T', 'I', '1'):
+		case FOURCC('B', 'C', '4', 'U'): format = ENG_IMAGE_FORMAT_BC4; break;
+		case FOURCC('A', 'T', 'I', '2'):
+		case FOURCC('B', 'C', '5', 'U'): format = ENG_IMAGE_FORMAT_BC5; break;
+		case FOURCC('D', 'X', '1', '0'):
+		{
+			if (size < 148)
+			{
+				return false;
+			}
+			uint32_t dxgiFormat = READ_U32_LE(data + 128);
+			offset = 148;
+			switch (dxgiFormat)
+			{
+			case 28: format = ENG_IMAGE_FORMAT_RGBA8; break;
+			case 29: format = ENG_IMAGE_FORMAT_RGBA8_SRGB; break;
+			case 71: format = ENG_IMAGE_FORMAT_BC1; break;
+			case 72: format = ENG_IMAGE_FORMAT_BC1_SRGB; break;
+			case 74: format = ENG_IMAGE_FORMAT_BC2; break;
+			case 75: format = ENG_IMAGE_FORMAT_BC2_SRGB; break;
+			case 77: format = ENG_IMAGE_FORMAT_BC3; break;
+			case 78: format = ENG_IMAGE_FORMAT_BC3_SRGB; break;
+			case 80: format = ENG_IMAGE_FORMAT_BC4; break;
+			case 83: format = ENG_IMAGE_FORMAT_BC5; break;
+			case 87: format = ENG_IMAGE_FORMAT_BGRA8; break;
+			case 91: format = ENG_IMAGE_FORMAT_BGRA8_SRGB; break;
+			case 95: format = ENG_IMAGE_FORMAT_BC6H; break;
+			case 98: format = ENG_IMAGE_FORMAT_BC7; break;
+			case 99: format = ENG_IMAGE_FORMAT_BC7_SRGB; break;
+			}
+			break;
+		}
+		}
+	}
+	else if ((pixelFlags & 0x40) && rgbBitCount == 32) // DDPF_RGB
+	{
+		format = redMask == 0x000000FF ? ENG_IMAGE_FORMAT_RGBA8 : ENG_IMAGE_FORMAT_BGRA8;
+	}
+
+	if (format == ENG_IMAGE_FORMAT_UNKNOWN)
+	{
+		eng_Err("Unsupported DDS pixel format.\n");
+		return false;
+	}
+
+	// Cube maps and arrays store each face's full chain in turn, so reading
+	// the first chain gives us face/layer 0.
+	return eng_ImageCopyLevels(image, format, width, height, levelCount, data + offset, size - offset);
+}
+
+////////////////////////////////////////////////////////////////////////// KTX
+bool eng_ImageDecodeKTX(eng_Image* image, const uint8_t* data, size_t size)
+{
+	if (size < 64 || READ_U32_LE(data + 12) != 0x04030201)
+	{
+		eng_Err("Unsupported KTX endianness.\n");
+		return false;
+	}
+	uint32_t glInternalFormat = READ_U32_LE(data + 28);
+	uint32_t width = READ_U32_LE(data + 36);
+	uint32_t height = READ_U32_LE(data + 40);
+	uint32_t arrayCount = READ_U32_LE(data + 48);
+	uint32_t faceCount = READ_U32_LE(data + 52);
+	uint32_t levelCount = READ_U32_LE(data + 56);
+	uint32_t keyValueBytes = READ_U32_LE(data + 60);
+
+	eng_ImageFormat format = ENG_IMAGE_FORMAT_UNKNOWN;
+	switch (glInternalFormat)
+	{
+	case 0x8058: format = ENG_IMAGE_FORMAT_RGBA8; break;         // GL_RGBA8
+	case 0x8C43: format = ENG_IMAGE_FORMAT_RGBA8_SRGB; break;    // GL_SRGB8_ALPHA8
+	case 0x93A1: format = ENG_IMAGE_FORMAT_BGRA8; break;         // GL_BGRA8_EXT
+	case 0x83F0:                                                 // GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+	case 0x83F1: format = ENG_IMAGE_FORMAT_BC1; break;           // GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+	case 0x8C4C:                                                 // GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+	case 0x8C4D: format = ENG_IMAGE_FORMAT_BC1_SRGB; break;      // GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT
+	case 0x83F2: format = ENG_IMAGE_FORMAT_BC2; break;           // GL_COMPRESSED_RGBA_S3TC_DXT3_EXT
+	case 0x8C4E: format = ENG_IMAGE_FORMAT_BC2_SRGB; break;      // GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT
+	case 0x83F3: format = ENG_IMAGE_FORMAT_BC3; break;           // GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+	case 0x8C4F: format = ENG_IMAGE_FORMAT_BC3_SRGB; break;      // GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+	case 0x8DBB: format = ENG_IMAGE_FORMAT_BC4; break;           // GL_COMPRESSED_RED_RGTC1
+	case 0x8DBD: format = ENG_IMAGE_FORMAT_BC5; break;           // GL_COMPRESSED_RG_RGTC2
+	case 0x8E8F: format = ENG_IMAGE_FORMAT_BC6H; break;          // GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT
+	case 0x8E8C: format = ENG_IMAGE_FORMAT_BC7; break;           // GL_COMPRESSED_RGBA_BPTC_UNORM
+	case 0x8E8D: format = ENG_IMAGE_FORMAT_BC7_SRGB; break;      // GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM
+	}
+	if (format == ENG_IMAGE_FORMAT_UNKNOWN)
+	{
+		eng_Err("Unsupported KTX internal format 0x%X.\n", glInternalFormat);
+		return false;
+	}
+	if (height == 0)
+	{
+		height = 1;
+	}
+	if (width == 0 || width > 16384 || height > 16384)
+	{
+		eng_Err("Image dimensions %ux%u are not supported.\n", width, height);
+		return false;
+	}
+	if (levelCount == 0)
+	{
+		levelCount = 1;
+	}
+	if (levelCount > ENG_IMAGE_MAX_LEVELS)
+	{
+		levelCount = ENG_IMAGE_MAX_LEVELS;
+	}
+	if (faceCount == 0)
+	{
+		faceCount = 1;
+	}
+
+	// KTX prefixes every level with its size and pads levels (and cube
+	// faces) to 4 bytes, so levels are gathered one at a time. Only face
+	// and layer 0 are kept. The dimension cap keeps the sum within DataSize.
+	size_t totalSize = 0;
+	for (uint32_t i = 0; i < levelCount; ++i)
+	{
+		uint32_t w = width >> i ? width >> i : 1;
+		uint32_t h = height >> i ? height >> i : 1;
+		totalSize += eng_ImageFormatGetLevelSize(format, w, h);
+	}
+
+	image->Width = width;
+	image->Height = height;
+	image->Format = format;
+	image->LevelCount = levelCount;
+	image->DataSize = (uint32_t)totalSize;
+	image->Data = eng_AllocatorAlloc(image->Allocator, totalSize, ENG_ALLOCATOR_DEFAULT_ALIGNMENT);
+	if (image->Data == NULL)
+	{
+		return false;
+	}
+
+	size_t offset = 64 + (size_t)keyValueBytes;
+	uint32_t dstOffset = 0;
+	for (uint32_t i = 0; i < levelCount; ++i)
+	{
+		if (offset + 4 > size)
+		{
+			return false;
+		}
+		uint32_t imageSize = READ_U32_LE(data + offset);
+		offset += 4;
+
+		eng_ImageLevel* level = &image->Levels[i];
+		level->Width = width >> i ? width >> i : 1;
+		level->Height = height >> i ? height >> i : 1;
+		level->Offset = dstOffset;
+		level->Size = eng_ImageFormatGetLevelSize(format, level->Width, level->Height);
+		if (level->Size > imageSize || offset + level->Size > size)
+		{
+			eng_Err("KTX level %u is truncated.\n", i);
+			return false;
+		}
+		memcpy((uint8_t*)image->Data + dstOffset, data + offset, level->Size);
+		dstOffset += level->Size;
+
+		size_t paddedSize = ((size_t)imageSize + 3) & ~(size_t)3;
+		offset += (faceCount == 6 && arrayCount == 0) ? paddedSize * 6 : paddedSize;
+	}
+	return true;
+}
\ No newline at end of file
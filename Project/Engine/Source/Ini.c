@@ -6,6 +6,7 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <Engine/Allocator.h>
 #include <Engine/Log.h>
 
 typedef struct eng_IniKeyValue
@@ -33,7 +34,9 @@ typedef struct eng_IniR
 	 */
 	uint32_t LastSectionPosition;
 	char* FileContents;
+	uint32_t FileContentsSize;
 	FILE* File;
+	const eng_Allocator* Allocator;
 	
 	uint32_t SectionCount;
 	struct eng_IniSection* Sections;
@@ -41,18 +44,18 @@ typedef struct eng_IniR
 
 uint32_t eng_IniRCountSections(eng_IniR* ini);
 void eng_IniRInitSections(eng_IniR* ini);
+bool eng_IniRLineGetSectionHead(char* line, char** outSectionHeadStart, char** outSectionHeadEnd);
+bool eng_IniRMatches(const char* start, const char* end, const char* name);
 
 eng_IniR* eng_IniRMalloc(void)
 {
 	return malloc(sizeof(eng_IniR));
 }
 
-bool eng_IniRInit(eng_IniR* ini, const char* path)
+bool eng_IniRInit(eng_IniR* ini, const char* path, const eng_Allocator* allocator)
 {
-	{ // temp
-		memset(ini, 0, sizeof(eng_IniR));
-		return true;
-	}
+	memset(ini, 0, sizeof(eng_IniR));
+	ini->Allocator = allocator;
 
 	ini->File = fopen(path, "r");
 	if (ini->File == NULL)
@@ -64,8 +67,10 @@ bool eng_IniRInit(eng_IniR* ini, const char* path)
 	rewind(ini->File);
 	if (ini->FileSize)
 	{
-		ini->FileContents = malloc(ini->FileSize+1);
-		fread(ini->FileContents, 1, ini->FileSize, ini->File);
+		ini->FileContentsSize = ini->FileSize+1;
+		ini->FileContents = eng_AllocatorAllocType(ini->Allocator, char, ini->FileContentsSize);
+		// Text mode drops '\r', so fewer bytes than ftell reported may arrive.
+		ini->FileSize = (uint32_t)fread(ini->FileContents, 1, ini->FileSize, ini->File);
 		ini->FileContents[ini->FileSize] = '\0';
 		for (uint32_t i = 0; i < ini->FileSize; ++i)
 		{
@@ -113,6 +118,8 @@ bool eng_IniRInit(eng_IniR* ini, const char* path)
 		ini->FileContents = NULL;
 	}
 	ini->LastSectionPosition = 0;
+	fclose(ini->File);
+	ini->File = NULL;
 
 	return true;
 }
@@ -123,7 +130,8 @@ void eng_IniRFree(eng_IniR* ini, bool subAllocationsOnly)
 	{
 		return;
 	}
-	free(ini->FileContents);
+	eng_AllocatorFreeType(ini->Allocator, ini->Sections, eng_IniSection, ini->SectionCount);
+	eng_AllocatorFreeType(ini->Allocator, ini->FileContents, char, ini->FileContentsSize);
 	if (!subAllocationsOnly)
 	{
 		free(ini);
@@ -139,6 +147,62 @@ size_t eng_IniRGetSizeof(void)
 
 const char* eng_IniRRead(eng_IniR* ini, const char* section, const char* key)
 {
+	// Lines were split on '\0' and upper cased by eng_IniRInit.
+	bool inSection = false;
+	for (uint32_t i = 0; i < ini->FileSize; i += (uint32_t)strlen(&ini->FileContents[i]) + 1)
+	{
+		char* line = &ini->FileContents[i];
+		while (*line == ' ' || *line == '\t')
+		{
+			++line;
+		}
+
+		if (*line == '[')
+		{
+			char* s;
+			char* e;
+			inSection = eng_IniRLineGetSectionHead(line, &s, &e) && eng_IniRMatches(s + 1, e - 1, section);
+			continue;
+		}
+
+		char* equals = strchr(line, '=');
+		if (!inSection || equals == NULL)
+		{
+			continue;
+		}
+		char* keyEnd = equals;
+		while (keyEnd > line && (keyEnd[-1] == ' ' || keyEnd[-1] == '\t'))
+		{
+			--keyEnd;
+		}
+		if (!eng_IniRMatches(line, keyEnd, key))
+		{
+			continue;
+		}
+
+		char* value = equals + 1;
+		while (*value == ' ' || *value == '\t')
+		{
+			++value;
+		}
+		char* valueEnd = value + strlen(value);
+		while (valueEnd > value && (valueEnd[-1] == ' ' || valueEnd[-1] == '\t'))
+		{
+			--valueEnd;
+		}
+		// The closing quote is cut off in place, so a repeated read only
+		// sees the opening one.
+		if (*value == '\"')
+		{
+			++value;
+			if (valueEnd > value && valueEnd[-1] == '\"')
+			{
+				--valueEnd;
+			}
+		}
+		*valueEnd = '\0';
+		return value;
+	}
 	return NULL;
 }
 
@@ -288,7 +352,7 @@ void eng_IniRInitSections(eng_IniR* ini)
 		ini->Sections = NULL;
 		return;
 	}
-	ini->Sections = calloc(ini->SectionCount, sizeof(eng_IniSection));
+	ini->Sections = eng_AllocatorCallocType(ini->Allocator, eng_IniSection, ini->SectionCount);
 
 	char* c = ini->FileContents;
 	char* s;
@@ -305,4 +369,16 @@ void eng_IniRInitSections(eng_IniR* ini)
 		i += e - s;
 		
 	}
+}
+
+bool eng_IniRMatches(const char* start, const char* end, const char* name)
+{
+	for (; start < end; ++start, ++name)
+	{
+		if (*name == '\0' || *start != toupper(*name))
+		{
+			return false;
+		}
+	}
+	return *name == '\0';
 }
\ No newline at end of file
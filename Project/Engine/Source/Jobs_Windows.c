@@ -0,0 +1,250 @@
+#ifdef GAME_WINDOWS
+#include <Engine/Jobs.h>
+
+#include <Engine/Allocator.h>
+#include <Engine/Atomic.h>
+#include <Engine/Log.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <windows.h>
+
+#define INITIAL_QUEUE_CAPACITY 256
+#define MAX_WORKERS 64
+
+typedef struct eng_Job
+{
+	eng_JobFunc_t Func;
+	void* UserData;
+	eng_JobCounter* Counter;
+} eng_Job;
+
+typedef struct eng_JobPool
+{
+	CRITICAL_SECTION Lock;
+	CONDITION_VARIABLE JobAvailable;
+	CONDITION_VARIABLE JobFinished;
+
+	// Ring buffer of queued jobs, guarded by Lock.
+	eng_Job* Queue;
+	uint32_t QueueCapacity;
+	uint32_t QueueHead;
+	uint32_t QueueCount;
+
+	bool ShuttingDown;
+
+	uint32_t WorkerCount;
+	uint32_t WorkerCapacity;
+	HANDLE* Workers;
+	const eng_Allocator* Allocator;
+} eng_JobPool;
+
+DWORD WINAPI eng_JobPoolWorkerMain(LPVOID param);
+bool eng_JobPoolTryPop(eng_JobPool* pool, eng_Job* outJob);
+void eng_JobPoolRun(eng_JobPool* pool, eng_Job* job);
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+eng_JobPool* eng_JobPoolMalloc(void)
+{
+	return malloc(sizeof(eng_JobPool));
+}
+
+bool eng_JobPoolInit(eng_JobPool* pool, uint32_t workerCount, const eng_Allocator* allocator)
+{
+	memset(pool, 0, sizeof(eng_JobPool));
+	pool->Allocator = allocator;
+
+	if (workerCount == 0)
+	{
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		workerCount = info.dwNumberOfProcessors > 1 ? (uint32_t)info.dwNumberOfProcessors - 1 : 1;
+	}
+	if (workerCount > MAX_WORKERS)
+	{
+		workerCount = MAX_WORKERS;
+	}
+
+	InitializeCriticalSection(&pool->Lock);
+	InitializeConditionVariable(&pool->JobAvailable);
+	InitializeConditionVariable(&pool->JobFinished);
+
+	pool->QueueCapacity = INITIAL_QUEUE_CAPACITY;
+	pool->Queue = eng_AllocatorAllocType(pool->Allocator, eng_Job, pool->QueueCapacity);
+	pool->Workers = eng_AllocatorCallocType(pool->Allocator, HANDLE, workerCount);
+	pool->WorkerCapacity = workerCount;
+	if (pool->Queue == NULL || pool->Workers == NULL)
+	{
+		return false;
+	}
+
+	for (uint32_t i = 0; i < workerCount; ++i)
+	{
+		pool->Workers[i] = CreateThread(NULL, 0, eng_JobPoolWorkerMain, pool, 0, NULL);
+		if (!eng_Ensure(pool->Workers[i] != NULL, "Failed to create job worker %u.\n", i))
+		{
+			break;
+		}
+		++pool->WorkerCount;
+	}
+
+	return pool->WorkerCount > 0;
+}
+
+void eng_JobPoolFree(eng_JobPool* pool, bool subAllocationsOnly)
+{
+	if (pool == NULL)
+	{
+		return;
+	}
+
+	EnterCriticalSection(&pool->Lock);
+	pool->ShuttingDown = true;
+	WakeAllConditionVariable(&pool->JobAvailable);
+	LeaveCriticalSection(&pool->Lock);
+
+	for (uint32_t i = 0; i < pool->WorkerCount; ++i)
+	{
+		WaitForSingleObject(pool->Workers[i], INFINITE);
+		CloseHandle(pool->Workers[i]);
+	}
+
+	DeleteCriticalSection(&pool->Lock);
+	eng_AllocatorFreeType(pool->Allocator, pool->Queue, eng_Job, pool->QueueCapacity);
+	eng_AllocatorFreeType(pool->Allocator, pool->Workers, HANDLE, pool->WorkerCapacity);
+
+	if (!subAllocationsOnly)
+	{
+		free(pool);
+	}
+}
+
+size_t eng_JobPoolGetSizeof(void)
+{
+	return sizeof(eng_JobPool);
+}
+
+////////////////////////////////////////////////////////////////////////// Job Pool API
+void eng_JobPoolPush(eng_JobPool* pool, eng_JobFunc_t func, void* userData, eng_JobCounter* counter)
+{
+	if (counter != NULL)
+	{
+		eng_AtomicIncrement32(&counter->Pending);
+	}
+
+	EnterCriticalSection(&pool->Lock);
+	if (pool->QueueCount == pool->QueueCapacity)
+	{
+		// Unroll the ring into a larger buffer so QueueHead starts at 0 again.
+		uint32_t newCapacity = pool->QueueCapacity * 2;
+		eng_Job* newQueue = eng_AllocatorAllocType(pool->Allocator, eng_Job, newCapacity);
+		if (!eng_Ensure(newQueue != NULL, "Failed to grow the job queue to %u jobs, running the job inline.\n", newCapacity))
+		{
+			// The old queue is untouched; the job still runs and counts down its counter.
+			LeaveCriticalSection(&pool->Lock);
+			eng_Job inlineJob = { .Func = func, .UserData = userData, .Counter = counter };
+			eng_JobPoolRun(pool, &inlineJob);
+			return;
+		}
+		for (uint32_t i = 0; i < pool->QueueCount; ++i)
+		{
+			newQueue[i] = pool->Queue[(pool->QueueHead + i) % pool->QueueCapacity];
+		}
+		eng_AllocatorFreeType(pool->Allocator, pool->Queue, eng_Job, pool->QueueCapacity);
+		pool->Queue = newQueue;
+		pool->QueueCapacity = newCapacity;
+		pool->QueueHead = 0;
+	}
+
+	eng_Job* job = &pool->Queue[(pool->QueueHead + pool->QueueCount) % pool->QueueCapacity];
+	job->Func = func;
+	job->UserData = userData;
+	job->Counter = counter;
+	++pool->QueueCount;
+
+	WakeConditionVariable(&pool->JobAvailable);
+	LeaveCriticalSection(&pool->Lock);
+}
+
+void eng_JobPoolWait(eng_JobPool* pool, eng_JobCounter* counter)
+{
+	eng_Job job;
+	while (eng_AtomicLoad32(&counter->Pending) > 0)
+	{
+		if (eng_JobPoolTryPop(pool, &job))
+		{
+			eng_JobPoolRun(pool, &job);
+			continue;
+		}
+
+		// Nothing left to help with: our jobs are running on workers.
+		EnterCriticalSection(&pool->Lock);
+		if (eng_AtomicLoad32(&counter->Pending) > 0 && pool->QueueCount == 0)
+		{
+			SleepConditionVariableCS(&pool->JobFinished, &pool->Lock, 1);
+		}
+		LeaveCriticalSection(&pool->Lock);
+	}
+}
+
+uint32_t eng_JobPoolGetWorkerCount(eng_JobPool* pool)
+{
+	return pool->WorkerCount;
+}
+
+////////////////////////////////////////////////////////////////////////// Internal
+DWORD WINAPI eng_JobPoolWorkerMain(LPVOID param)
+{
+	eng_JobPool* pool = (eng_JobPool*)param;
+	eng_Job job;
+
+	for (;;)
+	{
+		EnterCriticalSection(&pool->Lock);
+		while (pool->QueueCount == 0 && !pool->ShuttingDown)
+		{
+			SleepConditionVariableCS(&pool->JobAvailable, &pool->Lock, INFINITE);
+		}
+		if (pool->QueueCount == 0)
+		{
+			// Shutting down with an empty queue.
+			LeaveCriticalSection(&pool->Lock);
+			return 0;
+		}
+		job = pool->Queue[pool->QueueHead];
+		pool->QueueHead = (pool->QueueHead + 1) % pool->QueueCapacity;
+		--pool->QueueCount;
+		LeaveCriticalSection(&pool->Lock);
+
+		eng_JobPoolRun(pool, &job);
+	}
+}
+
+bool eng_JobPoolTryPop(eng_JobPool* pool, eng_Job* outJob)
+{
+	bool popped = false;
+	EnterCriticalSection(&pool->Lock);
+	if (pool->QueueCount > 0)
+	{
+		*outJob = pool->Queue[pool->QueueHead];
+		pool->QueueHead = (pool->QueueHead + 1) % pool->QueueCapacity;
+		--pool->QueueCount;
+		popped = true;
+	}
+	LeaveCriticalSection(&pool->Lock);
+	return popped;
+}
+
+void eng_JobPoolRun(eng_JobPool* pool, eng_Job* job)
+{
+	job->Func(job->UserData);
+
+	if (job->Counter != NULL && eng_AtomicDecrement32(&job->Counter->Pending) == 0)
+	{
+		EnterCriticalSection(&pool->Lock);
+		WakeAllConditionVariable(&pool->JobFinished);
+		LeaveCriticalSection(&pool->Lock);
+	}
+}
+
+#endif
\ No newline at end of file
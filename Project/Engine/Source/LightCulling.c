@@ -0,0 +1,100 @@
+#include <Engine/LightCulling.h>
+
+#include <math.h>
+
+// Bounds are stored as two vec4s per cluster to match std430 layout.
+#define BOUNDS_FLOATS_PER_CLUSTER 8
+
+float eng_LightClusterSliceDepth(const eng_LightClusterConfig* config, uint32_t slice);
+
+////////////////////////////////////////////////////////////////////////// Light Culling API
+uint32_t eng_LightClusterGetCount(const eng_LightClusterConfig* config)
+{
+	return config->TilesX * config->TilesY * config->Slices;
+}
+
+void eng_LightClusterGetBounds(const eng_LightClusterConfig* config, uint32_t x, uint32_t y, uint32_t z, float outMin[3], float outMax[3])
+{
+	float tanY = tanf(config->FovY * 0.5f);
+	float tanX = tanY * config->Aspect;
+	float nearZ = eng_LightClusterSliceDepth(config, z);
+	float farZ = eng_LightClusterSliceDepth(config, z + 1);
+
+	// Tile edges in normalized device coordinates.
+	float x0 = -1.0f + 2.0f * x / config->TilesX;
+	float x1 = -1.0f + 2.0f * (x + 1) / config->TilesX;
+	float y0 = -1.0f + 2.0f * y / config->TilesY;
+	float y1 = -1.0f + 2.0f * (y + 1) / config->TilesY;
+
+	// A tile edge moves linearly with depth, so its extremes are at the
+	// slice's near or far plane depending on which side of center it is.
+	outMin[0] = fminf(x0 * nearZ, x0 * farZ) * tanX;
+	outMax[0] = fmaxf(x1 * nearZ, x1 * farZ) * tanX;
+	outMin[1] = fminf(y0 * nearZ, y0 * farZ) * tanY;
+	outMax[1] = fmaxf(y1 * nearZ, y1 * farZ) * tanY;
+	outMin[2] = nearZ;
+	outMax[2] = farZ;
+}
+
+uint32_t eng_LightClusterFind(const eng_LightClusterConfig* config, const float viewPosition[3])
+{
+	float depth = viewPosition[2];
+	if (depth < config->Near || depth >= config->Far)
+	{
+		return UINT32_MAX;
+	}
+
+	float tanY = tanf(config->FovY * 0.5f);
+	float ndcX = viewPosition[0] / (depth * tanY * config->Aspect);
+	float ndcY = viewPosition[1] / (depth * tanY);
+	if (ndcX < -1.0f || ndcX >= 1.0f || ndcY < -1.0f || ndcY >= 1.0f)
+	{
+		return UINT32_MAX;
+	}
+
+	uint32_t x = (uint32_t)((ndcX + 1.0f) * 0.5f * config->TilesX);
+	uint32_t y = (uint32_t)((ndcY + 1.0f) * 0.5f * config->TilesY);
+	uint32_t z = (uint32_t)(logf(depth / config->Near) / logf(config->Far / config->Near) * config->Slices);
+	if (z >= config->Slices)
+	{
+		z = config->Slices - 1;
+	}
+	return x + config->TilesX * (y + config->TilesY * z);
+}
+
+void eng_LightCullClusters(const eng_LightClusterConfig* config, const float* bounds, const eng_Light* lights, uint32_t lightCount, uint32_t* outCounts, uint32_t* outIndices)
+{
+	uint32_t clusterCount = eng_LightClusterGetCount(config);
+	for (uint32_t cluster = 0; cluster < clusterCount; ++cluster)
+	{
+		const float* boundsMin = bounds + cluster * BOUNDS_FLOATS_PER_CLUSTER;
+		const float* boundsMax = boundsMin + 4;
+		uint32_t* indices = outIndices + cluster * config->MaxLightsPerCluster;
+		uint32_t count = 0;
+
+		for (uint32_t i = 0; i < lightCount && count < config->MaxLightsPerCluster; ++i)
+		{
+			// Sphere against AABB: distance to the closest point in the box.
+			float distanceSquared = 0.0f;
+			for (uint32_t axis = 0; axis < 3; ++axis)
+			{
+				float center = lights[i].Position[axis];
+				float closest = center < boundsMin[axis] ? boundsMin[axis] : (center > boundsMax[axis] ? boundsMax[axis] : center);
+				float delta = closest - center;
+				distanceSquared += delta * delta;
+			}
+			if (distanceSquared <= lights[i].Radius * lights[i].Radius)
+			{
+				indices[count++] = i;
+			}
+		}
+		outCounts[cluster] = count;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////// Internal
+float eng_LightClusterSliceDepth(const eng_LightClusterConfig* config, uint32_t slice)
+{
+	// Exponential slices keep clusters roughly cubic in view space.
+	return config->Near * powf(config->Far / config->Near, (float)slice / config->Slices);
+}
\ No newline at end of file
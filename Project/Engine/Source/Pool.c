@@ -0,0 +1,458 @@
+#include <Engine/Pool.h>
+
+#include <Engine/Atomic.h>
+#include <Engine/Log.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#define CACHE_LINE_SIZE 64
+#define INVALID_INDEX UINT32_MAX
+#define POISON_FREE 0xDD
+#define POISON_ALLOC 0xCD
+
+// The first cache line of a slab. Slabs are aligned to their own size, so
+// any object's slab is found by masking its address.
+typedef struct eng_PoolSlabHeader
+{
+	uint32_t SlabIndex;
+} eng_PoolSlabHeader;
+
+// One per thread slot, a cache line each so threads don't share lines.
+typedef struct eng_PoolCache
+{
+	void* Head;
+	uint32_t Count;
+	uint8_t Padding[CACHE_LINE_SIZE - sizeof(void*) - sizeof(uint32_t)];
+} eng_PoolCache;
+
+typedef struct eng_Pool
+{
+	eng_Allocator Interface;
+	const eng_Allocator* Allocator;
+	eng_PoolSettings Settings;
+	size_t Stride;
+	size_t SlabBytes;
+	uint32_t ObjectsPerSlab;
+
+	uint8_t** Slabs;
+	volatile int32_t SlabCount;
+	// Taken while a slab is added.
+	volatile int32_t GrowLock;
+
+	// Index of the first free object in the low 32 bits; the high 32 count
+	// changes so a pop racing with a pop and push of the same object fails.
+	volatile int64_t GlobalHead;
+	// Guards GlobalHead when Settings.LockFree is false.
+	volatile int32_t GlobalLock;
+
+	eng_PoolCache* Caches;
+} eng_Pool;
+
+static ENG_THREAD_LOCAL uint32_t t_PoolThreadSlot;
+static volatile int32_t s_PoolThreadCount;
+
+// @returns the calling thread's cache, or NULL if it's past ENG_POOL_MAX_THREADS.
+eng_PoolCache* eng_PoolGetCache(eng_Pool* pool);
+uint8_t* eng_PoolIndexToObject(eng_Pool* pool, uint32_t index);
+uint32_t eng_PoolObjectToIndex(eng_Pool* pool, void* obj);
+// Links objects first to last (threaded through their first 4 bytes) onto the global list.
+void eng_PoolGlobalPushChain(eng_Pool* pool, uint32_t first, uint32_t last);
+// @returns an object index off the global list, or INVALID_INDEX if it's empty.
+uint32_t eng_PoolGlobalPop(eng_Pool* pool);
+// Adds a slab. @returns false if MaxSlabs are full or the allocator fails.
+bool eng_PoolGrow(eng_Pool* pool);
+void eng_PoolCachePush(eng_PoolCache* cache, void* obj);
+void* eng_PoolCachePop(eng_PoolCache* cache);
+// Moves count objects from cache onto the global list.
+void eng_PoolCacheDrain(eng_Pool* pool, eng_PoolCache* cache, uint32_t count);
+void eng_PoolPoison(eng_Pool* pool, void* obj, uint8_t value);
+void eng_PoolCheckPoison(eng_Pool* pool, void* obj);
+void* eng_PoolInterfaceAlloc(void* userData, size_t size, size_t alignment);
+void* eng_PoolInterfaceRealloc(void* userData, void* ptr, size_t oldSize, size_t newSize, size_t alignment);
+void eng_PoolInterfaceFree(void* userData, void* ptr, size_t size);
+
+eng_PoolSettings eng_PoolGetDefaults(void)
+{
+	const eng_PoolSettings settings = {
+		.ObjectsPerSlab = 64,
+		.MaxSlabs = 1024,
+		.ThreadCacheSize = 32,
+		.LockFree = true,
+	};
+	return settings;
+}
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+eng_Pool* eng_PoolMalloc(void)
+{
+	return malloc(sizeof(eng_Pool));
+}
+
+bool eng_PoolInit(eng_Pool* pool, size_t objectSize, size_t alignment, const eng_PoolSettings* settings, const eng_Allocator* allocator)
+{
+	memset(pool, 0, sizeof(eng_Pool));
+	pool->Interface.Alloc = eng_PoolInterfaceAlloc;
+	pool->Interface.Realloc = eng_PoolInterfaceRealloc;
+	pool->Interface.Free = eng_PoolInterfaceFree;
+	pool->Interface.UserData = pool;
+	pool->Allocator = allocator;
+	pool->Settings = settings != NULL ? *settings : eng_PoolGetDefaults();
+	pool->GlobalHead = INVALID_INDEX;
+
+	if (!eng_Ensure(alignment != 0 && (alignment & (alignment - 1)) == 0 && alignment <= CACHE_LINE_SIZE, "Pool alignment %zu isn't a power of two up to %d.\n", alignment, CACHE_LINE_SIZE)
+		|| !eng_Ensure(objectSize > 0 && pool->Settings.ObjectsPerSlab > 0 && pool->Settings.MaxSlabs > 0, "Pool settings can't hold any objects.\n"))
+	{
+		return false;
+	}
+
+	// Free objects hold a link, so they're at least a pointer in size.
+	size_t size = objectSize > sizeof(void*) ? objectSize : sizeof(void*);
+	pool->Stride = (size + alignment - 1) & ~(alignment - 1);
+	size_t wanted = CACHE_LINE_SIZE + pool->Stride * pool->Settings.ObjectsPerSlab;
+	pool->SlabBytes = CACHE_LINE_SIZE;
+	while (pool->SlabBytes < wanted)
+	{
+		pool->SlabBytes *= 2;
+	}
+	pool->ObjectsPerSlab = (uint32_t)((pool->SlabBytes - CACHE_LINE_SIZE) / pool->Stride);
+	if (!eng_Ensure((uint64_t)pool->ObjectsPerSlab * pool->Settings.MaxSlabs < INVALID_INDEX, "Pool of %u slabs of %u objects is too large.\n", pool->Settings.MaxSlabs, pool->ObjectsPerSlab))
+	{
+		return false;
+	}
+
+	pool->Slabs = eng_AllocatorCallocType(allocator, uint8_t*, pool->Settings.MaxSlabs);
+	pool->Caches = eng_AllocatorAlloc(allocator, ENG_POOL_MAX_THREADS * sizeof(eng_PoolCache), CACHE_LINE_SIZE);
+	if (pool->Slabs == NULL || pool->Caches == NULL)
+	{
+		return false;
+	}
+	memset(pool->Caches, 0, ENG_POOL_MAX_THREADS * sizeof(eng_PoolCache));
+	return true;
+}
+
+void eng_PoolFree(eng_Pool* pool, bool subAllocationsOnly)
+{
+	if (pool == NULL)
+	{
+		return;
+	}
+
+	if (pool->Slabs != NULL)
+	{
+		for (int32_t i = 0; i < pool->SlabCount; ++i)
+		{
+			eng_AllocatorFree(pool->Allocator, pool->Slabs[i], pool->SlabBytes);
+		}
+	}
+	eng_AllocatorFreeType(pool->Allocator, pool->Slabs, uint8_t*, pool->Settings.MaxSlabs);
+	eng_AllocatorFreeType(pool->Allocator, pool->Caches, eng_PoolCache, ENG_POOL_MAX_THREADS);
+
+	if (!subAllocationsOnly)
+	{
+		free(pool);
+	}
+}
+
+size_t eng_PoolGetSizeof(void)
+{
+	return sizeof(eng_Pool);
+}
+
+////////////////////////////////////////////////////////////////////////// Pool API
+void* eng_PoolAlloc(eng_Pool* pool)
+{
+	eng_PoolCache* cache = eng_PoolGetCache(pool);
+	void* obj = NULL;
+	if (cache != NULL)
+	{
+		obj = eng_PoolCachePop(cache);
+		if (obj == NULL)
+		{
+			// Refill half the cache so the next few allocations stay local.
+			uint32_t refill = pool->Settings.ThreadCacheSize / 2;
+			for (uint32_t i = 0; i < refill; ++i)
+			{
+				uint32_t index = eng_PoolGlobalPop(pool);
+				if (index == INVALID_INDEX)
+				{
+					break;
+				}
+				eng_PoolCachePush(cache, eng_PoolIndexToObject(pool, index));
+			}
+			obj = eng_PoolCachePop(cache);
+		}
+	}
+
+	while (obj == NULL)
+	{
+		uint32_t index = eng_PoolGlobalPop(pool);
+		if (index != INVALID_INDEX)
+		{
+			obj = eng_PoolIndexToObject(pool, index);
+		}
+		else if (!eng_PoolGrow(pool))
+		{
+			return NULL;
+		}
+	}
+
+#if !defined(GAME_FINAL)
+	eng_PoolCheckPoison(pool, obj);
+	eng_PoolPoison(pool, obj, POISON_ALLOC);
+#endif
+	return obj;
+}
+
+void eng_PoolRelease(eng_Pool* pool, void* obj)
+{
+	if (obj == NULL)
+	{
+		return;
+	}
+
+#if !defined(GAME_FINAL)
+	eng_PoolPoison(pool, obj, POISON_FREE);
+#endif
+
+	eng_PoolCache* cache = eng_PoolGetCache(pool);
+	if (cache == NULL)
+	{
+		uint32_t index = eng_PoolObjectToIndex(pool, obj);
+		eng_PoolGlobalPushChain(pool, index, index);
+		return;
+	}
+
+	eng_PoolCachePush(cache, obj);
+	if (cache->Count > pool->Settings.ThreadCacheSize)
+	{
+		eng_PoolCacheDrain(pool, cache, cache->Count / 2);
+	}
+}
+
+void eng_PoolFlushThreadCache(eng_Pool* pool)
+{
+	eng_PoolCache* cache = eng_PoolGetCache(pool);
+	if (cache != NULL)
+	{
+		eng_PoolCacheDrain(pool, cache, cache->Count);
+	}
+}
+
+size_t eng_PoolGetObjectSize(eng_Pool* pool)
+{
+	return pool->Stride;
+}
+
+uint32_t eng_PoolGetCapacity(eng_Pool* pool)
+{
+	return (uint32_t)eng_AtomicLoad32(&pool->SlabCount) * pool->ObjectsPerSlab;
+}
+
+const eng_Allocator* eng_PoolGetAllocator(eng_Pool* pool)
+{
+	return &pool->Interface;
+}
+
+////////////////////////////////////////////////////////////////////////// Internal
+eng_PoolCache* eng_PoolGetCache(eng_Pool* pool)
+{
+	if (t_PoolThreadSlot == 0)
+	{
+		t_PoolThreadSlot = (uint32_t)eng_AtomicIncrement32(&s_PoolThreadCount);
+	}
+	return t_PoolThreadSlot <= ENG_POOL_MAX_THREADS && pool->Settings.ThreadCacheSize > 0 ? &pool->Caches[t_PoolThreadSlot - 1] : NULL;
+}
+
+uint8_t* eng_PoolIndexToObject(eng_Pool* pool, uint32_t index)
+{
+	uint8_t* slab = pool->Slabs[index / pool->ObjectsPerSlab];
+	return slab + CACHE_LINE_SIZE + (size_t)(index % pool->ObjectsPerSlab) * pool->Stride;
+}
+
+uint32_t eng_PoolObjectToIndex(eng_Pool* pool, void* obj)
+{
+	uint8_t* slab = (uint8_t*)((uintptr_t)obj & ~(uintptr_t)(pool->SlabBytes - 1));
+	const eng_PoolSlabHeader* header = (const eng_PoolSlabHeader*)slab;
+	size_t offset = (size_t)((uint8_t*)obj - slab) - CACHE_LINE_SIZE;
+	return header->SlabIndex * pool->ObjectsPerSlab + (uint32_t)(offset / pool->Stride);
+}
+
+void eng_PoolGlobalPushChain(eng_Pool* pool, uint32_t first, uint32_t last)
+{
+	if (!pool->Settings.LockFree)
+	{
+		eng_AtomicLock(&pool->GlobalLock);
+	}
+
+	uint32_t* lastLink = (uint32_t*)eng_PoolIndexToObject(pool, last);
+	int64_t head = eng_AtomicLoad64(&pool->GlobalHead);
+	for (;;)
+	{
+		*lastLink = (uint32_t)head;
+		int64_t tag = (head >> 32) + 1;
+		int64_t exchange = (int64_t)((uint64_t)tag << 32 | first);
+		int64_t seen = eng_AtomicCompareExchange64(&pool->GlobalHead, exchange, head);
+		if (seen == head)
+		{
+			break;
+		}
+		head = seen;
+	}
+
+	if (!pool->Settings.LockFree)
+	{
+		eng_AtomicUnlock(&pool->GlobalLock);
+	}
+}
+
+uint32_t eng_PoolGlobalPop(eng_Pool* pool)
+{
+	if (!pool->Settings.LockFree)
+	{
+		eng_AtomicLock(&pool->GlobalLock);
+	}
+
+	uint32_t index;
+	int64_t head = eng_AtomicLoad64(&pool->GlobalHead);
+	for (;;)
+	{
+		index = (uint32_t)head;
+		if (index == INVALID_INDEX)
+		{
+			break;
+		}
+		// The object may be popped and reused under us, making next junk;
+		// the tag then no longer matches and the exchange fails.
+		uint32_t next = *(volatile uint32_t*)eng_PoolIndexToObject(pool, index);
+		int64_t tag = (head >> 32) + 1;
+		int64_t exchange = (int64_t)((uint64_t)tag << 32 | next);
+		int64_t seen = eng_AtomicCompareExchange64(&pool->GlobalHead, exchange, head);
+		if (seen == head)
+		{
+			break;
+		}
+		head = seen;
+	}
+
+	if (!pool->Settings.LockFree)
+	{
+		eng_AtomicUnlock(&pool->GlobalLock);
+	}
+	return index;
+}
+
+bool eng_PoolGrow(eng_Pool* pool)
+{
+	eng_AtomicLock(&pool->GrowLock);
+
+	// Another thread may have grown the pool while this one waited.
+	bool grown = (uint32_t)eng_AtomicLoad64(&pool->GlobalHead) != INVALID_INDEX;
+	uint32_t slabIndex = (uint32_t)pool->SlabCount;
+	if (!grown && eng_Ensure(slabIndex < pool->Settings.MaxSlabs, "Pool is out of slabs (%u of %zu byte objects).\n", slabIndex * pool->ObjectsPerSlab, pool->Stride))
+	{
+		uint8_t* slab = eng_AllocatorAlloc(pool->Allocator, pool->SlabBytes, pool->SlabBytes);
+		if (slab != NULL)
+		{
+			((eng_PoolSlabHeader*)slab)->SlabIndex = slabIndex;
+			pool->Slabs[slabIndex] = slab;
+			eng_AtomicIncrement32(&pool->SlabCount);
+
+			uint32_t first = slabIndex * pool->ObjectsPerSlab;
+			uint32_t last = first + pool->ObjectsPerSlab - 1;
+			for (uint32_t i = first; i < last; ++i)
+			{
+				uint8_t* obj = eng_PoolIndexToObject(pool, i);
+#if !defined(GAME_FINAL)
+				eng_PoolPoison(pool, obj, POISON_FREE);
+#endif
+				*(uint32_t*)obj = i + 1;
+			}
+#if !defined(GAME_FINAL)
+			eng_PoolPoison(pool, eng_PoolIndexToObject(pool, last), POISON_FREE);
+#endif
+			eng_PoolGlobalPushChain(pool, first, last);
+			grown = true;
+		}
+	}
+
+	eng_AtomicUnlock(&pool->GrowLock);
+	return grown;
+}
+
+void eng_PoolCachePush(eng_PoolCache* cache, void* obj)
+{
+	*(void**)obj = cache->Head;
+	cache->Head = obj;
+	++cache->Count;
+}
+
+void* eng_PoolCachePop(eng_PoolCache* cache)
+{
+	void* obj = cache->Head;
+	if (obj != NULL)
+	{
+		cache->Head = *(void**)obj;
+		--cache->Count;
+	}
+	return obj;
+}
+
+void eng_PoolCacheDrain(eng_Pool* pool, eng_PoolCache* cache, uint32_t count)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	// Relink the objects by index so they go onto the global list in one exchange.
+	uint32_t first = eng_PoolObjectToIndex(pool, eng_PoolCachePop(cache));
+	uint32_t last = first;
+	for (uint32_t i = 1; i < count; ++i)
+	{
+		uint32_t index = eng_PoolObjectToIndex(pool, eng_PoolCachePop(cache));
+		*(uint32_t*)eng_PoolIndexToObject(pool, last) = index;
+		last = index;
+	}
+	eng_PoolGlobalPushChain(pool, first, last);
+}
+
+void eng_PoolPoison(eng_Pool* pool, void* obj, uint8_t value)
+{
+	// The first pointer's worth holds free list links.
+	memset((uint8_t*)obj + sizeof(void*), value, pool->Stride - sizeof(void*));
+}
+
+void eng_PoolCheckPoison(eng_Pool* pool, void* obj)
+{
+	const uint8_t* bytes = (const uint8_t*)obj;
+	for (size_t i = sizeof(void*); i < pool->Stride; ++i)
+	{
+		if (bytes[i] != POISON_FREE)
+		{
+			eng_Err("Pool object %p was written to after it was released.\n", obj);
+			return;
+		}
+	}
+}
+
+void* eng_PoolInterfaceAlloc(void* userData, size_t size, size_t alignment)
+{
+	eng_Pool* pool = userData;
+	if (!eng_Ensure(size <= pool->Stride, "Pool of %zu byte objects can't allocate %zu bytes.\n", pool->Stride, size))
+	{
+		return NULL;
+	}
+	return eng_PoolAlloc(pool);
+}
+
+void* eng_PoolInterfaceRealloc(void* userData, void* ptr, size_t oldSize, size_t newSize, size_t alignment)
+{
+	eng_Pool* pool = userData;
+	return newSize <= pool->Stride ? ptr : NULL;
+}
+
+void eng_PoolInterfaceFree(void* userData, void* ptr, size_t size)
+{
+	eng_PoolRelease(userData, ptr);
+}
\ No newline at end of file
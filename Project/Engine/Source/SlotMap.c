@@ -0,0 +1,113 @@
+#include <Engine/SlotMap.h>
+
+typedef struct eng_Slot
+{
+	// Index into Dense while in use, the next free slot while not.
+	uint32_t Index;
+	uint32_t Generation;
+} eng_Slot;
+
+eng_SlotHandle eng_SlotMakeHandle(uint32_t slot, uint32_t generation);
+// @returns the slot handle refers to, or NULL if it doesn't resolve.
+eng_Slot* eng_SlotMapResolve(eng_SlotMap* map, eng_SlotHandle handle);
+
+void eng_SlotMapInit(eng_SlotMap* map, uint32_t typeSize, const eng_Allocator* allocator)
+{
+	eng_ArrayInitAllocator(&map->Dense, typeSize, allocator);
+	eng_ArrayInitAllocatorType(&map->DenseToSlot, uint32_t, allocator);
+	eng_ArrayInitAllocatorType(&map->Slots, eng_Slot, allocator);
+	map->FreeSlot = UINT32_MAX;
+}
+
+void eng_SlotMapDestroy(eng_SlotMap* map)
+{
+	eng_ArrayDestroy(&map->Dense);
+	eng_ArrayDestroy(&map->DenseToSlot);
+	eng_ArrayDestroy(&map->Slots);
+}
+
+eng_SlotHandle eng_SlotMapInsert(eng_SlotMap* map, void* object)
+{
+	uint32_t slotIndex = map->FreeSlot;
+	eng_Slot* slot;
+	if (slotIndex != UINT32_MAX)
+	{
+		slot = eng_ArrayPIndexType(&map->Slots, eng_Slot, slotIndex);
+		map->FreeSlot = slot->Index;
+	}
+	else
+	{
+		eng_Slot newSlot = { .Index = 0, .Generation = 1 };
+		slotIndex = eng_ArrayPushBack(&map->Slots, &newSlot);
+		slot = eng_ArrayPIndexType(&map->Slots, eng_Slot, slotIndex);
+	}
+
+	slot->Index = eng_ArrayPushBack(&map->Dense, object);
+	eng_ArrayPushBack(&map->DenseToSlot, &slotIndex);
+	return eng_SlotMakeHandle(slotIndex, slot->Generation);
+}
+
+bool eng_SlotMapRemove(eng_SlotMap* map, eng_SlotHandle handle)
+{
+	eng_Slot* slot = eng_SlotMapResolve(map, handle);
+	if (slot == NULL)
+	{
+		return false;
+	}
+
+	// The last element fills the hole, so its slot has to follow it.
+	uint32_t index = slot->Index;
+	uint32_t last = map->Dense.Count - 1;
+	if (index != last)
+	{
+		uint32_t movedSlot = eng_ArrayIndexType(&map->DenseToSlot, uint32_t, last);
+		eng_ArrayPIndexType(&map->Slots, eng_Slot, movedSlot)->Index = index;
+	}
+	eng_ArrayRemoveLastSwap(&map->Dense, index);
+	eng_ArrayRemoveLastSwap(&map->DenseToSlot, index);
+
+	// Skip 0 on wrap around so the invalid handle never resolves.
+	slot->Generation = slot->Generation == UINT32_MAX ? 1 : slot->Generation + 1;
+	slot->Index = map->FreeSlot;
+	map->FreeSlot = (uint32_t)handle;
+	return true;
+}
+
+void* eng_SlotMapGet(eng_SlotMap* map, eng_SlotHandle handle)
+{
+	eng_Slot* slot = eng_SlotMapResolve(map, handle);
+	return slot != NULL ? eng_ArrayIndex(&map->Dense, slot->Index) : NULL;
+}
+
+bool eng_SlotMapContains(eng_SlotMap* map, eng_SlotHandle handle)
+{
+	return eng_SlotMapResolve(map, handle) != NULL;
+}
+
+uint32_t eng_SlotMapCount(eng_SlotMap* map)
+{
+	return map->Dense.Count;
+}
+
+eng_SlotHandle eng_SlotMapGetHandle(eng_SlotMap* map, uint32_t index)
+{
+	uint32_t slotIndex = eng_ArrayIndexType(&map->DenseToSlot, uint32_t, index);
+	return eng_SlotMakeHandle(slotIndex, eng_ArrayPIndexType(&map->Slots, eng_Slot, slotIndex)->Generation);
+}
+
+////////////////////////////////////////////////////////////////////////// Internal
+eng_SlotHandle eng_SlotMakeHandle(uint32_t slot, uint32_t generation)
+{
+	return ((eng_SlotHandle)generation << 32) | slot;
+}
+
+eng_Slot* eng_SlotMapResolve(eng_SlotMap* map, eng_SlotHandle handle)
+{
+	uint32_t slotIndex = (uint32_t)handle;
+	if (slotIndex >= map->Slots.Count)
+	{
+		return NULL;
+	}
+	eng_Slot* slot = eng_ArrayPIndexType(&map->Slots, eng_Slot, slotIndex);
+	return slot->Generation == (uint32_t)(handle >> 32) ? slot : NULL;
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+#include <Engine/SoaArray.h>
+
+#include <Engine/Log.h>
+
+#include <string.h>
+
+#define INITIAL_SOA_CAPACITY ENG_SOA_CAPACITY_GRANULE
+
+// @returns the bytes a column of capacity elements of size takes, padded to the next column.
+size_t eng_SoaColumnBytes(uint32_t size, uint32_t capacity);
+// @returns the bytes all columns take at capacity.
+size_t eng_SoaArrayGetAllocationSize(eng_SoaArray* array, uint32_t capacity);
+// Moves every column into one allocation holding capacity rows.
+void eng_SoaArrayReallocate(eng_SoaArray* array, uint32_t capacity);
+
+void eng_SoaArrayInit(eng_SoaArray* array, const uint32_t* columnSizes, uint32_t columnCount, const eng_Allocator* allocator)
+{
+	memset(array, 0, sizeof(eng_SoaArray));
+#if !defined(GAME_FINAL)
+	if (columnCount == 0 || columnCount > ENG_SOA_MAX_COLUMNS)
+	{
+		eng_DevFatal("A structure of arrays needs between 1 and %d columns, not %u.\n", ENG_SOA_MAX_COLUMNS, columnCount);
+		return;
+	}
+#endif
+	array->Allocator = allocator;
+	array->ColumnCount = columnCount;
+	memcpy(array->ColumnSizes, columnSizes, columnCount * sizeof(uint32_t));
+	eng_SoaArrayReallocate(array, INITIAL_SOA_CAPACITY);
+}
+
+void eng_SoaArrayDestroy(eng_SoaArray* array)
+{
+	if (array->Columns[0] != NULL)
+	{
+		eng_AllocatorFree(array->Allocator, array->Columns[0], eng_SoaArrayGetAllocationSize(array, array->Capacity));
+	}
+}
+
+void eng_SoaArrayReserve(eng_SoaArray* array, uint32_t rowsToReserve)
+{
+	if (rowsToReserve > array->Capacity)
+	{
+		eng_SoaArrayReallocate(array, rowsToReserve);
+	}
+}
+
+void eng_SoaArrayResize(eng_SoaArray* array, uint32_t newRowCount)
+{
+	if (newRowCount > array->Capacity)
+	{
+		uint32_t capacity = array->Capacity * 2;
+		eng_SoaArrayReallocate(array, capacity > newRowCount ? capacity : newRowCount);
+	}
+	array->Count = newRowCount;
+}
+
+void* eng_SoaArrayColumn(eng_SoaArray* array, uint32_t column)
+{
+#if !defined(GAME_FINAL)
+	if (column >= array->ColumnCount)
+	{
+		eng_DevFatal("Column %u out of bounds of %u.\n", column, array->ColumnCount);
+	}
+#endif
+	return array->Columns[column];
+}
+
+void* eng_SoaArrayIndex(eng_SoaArray* array, uint32_t column, uint32_t row)
+{
+#if !defined(GAME_FINAL)
+	if (row >= array->Count)
+	{
+		eng_DevFatal("Row %u out of bounds of %u.\n", row, array->Count);
+	}
+#endif
+	return (char*)eng_SoaArrayColumn(array, column) + (size_t)row * array->ColumnSizes[column];
+}
+
+uint32_t eng_SoaArrayPushBack(eng_SoaArray* array)
+{
+	eng_SoaArrayResize(array, array->Count + 1);
+	return array->Count - 1;
+}
+
+void eng_SoaArrayRemoveLastSwap(eng_SoaArray* array, uint32_t row)
+{
+#if !defined(GAME_FINAL)
+	if (row >= array->Count)
+	{
+		eng_DevFatal("Trying to remove row %u of %u.\n", row, array->Count);
+		return;
+	}
+#endif
+	uint32_t last = --array->Count;
+	if (row == last)
+	{
+		return;
+	}
+	for (uint32_t i = 0; i < array->ColumnCount; ++i)
+	{
+		char* column = array->Columns[i];
+		size_t size = array->ColumnSizes[i];
+		memcpy(column + row * size, column + last * size, size);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////// Internal
+size_t eng_SoaColumnBytes(uint32_t size, uint32_t capacity)
+{
+	return ((size_t)size * capacity + ENG_SOA_COLUMN_ALIGNMENT - 1) & ~(size_t)(ENG_SOA_COLUMN_ALIGNMENT - 1);
+}
+
+size_t eng_SoaArrayGetAllocationSize(eng_SoaArray* array, uint32_t capacity)
+{
+	size_t bytes = 0;
+	for (uint32_t i = 0; i < array->ColumnCount; ++i)
+	{
+		bytes += eng_SoaColumnBytes(array->ColumnSizes[i], capacity);
+	}
+	return bytes;
+}
+
+void eng_SoaArrayReallocate(eng_SoaArray* array, uint32_t capacity)
+{
+	capacity = (capacity + ENG_SOA_CAPACITY_GRANULE - 1) & ~(uint32_t)(ENG_SOA_CAPACITY_GRANULE - 1);
+	char* old = array->Columns[0];
+	size_t oldSize = eng_SoaArrayGetAllocationSize(array, array->Capacity);
+	char* buffer = eng_AllocatorAlloc(array->Allocator, eng_SoaArrayGetAllocationSize(array, capacity), ENG_SOA_COLUMN_ALIGNMENT);
+	// Every column's offset changes with capacity, so they're copied one by one.
+	char* column = buffer;
+	for (uint32_t i = 0; i < array->ColumnCount; ++i)
+	{
+		if (old != NULL)
+		{
+			memcpy(column, array->Columns[i], (size_t)array->Count * array->ColumnSizes[i]);
+		}
+		array->Columns[i] = column;
+		column += eng_SoaColumnBytes(array->ColumnSizes[i], capacity);
+	}
+	if (old != NULL)
+	{
+		eng_AllocatorFree(array->Allocator, old, oldSize);
+	}
+	array->Capacity = capacity;
+}
\ No newline at end of file
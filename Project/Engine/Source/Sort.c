@@ -0,0 +1,363 @@
+#include <Engine/Sort.h>
+
+#include <Engine/Allocator.h>
+#include <Engine/Jobs.h>
+#include <Engine/Log.h>
+
+#include <string.h>
+
+// Runs this short are insertion sorted before merging.
+#define INSERTION_RUN 32
+// Each parallel chunk gets at least this many elements.
+#define MIN_PARALLEL_CHUNK 8192
+#define MAX_SORT_CHUNKS 64
+
+typedef struct eng_SortJob
+{
+	// Sorting: Data[First, End) using the same range of Scratch.
+	// Merging: Data[First, Middle) and Data[Middle, End) into Scratch.
+	char* Data;
+	char* Scratch;
+	uint32_t First;
+	uint32_t Middle;
+	uint32_t End;
+	size_t TypeSize;
+	eng_CompareFunc_t Compare;
+	void* UserData;
+} eng_SortJob;
+
+uint32_t eng_SortKeyGetSize(eng_SortKey keyType);
+// @returns the key in element as an unsigned integer that orders the same way.
+uint64_t eng_SortKeyGetBits(const char* element, eng_SortKey keyType, uint32_t keyOffset);
+void eng_SortSwap(char* a, char* b, size_t size);
+// Merges from[first, middle) and from[middle, end) into to[first, end).
+void eng_SortMerge(const char* from, char* to, uint32_t first, uint32_t middle, uint32_t end, size_t typeSize, eng_CompareFunc_t compare, void* userData);
+// eng_JobFunc_t sorting one eng_SortJob range in place.
+void eng_SortRangeJob(void* userData);
+// eng_JobFunc_t merging one eng_SortJob pair of ranges.
+void eng_SortMergeJob(void* userData);
+// @returns the index of the first element whose key orders after key if upper, or not before it otherwise.
+uint32_t eng_SortBoundKey(eng_Array* array, eng_SortKey keyType, uint32_t keyOffset, const void* key, bool upper);
+
+////////////////////////////////////////////////////////////////////////// Sort API
+void eng_ArrayRadixSort(eng_Array* array, eng_SortKey keyType, uint32_t keyOffset)
+{
+	uint32_t count = array->Count;
+	if (count < 2)
+	{
+		return;
+	}
+
+	// Every pass's histogram in one read over the keys.
+	uint32_t keySize = eng_SortKeyGetSize(keyType);
+	uint32_t histograms[8][256];
+	memset(histograms, 0, sizeof(histograms));
+	size_t typeSize = array->TypeSize;
+	char* from = array->Buffer;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		uint64_t bits = eng_SortKeyGetBits(from + i * typeSize, keyType, keyOffset);
+		for (uint32_t digit = 0; digit < keySize; ++digit)
+		{
+			++histograms[digit][(bits >> (digit * 8)) & 0xFF];
+		}
+	}
+
+	char* scratch = eng_AllocatorAlloc(array->Allocator, count * typeSize, ENG_ALLOCATOR_DEFAULT_ALIGNMENT);
+	char* to = scratch;
+	uint64_t firstBits = eng_SortKeyGetBits(from, keyType, keyOffset);
+	for (uint32_t digit = 0; digit < keySize; ++digit)
+	{
+		uint32_t shift = digit * 8;
+		uint32_t* histogram = histograms[digit];
+		if (histogram[(firstBits >> shift) & 0xFF] == count)
+		{
+			continue;
+		}
+
+		uint32_t offset = 0;
+		for (uint32_t bucket = 0; bucket < 256; ++bucket)
+		{
+			uint32_t bucketCount = histogram[bucket];
+			histogram[bucket] = offset;
+			offset += bucketCount;
+		}
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			const char* element = from + i * typeSize;
+			uint32_t bucket = (uint32_t)(eng_SortKeyGetBits(element, keyType, keyOffset) >> shift) & 0xFF;
+			memcpy(to + histogram[bucket]++ * typeSize, element, typeSize);
+		}
+
+		char* swap = from;
+		from = to;
+		to = swap;
+	}
+
+	if (from != array->Buffer)
+	{
+		memcpy(array->Buffer, from, count * typeSize);
+	}
+	eng_AllocatorFree(array->Allocator, scratch, count * typeSize);
+}
+
+void eng_ArraySort(eng_Array* array, eng_CompareFunc_t compare, void* userData, eng_JobPool* jobs)
+{
+	uint32_t count = array->Count;
+	if (count < 2)
+	{
+		return;
+	}
+
+	// A power of two chunks, a couple per thread, so every merge level pairs up evenly.
+	uint32_t chunks = 1;
+	if (jobs != NULL)
+	{
+		uint32_t target = (eng_JobPoolGetWorkerCount(jobs) + 1) * 2;
+		while (chunks < target && chunks * 2 <= MAX_SORT_CHUNKS && count / (chunks * 2) >= MIN_PARALLEL_CHUNK)
+		{
+			chunks *= 2;
+		}
+	}
+
+	size_t typeSize = array->TypeSize;
+	char* scratch = eng_AllocatorAlloc(array->Allocator, count * typeSize, ENG_ALLOCATOR_DEFAULT_ALIGNMENT);
+	eng_SortJob sortJobs[MAX_SORT_CHUNKS];
+	eng_JobCounter counter = { 0 };
+	for (uint32_t i = 0; i < chunks; ++i)
+	{
+		eng_SortJob job = {
+			.Data = array->Buffer,
+			.Scratch = scratch,
+			.First = (uint32_t)((uint64_t)count * i / chunks),
+			.End = (uint32_t)((uint64_t)count * (i + 1) / chunks),
+			.TypeSize = typeSize,
+			.Compare = compare,
+			.UserData = userData,
+		};
+		sortJobs[i] = job;
+		if (chunks > 1)
+		{
+			eng_JobPoolPush(jobs, eng_SortRangeJob, &sortJobs[i], &counter);
+		}
+		else
+		{
+			eng_SortRangeJob(&sortJobs[i]);
+		}
+	}
+	if (chunks > 1)
+	{
+		eng_JobPoolWait(jobs, &counter);
+	}
+
+	// Merge neighbouring chunks level by level, back and forth between the buffers.
+	char* from = array->Buffer;
+	char* to = scratch;
+	for (uint32_t width = 1; width < chunks; width *= 2)
+	{
+		for (uint32_t i = 0; i < chunks; i += width * 2)
+		{
+			eng_SortJob* job = &sortJobs[i / (width * 2)];
+			job->Data = from;
+			job->Scratch = to;
+			job->First = (uint32_t)((uint64_t)count * i / chunks);
+			job->Middle = (uint32_t)((uint64_t)count * (i + width) / chunks);
+			job->End = (uint32_t)((uint64_t)count * (i + width * 2) / chunks);
+			eng_JobPoolPush(jobs, eng_SortMergeJob, job, &counter);
+		}
+		eng_JobPoolWait(jobs, &counter);
+		char* swap = from;
+		from = to;
+		to = swap;
+	}
+
+	if (from != array->Buffer)
+	{
+		memcpy(array->Buffer, from, count * typeSize);
+	}
+	eng_AllocatorFree(array->Allocator, scratch, count * typeSize);
+}
+
+uint32_t eng_ArrayLowerBound(eng_Array* array, const void* key, eng_CompareFunc_t compare, void* userData)
+{
+	if (array->Count == 0)
+	{
+		return 0;
+	}
+	size_t typeSize = array->TypeSize;
+	const char* base = array->Buffer;
+	uint32_t length = array->Count;
+	// Halves the range with a conditional move rather than a branch.
+	while (length > 1)
+	{
+		uint32_t half = length / 2;
+		base = compare(base + half * typeSize, key, userData) < 0 ? base + half * typeSize : base;
+		length -= half;
+	}
+	return (uint32_t)((base - (const char*)array->Buffer) / typeSize) + (compare(base, key, userData) < 0 ? 1 : 0);
+}
+
+uint32_t eng_ArrayUpperBound(eng_Array* array, const void* key, eng_CompareFunc_t compare, void* userData)
+{
+	if (array->Count == 0)
+	{
+		return 0;
+	}
+	size_t typeSize = array->TypeSize;
+	const char* base = array->Buffer;
+	uint32_t length = array->Count;
+	while (length > 1)
+	{
+		uint32_t half = length / 2;
+		base = compare(base + half * typeSize, key, userData) <= 0 ? base + half * typeSize : base;
+		length -= half;
+	}
+	return (uint32_t)((base - (const char*)array->Buffer) / typeSize) + (compare(base, key, userData) <= 0 ? 1 : 0);
+}
+
+uint32_t eng_ArrayLowerBoundKey(eng_Array* array, eng_SortKey keyType, uint32_t keyOffset, const void* key)
+{
+	return eng_SortBoundKey(array, keyType, keyOffset, key, false);
+}
+
+uint32_t eng_ArrayUpperBoundKey(eng_Array* array, eng_SortKey keyType, uint32_t keyOffset, const void* key)
+{
+	return eng_SortBoundKey(array, keyType, keyOffset, key, true);
+}
+
+////////////////////////////////////////////////////////////////////////// Internal
+uint32_t eng_SortKeyGetSize(eng_SortKey keyType)
+{
+	return keyType >= ENG_SORT_KEY_U64 ? 8 : 4;
+}
+
+uint64_t eng_SortKeyGetBits(const char* element, eng_SortKey keyType, uint32_t keyOffset)
+{
+	const char* key = element + keyOffset;
+	uint32_t bits32;
+	uint64_t bits64;
+	switch (keyType)
+	{
+	case ENG_SORT_KEY_U32:
+		memcpy(&bits32, key, sizeof(bits32));
+		return bits32;
+	case ENG_SORT_KEY_I32:
+		memcpy(&bits32, key, sizeof(bits32));
+		return bits32 ^ 0x80000000u;
+	case ENG_SORT_KEY_F32:
+		// Negative floats flip entirely so larger magnitudes order first.
+		memcpy(&bits32, key, sizeof(bits32));
+		return bits32 ^ ((uint32_t)-(int32_t)(bits32 >> 31) | 0x80000000u);
+	case ENG_SORT_KEY_U64:
+		memcpy(&bits64, key, sizeof(bits64));
+		return bits64;
+	case ENG_SORT_KEY_I64:
+		memcpy(&bits64, key, sizeof(bits64));
+		return bits64 ^ 0x8000000000000000ull;
+	case ENG_SORT_KEY_F64:
+		memcpy(&bits64, key, sizeof(bits64));
+		return bits64 ^ ((uint64_t)-(int64_t)(bits64 >> 63) | 0x8000000000000000ull);
+	default:
+		return 0;
+	}
+}
+
+void eng_SortSwap(char* a, char* b, size_t size)
+{
+	char temp[64];
+	while (size > 0)
+	{
+		size_t step = size < sizeof(temp) ? size : sizeof(temp);
+		memcpy(temp, a, step);
+		memcpy(a, b, step);
+		memcpy(b, temp, step);
+		a += step;
+		b += step;
+		size -= step;
+	}
+}
+
+void eng_SortMerge(const char* from, char* to, uint32_t first, uint32_t middle, uint32_t end, size_t typeSize, eng_CompareFunc_t compare, void* userData)
+{
+	uint32_t left = first;
+	uint32_t right = middle;
+	char* out = to + first * typeSize;
+	while (left < middle && right < end)
+	{
+		// Ties take from the left to stay stable.
+		const char* next = compare(from + right * typeSize, from + left * typeSize, userData) < 0 ? from + right++ * typeSize : from + left++ * typeSize;
+		memcpy(out, next, typeSize);
+		out += typeSize;
+	}
+	memcpy(out, from + left * typeSize, (middle - left) * typeSize);
+	out += (middle - left) * typeSize;
+	memcpy(out, from + right * typeSize, (end - right) * typeSize);
+}
+
+void eng_SortRangeJob(void* userData)
+{
+	eng_SortJob* job = userData;
+	size_t typeSize = job->TypeSize;
+
+	for (uint32_t run = job->First; run < job->End; run += INSERTION_RUN)
+	{
+		uint32_t runEnd = job->End - run < INSERTION_RUN ? job->End : run + INSERTION_RUN;
+		for (uint32_t i = run + 1; i < runEnd; ++i)
+		{
+			for (uint32_t j = i; j > run && job->Compare(job->Data + j * typeSize, job->Data + (j - 1) * typeSize, job->UserData) < 0; --j)
+			{
+				eng_SortSwap(job->Data + j * typeSize, job->Data + (j - 1) * typeSize, typeSize);
+			}
+		}
+	}
+
+	char* from = job->Data;
+	char* to = job->Scratch;
+	for (uint32_t width = INSERTION_RUN; width < job->End - job->First; width *= 2)
+	{
+		for (uint32_t first = job->First; first < job->End; first += width * 2)
+		{
+			uint32_t middle = job->End - first < width ? job->End : first + width;
+			uint32_t end = job->End - middle < width ? job->End : middle + width;
+			eng_SortMerge(from, to, first, middle, end, typeSize, job->Compare, job->UserData);
+		}
+		char* swap = from;
+		from = to;
+		to = swap;
+	}
+
+	if (from != job->Data)
+	{
+		memcpy(job->Data + job->First * typeSize, from + job->First * typeSize, (job->End - job->First) * typeSize);
+	}
+}
+
+void eng_SortMergeJob(void* userData)
+{
+	eng_SortJob* job = userData;
+	eng_SortMerge(job->Data, job->Scratch, job->First, job->Middle, job->End, job->TypeSize, job->Compare, job->UserData);
+}
+
+uint32_t eng_SortBoundKey(eng_Array* array, eng_SortKey keyType, uint32_t keyOffset, const void* key, bool upper)
+{
+	if (array->Count == 0)
+	{
+		return 0;
+	}
+	uint64_t keyBits = eng_SortKeyGetBits(key, keyType, 0);
+	size_t typeSize = array->TypeSize;
+	const char* base = array->Buffer;
+	uint32_t length = array->Count;
+	// Lower bound steps past keys below key, upper bound past keys up to it.
+	uint64_t limit = upper ? keyBits : keyBits - 1;
+	bool anyBelow = upper || keyBits != 0;
+	while (length > 1)
+	{
+		uint32_t half = length / 2;
+		bool before = anyBelow && eng_SortKeyGetBits(base + half * typeSize, keyType, keyOffset) <= limit;
+		base = before ? base + half * typeSize : base;
+		length -= half;
+	}
+	bool before = anyBelow && eng_SortKeyGetBits(base, keyType, keyOffset) <= limit;
+	return (uint32_t)((base - (const char*)array->Buffer) / typeSize) + (before ? 1 : 0);
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include <Engine/TextureLoader.h>
+
+#include <Engine/Allocator.h>
+#include <Engine/Atomic.h>
+#include <Engine/Graphics_VulkanTexture.h>
+#include <Engine/Image.h>
+#include <Engine/Jobs.h>
+#include <Engine/Log.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct eng_TextureLoadJob
+{
+	struct eng_TextureLoadJob* Next;
+	eng_TextureLoader* Loader;
+	eng_VulkanTexture* Texture;
+	eng_Image Image;
+	bool Decoded;
+	// Stored inline after the job.
+	char* Path;
+} eng_TextureLoadJob;
+
+typedef struct eng_TextureLoader
+{
+	eng_JobPool* Jobs;
+	eng_VulkanUploader* Uploader;
+	const eng_Allocator* Allocator;
+	eng_JobCounter InFlight;
+	uint32_t PendingCount;
+
+	// Workers push finished jobs here; the main thread takes the whole list
+	// at once, so a single compare-exchange push is all that's needed.
+	void* volatile Decoded;
+} eng_TextureLoader;
+
+void eng_TextureLoaderDecodeJob(void* userData);
+void eng_TextureLoadJobFree(eng_TextureLoader* loader, eng_TextureLoadJob* job);
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+eng_TextureLoader* eng_TextureLoaderMalloc(void)
+{
+	return malloc(sizeof(eng_TextureLoader));
+}
+
+bool eng_TextureLoaderInit(eng_TextureLoader* loader, eng_JobPool* jobs, eng_VulkanUploader* uploader, const eng_Allocator* allocator)
+{
+	memset(loader, 0, sizeof(eng_TextureLoader));
+	loader->Jobs = jobs;
+	loader->Uploader = uploader;
+	loader->Allocator = allocator;
+	return true;
+}
+
+void eng_TextureLoaderFree(eng_TextureLoader* loader, bool subAllocationsOnly)
+{
+	if (loader == NULL)
+	{
+		return;
+	}
+
+	eng_JobPoolWait(loader->Jobs, &loader->InFlight);
+
+	eng_TextureLoadJob* job = eng_AtomicExchangePtr(&loader->Decoded, NULL);
+	while (job != NULL)
+	{
+		eng_TextureLoadJob* next = job->Next;
+		eng_ImageDestroy(&job->Image);
+		eng_TextureLoadJobFree(loader, job);
+		job = next;
+	}
+
+	if (!subAllocationsOnly)
+	{
+		free(loader);
+	}
+}
+
+size_t eng_TextureLoaderGetSizeof(void)
+{
+	return sizeof(eng_TextureLoader);
+}
+
+////////////////////////////////////////////////////////////////////////// Texture Loader API
+bool eng_TextureLoaderLoad(eng_TextureLoader* loader, eng_VulkanTexture* texture, const char* path)
+{
+	size_t pathSize = strlen(path) + 1;
+	eng_TextureLoadJob* job = eng_AllocatorAlloc(loader->Allocator, sizeof(eng_TextureLoadJob) + pathSize, ENG_ALIGNOF(eng_TextureLoadJob));
+	if (job == NULL)
+	{
+		eng_Err("Failed to allocate a load job for texture \"%s\".\n", path);
+		return false;
+	}
+	memset(job, 0, sizeof(eng_TextureLoadJob));
+	job->Loader = loader;
+	job->Texture = texture;
+	job->Path = (char*)(job + 1);
+	memcpy(job->Path, path, pathSize);
+
+	++loader->PendingCount;
+	eng_JobPoolPush(loader->Jobs, eng_TextureLoaderDecodeJob, job, &loader->InFlight);
+	return true;
+}
+
+void eng_TextureLoaderUpdate(eng_TextureLoader* loader)
+{
+	eng_TextureLoadJob* job = eng_AtomicExchangePtr(&loader->Decoded, NULL);
+
+	// The list comes out newest first; flip it so uploads keep request order.
+	eng_TextureLoadJob* ordered = NULL;
+	while (job != NULL)
+	{
+		eng_TextureLoadJob* next = job->Next;
+		job->Next = ordered;
+		ordered = job;
+		job = next;
+	}
+
+	while (ordered != NULL)
+	{
+		eng_TextureLoadJob* next = ordered->Next;
+		if (ordered->Decoded)
+		{
+			eng_VulkanUploaderQueueImage(loader->Uploader, ordered->Texture, &ordered->Image);
+		}
+		eng_TextureLoadJobFree(loader, ordered);
+		--loader->PendingCount;
+		ordered = next;
+	}
+}
+
+uint32_t eng_TextureLoaderGetPendingCount(eng_TextureLoader* loader)
+{
+	return loader->PendingCount;
+}
+
+////////////////////////////////////////////////////////////////////////// Internal
+void eng_TextureLoaderDecodeJob(void* userData)
+{
+	eng_TextureLoadJob* job = (eng_TextureLoadJob*)userData;
+	eng_TextureLoader* loader = job->Loader;
+
+	job->Decoded = eng_ImageInitFromFile(&job->Image, job->Path, loader->Allocator);
+
+	void* head;
+	do
+	{
+		head = eng_AtomicLoadPtr(&loader->Decoded);
+		job->Next = head;
+	} while (eng_AtomicCompareExchangePtr(&loader->Decoded, job, head) != head);
+}
+
+void eng_TextureLoadJobFree(eng_TextureLoader* loader, eng_TextureLoadJob* job)
+{
+	eng_AllocatorFree(loader->Allocator, job, sizeof(eng_TextureLoadJob) + strlen(job->Path) + 1);
+}
\ No newline at end of file
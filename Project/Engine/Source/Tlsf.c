@@ -0,0 +1,485 @@
+#include <Engine/Tlsf.h>
+
+#include <Engine/Bits.h>
+#include <Engine/Log.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+// Block sizes are multiples of ALIGN_SIZE, which leaves the low bit of
+// eng_TlsfBlock::Size free to mark free blocks.
+#define ALIGN_SIZE_LOG2 4
+#define ALIGN_SIZE ((size_t)1 << ALIGN_SIZE_LOG2)
+#define FREE_BIT ((size_t)1)
+
+// Each first level (a power of two) is split into SL_COUNT linear steps.
+#define SL_COUNT_LOG2 5
+#define SL_COUNT (1u << SL_COUNT_LOG2)
+// Below SMALL_BLOCK_SIZE sizes go in first level 0, one ALIGN_SIZE apart.
+#define FL_SHIFT (SL_COUNT_LOG2 + ALIGN_SIZE_LOG2)
+#define SMALL_BLOCK_SIZE ((size_t)1 << FL_SHIFT)
+#if SIZE_MAX > 0xFFFFFFFFu
+#define FL_MAX 39
+#else
+#define FL_MAX 31
+#endif
+#define FL_COUNT (FL_MAX - FL_SHIFT + 1)
+#define MAX_BLOCK_SIZE ((size_t)1 << FL_MAX)
+
+// Header in front of every block. The payload starts BLOCK_OVERHEAD bytes
+// in, so payloads stay ALIGN_SIZE aligned on 32 bit too.
+typedef struct eng_TlsfBlock
+{
+	// The block physically before this one, NULL for the first.
+	struct eng_TlsfBlock* PrevPhys;
+	size_t Size;
+} eng_TlsfBlock;
+#define BLOCK_OVERHEAD ALIGN_SIZE
+
+// Free blocks keep their free list links in their payload.
+typedef struct eng_TlsfLinks
+{
+	eng_TlsfBlock* Next;
+	eng_TlsfBlock* Prev;
+} eng_TlsfLinks;
+#define MIN_BLOCK_SIZE ALIGN_SIZE
+
+typedef struct eng_Tlsf
+{
+	eng_Allocator Interface;
+	const eng_Allocator* Allocator;
+	// Owned when eng_TlsfInit was given no region.
+	void* OwnedRegion;
+	size_t RegionSize;
+	size_t Capacity;
+	size_t Used;
+
+	uint32_t FlBitmap;
+	uint32_t SlBitmaps[FL_COUNT];
+	eng_TlsfBlock* FreeLists[FL_COUNT][SL_COUNT];
+} eng_Tlsf;
+
+size_t eng_TlsfBlockSize(const eng_TlsfBlock* block);
+bool eng_TlsfBlockIsFree(const eng_TlsfBlock* block);
+uint8_t* eng_TlsfBlockPayload(eng_TlsfBlock* block);
+eng_TlsfBlock* eng_TlsfBlockFromPayload(void* ptr);
+eng_TlsfBlock* eng_TlsfBlockNext(eng_TlsfBlock* block);
+eng_TlsfLinks* eng_TlsfBlockLinks(eng_TlsfBlock* block);
+uint32_t eng_TlsfSizeLog2(size_t size);
+void eng_TlsfMapping(size_t size, uint32_t* outFl, uint32_t* outSl);
+void eng_TlsfInsert(eng_Tlsf* tlsf, eng_TlsfBlock* block);
+void eng_TlsfRemove(eng_Tlsf* tlsf, eng_TlsfBlock* block);
+// @returns a free block of at least size bytes taken off its free list, or NULL.
+eng_TlsfBlock* eng_TlsfFindFree(eng_Tlsf* tlsf, size_t size);
+// Trims block to size bytes, returning the rest to the free lists.
+void eng_TlsfSplit(eng_Tlsf* tlsf, eng_TlsfBlock* block, size_t size);
+// Absorbs next into block when it's free. @returns true if it was.
+bool eng_TlsfAbsorbNext(eng_Tlsf* tlsf, eng_TlsfBlock* block);
+// @returns the request rounded up to a block size, or 0 if it's too large.
+size_t eng_TlsfAdjustSize(size_t size);
+void* eng_TlsfInterfaceAlloc(void* userData, size_t size, size_t alignment);
+void* eng_TlsfInterfaceRealloc(void* userData, void* ptr, size_t oldSize, size_t newSize, size_t alignment);
+void eng_TlsfInterfaceFree(void* userData, void* ptr, size_t size);
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+eng_Tlsf* eng_TlsfMalloc(void)
+{
+	return malloc(sizeof(eng_Tlsf));
+}
+
+bool eng_TlsfInit(eng_Tlsf* tlsf, void* region, size_t regionSize, const eng_Allocator* allocator)
+{
+	memset(tlsf, 0, sizeof(eng_Tlsf));
+	tlsf->Interface.Alloc = eng_TlsfInterfaceAlloc;
+	tlsf->Interface.Realloc = eng_TlsfInterfaceRealloc;
+	tlsf->Interface.Free = eng_TlsfInterfaceFree;
+	tlsf->Interface.UserData = tlsf;
+	tlsf->Allocator = allocator;
+	tlsf->RegionSize = regionSize;
+
+	if (region == NULL)
+	{
+		region = eng_AllocatorAlloc(allocator, regionSize, ALIGN_SIZE);
+		tlsf->OwnedRegion = region;
+		if (region == NULL)
+		{
+			return false;
+		}
+	}
+
+	// The region ends with a zero sized used block, so every block has a
+	// physical successor and merging never runs off the end.
+	uintptr_t start = ((uintptr_t)region + ALIGN_SIZE - 1) & ~(uintptr_t)(ALIGN_SIZE - 1);
+	uintptr_t end = ((uintptr_t)region + regionSize) & ~(uintptr_t)(ALIGN_SIZE - 1);
+	if (!eng_Ensure(end > start && end - start >= 2 * BLOCK_OVERHEAD + MIN_BLOCK_SIZE, "TLSF region of %zu bytes is too small.\n", regionSize))
+	{
+		return false;
+	}
+	size_t size = (size_t)(end - start) - 2 * BLOCK_OVERHEAD;
+	if (size >= MAX_BLOCK_SIZE)
+	{
+		size = MAX_BLOCK_SIZE - ALIGN_SIZE;
+	}
+
+	eng_TlsfBlock* first = (eng_TlsfBlock*)start;
+	first->PrevPhys = NULL;
+	first->Size = size | FREE_BIT;
+	eng_TlsfBlock* sentinel = eng_TlsfBlockNext(first);
+	sentinel->PrevPhys = first;
+	sentinel->Size = 0;
+	eng_TlsfInsert(tlsf, first);
+	tlsf->Capacity = size;
+	return true;
+}
+
+void eng_TlsfFree(eng_Tlsf* tlsf, bool subAllocationsOnly)
+{
+	if (tlsf == NULL)
+	{
+		return;
+	}
+
+	eng_AllocatorFree(tlsf->Allocator, tlsf->OwnedRegion, tlsf->RegionSize);
+
+	if (!subAllocationsOnly)
+	{
+		free(tlsf);
+	}
+}
+
+size_t eng_TlsfGetSizeof(void)
+{
+	return sizeof(eng_Tlsf);
+}
+
+////////////////////////////////////////////////////////////////////////// Tlsf API
+void* eng_TlsfAlloc(eng_Tlsf* tlsf, size_t size, size_t alignment)
+{
+	if (!eng_Ensure(alignment != 0 && (alignment & (alignment - 1)) == 0, "TLSF alignment %zu isn't a power of two.\n", alignment))
+	{
+		return NULL;
+	}
+	size_t adjusted = eng_TlsfAdjustSize(size);
+	if (adjusted == 0)
+	{
+		return NULL;
+	}
+
+	if (alignment <= ALIGN_SIZE)
+	{
+		eng_TlsfBlock* block = eng_TlsfFindFree(tlsf, adjusted);
+		if (block == NULL)
+		{
+			return NULL;
+		}
+		eng_TlsfSplit(tlsf, block, adjusted);
+		block->Size &= ~FREE_BIT;
+		tlsf->Used += eng_TlsfBlockSize(block);
+		return eng_TlsfBlockPayload(block);
+	}
+
+	// Over-aligned requests look for enough room to cut a free block off
+	// the front that moves the payload onto the alignment.
+	const size_t minGap = BLOCK_OVERHEAD + MIN_BLOCK_SIZE;
+	if (adjusted > MAX_BLOCK_SIZE - alignment - minGap)
+	{
+		return NULL;
+	}
+	eng_TlsfBlock* block = eng_TlsfFindFree(tlsf, adjusted + alignment + minGap);
+	if (block == NULL)
+	{
+		return NULL;
+	}
+
+	uintptr_t payload = (uintptr_t)eng_TlsfBlockPayload(block);
+	uintptr_t aligned = (payload + alignment - 1) & ~(uintptr_t)(alignment - 1);
+	if (aligned != payload && aligned - payload < minGap)
+	{
+		aligned = (payload + minGap + alignment - 1) & ~(uintptr_t)(alignment - 1);
+	}
+	size_t gap = (size_t)(aligned - payload);
+	if (gap != 0)
+	{
+		eng_TlsfBlock* alignedBlock = (eng_TlsfBlock*)(aligned - BLOCK_OVERHEAD);
+		alignedBlock->PrevPhys = block;
+		alignedBlock->Size = (eng_TlsfBlockSize(block) - gap) | FREE_BIT;
+		eng_TlsfBlockNext(alignedBlock)->PrevPhys = alignedBlock;
+		// The block before a free block is never free, so the gap needs no merging.
+		block->Size = (gap - BLOCK_OVERHEAD) | FREE_BIT;
+		eng_TlsfInsert(tlsf, block);
+		block = alignedBlock;
+	}
+
+	eng_TlsfSplit(tlsf, block, adjusted);
+	block->Size &= ~FREE_BIT;
+	tlsf->Used += eng_TlsfBlockSize(block);
+	return eng_TlsfBlockPayload(block);
+}
+
+void* eng_TlsfRealloc(eng_Tlsf* tlsf, void* ptr, size_t size, size_t alignment)
+{
+	if (ptr == NULL)
+	{
+		return eng_TlsfAlloc(tlsf, size, alignment);
+	}
+	size_t adjusted = eng_TlsfAdjustSize(size);
+	if (adjusted == 0)
+	{
+		return NULL;
+	}
+
+	eng_TlsfBlock* block = eng_TlsfBlockFromPayload(ptr);
+	size_t current = eng_TlsfBlockSize(block);
+	// Resizing in place keeps ptr, so a stricter alignment has to move.
+	bool aligned = ((uintptr_t)ptr & (alignment - 1)) == 0;
+	bool fits = adjusted <= current;
+	if (aligned && !fits)
+	{
+		eng_TlsfBlock* next = eng_TlsfBlockNext(block);
+		fits = eng_TlsfBlockIsFree(next) && current + BLOCK_OVERHEAD + eng_TlsfBlockSize(next) >= adjusted;
+		if (fits)
+		{
+			eng_TlsfAbsorbNext(tlsf, block);
+		}
+	}
+	if (!aligned || !fits)
+	{
+		void* moved = eng_TlsfAlloc(tlsf, size, alignment);
+		if (moved != NULL)
+		{
+			memcpy(moved, ptr, current < size ? current : size);
+			eng_TlsfRelease(tlsf, ptr);
+		}
+		return moved;
+	}
+
+	eng_TlsfSplit(tlsf, block, adjusted);
+	tlsf->Used = tlsf->Used - current + eng_TlsfBlockSize(block);
+	return ptr;
+}
+
+void eng_TlsfRelease(eng_Tlsf* tlsf, void* ptr)
+{
+	if (ptr == NULL)
+	{
+		return;
+	}
+
+	eng_TlsfBlock* block = eng_TlsfBlockFromPayload(ptr);
+	if (!eng_Ensure(!eng_TlsfBlockIsFree(block), "TLSF block %p was released twice.\n", ptr))
+	{
+		return;
+	}
+	tlsf->Used -= eng_TlsfBlockSize(block);
+	block->Size |= FREE_BIT;
+
+	eng_TlsfBlock* prev = block->PrevPhys;
+	if (prev != NULL && eng_TlsfBlockIsFree(prev))
+	{
+		eng_TlsfRemove(tlsf, prev);
+		prev->Size += BLOCK_OVERHEAD + eng_TlsfBlockSize(block);
+		eng_TlsfBlockNext(prev)->PrevPhys = prev;
+		block = prev;
+	}
+	eng_TlsfAbsorbNext(tlsf, block);
+	eng_TlsfInsert(tlsf, block);
+}
+
+size_t eng_TlsfGetUsed(eng_Tlsf* tlsf)
+{
+	return tlsf->Used;
+}
+
+size_t eng_TlsfGetCapacity(eng_Tlsf* tlsf)
+{
+	return tlsf->Capacity;
+}
+
+const eng_Allocator* eng_TlsfGetAllocator(eng_Tlsf* tlsf)
+{
+	return &tlsf->Interface;
+}
+
+////////////////////////////////////////////////////////////////////////// Internal
+size_t eng_TlsfBlockSize(const eng_TlsfBlock* block)
+{
+	return block->Size & ~FREE_BIT;
+}
+
+bool eng_TlsfBlockIsFree(const eng_TlsfBlock* block)
+{
+	return (block->Size & FREE_BIT) != 0;
+}
+
+uint8_t* eng_TlsfBlockPayload(eng_TlsfBlock* block)
+{
+	return (uint8_t*)block + BLOCK_OVERHEAD;
+}
+
+eng_TlsfBlock* eng_TlsfBlockFromPayload(void* ptr)
+{
+	return (eng_TlsfBlock*)((uint8_t*)ptr - BLOCK_OVERHEAD);
+}
+
+eng_TlsfBlock* eng_TlsfBlockNext(eng_TlsfBlock* block)
+{
+	return (eng_TlsfBlock*)(eng_TlsfBlockPayload(block) + eng_TlsfBlockSize(block));
+}
+
+eng_TlsfLinks* eng_TlsfBlockLinks(eng_TlsfBlock* block)
+{
+	return (eng_TlsfLinks*)eng_TlsfBlockPayload(block);
+}
+
+uint32_t eng_TlsfSizeLog2(size_t size)
+{
+#if SIZE_MAX > 0xFFFFFFFFu
+	return eng_BitScanReverse64((uint64_t)size);
+#else
+	return eng_BitScanReverse32((uint32_t)size);
+#endif
+}
+
+void eng_TlsfMapping(size_t size, uint32_t* outFl, uint32_t* outSl)
+{
+	if (size < SMALL_BLOCK_SIZE)
+	{
+		*outFl = 0;
+		*outSl = (uint32_t)(size / (SMALL_BLOCK_SIZE / SL_COUNT));
+		return;
+	}
+	uint32_t fl = eng_TlsfSizeLog2(size);
+	*outSl = (uint32_t)(size >> (fl - SL_COUNT_LOG2)) ^ SL_COUNT;
+	*outFl = fl - (FL_SHIFT - 1);
+}
+
+void eng_TlsfInsert(eng_Tlsf* tlsf, eng_TlsfBlock* block)
+{
+	uint32_t fl, sl;
+	eng_TlsfMapping(eng_TlsfBlockSize(block), &fl, &sl);
+	eng_TlsfBlock* head = tlsf->FreeLists[fl][sl];
+	eng_TlsfLinks* links = eng_TlsfBlockLinks(block);
+	links->Next = head;
+	links->Prev = NULL;
+	if (head != NULL)
+	{
+		eng_TlsfBlockLinks(head)->Prev = block;
+	}
+	tlsf->FreeLists[fl][sl] = block;
+	tlsf->FlBitmap |= 1u << fl;
+	tlsf->SlBitmaps[fl] |= 1u << sl;
+}
+
+void eng_TlsfRemove(eng_Tlsf* tlsf, eng_TlsfBlock* block)
+{
+	uint32_t fl, sl;
+	eng_TlsfMapping(eng_TlsfBlockSize(block), &fl, &sl);
+	eng_TlsfLinks* links = eng_TlsfBlockLinks(block);
+	if (links->Next != NULL)
+	{
+		eng_TlsfBlockLinks(links->Next)->Prev = links->Prev;
+	}
+	if (links->Prev != NULL)
+	{
+		eng_TlsfBlockLinks(links->Prev)->Next = links->Next;
+	}
+	else
+	{
+		tlsf->FreeLists[fl][sl] = links->Next;
+		if (links->Next == NULL)
+		{
+			tlsf->SlBitmaps[fl] &= ~(1u << sl);
+			if (tlsf->SlBitmaps[fl] == 0)
+			{
+				tlsf->FlBitmap &= ~(1u << fl);
+			}
+		}
+	}
+}
+
+eng_TlsfBlock* eng_TlsfFindFree(eng_Tlsf* tlsf, size_t size)
+{
+	// Round up to the next size class so any block in it is large enough.
+	if (size >= SMALL_BLOCK_SIZE)
+	{
+		size += ((size_t)1 << (eng_TlsfSizeLog2(size) - SL_COUNT_LOG2)) - 1;
+	}
+	uint32_t fl, sl;
+	eng_TlsfMapping(size, &fl, &sl);
+	if (fl >= FL_COUNT)
+	{
+		return NULL;
+	}
+
+	uint32_t slMap = tlsf->SlBitmaps[fl] & (~0u << sl);
+	if (slMap == 0)
+	{
+		uint32_t flMap = fl + 1 < 32 ? tlsf->FlBitmap & (~0u << (fl + 1)) : 0;
+		if (flMap == 0)
+		{
+			return NULL;
+		}
+		fl = eng_BitScanForward32(flMap);
+		slMap = tlsf->SlBitmaps[fl];
+	}
+	sl = eng_BitScanForward32(slMap);
+
+	eng_TlsfBlock* block = tlsf->FreeLists[fl][sl];
+	eng_TlsfRemove(tlsf, block);
+	return block;
+}
+
+void eng_TlsfSplit(eng_Tlsf* tlsf, eng_TlsfBlock* block, size_t size)
+{
+	size_t total = eng_TlsfBlockSize(block);
+	if (total < size + BLOCK_OVERHEAD + MIN_BLOCK_SIZE)
+	{
+		return;
+	}
+
+	eng_TlsfBlock* rest = (eng_TlsfBlock*)(eng_TlsfBlockPayload(block) + size);
+	rest->PrevPhys = block;
+	rest->Size = (total - size - BLOCK_OVERHEAD) | FREE_BIT;
+	eng_TlsfBlockNext(rest)->PrevPhys = rest;
+	block->Size = size | (block->Size & FREE_BIT);
+	eng_TlsfAbsorbNext(tlsf, rest);
+	eng_TlsfInsert(tlsf, rest);
+}
+
+bool eng_TlsfAbsorbNext(eng_Tlsf* tlsf, eng_TlsfBlock* block)
+{
+	eng_TlsfBlock* next = eng_TlsfBlockNext(block);
+	if (!eng_TlsfBlockIsFree(next))
+	{
+		return false;
+	}
+	eng_TlsfRemove(tlsf, next);
+	block->Size += BLOCK_OVERHEAD + eng_TlsfBlockSize(next);
+	eng_TlsfBlockNext(block)->PrevPhys = block;
+	return true;
+}
+
+size_t eng_TlsfAdjustSize(size_t size)
+{
+	if (size >= MAX_BLOCK_SIZE)
+	{
+		return 0;
+	}
+	size_t adjusted = (size + ALIGN_SIZE - 1) & ~(ALIGN_SIZE - 1);
+	return adjusted < MIN_BLOCK_SIZE ? MIN_BLOCK_SIZE : adjusted;
+}
+
+void* eng_TlsfInterfaceAlloc(void* userData, size_t size, size_t alignment)
+{
+	return eng_TlsfAlloc(userData, size, alignment);
+}
+
+void* eng_TlsfInterfaceRealloc(void* userData, void* ptr, size_t oldSize, size_t newSize, size_t alignment)
+{
+	return eng_TlsfRealloc(userData, ptr, newSize, alignment);
+}
+
+void eng_TlsfInterfaceFree(void* userData, void* ptr, size_t size)
+{
+	eng_TlsfRelease(userData, ptr);
+}
\ No newline at end of file
@@ -0,0 +1,308 @@
+#include <Engine/TrackingAllocator.h>
+
+#include <Engine/Atomic.h>
+#include <Engine/Log.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+// Leaks past this many are only counted.
+#define MAX_REPORTED_LEAKS 64
+
+// Sits right in front of every allocation's memory.
+typedef struct eng_TrackingHeader
+{
+	struct eng_TrackingHeader* Prev;
+	struct eng_TrackingHeader* Next;
+	const char* File;
+	size_t Size;
+	// Bytes from the start of the backing allocation to the caller's memory,
+	// at least the alignment, so it doesn't fit a narrower type for slab sized
+	// alignments.
+	size_t Offset;
+	int32_t Line;
+	uint16_t Tag;
+} eng_TrackingHeader;
+
+typedef struct eng_TrackingTag
+{
+	eng_Allocator Interface;
+	struct eng_TrackingAllocator* Tracker;
+	eng_AllocationStats Stats;
+} eng_TrackingTag;
+
+typedef struct eng_TrackingAllocator
+{
+	const eng_Allocator* Backing;
+	// Guards everything below.
+	volatile int32_t Lock;
+	eng_TrackingTag Tags[ENG_TRACKING_MAX_TAGS];
+	uint32_t TagCount;
+	eng_AllocationStats Total;
+	// Every live allocation, newest first.
+	eng_TrackingHeader* Live;
+} eng_TrackingAllocator;
+
+size_t eng_TrackingGetOffset(size_t alignment);
+eng_TrackingHeader* eng_TrackingGetHeader(void* ptr);
+// Links header in and counts it against tag, as a new allocation unless it was
+// only resized. Takes the lock.
+void eng_TrackingAdd(eng_TrackingTag* tag, eng_TrackingHeader* header, bool resized);
+// Unlinks header and takes it off tag. Takes the lock.
+void eng_TrackingRemove(eng_TrackingTag* tag, eng_TrackingHeader* header);
+void* eng_TrackingInterfaceAlloc(void* userData, size_t size, size_t alignment);
+void* eng_TrackingInterfaceRealloc(void* userData, void* ptr, size_t oldSize, size_t newSize, size_t alignment);
+void eng_TrackingInterfaceFree(void* userData, void* ptr, size_t size);
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+eng_TrackingAllocator* eng_TrackingAllocatorMalloc(void)
+{
+	return malloc(sizeof(eng_TrackingAllocator));
+}
+
+bool eng_TrackingAllocatorInit(eng_TrackingAllocator* tracker, const eng_Allocator* backing)
+{
+	memset(tracker, 0, sizeof(eng_TrackingAllocator));
+	tracker->Backing = backing;
+	tracker->Total.Name = "Total";
+	return true;
+}
+
+void eng_TrackingAllocatorFree(eng_TrackingAllocator* tracker, bool subAllocationsOnly)
+{
+	if (tracker == NULL)
+	{
+		return;
+	}
+
+	if (!subAllocationsOnly)
+	{
+		free(tracker);
+	}
+}
+
+size_t eng_TrackingAllocatorGetSizeof(void)
+{
+	return sizeof(eng_TrackingAllocator);
+}
+
+////////////////////////////////////////////////////////////////////////// Tracking Allocator API
+const eng_Allocator* eng_TrackingAllocatorGetTag(eng_TrackingAllocator* tracker, const char* name)
+{
+	eng_AtomicLock(&tracker->Lock);
+	eng_TrackingTag* tag = NULL;
+	for (uint32_t i = 0; i < tracker->TagCount && tag == NULL; ++i)
+	{
+		if (strcmp(tracker->Tags[i].Stats.Name, name) == 0)
+		{
+			tag = &tracker->Tags[i];
+		}
+	}
+	if (tag == NULL && tracker->TagCount < ENG_TRACKING_MAX_TAGS)
+	{
+		tag = &tracker->Tags[tracker->TagCount++];
+		tag->Interface.Alloc = eng_TrackingInterfaceAlloc;
+		tag->Interface.Realloc = eng_TrackingInterfaceRealloc;
+		tag->Interface.Free = eng_TrackingInterfaceFree;
+		tag->Interface.UserData = tag;
+		tag->Tracker = tracker;
+		tag->Stats.Name = name;
+	}
+	else if (tag == NULL)
+	{
+		eng_Warn("Out of allocation tags; \"%s\" is counted as \"%s\".\n", name, tracker->Tags[ENG_TRACKING_MAX_TAGS - 1].Stats.Name);
+		tag = &tracker->Tags[ENG_TRACKING_MAX_TAGS - 1];
+	}
+	eng_AtomicUnlock(&tracker->Lock);
+	return &tag->Interface;
+}
+
+uint32_t eng_TrackingAllocatorGetTagCount(eng_TrackingAllocator* tracker)
+{
+	return tracker->TagCount;
+}
+
+eng_AllocationStats eng_TrackingAllocatorGetTagStats(eng_TrackingAllocator* tracker, uint32_t index)
+{
+	eng_AtomicLock(&tracker->Lock);
+	eng_AllocationStats stats = tracker->Tags[index].Stats;
+	eng_AtomicUnlock(&tracker->Lock);
+	return stats;
+}
+
+eng_AllocationStats eng_TrackingAllocatorGetTotal(eng_TrackingAllocator* tracker)
+{
+	eng_AtomicLock(&tracker->Lock);
+	eng_AllocationStats stats = tracker->Total;
+	eng_AtomicUnlock(&tracker->Lock);
+	return stats;
+}
+
+void eng_TrackingAllocatorReport(eng_TrackingAllocator* tracker)
+{
+	for (uint32_t i = 0; i <= tracker->TagCount; ++i)
+	{
+		eng_AllocationStats stats = i < tracker->TagCount ? eng_TrackingAllocatorGetTagStats(tracker, i) : eng_TrackingAllocatorGetTotal(tracker);
+		eng_Log("Memory %-16s %10zu bytes live in %6u allocations, %10zu peak, %8llu made.\n", stats.Name,
+			stats.LiveBytes, stats.LiveCount, stats.PeakBytes, (unsigned long long)stats.TotalCount);
+	}
+}
+
+uint32_t eng_TrackingAllocatorReportLeaks(eng_TrackingAllocator* tracker)
+{
+	eng_AtomicLock(&tracker->Lock);
+	uint32_t leaks = 0;
+	for (eng_TrackingHeader* header = tracker->Live; header != NULL; header = header->Next)
+	{
+		if (leaks < MAX_REPORTED_LEAKS)
+		{
+			eng_Err("Leaked %zu bytes (%s) allocated at %s(%d).\n", header->Size, tracker->Tags[header->Tag].Stats.Name,
+				header->File != NULL ? header->File : "unknown", header->Line);
+		}
+		++leaks;
+	}
+	if (leaks > 0)
+	{
+		eng_Err("%u allocations totalling %zu bytes were leaked.\n", leaks, tracker->Total.LiveBytes);
+	}
+	eng_AtomicUnlock(&tracker->Lock);
+	return leaks;
+}
+
+////////////////////////////////////////////////////////////////////////// Internal
+size_t eng_TrackingGetOffset(size_t alignment)
+{
+	if (alignment < ENG_ALIGNOF(eng_TrackingHeader))
+	{
+		alignment = ENG_ALIGNOF(eng_TrackingHeader);
+	}
+	return (sizeof(eng_TrackingHeader) + alignment - 1) & ~(alignment - 1);
+}
+
+eng_TrackingHeader* eng_TrackingGetHeader(void* ptr)
+{
+	return (eng_TrackingHeader*)((uint8_t*)ptr - sizeof(eng_TrackingHeader));
+}
+
+void eng_TrackingAdd(eng_TrackingTag* tag, eng_TrackingHeader* header, bool resized)
+{
+	eng_TrackingAllocator* tracker = tag->Tracker;
+	eng_AtomicLock(&tracker->Lock);
+	header->Prev = NULL;
+	header->Next = tracker->Live;
+	if (tracker->Live != NULL)
+	{
+		tracker->Live->Prev = header;
+	}
+	tracker->Live = header;
+
+	eng_AllocationStats* stats[2] = { &tag->Stats, &tracker->Total };
+	for (uint32_t i = 0; i < 2; ++i)
+	{
+		stats[i]->LiveBytes += header->Size;
+		stats[i]->PeakBytes = stats[i]->LiveBytes > stats[i]->PeakBytes ? stats[i]->LiveBytes : stats[i]->PeakBytes;
+		++stats[i]->LiveCount;
+		stats[i]->TotalCount += resized ? 0 : 1;
+	}
+	eng_AtomicUnlock(&tracker->Lock);
+}
+
+void eng_TrackingRemove(eng_TrackingTag* tag, eng_TrackingHeader* header)
+{
+	eng_TrackingAllocator* tracker = tag->Tracker;
+	eng_AtomicLock(&tracker->Lock);
+	if (header->Prev != NULL)
+	{
+		header->Prev->Next = header->Next;
+	}
+	else
+	{
+		tracker->Live = header->Next;
+	}
+	if (header->Next != NULL)
+	{
+		header->Next->Prev = header->Prev;
+	}
+
+	eng_AllocationStats* stats[2] = { &tag->Stats, &tracker->Total };
+	for (uint32_t i = 0; i < 2; ++i)
+	{
+		stats[i]->LiveBytes -= header->Size;
+		--stats[i]->LiveCount;
+	}
+	eng_AtomicUnlock(&tracker->Lock);
+}
+
+void* eng_TrackingInterfaceAlloc(void* userData, size_t size, size_t alignment)
+{
+	eng_TrackingTag* tag = userData;
+	const char* file;
+	int line;
+	eng_AllocatorGetCallsite(&file, &line);
+
+	size_t offset = eng_TrackingGetOffset(alignment);
+	size_t backingAlignment = alignment > ENG_ALIGNOF(eng_TrackingHeader) ? alignment : ENG_ALIGNOF(eng_TrackingHeader);
+	uint8_t* raw = eng_AllocatorAlloc(tag->Tracker->Backing, offset + size, backingAlignment);
+	if (raw == NULL)
+	{
+		return NULL;
+	}
+
+	uint8_t* ptr = raw + offset;
+	eng_TrackingHeader* header = eng_TrackingGetHeader(ptr);
+	header->File = file;
+	header->Line = line;
+	header->Size = size;
+	header->Tag = (uint16_t)(tag - tag->Tracker->Tags);
+	header->Offset = offset;
+	eng_TrackingAdd(tag, header, false);
+	return ptr;
+}
+
+void* eng_TrackingInterfaceRealloc(void* userData, void* ptr, size_t oldSize, size_t newSize, size_t alignment)
+{
+	eng_TrackingTag* tag = userData;
+	eng_TrackingHeader* header = eng_TrackingGetHeader(ptr);
+	size_t offset = header->Offset;
+	if (offset != eng_TrackingGetOffset(alignment))
+	{
+		// A different alignment needs a different header offset, so move by hand.
+		void* moved = eng_TrackingInterfaceAlloc(userData, newSize, alignment);
+		if (moved != NULL)
+		{
+			memcpy(moved, ptr, header->Size < newSize ? header->Size : newSize);
+			eng_TrackingInterfaceFree(userData, ptr, header->Size);
+		}
+		return moved;
+	}
+
+	const char* file;
+	int line;
+	eng_AllocatorGetCallsite(&file, &line);
+
+	// Unlinked while the backing allocator may move it, relinked either way.
+	eng_TrackingTag* owner = &tag->Tracker->Tags[header->Tag];
+	eng_TrackingRemove(owner, header);
+	size_t backingAlignment = alignment > ENG_ALIGNOF(eng_TrackingHeader) ? alignment : ENG_ALIGNOF(eng_TrackingHeader);
+	uint8_t* raw = eng_AllocatorRealloc(tag->Tracker->Backing, (uint8_t*)ptr - offset, offset + header->Size, offset + newSize, backingAlignment);
+	if (raw == NULL)
+	{
+		eng_TrackingAdd(owner, header, true);
+		return NULL;
+	}
+
+	header = eng_TrackingGetHeader(raw + offset);
+	header->File = file;
+	header->Line = line;
+	header->Size = newSize;
+	eng_TrackingAdd(owner, header, true);
+	return raw + offset;
+}
+
+void eng_TrackingInterfaceFree(void* userData, void* ptr, size_t size)
+{
+	eng_TrackingTag* tag = userData;
+	eng_TrackingHeader* header = eng_TrackingGetHeader(ptr);
+	eng_TrackingRemove(&tag->Tracker->Tags[header->Tag], header);
+	eng_AllocatorFree(tag->Tracker->Backing, (uint8_t*)ptr - header->Offset, header->Offset + header->Size);
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include <Engine/VirtualMemory.h>
+
+#if defined(GAME_WINDOWS)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Transparent huge pages on x64 Linux.
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+////////////////////////////////////////////////////////////////////////// Virtual Memory API
+#if defined(GAME_WINDOWS)
+
+size_t eng_VirtualGetPageSize(bool hugePages)
+{
+	(void)hugePages;
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return info.dwPageSize;
+}
+
+void* eng_VirtualReserve(size_t size, bool hugePages)
+{
+	(void)hugePages;
+	return VirtualAlloc(NULL, size, MEM_RESERVE, PAGE_NOACCESS);
+}
+
+bool eng_VirtualCommit(void* address, size_t size)
+{
+	return VirtualAlloc(address, size, MEM_COMMIT, PAGE_READWRITE) != NULL;
+}
+
+void eng_VirtualDecommit(void* address, size_t size)
+{
+	VirtualFree(address, size, MEM_DECOMMIT);
+}
+
+void eng_VirtualRelease(void* address, size_t size)
+{
+	(void)size;
+	VirtualFree(address, 0, MEM_RELEASE);
+}
+
+#else
+
+size_t eng_VirtualGetPageSize(bool hugePages)
+{
+#if defined(MADV_HUGEPAGE)
+	if (hugePages)
+	{
+		return HUGE_PAGE_SIZE;
+	}
+#endif
+	return (size_t)sysconf(_SC_PAGESIZE);
+}
+
+void* eng_VirtualReserve(size_t size, bool hugePages)
+{
+	size_t alignment = eng_VirtualGetPageSize(hugePages);
+	// Over-reserve so the range can start on a huge page boundary, then trim.
+	size_t reserved = size + (alignment > eng_VirtualGetPageSize(false) ? alignment : 0);
+	uint8_t* address = mmap(NULL, reserved, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	if (address == MAP_FAILED)
+	{
+		return NULL;
+	}
+
+	uint8_t* aligned = (uint8_t*)(((uintptr_t)address + alignment - 1) & ~(uintptr_t)(alignment - 1));
+	if (aligned != address)
+	{
+		munmap(address, aligned - address);
+	}
+	if (aligned + size != address + reserved)
+	{
+		munmap(aligned + size, (address + reserved) - (aligned + size));
+	}
+#if defined(MADV_HUGEPAGE)
+	if (hugePages)
+	{
+		madvise(aligned, size, MADV_HUGEPAGE);
+	}
+#endif
+	return aligned;
+}
+
+bool eng_VirtualCommit(void* address, size_t size)
+{
+	return mprotect(address, size, PROT_READ | PROT_WRITE) == 0;
+}
+
+void eng_VirtualDecommit(void* address, size_t size)
+{
+	madvise(address, size, MADV_DONTNEED);
+	mprotect(address, size, PROT_NONE);
+}
+
+void eng_VirtualRelease(void* address, size_t size)
+{
+	munmap(address, size);
+}
+
+#endif
\ No newline at end of file
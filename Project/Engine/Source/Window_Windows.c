@@ -3,6 +3,7 @@
 
 #include <Engine/Window.h>
 
+#include <Engine/Allocator.h>
 #include <Engine/Array.h>
 #include <Engine/Graphics_Vulkan.h>
 #include <Engine/Log.h>
@@ -31,8 +32,10 @@ typedef struct eng_Window
 	uint16_t Width, Height;
 	char* Title;
 
+	const eng_Allocator* Allocator;
+
 	// callbacks
-	eng_ArrayDecl(OnClose, struct eng_WindowCallback);
+	eng_ArrayDeclInline(OnClose, struct eng_WindowCallback, 2);
 } eng_Window;
 
 bool g_VulkanSupport = false;
@@ -90,7 +93,10 @@ void eng_WindowFree(eng_Window* window, bool subAllocationsOnly)
 		return;
 	}
 
-	free(window->Title);
+	if (window->Title != NULL)
+	{
+		eng_AllocatorFreeType(window->Allocator, window->Title, char, strlen(window->Title) + 1);
+	}
 	
 	eng_ArrayDestroy(&window->OnClose);
 
@@ -100,15 +106,16 @@ void eng_WindowFree(eng_Window* window, bool subAllocationsOnly)
 	}
 }
 
-bool eng_WindowInit(eng_Window* window, uint16_t width, uint16_t height, const char* title)
+bool eng_WindowInit(eng_Window* window, uint16_t width, uint16_t height, const char* title, const eng_Allocator* allocator)
 {
 	if (!eng_WindowSetupValidate(window, width, height, title))
 	{
 		return false;
 	}
 	memset(window, 0, sizeof(eng_Window));
+	window->Allocator = allocator;
 
-	eng_ArrayInitType(&window->OnClose, eng_WindowCallback);
+	eng_ArrayInitInlineType(&window->OnClose, eng_WindowCallback, window->OnCloseInline, allocator);
 
 	// hint to GLFW not to create opengl/opengles contexts.
 	if (g_VulkanSupport) {
@@ -165,8 +172,11 @@ uint16_t eng_WindowGetHeight(eng_Window* window)
 
 void eng_WindowSetTitle(eng_Window* window, const char* title)
 {
-	free(window->Title);
-	window->Title = malloc(strlen(title) + 1);
+	if (window->Title != NULL)
+	{
+		eng_AllocatorFreeType(window->Allocator, window->Title, char, strlen(window->Title) + 1);
+	}
+	window->Title = eng_AllocatorAllocType(window->Allocator, char, strlen(title) + 1);
 	strcpy(window->Title, title);
 }
 
@@ -256,10 +266,8 @@ bool eng_WindowSetupValidate(eng_Window* window, uint16_t width, uint16_t height
 
 void eng_WindowCallbackListBind(eng_Array* callbackList, eng_WindowCallback_t func, void* UserData)
 {
-	eng_ArrayResize(callbackList, callbackList->Count + 1);
-	eng_WindowCallback* callback = eng_ArrayPIndexType(callbackList, eng_WindowCallback, callbackList->Count-1);
-	callback->Func = func;
-	callback->UserData = UserData;
+	eng_WindowCallback callback = { .Func = func, .UserData = UserData };
+	eng_ArrayPushBack(callbackList, &callback);
 }
 
 // TODO: handle callbacks that might be in the list twice.
@@ -0,0 +1,81 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct eng_Allocator eng_Allocator;
+typedef struct eng_JobPool eng_JobPool;
+typedef struct eng_TextureLoader eng_TextureLoader;
+typedef struct eng_VulkanTexture eng_VulkanTexture;
+typedef struct eng_VulkanUploader eng_VulkanUploader;
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+/**
+* Texture Loader Malloc
+*
+* @note The loader is not ready for use until eng_TextureLoaderInit is
+* called.
+* @return A newly allocated texture loader.
+*/
+eng_TextureLoader* eng_TextureLoaderMalloc(void);
+
+/**
+* Texture Loader Init
+*
+* @description Image files are read and decoded on jobs, then handed to
+* uploader. Both jobs and uploader must outlive the loader. Requests and
+* decoded pixels come from allocator (NULL for the heap), which must be
+* thread safe since decoding allocates on the workers.
+* @return true if initialization was successful.
+*/
+bool eng_TextureLoaderInit(eng_TextureLoader* loader, eng_JobPool* jobs, eng_VulkanUploader* uploader, const eng_Allocator* allocator);
+
+/**
+* Texture Loader Free
+*
+* Waits for in-flight decodes, then frees memory associated with the
+* loader. If subAllocationsOnly is true, the loader pointer itself will not
+* be freed.
+*/
+void eng_TextureLoaderFree(eng_TextureLoader* loader, bool subAllocationsOnly);
+
+/**
+* Texture Loader Get Sizeof
+*
+* @return the sizeof the internal eng_TextureLoader object, for use with
+* custom allocators.
+*/
+size_t eng_TextureLoaderGetSizeof(void);
+
+////////////////////////////////////////////////////////////////////////// Texture Loader API
+
+/**
+* Texture Loader Load
+*
+* Starts loading the image at path (TGA, PNG, DDS or KTX) into texture,
+* which must have been through eng_VulkanTextureInit. Returns immediately;
+* poll eng_VulkanTextureIsReady. Main thread only.
+* @returns false if the load couldn't be queued.
+*/
+bool eng_TextureLoaderLoad(eng_TextureLoader* loader, eng_VulkanTexture* texture, const char* path);
+
+/**
+* Texture Loader Update
+*
+* Call once per frame on the main thread, before eng_VulkanUploaderUpdate.
+* Moves every image decoded since the last call into the uploader.
+*/
+void eng_TextureLoaderUpdate(eng_TextureLoader* loader);
+
+/** @returns the number of loads that have not yet reached the uploader. */
+uint32_t eng_TextureLoaderGetPendingCount(eng_TextureLoader* loader);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Engine/Allocator.h>
+
+typedef struct eng_Tlsf eng_Tlsf;
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+/**
+* Tlsf Malloc
+*
+* @note The allocator is not ready for use until eng_TlsfInit is called.
+* @return A newly allocated TLSF allocator.
+*/
+eng_Tlsf* eng_TlsfMalloc(void);
+
+/**
+* Tlsf Init
+*
+* @description A Two-Level Segregated Fit allocator over one fixed region.
+* Free blocks are binned by size class, with a bitmap per level, so
+* allocating and freeing take the same few steps however full or
+* fragmented the region is. Neighbouring free blocks are merged straight
+* away. region is regionSize bytes the caller reserved and keeps alive;
+* if it's NULL, regionSize bytes are taken from allocator (NULL for the
+* heap) and given back when the TLSF allocator is freed. The region never
+* grows: allocations fail once it's full. Not thread safe.
+* @return true if initialization was successful.
+*/
+bool eng_TlsfInit(eng_Tlsf* tlsf, void* region, size_t regionSize, const eng_Allocator* allocator);
+
+/**
+* Tlsf Free
+*
+* Frees memory associated with the TLSF allocator, and with it every
+* allocation made from it. If subAllocationsOnly is true, the TLSF pointer
+* itself will not be freed.
+*/
+void eng_TlsfFree(eng_Tlsf* tlsf, bool subAllocationsOnly);
+
+/**
+* Tlsf Get Sizeof
+*
+* @return the sizeof the internal eng_Tlsf object, for use with
+* custom allocators.
+*/
+size_t eng_TlsfGetSizeof(void);
+
+////////////////////////////////////////////////////////////////////////// Tlsf API
+
+/**
+* Tlsf Alloc
+*
+* alignment must be a power of two.
+* @return uninitialized memory, or NULL if no free block is large enough.
+*/
+void* eng_TlsfAlloc(eng_Tlsf* tlsf, size_t size, size_t alignment);
+
+/**
+* Tlsf Realloc
+*
+* Grows into the following block when it's free, otherwise moves.
+* @return the new memory, or NULL on failure, in which case ptr is untouched.
+*/
+void* eng_TlsfRealloc(eng_Tlsf* tlsf, void* ptr, size_t size, size_t alignment);
+
+/** Gives ptr back to the region. NULL is ignored. */
+void eng_TlsfRelease(eng_Tlsf* tlsf, void* ptr);
+
+/** @returns the bytes held by live allocations, rounded up to block sizes. */
+size_t eng_TlsfGetUsed(eng_Tlsf* tlsf);
+
+/** @returns the bytes the region can hand out. */
+size_t eng_TlsfGetCapacity(eng_Tlsf* tlsf);
+
+/**
+* Tlsf Get Allocator
+*
+* @return an allocator over the TLSF region, valid for its lifetime, to
+* hand to eng_ArrayInitAllocator or any system's init.
+*/
+const eng_Allocator* eng_TlsfGetAllocator(eng_Tlsf* tlsf);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
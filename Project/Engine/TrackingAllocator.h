@@ -0,0 +1,101 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Engine/Allocator.h>
+
+#define ENG_TRACKING_MAX_TAGS 32
+
+typedef struct eng_TrackingAllocator eng_TrackingAllocator;
+
+typedef struct eng_AllocationStats
+{
+	// The tag's name, or "Total".
+	const char* Name;
+	size_t LiveBytes;
+	size_t PeakBytes;
+	uint32_t LiveCount;
+	// Allocations made over the tracker's lifetime.
+	uint64_t TotalCount;
+} eng_AllocationStats;
+
+////////////////////////////////////////////////////////////////////////// Lifecycle
+/**
+* Tracking Allocator Malloc
+*
+* @note The tracker is not ready for use until eng_TrackingAllocatorInit
+* is called.
+* @return A newly allocated tracking allocator.
+*/
+eng_TrackingAllocator* eng_TrackingAllocatorMalloc(void);
+
+/**
+* Tracking Allocator Init
+*
+* @description Sits between engine systems and backing (NULL for the
+* heap), keeping live and peak bytes and allocation counts per tag, and
+* a header on every live allocation recording its size, tag and callsite
+* so leaks can be listed at shutdown. Thread safe as long as backing is.
+* @return true if initialization was successful.
+*/
+bool eng_TrackingAllocatorInit(eng_TrackingAllocator* tracker, const eng_Allocator* backing);
+
+/**
+* Tracking Allocator Free
+*
+* Frees the tracker. Allocations still live are left alone; report them
+* with eng_TrackingAllocatorReportLeaks first. If subAllocationsOnly is
+* true, the tracker pointer itself will not be freed.
+*/
+void eng_TrackingAllocatorFree(eng_TrackingAllocator* tracker, bool subAllocationsOnly);
+
+/**
+* Tracking Allocator Get Sizeof
+*
+* @return the sizeof the internal eng_TrackingAllocator object, for use
+* with custom allocators.
+*/
+size_t eng_TrackingAllocatorGetSizeof(void);
+
+////////////////////////////////////////////////////////////////////////// Tracking Allocator API
+
+/**
+* Tracking Allocator Get Tag
+*
+* @return an allocator that counts against the tag named name, creating
+* the tag on first use. name must outlive the tracker; string literals
+* are the intent. Past ENG_TRACKING_MAX_TAGS, tags share the last one.
+*/
+const eng_Allocator* eng_TrackingAllocatorGetTag(eng_TrackingAllocator* tracker, const char* name);
+
+/** @returns how many tags have been made. */
+uint32_t eng_TrackingAllocatorGetTagCount(eng_TrackingAllocator* tracker);
+
+/** @returns the stats of the tag at index, in the order tags were made. */
+eng_AllocationStats eng_TrackingAllocatorGetTagStats(eng_TrackingAllocator* tracker, uint32_t index);
+
+/** @returns the stats over every tag. Cheap enough to call every frame. */
+eng_AllocationStats eng_TrackingAllocatorGetTotal(eng_TrackingAllocator* tracker);
+
+/** Logs live, peak and count for every tag and the total. */
+void eng_TrackingAllocatorReport(eng_TrackingAllocator* tracker);
+
+/**
+* Tracking Allocator Report Leaks
+*
+* Logs every allocation still live with its tag, size and callsite. Call
+* once everything allocated through the tracker should have been freed.
+* @return the number of live allocations.
+*/
+uint32_t eng_TrackingAllocatorReportLeaks(eng_TrackingAllocator* tracker);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,174 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Engine/Array.h>
+#include <Engine/Log.h>
+
+// A typed view over eng_Array. The element size is a compile time constant
+// and indexing is inlined, so hot loops don't pay for a call and a runtime
+// multiply per element. Growth and the rest of the bookkeeping still go
+// through eng_Array, and .Array can be handed to anything taking one.
+//
+// eng_TypedArrayDecl(eng_FloatArray, float);
+//
+// eng_FloatArray values;
+// eng_FloatArrayInit(&values, allocator);
+// eng_FloatArrayPushBack(&values, 1.0f);
+// float first = *eng_FloatArrayAt(&values, 0);
+// eng_FloatArrayDestroy(&values);
+#define eng_TypedArrayDecl(name, type) \
+	typedef struct name \
+	{ \
+		eng_Array Array; \
+	} name; \
+	\
+	static inline void name##Init(name* array, const eng_Allocator* allocator) \
+	{ \
+		eng_ArrayInitAllocator(&array->Array, (uint32_t)sizeof(type), allocator); \
+	} \
+	\
+	static inline void name##Destroy(name* array) \
+	{ \
+		eng_ArrayDestroy(&array->Array); \
+	} \
+	\
+	/* @returns array viewing other's memory, or NULL if other holds a different size element. */ \
+	static inline name* name##FromArray(eng_Array* other) \
+	{ \
+		return other->TypeSize == sizeof(type) ? (name*)other : NULL; \
+	} \
+	\
+	static inline uint32_t name##Count(const name* array) \
+	{ \
+		return array->Array.Count; \
+	} \
+	\
+	static inline type* name##At(name* array, uint32_t index) \
+	{ \
+		eng_TypedArrayCheckIndex(index, array->Array.Count); \
+		return (type*)array->Array.Buffer + index; \
+	} \
+	\
+	static inline type* name##Begin(name* array) \
+	{ \
+		return (type*)array->Array.Buffer; \
+	} \
+	\
+	static inline type* name##End(name* array) \
+	{ \
+		return (type*)array->Array.Buffer + array->Array.Count; \
+	} \
+	\
+	/* @returns the index value was placed at. */ \
+	static inline uint32_t name##PushBack(name* array, type value) \
+	{ \
+		if ((size_t)(array->Array.Count + 1) * sizeof(type) > array->Array.BufferSize) \
+		{ \
+			return eng_ArrayPushBack(&array->Array, &value); \
+		} \
+		((type*)array->Array.Buffer)[array->Array.Count] = value; \
+		return array->Array.Count++; \
+	} \
+	\
+	static inline void name##RemoveLastSwap(name* array, uint32_t index) \
+	{ \
+		eng_TypedArrayCheckIndex(index, array->Array.Count); \
+		type* data = (type*)array->Array.Buffer; \
+		data[index] = data[--array->Array.Count]; \
+	}
+
+#if !defined(GAME_FINAL)
+#define eng_TypedArrayCheckIndex(index, count) \
+	do \
+	{ \
+		if ((index) >= (count)) \
+		{ \
+			eng_DevFatal("Array index %u out of bounds of %u.\n", (unsigned)(index), (unsigned)(count)); \
+		} \
+	} while (0)
+#else
+#define eng_TypedArrayCheckIndex(index, count) do { } while (0)
+#endif
+
+#ifdef __cplusplus
+}
+
+#include <type_traits>
+
+// The same for C++, owning its buffer:
+//
+// eng_TypedArray<float> values(allocator);
+// values.PushBack(1.0f);
+// for (float& value : values) { ... }
+template<typename T>
+class eng_TypedArray
+{
+	static_assert(std::is_trivially_copyable<T>::value, "eng_Array moves elements with memcpy.");
+
+public:
+	explicit eng_TypedArray(const eng_Allocator* allocator = nullptr)
+	{
+		eng_ArrayInitAllocator(&Array, (uint32_t)sizeof(T), allocator);
+	}
+
+	~eng_TypedArray()
+	{
+		eng_ArrayDestroy(&Array);
+	}
+
+	eng_TypedArray(const eng_TypedArray&) = delete;
+	eng_TypedArray& operator=(const eng_TypedArray&) = delete;
+
+	T& operator[](uint32_t index)
+	{
+		eng_TypedArrayCheckIndex(index, Array.Count);
+		return Data()[index];
+	}
+
+	const T& operator[](uint32_t index) const
+	{
+		eng_TypedArrayCheckIndex(index, Array.Count);
+		return Data()[index];
+	}
+
+	T* Data() { return static_cast<T*>(Array.Buffer); }
+	const T* Data() const { return static_cast<const T*>(Array.Buffer); }
+	uint32_t Count() const { return Array.Count; }
+
+	T* begin() { return Data(); }
+	T* end() { return Data() + Array.Count; }
+	const T* begin() const { return Data(); }
+	const T* end() const { return Data() + Array.Count; }
+
+	uint32_t PushBack(const T& value)
+	{
+		if ((size_t)(Array.Count + 1) * sizeof(T) > Array.BufferSize)
+		{
+			return eng_ArrayPushBack(&Array, const_cast<T*>(&value));
+		}
+		Data()[Array.Count] = value;
+		return Array.Count++;
+	}
+
+	void RemoveLastSwap(uint32_t index)
+	{
+		eng_TypedArrayCheckIndex(index, Array.Count);
+		Data()[index] = Data()[--Array.Count];
+	}
+
+	// For handing to C code that takes an eng_Array.
+	eng_Array* AsArray() { return &Array; }
+
+private:
+	eng_Array Array;
+};
+
+#endif
\ No newline at end of file
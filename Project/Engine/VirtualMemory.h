@@ -0,0 +1,51 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#else
+#include <stdbool.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+////////////////////////////////////////////////////////////////////////// Virtual Memory API
+
+/**
+* Virtual Get Page Size
+*
+* @return the granularity memory is committed in: the system page size,
+* or the huge page size if hugePages is true and huge pages are available.
+* Windows only hands out large pages committed up front, so it always
+* returns the normal page size there.
+*/
+size_t eng_VirtualGetPageSize(bool hugePages);
+
+/**
+* Virtual Reserve
+*
+* Reserves size bytes of address space without backing any of it. The
+* range can't be touched until it's committed. With hugePages the range is
+* aligned and flagged for huge pages where the OS supports it.
+* @return the start of the range, or NULL on failure.
+*/
+void* eng_VirtualReserve(size_t size, bool hugePages);
+
+/**
+* Virtual Commit
+*
+* Backs size bytes from address, inside a reservation and on page
+* boundaries, with zeroed read/write memory.
+* @return true if the memory was committed.
+*/
+bool eng_VirtualCommit(void* address, size_t size);
+
+/** Gives the memory back to the OS, keeping the addresses reserved. */
+void eng_VirtualDecommit(void* address, size_t size);
+
+/** Releases a whole reservation made with eng_VirtualReserve. */
+void eng_VirtualRelease(void* address, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
@@ -9,6 +9,7 @@ extern "C" {
 #include <stdint.h>
 
 typedef struct eng_Window eng_Window;
+typedef struct eng_Allocator eng_Allocator;
 
 ////////////////////////////////////////////////////////////////////////// Lifecycle
 /**
@@ -38,10 +39,11 @@ eng_Window* eng_WindowMalloc(void);
 /**
 * Window Init
 *
-* @description Initializes the window, making it ready for use.
+* @description Initializes the window, making it ready for use. The
+* title and callback lists come from allocator (NULL for the heap).
 * @return true if initialization was successful.
 */
-bool eng_WindowInit(eng_Window* window, uint16_t width, uint16_t height, const char* title);
+bool eng_WindowInit(eng_Window* window, uint16_t width, uint16_t height, const char* title, const eng_Allocator* allocator);
 
 /**
 * Window Free
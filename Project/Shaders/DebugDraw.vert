@@ -0,0 +1,62 @@
+#version 450
+
+// Wireframe debug primitives written by Graphics_VulkanDebugDraw.c. Every
+// instance is one primitive, expanded here into a line list.
+
+#define PRIMITIVE_LINE 0
+#define PRIMITIVE_BOX 1
+#define PRIMITIVE_SPHERE 2
+#define SPHERE_SEGMENTS 32
+
+layout(push_constant) uniform PushConstants
+{
+	mat4 ViewProjection;
+	uint Primitive;
+} pc;
+
+// Line: A to B. Box: A min, B max. Sphere: A center, B.x radius.
+layout(location = 0) in vec3 inA;
+layout(location = 1) in vec4 inColor;
+layout(location = 2) in vec3 inB;
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+	uint vertex = uint(gl_VertexIndex);
+	uint end = vertex & 1u;
+	vec3 position;
+
+	if (pc.Primitive == PRIMITIVE_LINE)
+	{
+		position = end == 0u ? inA : inB;
+	}
+	else if (pc.Primitive == PRIMITIVE_BOX)
+	{
+		// 12 edges, 4 along each axis. The low two bits of the edge pick
+		// which corner of the other two axes it runs from.
+		uint edge = vertex >> 1;
+		uint axis = edge >> 2;
+		vec3 corner;
+		corner[axis] = float(end);
+		corner[(axis + 1u) % 3u] = float(edge & 1u);
+		corner[(axis + 2u) % 3u] = float((edge >> 1) & 1u);
+		position = mix(inA, inB, corner);
+	}
+	else
+	{
+		// Three circles, in the XY, YZ and ZX planes.
+		uint circle = vertex / (SPHERE_SEGMENTS * 2u);
+		uint segment = (vertex >> 1) % SPHERE_SEGMENTS + end;
+		float angle = float(segment) * (6.2831853 / float(SPHERE_SEGMENTS));
+		vec2 point = vec2(cos(angle), sin(angle)) * inB.x;
+		vec3 offset;
+		offset[circle] = point.x;
+		offset[(circle + 1u) % 3u] = point.y;
+		offset[(circle + 2u) % 3u] = 0.0;
+		position = inA + offset;
+	}
+
+	outColor = inColor;
+	gl_Position = pc.ViewProjection * vec4(position, 1.0);
+}
@@ -0,0 +1,18 @@
+#version 450
+
+// Soft round sprites, blended additively.
+
+layout(location = 0) in vec4 inColor;
+layout(location = 1) in vec2 inCorner;
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+	float falloff = 1.0 - dot(inCorner, inCorner);
+	if (falloff <= 0.0)
+	{
+		discard;
+	}
+	outColor = vec4(inColor.rgb * (inColor.a * falloff), 0.0);
+}
@@ -0,0 +1,39 @@
+#version 450
+
+// One instance per live particle, expanded to a quad from a 4 vertex strip.
+
+struct Particle
+{
+	vec2 Position;
+	vec2 Velocity;
+	float Life;
+	float MaxLife;
+	uint Color;
+	float Size;
+};
+
+layout(std430, set = 0, binding = 0) readonly buffer Particles
+{
+	Particle particles[];
+};
+
+layout(push_constant) uniform PushConstants
+{
+	vec2 InvHalfExtent;
+} pc;
+
+layout(location = 0) out vec4 outColor;
+layout(location = 1) out vec2 outCorner;
+
+void main()
+{
+	Particle particle = particles[gl_InstanceIndex];
+	vec2 corner = vec2(gl_VertexIndex & 1, gl_VertexIndex >> 1) * 2.0 - 1.0;
+
+	outColor = unpackUnorm4x8(particle.Color);
+	outColor.a *= clamp(particle.Life / particle.MaxLife, 0.0, 1.0);
+	outCorner = corner;
+
+	vec2 position = particle.Position + corner * (particle.Size * 0.5);
+	gl_Position = vec4(position * pc.InvHalfExtent - 1.0, 0.0, 1.0);
+}
@@ -0,0 +1,25 @@
+#version 450
+
+// The glyph atlas is an R8 texel buffer the CPU writes directly, so glyphs
+// are fetched rather than filtered. Quads are pixel aligned, which keeps
+// each fragment on exactly one atlas texel.
+
+layout(set = 0, binding = 0) uniform samplerBuffer Atlas;
+
+layout(push_constant) uniform PushConstants
+{
+	vec2 InvHalfExtent;
+	uint AtlasSize;
+} pc;
+
+layout(location = 0) in vec2 inTexel;
+layout(location = 1) in vec4 inColor;
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+	ivec2 texel = ivec2(inTexel);
+	float coverage = texelFetch(Atlas, texel.y * int(pc.AtlasSize) + texel.x).r;
+	outColor = vec4(inColor.rgb, inColor.a * coverage);
+}
@@ -0,0 +1,23 @@
+#version 450
+
+// Screen space text quads written by Graphics_VulkanText.c.
+
+layout(push_constant) uniform PushConstants
+{
+	vec2 InvHalfExtent;
+	uint AtlasSize;
+} pc;
+
+layout(location = 0) in vec2 inPosition; // pixels, top left origin
+layout(location = 1) in vec2 inTexel;    // glyph atlas texels
+layout(location = 2) in vec4 inColor;
+
+layout(location = 0) out vec2 outTexel;
+layout(location = 1) out vec4 outColor;
+
+void main()
+{
+	outTexel = inTexel;
+	outColor = inColor;
+	gl_Position = vec4(inPosition * pc.InvHalfExtent - 1.0, 0.0, 1.0);
+}
@@ -0,0 +1,656 @@
+#include <Source/Benchmarks.h>
+
+#if defined(GAME_BENCH)
+
+#include <Engine/Allocator.h>
+#include <Engine/Array.h>
+#include <Engine/Graphics_Vulkan.h>
+#include <Engine/Graphics_VulkanParticles.h>
+#include <Engine/HashMap.h>
+#include <Engine/Jobs.h>
+#include <Engine/Log.h>
+#include <Engine/Sort.h>
+#include <Engine/Stopwatch.h>
+#include <Engine/Tlsf.h>
+#include <Engine/TypedArray.h>
+#include <Engine/Window.h>
+
+#include <algorithm>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unordered_map>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+namespace {
+
+// Times the benchmarks that run long enough for it.
+eng_Stopwatch* Stopwatch = nullptr;
+// Results land here so the optimizer can't drop the work producing them.
+volatile uint64_t Sink = 0;
+
+// Seeded the same for every contender, so they all see the same workload.
+struct BenchRandom
+{
+	uint64_t State;
+
+	explicit BenchRandom(uint64_t seed) : State(seed) {}
+
+	uint64_t Next()
+	{
+		// splitmix64
+		uint64_t z = (State += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	uint32_t Below(uint32_t bound)
+	{
+		return (uint32_t)(Next() % bound);
+	}
+};
+
+// Single operations are shorter than the stopwatch's resolution, so they're
+// timed with the time stamp counter, converted to nanoseconds against it.
+double NanosecondsPerTick = 0.0;
+
+void CalibrateTicks()
+{
+	eng_StopwatchStart(Stopwatch);
+	uint64_t start = __rdtsc();
+	while (__rdtsc() - start < 200000000ull)
+	{
+	}
+	uint64_t ticks = __rdtsc() - start;
+	eng_StopwatchStop(Stopwatch);
+	NanosecondsPerTick = eng_StopwatchGetNanoseconds(Stopwatch) / (double)ticks;
+}
+
+// Sorts samples (in ticks) and logs their percentiles in nanoseconds.
+void LogLatency(const char* name, std::vector<uint64_t>& samples)
+{
+	if (samples.empty())
+	{
+		return;
+	}
+	std::sort(samples.begin(), samples.end());
+	auto at = [&](double percentile)
+	{
+		size_t index = std::min(samples.size() - 1, (size_t)(percentile * samples.size()));
+		return samples[index] * NanosecondsPerTick;
+	};
+	eng_Log("  %-24s p50 %7.1f ns  p99 %7.1f ns  p99.9 %8.1f ns  max %10.1f ns\n", name, at(0.5), at(0.99), at(0.999),
+		samples.back() * NanosecondsPerTick);
+}
+
+// @returns the milliseconds work took on the stopwatch.
+template<typename Work>
+double TimeMilliseconds(Work work)
+{
+	eng_StopwatchStart(Stopwatch);
+	work();
+	eng_StopwatchStop(Stopwatch);
+	return eng_StopwatchGetMilliseconds(Stopwatch);
+}
+
+////////////////////////////////////////////////////////////////////////// TLSF
+// A frame thread's churn: random slots are freed if live and allocated
+// otherwise, mostly small sizes with the odd large one.
+static constexpr uint32_t TlsfSlots = 8192;
+static constexpr uint32_t TlsfOperations = 2000000;
+static constexpr size_t TlsfRegionSize = 256 * 1024 * 1024;
+
+template<typename Alloc, typename Release>
+void RunAllocatorChurn(const char* name, Alloc alloc, Release release)
+{
+	std::vector<void*> live(TlsfSlots, nullptr);
+	std::vector<uint64_t> allocTicks, releaseTicks;
+	allocTicks.reserve(TlsfOperations);
+	releaseTicks.reserve(TlsfOperations);
+	uint32_t failed = 0;
+
+	// The first pass faults the memory in; the second is measured.
+	for (uint32_t pass = 0; pass < 2; ++pass)
+	{
+		allocTicks.clear();
+		releaseTicks.clear();
+		BenchRandom random(38);
+		for (uint32_t i = 0; i < TlsfOperations; ++i)
+		{
+			uint32_t slot = random.Below(TlsfSlots);
+			size_t size = random.Below(16) == 0 ? 4096 + random.Below(60 * 1024) : 16 + random.Below(1024);
+			if (live[slot] != nullptr)
+			{
+				uint64_t start = __rdtsc();
+				release(live[slot]);
+				releaseTicks.push_back(__rdtsc() - start);
+				live[slot] = nullptr;
+			}
+			else
+			{
+				uint64_t start = __rdtsc();
+				live[slot] = alloc(size);
+				allocTicks.push_back(__rdtsc() - start);
+				failed += live[slot] == nullptr ? 1 : 0;
+			}
+		}
+		for (void*& ptr : live)
+		{
+			release(ptr);
+			ptr = nullptr;
+		}
+	}
+
+	eng_Log(" %s%s\n", name, failed > 0 ? " (some allocations failed)" : "");
+	LogLatency("alloc", allocTicks);
+	LogLatency("free", releaseTicks);
+}
+
+void BenchTlsf()
+{
+	eng_Log("TLSF vs malloc: %u random allocs and frees over %u live slots\n", TlsfOperations, TlsfSlots);
+
+	eng_Tlsf* tlsf = eng_TlsfMalloc();
+	if (!eng_Ensure(tlsf != nullptr && eng_TlsfInit(tlsf, nullptr, TlsfRegionSize, nullptr), "TLSF benchmark failed to reserve its region.\n"))
+	{
+		eng_TlsfFree(tlsf, false);
+		return;
+	}
+	RunAllocatorChurn("eng_Tlsf",
+		[tlsf](size_t size) { return eng_TlsfAlloc(tlsf, size, ENG_ALLOCATOR_DEFAULT_ALIGNMENT); },
+		[tlsf](void* ptr) { eng_TlsfRelease(tlsf, ptr); });
+	eng_TlsfFree(tlsf, false);
+
+	RunAllocatorChurn("malloc",
+		[](size_t size) { return malloc(size); },
+		[](void* ptr) { free(ptr); });
+}
+
+
+////////////////////////////////////////////////////////////////////////// Typed array
+// Sums are over integers so a loop the compiler can see through vectorizes.
+static constexpr uint32_t TypedArrayCount = 16 * 1024 * 1024;
+static constexpr uint32_t TypedArrayPasses = 8;
+
+eng_TypedArrayDecl(eng_BenchArray, uint32_t);
+
+// push(value) appends; sum() adds every element up by index.
+template<typename Push, typename Sum>
+void RunIndexing(const char* name, Push push, Sum sum)
+{
+	double pushMilliseconds = TimeMilliseconds([&]
+	{
+		for (uint32_t i = 0; i < TypedArrayCount; ++i)
+		{
+			push(i & 1023);
+		}
+	});
+	uint64_t total = 0;
+	double sumMilliseconds = TimeMilliseconds([&]
+	{
+		for (uint32_t pass = 0; pass < TypedArrayPasses; ++pass)
+		{
+			total += sum();
+		}
+	});
+	Sink = total;
+	eng_Log("  %-24s push back %7.1f M/s  index %8.1f M/s\n", name, TypedArrayCount / pushMilliseconds / 1000.0,
+		(double)TypedArrayCount * TypedArrayPasses / sumMilliseconds / 1000.0);
+}
+
+void BenchTypedArray()
+{
+	eng_Log("Typed array vs eng_Array vs std::vector: %u uint32 pushed, then summed by index %u times\n", TypedArrayCount, TypedArrayPasses);
+
+	{
+		eng_Array array;
+		eng_ArrayInitType(&array, uint32_t);
+		RunIndexing("eng_Array",
+			[&](uint32_t value) { eng_ArrayPushBack(&array, &value); },
+			[&]
+			{
+				uint64_t total = 0;
+				for (uint32_t i = 0; i < array.Count; ++i)
+				{
+					total += eng_ArrayIndexType(&array, uint32_t, i);
+				}
+				return total;
+			});
+		eng_ArrayDestroy(&array);
+	}
+
+	{
+		eng_BenchArray array;
+		eng_BenchArrayInit(&array, nullptr);
+		RunIndexing("eng_TypedArrayDecl",
+			[&](uint32_t value) { eng_BenchArrayPushBack(&array, value); },
+			[&]
+			{
+				uint64_t total = 0;
+				for (uint32_t i = 0; i < eng_BenchArrayCount(&array); ++i)
+				{
+					total += *eng_BenchArrayAt(&array, i);
+				}
+				return total;
+			});
+		eng_BenchArrayDestroy(&array);
+	}
+
+	{
+		eng_TypedArray<uint32_t> array;
+		RunIndexing("eng_TypedArray<T>",
+			[&](uint32_t value) { array.PushBack(value); },
+			[&]
+			{
+				uint64_t total = 0;
+				for (uint32_t i = 0; i < array.Count(); ++i)
+				{
+					total += array[i];
+				}
+				return total;
+			});
+	}
+
+	{
+		std::vector<uint32_t> array;
+		RunIndexing("std::vector",
+			[&](uint32_t value) { array.push_back(value); },
+			[&]
+			{
+				uint64_t total = 0;
+				for (size_t i = 0; i < array.size(); ++i)
+				{
+					total += array[i];
+				}
+				return total;
+			});
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////// Array growth
+// Not a power of two, which would flatter doubling.
+static constexpr uint32_t GrowthCount = 40000000;
+
+// The heap, counting what an array holds. A realloc that moves briefly
+// holds the old and new buffers both, so that's what peaks are made of.
+struct GrowthCounter
+{
+	size_t Live;
+	size_t Peak;
+	uint32_t Reallocs;
+};
+
+void* GrowthCounterAlloc(void* userData, size_t size, size_t alignment)
+{
+	GrowthCounter* counter = static_cast<GrowthCounter*>(userData);
+	counter->Live += size;
+	counter->Peak = std::max(counter->Peak, counter->Live);
+	return eng_AllocatorAlloc(nullptr, size, alignment);
+}
+
+void* GrowthCounterRealloc(void* userData, void* ptr, size_t oldSize, size_t newSize, size_t alignment)
+{
+	GrowthCounter* counter = static_cast<GrowthCounter*>(userData);
+	counter->Peak = std::max(counter->Peak, counter->Live + newSize);
+	counter->Live = counter->Live - oldSize + newSize;
+	++counter->Reallocs;
+	return eng_AllocatorRealloc(nullptr, ptr, oldSize, newSize, alignment);
+}
+
+void GrowthCounterFree(void* userData, void* ptr, size_t size)
+{
+	static_cast<GrowthCounter*>(userData)->Live -= size;
+	eng_AllocatorFree(nullptr, ptr, size);
+}
+
+void RunGrowth(const char* name, const eng_ArrayGrowth* growth)
+{
+	GrowthCounter counter = {};
+	const eng_Allocator allocator = { GrowthCounterAlloc, GrowthCounterRealloc, GrowthCounterFree, &counter };
+	eng_Array array;
+	eng_ArrayInitAllocatorType(&array, uint32_t, &allocator);
+	eng_ArraySetGrowth(&array, growth);
+	double milliseconds = TimeMilliseconds([&]
+	{
+		for (uint32_t i = 0; i < GrowthCount; ++i)
+		{
+			eng_ArrayPushBack(&array, &i);
+		}
+	});
+	const double mebibyte = 1024.0 * 1024.0;
+	eng_Log("  %-28s %7.1f M/s  %4u reallocs  buffer %7.1f MiB (%5.1f%% slack)  peak %7.1f MiB\n", name, GrowthCount / milliseconds / 1000.0,
+		counter.Reallocs, array.BufferSize / mebibyte, 100.0 * (array.BufferSize - (double)GrowthCount * sizeof(uint32_t)) / array.BufferSize,
+		counter.Peak / mebibyte);
+	eng_ArrayDestroy(&array);
+}
+
+void BenchArrayGrowth()
+{
+	eng_Log("eng_Array growth policies: %u uint32 pushed back one at a time\n", GrowthCount);
+
+	static const eng_ArrayGrowth doubling = eng_ArrayGetDefaultGrowth();
+	static const eng_ArrayGrowth percent = { 150, 0, 0 };
+	static const eng_ArrayGrowth pages = { 125, 1024 * 1024, 4096 };
+	RunGrowth("doubling", &doubling);
+	RunGrowth("150%", &percent);
+	RunGrowth("125%, 1 MiB min, 4 KiB pages", &pages);
+}
+
+
+////////////////////////////////////////////////////////////////////////// Hash map
+static constexpr uint32_t HashMapCount = 4 * 1024 * 1024;
+
+// insert(key, value), find(key) returning the value or 0, erase(key).
+template<typename Insert, typename Find, typename Erase>
+void RunHashMap(const char* name, Insert insert, Find find, Erase erase)
+{
+	// Random keys, looked up in a different order than they went in, and
+	// misses drawn from the same distribution.
+	std::vector<uint64_t> keys(HashMapCount), misses(HashMapCount), order(HashMapCount);
+	BenchRandom random(49);
+	for (uint32_t i = 0; i < HashMapCount; ++i)
+	{
+		keys[i] = random.Next() | 1;
+		misses[i] = random.Next() & ~1ull;
+	}
+	for (uint32_t i = 0; i < HashMapCount; ++i)
+	{
+		order[i] = keys[i];
+	}
+	for (uint32_t i = HashMapCount - 1; i > 0; --i)
+	{
+		std::swap(order[i], order[random.Below(i + 1)]);
+	}
+
+	uint64_t total = 0;
+	double insertMilliseconds = TimeMilliseconds([&]
+	{
+		for (uint32_t i = 0; i < HashMapCount; ++i)
+		{
+			insert(keys[i], i + 1);
+		}
+	});
+	double hitMilliseconds = TimeMilliseconds([&]
+	{
+		for (uint32_t i = 0; i < HashMapCount; ++i)
+		{
+			total += find(order[i]);
+		}
+	});
+	double missMilliseconds = TimeMilliseconds([&]
+	{
+		for (uint32_t i = 0; i < HashMapCount; ++i)
+		{
+			total += find(misses[i]);
+		}
+	});
+	double eraseMilliseconds = TimeMilliseconds([&]
+	{
+		for (uint32_t i = 0; i < HashMapCount; ++i)
+		{
+			erase(order[i]);
+		}
+	});
+	Sink = total;
+
+	const double perOperation = 1000000.0 / HashMapCount;
+	eng_Log("  %-24s insert %6.1f ns  find hit %6.1f ns  find miss %6.1f ns  erase %6.1f ns\n", name, insertMilliseconds * perOperation,
+		hitMilliseconds * perOperation, missMilliseconds * perOperation, eraseMilliseconds * perOperation);
+}
+
+void BenchHashMap()
+{
+	eng_Log("eng_HashMap vs std::unordered_map: %u random uint64 keys to uint64 values, per operation\n", HashMapCount);
+
+	{
+		eng_HashMap map;
+		eng_HashMapInitType(&map, uint64_t, uint64_t, nullptr, nullptr);
+		RunHashMap("eng_HashMap",
+			[&](uint64_t key, uint64_t value) { eng_HashMapInsert(&map, &key, &value); },
+			[&](uint64_t key)
+			{
+				uint64_t* value = eng_HashMapFindType(&map, uint64_t, &key);
+				return value != nullptr ? *value : 0;
+			},
+			[&](uint64_t key) { eng_HashMapRemove(&map, &key); });
+		eng_HashMapDestroy(&map);
+	}
+
+	{
+		std::unordered_map<uint64_t, uint64_t> map;
+		RunHashMap("std::unordered_map",
+			[&](uint64_t key, uint64_t value) { map[key] = value; },
+			[&](uint64_t key)
+			{
+				auto found = map.find(key);
+				return found != map.end() ? found->second : 0;
+			},
+			[&](uint64_t key) { map.erase(key); });
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////// Sort
+static constexpr uint32_t SortCount = 4 * 1024 * 1024;
+
+// What draw-key sorting moves around.
+struct SortItem
+{
+	uint64_t Key;
+	uint32_t Index;
+	uint32_t Padding;
+};
+
+int CompareSortItems(const void* a, const void* b, void*)
+{
+	uint64_t left = static_cast<const SortItem*>(a)->Key;
+	uint64_t right = static_cast<const SortItem*>(b)->Key;
+	return (left > right) - (left < right);
+}
+
+bool SortItemLess(const SortItem& a, const SortItem& b)
+{
+	return a.Key < b.Key;
+}
+
+// Sorts a fresh copy of items with sort(array), outside the timing.
+template<typename Sort>
+void RunSort(const char* name, const std::vector<SortItem>& items, Sort sort)
+{
+	eng_Array array;
+	eng_ArrayInitType(&array, SortItem);
+	eng_ArrayResize(&array, (uint32_t)items.size());
+	memcpy(array.Buffer, items.data(), items.size() * sizeof(SortItem));
+	double milliseconds = TimeMilliseconds([&] { sort(&array); });
+	eng_Log("  %-24s %8.1f ms  %7.1f M/s\n", name, milliseconds, items.size() / milliseconds / 1000.0);
+	eng_ArrayDestroy(&array);
+}
+
+// find(key) returns the lower bound of key.
+template<typename Find>
+void RunSearch(const char* name, const std::vector<uint64_t>& keys, Find find)
+{
+	uint64_t total = 0;
+	double milliseconds = TimeMilliseconds([&]
+	{
+		for (uint64_t key : keys)
+		{
+			total += find(key);
+		}
+	});
+	Sink = total;
+	eng_Log("  %-24s %6.1f ns per search\n", name, milliseconds * 1000000.0 / keys.size());
+}
+
+void BenchSort()
+{
+	eng_JobPool* jobs = eng_JobPoolMalloc();
+	if (!eng_Ensure(jobs != nullptr && eng_JobPoolInit(jobs, 0, nullptr), "Sort benchmark failed to start its job pool.\n"))
+	{
+		eng_JobPoolFree(jobs, false);
+		return;
+	}
+
+	std::vector<SortItem> items(SortCount);
+	BenchRandom random(50);
+	for (uint32_t i = 0; i < SortCount; ++i)
+	{
+		items[i].Key = random.Next();
+		items[i].Index = i;
+		items[i].Padding = 0;
+	}
+
+	eng_Log("Sorting %u 16 byte items by a uint64 key, with %u job workers\n", SortCount, eng_JobPoolGetWorkerCount(jobs));
+	RunSort("eng_ArrayRadixSort", items, [](eng_Array* array) { eng_ArrayRadixSort(array, ENG_SORT_KEY_U64, offsetof(SortItem, Key)); });
+	RunSort("eng_ArraySort", items, [](eng_Array* array) { eng_ArraySort(array, CompareSortItems, nullptr, nullptr); });
+	RunSort("eng_ArraySort on jobs", items, [jobs](eng_Array* array) { eng_ArraySort(array, CompareSortItems, nullptr, jobs); });
+	RunSort("std::sort", items, [](eng_Array* array)
+	{
+		SortItem* begin = static_cast<SortItem*>(array->Buffer);
+		std::sort(begin, begin + array->Count, SortItemLess);
+	});
+	RunSort("std::stable_sort", items, [](eng_Array* array)
+	{
+		SortItem* begin = static_cast<SortItem*>(array->Buffer);
+		std::stable_sort(begin, begin + array->Count, SortItemLess);
+	});
+
+	// Half the keys searched for are in the array.
+	std::sort(items.begin(), items.end(), SortItemLess);
+	std::vector<uint64_t> keys(SortCount);
+	for (uint32_t i = 0; i < SortCount; ++i)
+	{
+		keys[i] = (i & 1) ? items[random.Below(SortCount)].Key : random.Next();
+	}
+	eng_Array sorted;
+	eng_ArrayInitType(&sorted, SortItem);
+	eng_ArrayResize(&sorted, SortCount);
+	memcpy(sorted.Buffer, items.data(), items.size() * sizeof(SortItem));
+
+	eng_Log("Searching %u sorted items %u times\n", SortCount, SortCount);
+	RunSearch("eng_ArrayLowerBound", keys, [&](uint64_t key)
+	{
+		SortItem item = { key, 0, 0 };
+		return eng_ArrayLowerBound(&sorted, &item, CompareSortItems, nullptr);
+	});
+	RunSearch("eng_ArrayLowerBoundKey", keys, [&](uint64_t key) { return eng_ArrayLowerBoundKey(&sorted, ENG_SORT_KEY_U64, offsetof(SortItem, Key), &key); });
+	RunSearch("std::lower_bound", keys, [&](uint64_t key)
+	{
+		SortItem item = { key, 0, 0 };
+		return (uint32_t)(std::lower_bound(items.begin(), items.end(), item, SortItemLess) - items.begin());
+	});
+
+	eng_ArrayDestroy(&sorted);
+	eng_JobPoolFree(jobs, false);
+}
+
+
+////////////////////////////////////////////////////////////////////////// Particles
+static constexpr uint32_t MinParticleCount = 64 * 1024;
+static constexpr uint32_t MaxParticleCount = 4 * 1024 * 1024;
+// Fixed steps, so every count simulates the same time whatever the frame rate.
+static constexpr float ParticleStepSeconds = 1.0f / 60.0f;
+// Particles live 2 seconds on average; 5 seconds fills the buffer.
+static constexpr uint32_t ParticleWarmupFrames = 300;
+static constexpr uint32_t ParticleMeasuredFrames = 120;
+
+// Simulation and draw are timed on the GPU, so this needs a window and device.
+void BenchParticles()
+{
+	if (!eng_Ensure(eng_WindowGlobalInit(), "Particle benchmark failed to initialize windows.\n"))
+	{
+		eng_WindowGlobalShutdown();
+		return;
+	}
+	eng_Window* window = eng_WindowMalloc();
+	if (!eng_Ensure(window != nullptr && eng_WindowInit(window, 1280, 720, "Particle benchmark", nullptr) && eng_WindowSupportsVulkan(window),
+		"Particle benchmark needs a window that supports Vulkan.\n"))
+	{
+		eng_WindowFree(window, false);
+		eng_WindowGlobalShutdown();
+		return;
+	}
+	eng_Vulkan* vulkan = eng_VulkanMalloc();
+	if (!eng_Ensure(vulkan != nullptr && eng_VulkanInit(vulkan, nullptr) && eng_WindowBindVulkan(window, vulkan), "Particle benchmark failed to start Vulkan.\n"))
+	{
+		eng_VulkanFree(vulkan, false);
+		eng_WindowFree(window, false);
+		eng_WindowGlobalShutdown();
+		return;
+	}
+
+	// A changing render scale would change the draw cost under test.
+	eng_DynamicResolutionSettings dynamicResolution = eng_DynamicResolutionGetDefaults();
+	dynamicResolution.Enabled = false;
+	eng_VulkanSetDynamicResolution(vulkan, &dynamicResolution);
+	uint32_t width, height;
+	eng_VulkanGetExtent(vulkan, &width, &height);
+
+	eng_Log("Particles, %u warmup and %u measured frames per count\n", ParticleWarmupFrames, ParticleMeasuredFrames);
+	for (uint32_t count = MinParticleCount; count <= MaxParticleCount; count *= 2)
+	{
+		eng_VulkanParticles* particles = eng_VulkanParticlesMalloc();
+		if (!eng_Ensure(particles != nullptr && eng_VulkanParticlesInit(particles, vulkan, count), "Particle benchmark failed to create %u particles.\n", count))
+		{
+			eng_VulkanParticlesFree(particles, false);
+			break;
+		}
+		eng_VulkanParticlesSetEmitter(particles, width * 0.5f, height * 0.75f, count * 0.5f);
+
+		double simulationMilliseconds = 0.0;
+		double renderMilliseconds = 0.0;
+		for (uint32_t frame = 0; frame < ParticleWarmupFrames + ParticleMeasuredFrames; ++frame)
+		{
+			eng_WindowUpdate(window);
+			eng_VulkanParticlesUpdate(particles, ParticleStepSeconds);
+			eng_VulkanUpdate(vulkan);
+			if (frame >= ParticleWarmupFrames)
+			{
+				simulationMilliseconds += eng_VulkanParticlesGetSimulationMilliseconds(particles);
+				renderMilliseconds += eng_VulkanParticlesGetRenderMilliseconds(particles);
+			}
+		}
+		eng_Log("  %8u particles (%s)  sim %7.3f ms  draw %7.3f ms\n", count,
+			eng_VulkanParticlesIsAsyncCompute(particles) ? "async compute" : "graphics queue",
+			simulationMilliseconds / ParticleMeasuredFrames, renderMilliseconds / ParticleMeasuredFrames);
+		eng_VulkanParticlesFree(particles, false);
+	}
+
+	eng_VulkanFree(vulkan, false);
+	eng_WindowFree(window, false);
+	eng_WindowGlobalShutdown();
+}
+
+}
+
+int RunBenchmarks()
+{
+	Stopwatch = eng_StopwatchMalloc();
+	if (Stopwatch == nullptr || !eng_StopwatchInit(Stopwatch))
+	{
+		eng_StopwatchFree(Stopwatch, false);
+		return -1;
+	}
+	CalibrateTicks();
+
+	BenchTlsf();
+	BenchTypedArray();
+	BenchArrayGrowth();
+	BenchHashMap();
+	BenchSort();
+	BenchParticles();
+
+	eng_StopwatchFree(Stopwatch, false);
+	return 0;
+}
+
+#endif
\ No newline at end of file
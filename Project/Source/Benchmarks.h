@@ -0,0 +1,7 @@
+#pragma once
+
+// The Bench configuration (GAME_BENCH) runs these instead of the game. Each
+// one pits an engine container or allocator against the standard library
+// on the same workload and logs the results. The last sweeps GPU particle
+// counts, logging simulation and draw time separately.
+int RunBenchmarks();
\ No newline at end of file
@@ -1,42 +1,60 @@
 #include <crtdbg.h>
 #include <Windows.h>
 #include <stdio.h>
+#include <math.h>
 #include <stdlib.h>
 
+#include <Engine/Arena.h>
+#include <Engine/FrameAllocator.h>
+#include <Engine/FramePacer.h>
 #include <Engine/Graphics_Vulkan.h>
+#include <Engine/Graphics_VulkanDebugDraw.h>
+#include <Engine/Graphics_VulkanLightCulling.h>
+#include <Engine/Graphics_VulkanParticles.h>
+#include <Engine/Graphics_VulkanText.h>
+#include <Engine/Graphics_VulkanTexture.h>
 #include <Engine/Ini.h>
+#include <Engine/Jobs.h>
 #include <Engine/Log.h>
 #include <Engine/Stopwatch.h>
+#include <Engine/TextureLoader.h>
+#include <Engine/TrackingAllocator.h>
 #include <Engine/Url.h>
 #include <Engine/Window.h>
 
+#include <Source/Benchmarks.h>
+
 #if defined(_MSC_VER)
 #define VISUAL_STUDIO_LEAK_DETECTION 1
 #endif
 
-class CoreSystemAllocator {
-public:
-	static constexpr unsigned CoreSystemMemorySize = 1024;
+// Core systems and their lifetime sub-allocations all come from one arena,
+// so startup costs a handful of mallocs rather than dozens. Systems that
+// allocate from job workers (the job pool, texture loading) use the heap,
+// since the arena isn't thread safe. Everything is tagged through one tracker
+// so memory can be broken down per system and leaks are listed at exit.
+static constexpr size_t CoreSystemBlockSize = 64 * 1024;
+static constexpr size_t FrameScratchSize = 64 * 1024;
 
-	template<typename T>
-	T Malloc(size_t size) {
-		if (CurrentOffset + size > CoreSystemMemorySize) {
-			__debugbreak();
-			throw "Critical failure. Buffer size is not large enough for internal systems.";
-		}
-		void* next = CoreSystemMemory + CurrentOffset;
-		CurrentOffset += size;;
-		return static_cast<T>(next);
-	}
-
-	size_t GetCurrentOffset() const {
-		return CurrentOffset;
+template<typename T>
+T CoreSystemMalloc(eng_Arena* arena, size_t size) {
+	void* memory = eng_ArenaAlloc(arena, size, ENG_ALLOCATOR_DEFAULT_ALIGNMENT);
+	if (memory == nullptr) {
+		__debugbreak();
+		throw "Critical failure. Out of memory for internal systems.";
 	}
+	return static_cast<T>(memory);
+}
 
-private:
-	char CoreSystemMemory[CoreSystemMemorySize];
-	size_t CurrentOffset = 0;
-};
+static constexpr unsigned TextureStagingSize = 64 * 1024 * 1024;
+static constexpr unsigned MaxTextGlyphsPerFrame = 4096;
+static constexpr unsigned ParticleCapacity = 1024 * 1024;
+static constexpr unsigned LightCount = 256;
+static constexpr unsigned MaxDebugPrimitivesPerFrame = 1024;
+// Lights outlined by debug draw, along with the cluster each one's center is in.
+static constexpr unsigned DebugDrawLightCount = 16;
+// Culling is checked against the CPU reference once the pipeline has warmed up.
+static constexpr unsigned LightValidationFrame = 4;
 
 volatile bool ApplicationRunning = true;
 
@@ -49,36 +67,89 @@ void OnWindowClose(void*)
 int main(int argsc, char** argsv) {
 #ifdef VISUAL_STUDIO_LEAK_DETECTION
 	_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
+#endif
+#if defined(GAME_BENCH)
+	return RunBenchmarks();
 #endif
 	int exitCode = 0;
 	////////////////////////////////////////////////////////////////////////// Setup
-	CoreSystemAllocator* allocator = new CoreSystemAllocator();
+	eng_TrackingAllocator* tracker = eng_TrackingAllocatorMalloc();
+	if (tracker == nullptr || !eng_TrackingAllocatorInit(tracker, nullptr))
+	{
+		eng_TrackingAllocatorFree(tracker, false);
+		return -1;
+	}
+
+	eng_Arena* arena = eng_ArenaMalloc();
+	if (arena == nullptr || !eng_ArenaInit(arena, CoreSystemBlockSize, eng_TrackingAllocatorGetTag(tracker, "Core")))
+	{
+		eng_ArenaFree(arena, false);
+		eng_TrackingAllocatorFree(tracker, false);
+		return -1;
+	}
+	const eng_Allocator* coreAllocator = eng_ArenaGetAllocator(arena);
 
 	char buffer[ENG_STOPWATCH_TOSTRING_LEN];
-	eng_Stopwatch* stopwatch = allocator->Malloc<eng_Stopwatch*>(eng_StopwatchGetSizeof());
+	eng_Stopwatch* stopwatch = CoreSystemMalloc<eng_Stopwatch*>(arena, eng_StopwatchGetSizeof());
+	eng_Stopwatch* frameStopwatch = CoreSystemMalloc<eng_Stopwatch*>(arena, eng_StopwatchGetSizeof());
+	eng_Stopwatch* renderStopwatch = CoreSystemMalloc<eng_Stopwatch*>(arena, eng_StopwatchGetSizeof());
+	eng_Stopwatch* stepStopwatch = CoreSystemMalloc<eng_Stopwatch*>(arena, eng_StopwatchGetSizeof());
 	eng_Window* window = nullptr;
 	eng_Vulkan* vulkan = nullptr;
 	eng_IniR* ini = nullptr;
+	eng_JobPool* jobs = nullptr;
+	eng_VulkanUploader* uploader = nullptr;
+	eng_TextureLoader* textureLoader = nullptr;
+	eng_VulkanParticles* particles = nullptr;
+	eng_VulkanText* text = nullptr;
+	eng_VulkanDebugDraw* debugDraw = nullptr;
+	eng_VulkanLightCulling* lightCulling = nullptr;
+	eng_FramePacer* pacer = nullptr;
+	eng_FrameAllocator* frameScratch = nullptr;
 
 	auto GracefullyExit = [&] (int exitCode)
 	{
+		eng_FramePacerFree(pacer, true);
+		eng_VulkanLightCullingFree(lightCulling, true);
+		eng_VulkanDebugDrawFree(debugDraw, true);
+		eng_VulkanTextFree(text, true);
+		eng_VulkanParticlesFree(particles, true);
+		eng_TextureLoaderFree(textureLoader, true);
+		eng_VulkanUploaderFree(uploader, true);
+		eng_JobPoolFree(jobs, true);
+		eng_StopwatchFree(stepStopwatch, true);
+		eng_StopwatchFree(renderStopwatch, true);
+		eng_StopwatchFree(frameStopwatch, true);
 		eng_StopwatchFree(stopwatch, true);
 		eng_VulkanFree(vulkan, true);
+		eng_FrameAllocatorFree(frameScratch, true);
 		eng_WindowFree(window, true);
 		eng_WindowGlobalShutdown();
 		eng_UrlGlobalShutdown();
 		eng_IniRFree(ini, true);
-		delete allocator;
-		allocator = nullptr;
+		eng_ArenaFree(arena, false);
+		arena = nullptr;
+		eng_TrackingAllocatorReportLeaks(tracker);
+		eng_TrackingAllocatorFree(tracker, false);
+		tracker = nullptr;
 		return exitCode;
 	};
 
 	////////////////////////////////////////////////////////////////////////// Setup
 	eng_StopwatchInit(stopwatch);
+	eng_StopwatchInit(frameStopwatch);
+	eng_StopwatchInit(renderStopwatch);
+	eng_StopwatchInit(stepStopwatch);
 	eng_StopwatchStart(stopwatch);
 
-	ini = allocator->Malloc<eng_IniR*>(eng_IniRGetSizeof());
-	if (!eng_Ensure(eng_IniRInit(ini, "engine.ini"), "Failed to load engine.ini"))
+	ini = CoreSystemMalloc<eng_IniR*>(arena, eng_IniRGetSizeof());
+	if (!eng_Ensure(eng_IniRInit(ini, "engine.ini", coreAllocator), "Failed to load engine.ini"))
+	{
+		return GracefullyExit(-1);
+	}
+
+	jobs = CoreSystemMalloc<eng_JobPool*>(arena, eng_JobPoolGetSizeof());
+	if (!eng_Ensure(eng_JobPoolInit(jobs, 0, eng_TrackingAllocatorGetTag(tracker, "Jobs")), "Job pool failed to start."))
 	{
 		return GracefullyExit(-1);
 	}
@@ -93,8 +164,8 @@ int main(int argsc, char** argsv) {
 		return GracefullyExit(-1);
 	}
 
-	window = allocator->Malloc<eng_Window*>(eng_WindowGetSizeof());
-	if (!eng_Ensure(eng_WindowInit(window, 1280, 720, "Improved Succotash"), "Application window failed to initialize."))
+	window = CoreSystemMalloc<eng_Window*>(arena, eng_WindowGetSizeof());
+	if (!eng_Ensure(eng_WindowInit(window, 1280, 720, "Improved Succotash", coreAllocator), "Application window failed to initialize."))
 	{
 		return GracefullyExit(-1);
 	}
@@ -102,8 +173,8 @@ int main(int argsc, char** argsv) {
 
 	if (eng_WindowSupportsVulkan(window)) 
 	{
-		vulkan = allocator->Malloc<eng_Vulkan*>(eng_VulkanGetSizeof());
-		if (!eng_Ensure(eng_VulkanInit(vulkan), "Vulkan initialization failed."))
+		vulkan = CoreSystemMalloc<eng_Vulkan*>(arena, eng_VulkanGetSizeof());
+		if (!eng_Ensure(eng_VulkanInit(vulkan, coreAllocator), "Vulkan initialization failed."))
 		{
 			return GracefullyExit(-1);
 		}
@@ -111,6 +182,110 @@ int main(int argsc, char** argsv) {
 		{
 			return GracefullyExit(-1);
 		}
+
+		eng_DynamicResolutionSettings dynamicResolution = eng_DynamicResolutionGetDefaults();
+		if (const char* value = eng_IniRRead(ini, "graphics", "dynamic_resolution"))
+		{
+			dynamicResolution.Enabled = atoi(value) != 0;
+		}
+		if (const char* value = eng_IniRRead(ini, "graphics", "target_frame_ms"))
+		{
+			dynamicResolution.TargetMilliseconds = (float)atof(value);
+		}
+		if (const char* value = eng_IniRRead(ini, "graphics", "min_render_scale"))
+		{
+			dynamicResolution.MinScale = (float)atof(value);
+		}
+		if (const char* value = eng_IniRRead(ini, "graphics", "max_render_scale"))
+		{
+			dynamicResolution.MaxScale = (float)atof(value);
+		}
+		eng_VulkanSetDynamicResolution(vulkan, &dynamicResolution);
+
+		frameScratch = CoreSystemMalloc<eng_FrameAllocator*>(arena, eng_FrameAllocatorGetSizeof());
+		if (!eng_Ensure(eng_FrameAllocatorInit(frameScratch, FrameScratchSize, ENG_VULKAN_FRAMES_IN_FLIGHT, eng_TrackingAllocatorGetTag(tracker, "Frame scratch")), "Frame scratch initialization failed."))
+		{
+			return GracefullyExit(-1);
+		}
+		eng_VulkanSetFrameAllocator(vulkan, frameScratch);
+
+		eng_FramePacerSettings framePacing = eng_FramePacerGetDefaults();
+		if (const char* value = eng_IniRRead(ini, "graphics", "frame_pacing"))
+		{
+			framePacing.Enabled = atoi(value) != 0;
+		}
+		if (const char* value = eng_IniRRead(ini, "graphics", "pacing_target_ms"))
+		{
+			framePacing.TargetMilliseconds = atof(value);
+		}
+		if (const char* value = eng_IniRRead(ini, "graphics", "pacing_safety_ms"))
+		{
+			framePacing.SafetyMilliseconds = atof(value);
+		}
+		pacer = CoreSystemMalloc<eng_FramePacer*>(arena, eng_FramePacerGetSizeof());
+		if (!eng_Ensure(eng_FramePacerInit(pacer, &framePacing), "Frame pacer initialization failed."))
+		{
+			return GracefullyExit(-1);
+		}
+		eng_FramePacerSetRefreshMilliseconds(pacer, eng_VulkanGetRefreshMilliseconds(vulkan));
+
+		uploader = CoreSystemMalloc<eng_VulkanUploader*>(arena, eng_VulkanUploaderGetSizeof());
+		if (!eng_Ensure(eng_VulkanUploaderInit(uploader, vulkan, TextureStagingSize), "Vulkan uploader initialization failed."))
+		{
+			return GracefullyExit(-1);
+		}
+
+		textureLoader = CoreSystemMalloc<eng_TextureLoader*>(arena, eng_TextureLoaderGetSizeof());
+		eng_TextureLoaderInit(textureLoader, jobs, uploader, eng_TrackingAllocatorGetTag(tracker, "Textures"));
+
+		particles = CoreSystemMalloc<eng_VulkanParticles*>(arena, eng_VulkanParticlesGetSizeof());
+		if (!eng_Ensure(eng_VulkanParticlesInit(particles, vulkan, ParticleCapacity), "Vulkan particles initialization failed."))
+		{
+			return GracefullyExit(-1);
+		}
+		uint32_t width, height;
+		eng_VulkanGetExtent(vulkan, &width, &height);
+		// Particles live 2 seconds on average, so this keeps the buffer about full.
+		eng_VulkanParticlesSetEmitter(particles, width * 0.5f, height * 0.75f, ParticleCapacity * 0.5f);
+
+		text = CoreSystemMalloc<eng_VulkanText*>(arena, eng_VulkanTextGetSizeof());
+		if (!eng_Ensure(eng_VulkanTextInit(text, vulkan, MaxTextGlyphsPerFrame), "Vulkan text initialization failed."))
+		{
+			return GracefullyExit(-1);
+		}
+
+		debugDraw = CoreSystemMalloc<eng_VulkanDebugDraw*>(arena, eng_VulkanDebugDrawGetSizeof());
+		if (!eng_Ensure(eng_VulkanDebugDrawInit(debugDraw, vulkan, MaxDebugPrimitivesPerFrame), "Vulkan debug draw initialization failed."))
+		{
+			return GracefullyExit(-1);
+		}
+
+		eng_LightClusterConfig clusterConfig = {};
+		clusterConfig.TilesX = 16;
+		clusterConfig.TilesY = 9;
+		clusterConfig.Slices = 24;
+		clusterConfig.MaxLightsPerCluster = 128;
+		clusterConfig.FovY = 1.0471976f; // 60 degrees
+		clusterConfig.Aspect = (float)width / (float)height;
+		clusterConfig.Near = 0.1f;
+		clusterConfig.Far = 100.0f;
+		lightCulling = CoreSystemMalloc<eng_VulkanLightCulling*>(arena, eng_VulkanLightCullingGetSizeof());
+		if (!eng_Ensure(eng_VulkanLightCullingInit(lightCulling, vulkan, &clusterConfig, LightCount), "Vulkan light culling initialization failed."))
+		{
+			return GracefullyExit(-1);
+		}
+
+#if !defined(GAME_FINAL)
+		// Perspective projection of the light clusters' view space, column major, depth 0 at Near and 1 at Far.
+		const float tanY = tanf(clusterConfig.FovY * 0.5f);
+		float viewProjection[16] = {};
+		viewProjection[0] = 1.0f / (tanY * clusterConfig.Aspect);
+		viewProjection[5] = 1.0f / tanY;
+		viewProjection[10] = clusterConfig.Far / (clusterConfig.Far - clusterConfig.Near);
+		viewProjection[11] = 1.0f;
+		viewProjection[14] = -clusterConfig.Near * clusterConfig.Far / (clusterConfig.Far - clusterConfig.Near);
+		eng_VulkanDebugDrawSetViewProjection(debugDraw, viewProjection);
+#endif
 	}
 	else
 	{
@@ -138,16 +313,130 @@ int main(int argsc, char** argsv) {
 	////////////////////////////////////////////////////////////////////////// Run
 	eng_StopwatchStart(stopwatch);
 
+	// Smoothed so the overlay is readable.
+	double frameMilliseconds = 0.0;
+	double renderMilliseconds = 0.0;
+	uint32_t frame = 0;
+	float lightSeconds = 0.0f;
+	eng_StopwatchStart(stepStopwatch);
 	while (ApplicationRunning) {
+		// Input is sampled as late as still makes the next present.
+		eng_FramePacerWait(pacer);
+		// The simulation steps by the time between input samples, which
+		// includes the pacer's wait; frameStopwatch only covers the work.
+		eng_StopwatchStop(stepStopwatch);
+		eng_StopwatchStart(stepStopwatch);
+		const float deltaSeconds = (float)eng_StopwatchGetSeconds(stepStopwatch);
+		eng_StopwatchStart(frameStopwatch);
 		eng_WindowUpdate(window);
+		eng_TextureLoaderUpdate(textureLoader);
+		eng_VulkanUploaderUpdate(uploader);
+		eng_VulkanParticlesUpdate(particles, deltaSeconds);
+
+		// Lights orbit the view axis at varying depths until there is a scene to light.
+		// They're rebuilt every frame, so they only need to last until the upload.
+		lightSeconds += deltaSeconds;
+		eng_Light* lights = eng_FrameAllocatorAllocType(frameScratch, eng_Light, LightCount);
+		for (uint32_t i = 0; i < LightCount; ++i)
+		{
+			float angle = lightSeconds * (0.2f + 0.002f * i) + i * 2.39996f;
+			float orbit = 2.0f + (i % 16);
+			lights[i].Position[0] = cosf(angle) * orbit;
+			lights[i].Position[1] = sinf(angle) * orbit * 0.5f;
+			lights[i].Position[2] = 4.0f + (i * 37 % 90);
+			lights[i].Radius = 1.0f + (i % 5);
+			lights[i].Color[0] = lights[i].Color[1] = lights[i].Color[2] = 1.0f;
+			lights[i].Intensity = 1.0f;
+		}
+		eng_VulkanLightCullingSetLights(lightCulling, lights, LightCount);
+
+#if !defined(GAME_FINAL)
+		const eng_LightClusterConfig* clusterConfig = eng_VulkanLightCullingGetConfig(lightCulling);
+		for (uint32_t i = 0; i < DebugDrawLightCount; ++i)
+		{
+			eng_VulkanDebugDrawSphere(debugDraw, lights[i].Position, lights[i].Radius, ENG_DEBUG_DRAW_COLOR(255, 200, 64, 255));
+			uint32_t cluster = eng_LightClusterFind(clusterConfig, lights[i].Position);
+			if (cluster != UINT32_MAX)
+			{
+				float clusterMin[3], clusterMax[3];
+				eng_LightClusterGetBounds(clusterConfig, cluster % clusterConfig->TilesX, cluster / clusterConfig->TilesX % clusterConfig->TilesY,
+					cluster / (clusterConfig->TilesX * clusterConfig->TilesY), clusterMin, clusterMax);
+				eng_VulkanDebugDrawBox(debugDraw, clusterMin, clusterMax, ENG_DEBUG_DRAW_COLOR(64, 160, 255, 255));
+			}
+		}
+#endif
+
+#if !defined(GAME_FINAL)
+		const uint32_t white = ENG_TEXT_COLOR(255, 255, 255, 255);
+		const int32_t line = (int32_t)eng_VulkanTextGetLineHeight(2);
+		eng_VulkanTextDrawf(text, 8, 8 + line * 0, 2, white, "Frame: %6.2f ms (%4.0f fps)", frameMilliseconds, frameMilliseconds > 0.0 ? 1000.0 / frameMilliseconds : 0.0);
+		eng_VulkanTextDrawf(text, 8, 8 + line * 1, 2, white, "Vulkan update: %6.2f ms", renderMilliseconds);
+		uint32_t renderWidth, renderHeight;
+		eng_VulkanGetRenderExtent(vulkan, &renderWidth, &renderHeight);
+		eng_VulkanTextDrawf(text, 8, 8 + line * 2, 2, white, "GPU frame: %6.2f ms at %ux%u (%3.0f%%)", eng_VulkanGetFrameMilliseconds(vulkan),
+			renderWidth, renderHeight, eng_VulkanGetRenderScale(vulkan) * 100.0f);
+		eng_VulkanTextDrawf(text, 8, 8 + line * 3, 2, white, "Setup: %s", buffer);
+		eng_AllocationStats memory = eng_TrackingAllocatorGetTotal(tracker);
+		eng_VulkanTextDrawf(text, 8, 8 + line * 4, 2, white, "Memory: %u bytes live in %u allocations, %u peak (core arena %u/%u bytes)",
+			(unsigned)memory.LiveBytes, memory.LiveCount, (unsigned)memory.PeakBytes, (unsigned)eng_ArenaGetUsed(arena), (unsigned)eng_ArenaGetCapacity(arena));
+		eng_VulkanTextDrawf(text, 8, 8 + line * 5, 2, white, "Textures pending: %u", eng_TextureLoaderGetPendingCount(textureLoader));
+		eng_VulkanTextDrawf(text, 8, 8 + line * 6, 2, white, "Glyphs rasterized: %u", eng_VulkanTextGetRasterizeCount(text));
+		eng_VulkanTextDrawf(text, 8, 8 + line * 7, 2, white, "Particles (%u, %s): sim %.3f ms, draw %.3f ms", eng_VulkanParticlesGetCapacity(particles),
+			eng_VulkanParticlesIsAsyncCompute(particles) ? "async compute" : "graphics queue",
+			eng_VulkanParticlesGetSimulationMilliseconds(particles), eng_VulkanParticlesGetRenderMilliseconds(particles));
+		eng_VulkanTextDrawf(text, 8, 8 + line * 8, 2, white, "Input to present: %5.2f ms (avg %5.2f), waited %5.2f ms, work %5.2f ms, interval %5.2f ms",
+			eng_FramePacerGetLatencyMilliseconds(pacer), eng_FramePacerGetAverageLatencyMilliseconds(pacer), eng_FramePacerGetWaitMilliseconds(pacer),
+			eng_FramePacerGetWorkMilliseconds(pacer), eng_FramePacerGetIntervalMilliseconds(pacer));
+		eng_VulkanTextDrawf(text, 8, 8 + line * 9, 2, white, "Frame scratch: %u bytes, high-water %u/%u bytes", (unsigned)eng_FrameAllocatorGetUsed(frameScratch),
+			(unsigned)eng_FrameAllocatorGetHighWaterMark(frameScratch), (unsigned)eng_FrameAllocatorGetBytesPerFrame(frameScratch));
+		// Fragments per rendered pixel is the scene's overdraw.
+		const double renderPixels = (double)renderWidth * renderHeight;
+		for (uint32_t region = 0; region < eng_VulkanQueryRegionGetCount(vulkan); ++region)
+		{
+			eng_VulkanQueryResult result;
+			const int32_t y = 8 + line * (10 + (int32_t)region);
+			if (!eng_VulkanQueryRegionGetResult(vulkan, region, &result))
+			{
+				eng_VulkanTextDrawf(text, 8, y, 2, white, "%s: no queries", eng_VulkanQueryRegionGetName(vulkan, region));
+			}
+			else if (result.HasStatistics)
+			{
+				eng_VulkanTextDrawf(text, 8, y, 2, white, "%s: %llu verts, %llu prims, %llu frags (%.2fx), %llu compute",
+					eng_VulkanQueryRegionGetName(vulkan, region), (unsigned long long)result.VertexInvocations, (unsigned long long)result.ClippingPrimitives,
+					(unsigned long long)result.FragmentInvocations, result.FragmentInvocations / renderPixels, (unsigned long long)result.ComputeInvocations);
+			}
+			else
+			{
+				eng_VulkanTextDrawf(text, 8, y, 2, white, "%s: %llu samples passed", eng_VulkanQueryRegionGetName(vulkan, region),
+					(unsigned long long)result.SamplesPassed);
+			}
+		}
+#endif
+
+		eng_StopwatchStart(renderStopwatch);
 		eng_VulkanUpdate(vulkan);
+		eng_StopwatchStop(renderStopwatch);
+		eng_StopwatchStop(frameStopwatch);
+		eng_FramePacerPresented(pacer, eng_VulkanGetAcquireMilliseconds(vulkan));
+
+		++frame;
+#if !defined(GAME_FINAL)
+		if (frame == LightValidationFrame)
+		{
+			eng_VulkanLightCullingValidate(lightCulling);
+		}
+#endif
+
+		frameMilliseconds += (eng_StopwatchGetMilliseconds(frameStopwatch) - frameMilliseconds) * 0.1;
+		renderMilliseconds += (eng_StopwatchGetMilliseconds(renderStopwatch) - renderMilliseconds) * 0.1;
 	}
 	eng_StopwatchStop(stopwatch);
 
 	eng_StopwatchToString(stopwatch, buffer, sizeof(buffer));
 	eng_Log("Application ran for: %s\n", buffer);
 
-	eng_Log("Core systems used %d/%d bytes of available memory.\n", allocator->GetCurrentOffset(), CoreSystemAllocator::CoreSystemMemorySize);
+	eng_FrameAllocatorReport(frameScratch);
+	eng_TrackingAllocatorReport(tracker);
 
 	////////////////////////////////////////////////////////////////////////// Cleanup
 	return GracefullyExit(0);